@@ -102,11 +102,37 @@ CachedObjectMgr::~CachedObjectMgr()
 /************************************************************************/
 /* CacheRecord                                                          */
 /************************************************************************/
-CachedObjectMgr::CacheRecord::CacheRecord() : objectID(nullptr), timestamp(0), version(0), cache(nullptr) {}
+CachedObjectMgr::CacheRecord::CacheRecord() : objectID(nullptr), timestamp(0), version(0), cache(nullptr), object(nullptr) {}
 CachedObjectMgr::CacheRecord::~CacheRecord()
 {
     PyDecRef( objectID );
     PyDecRef( cache );
+    PySafeDecRef( object );
+}
+
+PyObject *CachedObjectMgr::CacheRecord::Encode()
+{
+    if (object == nullptr) {
+        PyCachedObject co;
+        co.timestamp = timestamp;
+        co.version = version;
+        co.nodeID = HackCacheNodeID;    //hack, doesn't matter until we have multi-node networks.
+        co.shared = true;
+        co.objectID = objectID;
+        co.cache = cache;
+
+        if (cache->content().size() == 0 || cache->content()[0] == MarshalHeaderByte)
+            co.compressed = false;
+        else
+            co.compressed = true;
+
+        object = co.Encode();
+        co.objectID = nullptr;    //not ours
+        co.cache = nullptr;
+    }
+
+    PyIncRef( object );
+    return object;
 }
 
 PyObject *CachedObjectMgr::CacheRecord::EncodeHint() const
@@ -148,26 +174,19 @@ std::string CachedObjectMgr::OIDToString(const PyRep *objectID)
     return v.result;
 }
 
+// a single string collapses to itself, so string IDs are looked up as they are
 bool CachedObjectMgr::HaveCached(const std::string &objectID) const
 {
-    //this is very sub-optimal, but it keeps things more consistent (in case StringCollapseVisitor ever gets more complicated)
-    PyString *str = new PyString( objectID );
-    bool ret = HaveCached(str);
-    PyDecRef(str);
-    return ret;
+    return (m_cachedObjects.find(objectID) != m_cachedObjects.end());
 }
 
 bool CachedObjectMgr::HaveCached(const PyRep *objectID) const
 {
-    PyIncRef(objectID);
-    const std::string str = OIDToString(objectID);
-
-    return (m_cachedObjects.find(str) != m_cachedObjects.end());
+    return HaveCached(OIDToString(objectID));
 }
 
 void CachedObjectMgr::InvalidateCache(const PyRep *objectID)
 {
-    PyIncRef(objectID);
     const std::string str = OIDToString(objectID);
     CachedObjMapItr res = m_cachedObjects.find(str);
 
@@ -211,8 +230,9 @@ void CachedObjectMgr::UpdateCache(const PyRep *objectID, PyRep **in_cached_data)
         //cached_data->visit(&dumper, 0);
     //}
 
+    // deflated once and sent to every client asking for it; compress hard
     Buffer* buf = new Buffer();
-    bool res = MarshalDeflate( cached_data, *buf );
+    bool res = MarshalDeflate( cached_data, *buf, 0x2000, Z_BEST_COMPRESSION );
 
     if ( res ) {
         PyBuffer* pbuf = new PyBuffer( &buf );
@@ -255,60 +275,32 @@ void CachedObjectMgr::_UpdateCache(const PyRep *objectID, PyBuffer **pbuf)
 
 PyObject *CachedObjectMgr::MakeCacheHint(const std::string &objectID)
 {
-    //this is sub-optimal, but it keeps things more consistent (in case StringCollapseVisitor ever gets more complicated)
-    PyString* str = new PyString( objectID );
-    PyObject* obj(MakeCacheHint(str));
-    PyDecRef(str);
-    return obj;
-}
-
-PyObject *CachedObjectMgr::MakeCacheHint(const PyRep *objectID)
-{
-    const std::string str = OIDToString(objectID);
-
-    CachedObjMapItr res = m_cachedObjects.find(str);
+    CachedObjMapItr res = m_cachedObjects.find(objectID);
     if (res == m_cachedObjects.end())
         return nullptr;
 
     return res->second->EncodeHint();
 }
 
-PyObject *CachedObjectMgr::GetCachedObject(const std::string &objectID)
+PyObject *CachedObjectMgr::MakeCacheHint(const PyRep *objectID)
 {
-    //this is sub-optimal, but it keeps things more consistent (in case StringCollapseVisitor ever gets more complicated)
-    PyString* str = new PyString( objectID );
-    PyObject* obj(GetCachedObject(str));
-    PyDecRef(str);
-    return obj;
+    return MakeCacheHint(OIDToString(objectID));
 }
 
-PyObject *CachedObjectMgr::GetCachedObject(const PyRep *objectID)
+PyObject *CachedObjectMgr::GetCachedObject(const std::string &objectID)
 {
-    const std::string str = OIDToString(objectID);
-
-    CachedObjMapItr res = m_cachedObjects.find(str);
+    CachedObjMapItr res = m_cachedObjects.find(objectID);
     if (res == m_cachedObjects.end())
         return nullptr;
 
-    PyCachedObject co;
-    co.timestamp = res->second->timestamp;
-    co.version = res->second->version;
-    co.nodeID = HackCacheNodeID;    //hack, doesn't matter until we have multi-node networks.
-    co.shared = true;
-    co.objectID = res->second->objectID->Clone();
-    co.cache = res->second->cache;
-
-    if (res->second->cache->content().size() == 0 || res->second->cache->content()[0] == MarshalHeaderByte)
-        co.compressed = false;
-    else
-        co.compressed = true;
+    sLog.Debug("CachedObjMgr","Returning cached object '%s' with checksum 0x%x", objectID.c_str(), res->second->version);
 
-    sLog.Debug("CachedObjMgr","Returning cached object '%s' with checksum 0x%x", str.c_str(), co.version);
-
-    PyObject* result = co.Encode();
-    co.cache = nullptr;    //avoid a copy
+    return res->second->Encode();
+}
 
-    return result;
+PyObject *CachedObjectMgr::GetCachedObject(const PyRep *objectID)
+{
+    return GetCachedObject(OIDToString(objectID));
 }
 
 bool CachedObjectMgr::IsCacheUpToDate(const PyRep *objectID, uint32 version, int64 timestamp)
@@ -319,9 +311,9 @@ bool CachedObjectMgr::IsCacheUpToDate(const PyRep *objectID, uint32 version, int
     if (res == m_cachedObjects.end())
         return false;
 
-    //for now, only support exact matches...
-    return (   res->second->version == version
-            && res->second->timestamp == timestamp);
+    // version is crc32 of our deflated contents, so it matches for equal contents even after the object was rebuilt
+    //  (timestamp is time of build, and changes with every rebuild)
+    return (res->second->version == version);
 }
 
 bool CachedObjectMgr::LoadCachedFromFile(const std::string &cacheDir, const std::string &objectID)
@@ -372,6 +364,13 @@ bool CachedObjectMgr::LoadCachedFromFile(const std::string &cacheDir, const PyRe
 
     fclose( f );
 
+    /* a partly written or damaged file would be sent to every client as is */
+    if ((header.length > 0) and (CRC32::Generate( &(*buf)[0], buf->size() ) != header.version)) {
+        sLog.Error("CachedObjMgr", "Cache file '%s' failed its checksum.  Rebuilding.", filename.c_str());
+        SafeDelete( buf );
+        return false;
+    }
+
     CachedObjMapItr res = m_cachedObjects.find( str );
 
     if ( res != m_cachedObjects.end() )
@@ -412,7 +411,11 @@ bool CachedObjectMgr::SaveCachedToFile(const std::string &cacheDir, const PyRep
     filename += str;
     filename += ".cache";
 
-    FILE *f = fopen(filename.c_str(), "wb");
+    /* written aside and renamed over the old file, so a crash here never leaves a partial file */
+    std::string tempname(filename);
+    tempname += ".tmp";
+
+    FILE *f = fopen(tempname.c_str(), "wb");
 
     if (f == nullptr)
         return false;
@@ -425,16 +428,33 @@ bool CachedObjectMgr::SaveCachedToFile(const std::string &cacheDir, const PyRep
 
     if (fwrite(&header, sizeof(header), 1, f) != 1) {
         fclose(f);
+        remove(tempname.c_str());
         return false;
     }
 
     if (fwrite(&res->second->cache->content()[0], sizeof(uint8), header.length, f) != header.length) {
-        assert(false);
         fclose(f);
+        remove(tempname.c_str());
         return false;
     }
-    fclose(f);
-    return true;
+    if (fclose(f) != 0) {
+        remove(tempname.c_str());
+        return false;
+    }
+#ifdef HAVE_WINDOWS_H
+    remove(filename.c_str());
+#endif /* HAVE_WINDOWS_H */
+    return (rename(tempname.c_str(), filename.c_str()) == 0);
+}
+
+bool CachedObjectMgr::RemoveCachedFile(const std::string &cacheDir, const PyRep *objectID)
+{
+    std::string filename(cacheDir);
+    filename += "/";
+    filename += OIDToString(objectID);
+    filename += ".cache";
+
+    return (remove(filename.c_str()) == 0);
 }
 
 /*
@@ -802,12 +822,12 @@ PyObject *PyCachedObject::Encode()
         //or if we can change this encode method to consume the PyCachedObject (which will almost always be the case)
         arg_tuple->items[4] = cache->Clone();
     }*/
-    //TODO: we don't really need to clone this if we can figure out a way to say "this is read only"
-    //or if we can change this encode method to consume the PyCachedObject (which will almost always be the case)
-    arg_tuple->items[4] = cache->Clone();
+    // contents and objectID are never changed once cached, so these are shared with the cache record
+    PyIncRef(cache);
+    arg_tuple->items[4] = cache;
     arg_tuple->items[5] = new PyInt(compressed?1:0);
-    //same cloning statement as above.
-    arg_tuple->items[6] = objectID->Clone();
+    PyIncRef(objectID);
+    arg_tuple->items[6] = objectID;
 
     return new PyObject( "objectCaching.CachedObject", arg_tuple );
 }
@@ -65,6 +65,7 @@ public:
     bool HaveCached(const std::string &objectID) const;
     bool HaveCached(const PyRep *objectID) const;
 
+    // true if client's copy has the version (checksum of contents) of ours.  timestamp is not compared
     bool IsCacheUpToDate(const PyRep *objectID, uint32 version, int64 timestamp);
 
     void InvalidateCache(const PyRep *objectID);
@@ -77,6 +78,7 @@ public:
     PyObject *MakeCacheHint(const PyRep *objectID);
     PyObject *MakeCacheHint(const std::string &objectID);
 
+    // returns new ref to the CachedObject sent to clients.  built once, then shared by all requests for it
     PyObject *GetCachedObject(const PyRep *objectID);
     PyObject *GetCachedObject(const std::string &objectID);
 
@@ -91,10 +93,13 @@ public:
     PyCachedCall *LoadCachedCall(const char *filename, const char *oname);
 
     //Cache file storage routines:
+    // files keep the deflated contents with their version and timestamp, so restarts skip db query and deflate,
+    //  and clients' copies stay current across restarts.  files failing their checksum are not loaded
     bool LoadCachedFromFile(const std::string &cacheDir, const std::string &objectID);
     bool LoadCachedFromFile(const std::string &cacheDir, const PyRep *objectID);
     bool SaveCachedToFile(const std::string &cacheDir, const std::string &objectID) const;
     bool SaveCachedToFile(const std::string &cacheDir, const PyRep *objectID) const;
+    static bool RemoveCachedFile(const std::string &cacheDir, const PyRep *objectID);
 
 protected:
     //static bool AddCachedFileContents(const char *filename, const char *oname, PySubStream *into);
@@ -108,13 +113,15 @@ protected:
         ~CacheRecord();
 
         PyObject *EncodeHint() const;
+        PyObject *Encode();
 
         PyRep *objectID;    //we own this
         int64 timestamp;
         uint32 version;
         PyBuffer *cache; //we own this.
+        PyObject *object;   //we own this.  encoded CachedObject, built on first request
     };
-    typedef std::map<std::string, CacheRecord *>    CachedObjMap;
+    typedef std::unordered_map<std::string, CacheRecord *>  CachedObjMap;
     typedef CachedObjMap::iterator                  CachedObjMapItr;
     typedef CachedObjMap::const_iterator            CachedObjMapConstItr;
 
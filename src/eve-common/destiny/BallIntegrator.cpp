@@ -0,0 +1,187 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "destiny/BallIntegrator.h"
+
+namespace Destiny {
+
+void BallIntegrator::Balls::Clear()
+{
+    posX.clear();  posY.clear();  posZ.clear();
+    velX.clear();  velY.clear();  velZ.clear();
+    headX.clear(); headY.clear(); headZ.clear();
+    tgtX.clear();  tgtY.clear();  tgtZ.clear();
+    speed.clear();
+}
+
+void BallIntegrator::Balls::SizeOutputs(bool missile)
+{
+    size_t size = speed.size();
+    velX.resize(size); velY.resize(size); velZ.resize(size);
+    if (missile) {
+        headX.resize(size); headY.resize(size); headZ.resize(size);
+    }
+}
+
+void BallIntegrator::Balls::Reserve(size_t size, bool missile)
+{
+    posX.reserve(size);  posY.reserve(size);  posZ.reserve(size);
+    velX.reserve(size);  velY.reserve(size);  velZ.reserve(size);
+    headX.reserve(size); headY.reserve(size); headZ.reserve(size);
+    if (missile) {
+        tgtX.reserve(size); tgtY.reserve(size); tgtZ.reserve(size);
+    }
+    speed.reserve(size);
+}
+
+size_t BallIntegrator::AddMove(const GPoint& position, const GVector& heading, float speed)
+{
+    m_moves.posX.push_back(position.x);
+    m_moves.posY.push_back(position.y);
+    m_moves.posZ.push_back(position.z);
+    m_moves.headX.push_back(heading.x);
+    m_moves.headY.push_back(heading.y);
+    m_moves.headZ.push_back(heading.z);
+    m_moves.speed.push_back(speed);
+    return m_moves.speed.size() - 1;
+}
+
+size_t BallIntegrator::AddMissile(const GPoint& position, const GPoint& target, float speed)
+{
+    m_missiles.posX.push_back(position.x);
+    m_missiles.posY.push_back(position.y);
+    m_missiles.posZ.push_back(position.z);
+    m_missiles.tgtX.push_back(target.x);
+    m_missiles.tgtY.push_back(target.y);
+    m_missiles.tgtZ.push_back(target.z);
+    m_missiles.speed.push_back(speed);
+    return m_missiles.speed.size() - 1;
+}
+
+void BallIntegrator::Integrate()
+{
+    // outputs are sized here, once per pass, rather than per ball
+    m_moves.SizeOutputs(false);
+    m_missiles.SizeOutputs(true);
+    MoveBalls(m_moves, 0, m_moves.speed.size());
+    MoveMissiles(m_missiles, 0, m_missiles.speed.size());
+}
+
+void BallIntegrator::IntegrateMove(size_t idx)
+{
+    m_moves.SizeOutputs(false);
+    MoveBalls(m_moves, idx, idx + 1);
+}
+
+void BallIntegrator::IntegrateMissile(size_t idx)
+{
+    m_missiles.SizeOutputs(true);
+    MoveMissiles(m_missiles, idx, idx + 1);
+}
+
+void BallIntegrator::Clear()
+{
+    m_moves.Clear();
+    m_missiles.Clear();
+}
+
+void BallIntegrator::Reserve(size_t moves, size_t missiles)
+{
+    m_moves.Reserve(moves, false);
+    m_missiles.Reserve(missiles, true);
+}
+
+/* the operations (and their order) below must stay the same as the GaVec3 operators used by DestinyManager,
+ *  so batched and single balls end up at the very same position.
+ */
+void BallIntegrator::MoveBalls(Balls& balls, size_t begin, size_t end)
+{
+    double* px = balls.posX.data();
+    double* py = balls.posY.data();
+    double* pz = balls.posZ.data();
+    double* vx = balls.velX.data();
+    double* vy = balls.velY.data();
+    double* vz = balls.velZ.data();
+    const double* hx = balls.headX.data();
+    const double* hy = balls.headY.data();
+    const double* hz = balls.headZ.data();
+    const double* sp = balls.speed.data();
+
+    // arrays never overlap; tell the compiler so, else it will not vectorize the loop
+    #pragma GCC ivdep
+    for (size_t i = begin; i < end; ++i) {
+        // velocity = heading * speed
+        vx[i] = hx[i] * sp[i];
+        vy[i] = hy[i] * sp[i];
+        vz[i] = hz[i] * sp[i];
+        // position = position + velocity
+        px[i] = px[i] + vx[i];
+        py[i] = py[i] + vy[i];
+        pz[i] = pz[i] + vz[i];
+    }
+}
+
+void BallIntegrator::MoveMissiles(Balls& balls, size_t begin, size_t end)
+{
+    double* px = balls.posX.data();
+    double* py = balls.posY.data();
+    double* pz = balls.posZ.data();
+    double* vx = balls.velX.data();
+    double* vy = balls.velY.data();
+    double* vz = balls.velZ.data();
+    double* hx = balls.headX.data();
+    double* hy = balls.headY.data();
+    double* hz = balls.headZ.data();
+    const double* tx = balls.tgtX.data();
+    const double* ty = balls.tgtY.data();
+    const double* tz = balls.tgtZ.data();
+    const double* sp = balls.speed.data();
+
+    #pragma GCC ivdep
+    for (size_t i = begin; i < end; ++i) {
+        // heading = GVector(position, target), normalized
+        double dx = tx[i] - px[i];
+        double dy = ty[i] - py[i];
+        double dz = tz[i] - pz[i];
+        double len = sqrt((dx * dx) + (dy * dy) + (dz * dz));
+        // normalize() leaves vectors shorter than epsilon as they are; scaling by 1.0 does the same without a branch
+        double inv = (len > Ga::Math::GaEpsilon ? 1.0 / len : 1.0);
+        hx[i] = dx * inv;
+        hy[i] = dy * inv;
+        hz[i] = dz * inv;
+        // velocity = heading * speed
+        vx[i] = hx[i] * sp[i];
+        vy[i] = hy[i] * sp[i];
+        vz[i] = hz[i] * sp[i];
+        // position = position + velocity
+        px[i] = px[i] + vx[i];
+        py[i] = py[i] + vy[i];
+        pz[i] = pz[i] + vz[i];
+    }
+}
+
+}
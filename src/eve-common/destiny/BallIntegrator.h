@@ -0,0 +1,102 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __DESTINY_BALL_INTEGRATOR_H_INCL__
+#define __DESTINY_BALL_INTEGRATOR_H_INCL__
+
+#include "math/gpoint.h"
+
+namespace Destiny {
+
+/**
+ * @brief Moves many balls one tic at a time, kept as structure of arrays.
+ *
+ * Balls are added each tic with their current position and heading (or target point),
+ *  then Integrate() moves all of them in one pass per group:
+ *   moving balls (GOTO, STOP, ORBIT, FOLLOW and warp alignment) travel along their heading at given speed,
+ *   missiles turn to face their target point first, then travel at given speed.
+ *
+ * results are bit-for-bit the same as the scalar GPoint/GVector code in DestinyManager:
+ *   velocity = heading * speed;  position = position + velocity;
+ *  with the missile heading normalized as GaVec3::normalize() does.
+ *
+ * the loops are branch-free over contiguous arrays, so the compiler may vectorize them.
+ */
+class BallIntegrator
+{
+public:
+    BallIntegrator()                                    { }
+
+    /** @return index of ball in move group. */
+    size_t AddMove(const GPoint& position, const GVector& heading, float speed);
+    /** @return index of ball in missile group. */
+    size_t AddMissile(const GPoint& position, const GPoint& target, float speed);
+
+    /** moves all balls of both groups. */
+    void Integrate();
+    /** moves one ball only.  used when a ball must be moved before the rest of its group. */
+    void IntegrateMove(size_t idx);
+    void IntegrateMissile(size_t idx);
+
+    void Clear();
+    void Reserve(size_t moves, size_t missiles);
+
+    size_t GetMoveCount() const                         { return m_moves.speed.size(); }
+    size_t GetMissileCount() const                      { return m_missiles.speed.size(); }
+
+    GPoint GetMovePosition(size_t idx) const            { return m_moves.GetPosition(idx); }
+    GVector GetMoveVelocity(size_t idx) const           { return m_moves.GetVelocity(idx); }
+    GPoint GetMissilePosition(size_t idx) const         { return m_missiles.GetPosition(idx); }
+    GVector GetMissileVelocity(size_t idx) const        { return m_missiles.GetVelocity(idx); }
+    GVector GetMissileHeading(size_t idx) const         { return m_missiles.GetHeading(idx); }
+
+private:
+    struct Balls {
+        std::vector<double> posX, posY, posZ;
+        std::vector<double> velX, velY, velZ;
+        std::vector<double> headX, headY, headZ;
+        std::vector<double> tgtX, tgtY, tgtZ;       // missiles only
+        std::vector<double> speed;
+
+        GPoint GetPosition(size_t idx) const        { return GPoint(posX[idx], posY[idx], posZ[idx]); }
+        GVector GetVelocity(size_t idx) const       { return GVector(velX[idx], velY[idx], velZ[idx]); }
+        GVector GetHeading(size_t idx) const        { return GVector(headX[idx], headY[idx], headZ[idx]); }
+
+        void Clear();
+        /** sizes velocity (and missile heading) arrays to number of balls. */
+        void SizeOutputs(bool missile);
+        void Reserve(size_t size, bool missile);
+    };
+
+    static void MoveBalls(Balls& balls, size_t begin, size_t end);
+    static void MoveMissiles(Balls& balls, size_t begin, size_t end);
+
+    Balls m_moves;
+    Balls m_missiles;
+};
+
+}
+
+#endif  // __DESTINY_BALL_INTEGRATOR_H_INCL__
@@ -0,0 +1,462 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "effects/FxExpression.h"
+
+const Expression& FX::GetExpression(const ExpressionMap& exps, uint16 expressionID)
+{
+    // unknown ids get expression 0, as FxDataMgr::GetExpression() does
+    static const Expression empty = Expression();
+    ExpressionMap::const_iterator itr = exps.find(expressionID);
+    if (itr != exps.end())
+        return itr->second;
+    itr = exps.find(0);
+    if (itr != exps.end())
+        return itr->second;
+    return empty;
+}
+
+void FX::ParseExpression(const ExpressionMap& exps, const Expression& expression, bool skill, uint16 srcTypeID, fxModifier& data, std::vector<fxModifier>& into)
+{
+    switch(expression.operandID) {
+        // these return the given expressionValue
+        case Operands::DEFBOOL:   //23  this evaulates to 'true' (Bool(1))
+        case Operands::DEFINT: {  //27  this is used as  0,1,2,{raceID}
+            //  seems to be called only to online/offline modules (and screws up my Online/Offline code...)
+            /** @todo  if this is used, change the Put* methods to use ModuleItem
+            int8 value = atoi(expression.expressionValue.c_str());
+            if (module) {
+                if (value == 0)
+                    data.srcRef->PutOffline();
+                if (value == 1)
+                    data.srcRef->PutOnline(isRig);
+                return; // we are done at this point
+            } */
+        } break;
+        case Operands::DEFASSOCIATION: { //21
+            data.math = GetAssociationEnum(expression.expressionValue);
+            /*
+            if (data.math > Math::MaxMathMethod) {
+                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
+                _log(EFFECTS__ERROR, "FX::ParseExpression(): out of range mathOp: %s(%i) for operand %u (%s).", \
+                        GetMathMethodName(data.math), data.math, expression.operandID, operand.operandKey.c_str());
+            } */
+        } break;
+        case Operands::DEFENVIDX: {     //24
+            data.targLoc = GetEnvironmentEnum(expression.expressionValue);
+            /*
+            if (data.targLoc > Target::MaxTargLocation) {
+                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
+                _log(EFFECTS__ERROR, "FX::ParseExpression(): out of range targLoc: %i for operand %u (%s).", \
+                        data.targAttr, expression.operandID, operand.operandKey.c_str());
+            } */
+        } break;
+        // these provide the given expressionID (attrib/grp)
+        case Operands::DEFATTRIBUTE: {  //22
+            if (expression.expressionAttributeID) {
+                if (data.targAttr) {  // always processed first
+                    data.srcAttr = expression.expressionAttributeID;
+                } else {
+                    data.targAttr = expression.expressionAttributeID;
+                }
+            } else {
+                _log(EFFECTS__ERROR, "FX::ParseExpression(): opATTR called with no expressionAttributeID defined");
+            }
+        } break;
+        case Operands::DEFGROUP: {      //26
+            data.fxSrc = Source::Group;
+            if (expression.expressionGroupID) {
+                data.grpID = expression.expressionGroupID;
+            } else if (expression.expressionValue != "") {
+                ;   // will have to figure out how to do this one.
+                _log(EFFECTS__WARNING, "FX::ParseExpression(): opGROUP using expressionValue %s called by %s",\
+                        expression.expressionValue.c_str(), expression.expressionName.c_str());
+            } else {
+                _log(EFFECTS__ERROR, "FX::ParseExpression(): opGROUP called with no expressionGroupID or expressionValue defined");
+            }
+        } break;
+        case Operands::DEFTYPEID: {     //29
+            if (skill)
+                data.fxSrc = Source::Skill;
+            if (expression.expressionTypeID) {
+                data.typeID = expression.expressionTypeID;
+            } else if (expression.expressionValue != "") {
+                ;   // will have to figure out how to do this one.
+                _log(EFFECTS__WARNING, "FX::ParseExpression(): opTYPEID using expressionValue %s", expression.expressionValue.c_str());
+            } else {
+                _log(EFFECTS__ERROR, "FX::ParseExpression(): opTYPEID called with no expressionTypeID or expressionValue defined");
+            }
+        } break;
+        case Operands::GETTYPE: { //36, %(arg1)s.GetTypeID()  --used by SRLG in AORSM
+            if (!data.typeID)
+                data.typeID = srcTypeID;    // get items on ship that require SkillItem as source
+        } break;
+        // do as stated
+        case Operands::GM:      //37, %(arg1)s.GetModule(%(arg2)s)      --used by subsystems as (GetModule(Ship:201):55)
+        case Operands::RSA: {   //64, %(arg1)s.%(arg2)s      -- used by AGRSM
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);
+        } break;
+        case Operands::COMBINE: { //17, %(arg1)s); (%(arg2)s      --executes two statements
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            fxModifier data1 = fxModifier();
+            data1.action = Action::Invalid;
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data1, into);
+        } break;
+        case Operands::LG: {    //48, %(arg1)s.LocationGroup.%(arg2)s  -- specify a group by grpID for a location'  used by ALGM
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);   //source
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);   //groupID
+        } break;
+        case Operands::SRLG: {    //49, %(arg1)s.SkillRequiredLocationGroup[%(arg2)s]  --  specify a group by skillID for a location   used by ALRSM and AORSM
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);   //source
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);   //skillID
+            if (!data.fxSrc) {    // fxSrc = Self in this case.  update to remove this hack?
+                data.fxSrc = Source::Skill;
+            }
+        } break;
+        case Operands::ATT:     //12, %(arg1)s->%(arg2)s               --(item:attribID)
+        case Operands::EFF:     //31, %(arg2)s.%(arg1)s                --define association type
+        case Operands::GA:      //34, %(arg1)s.%(arg2)s                --GetAttribute      (no known uses)
+        case Operands::GET:     //35, %(arg1)s.%(arg2)s()              --used a lot.  eg. Get(Ship:101) means 'get attribute 101 on ShipItem'
+        case Operands::IA: {    //40, %(arg1)s                         --used by AGSM
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            if (expression.arg2)
+                ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);
+        } break;
+        // effect function calls.
+        // here is where we'll actually add the modifier data to the item's map
+        case Operands::AIM:     //6,  AddItemModifier(env,%(arg1)s, %(arg2)s)
+        case Operands::AGRSM:   //5,  [%(arg1)s].AGRSM(%(arg2)s)    --AddGangRequiredSkillModifier
+        case Operands::AGSM: {  //3,  [%(arg1)s].AGSM(%(arg2)s)        --AddGangShipModifier
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);
+            into.push_back(data);
+        } break;
+        case Operands::ALGM:    //7,  (%(arg1)s).AddLocationGroupModifier (%(arg2)s)
+        case Operands::ALM:     //8,  (%(arg1)s).AddLocationModifier (%(arg2)s)
+        case Operands::ALRSM:   //9,  (%(arg1)s).AddLocationRequiredSkillModifier(%(arg2)s)
+        case Operands::AORSM: { //11, (%(arg1)s).AddOwnerRequiredSkillModifier(%(arg2)s)
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);
+            if ((skill) and (!data.fxSrc))      // fxSrc = Self in this case.  update to remove this hack?
+                data.fxSrc = Source::Skill;
+            into.push_back(data);
+        } break;
+        // remove modifier calls only partially enabled for modules and charges.
+        // will implement for implants and boosters when those systems are written.
+        case Operands::RIM:     //58, (%(arg1)s).RemoveItemModifier (%(arg2)s)
+        case Operands::RGGM:    //54, [%(arg1)s].RemoveGangGroupModifier(%(arg2)s)
+        case Operands::RGSM:    //55, [%(arg1)s].RemoveGangShipModifier(%(arg2)s)
+        case Operands::RGORSM:  //56, [%(arg1)s].RemoveGangOwnerRequiredSkillModifier(%(arg2)s)
+        case Operands::RGRSM: { //57, [%(arg1)s].RemoveGangRequiredSkillModifier(%(arg2)s)
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);
+            // removal is the reversed modifier
+            data.math = GetReverseMathMethod(data.math);
+            data.remove = true;
+            into.push_back(data);
+        } break;
+        case Operands::RLGM:    //59, (%(arg1)s).RemoveLocationGroupModifier (%(arg2)s)
+        case Operands::RLM:     //60, (%(arg1)s).RemoveLocationModifier (%(arg2)s)
+        case Operands::RLRSM:   //61, (%(arg1)s).RemoveLocationRequiredSkillModifier(%(arg2)s)
+        case Operands::RORSM: { //62, (%(arg1)s).RemoveOwnerRequiredSkillModifier(%(arg2)s)
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, data, into);
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, data, into);
+            if ((skill) and (!data.fxSrc))     // fxSrc = Self in this case.  update to remove this hack?
+                data.fxSrc = Source::Skill;
+            // removal is the reversed modifier
+            data.math = GetReverseMathMethod(data.math);
+            data.remove = true;
+            into.push_back(data);
+        } break;
+        /*
+        // next 3 not used here, as they are only used by effect 16 (Online), which is covered in GenericModule class.
+        case Operands::OR:     //'%(arg1)s OR %(arg2)s'       -- used with 'if' in arg2 as 'y'.   ((if x then y) OR z)  (used as "else" or elif)
+        case Operands::AND:    //'(%(arg1)s) AND (%(arg2)s)'  -- used with 'if' in arg1 as 'x'.   (if (x AND y) then ....)
+        case Operands::IF: {    //'If(%(arg1)s), Then (%(arg2)s)'    -- std conditional.  (if x then y)
+        } break;
+        // trivial attribute operations
+        case Operands::ADD: {      //1, (%(arg1)s)+(%(arg2)s)
+            // this isnt complete.
+            fxData arg1 = fxData();
+                arg1.srcRef = data.srcRef;
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, arg1, into);
+            fxData arg2 = fxData();
+                arg2.srcRef = data.srcRef;
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, arg2, into);
+            data.result = (arg1.result + arg2.result);
+        } break;
+        case Operands::GTE: {  //39    %(arg1)s>=%(arg2)s
+            fxData arg1 = fxData();
+                arg1.srcRef = data.srcRef;
+            ParseExpression(exps, GetExpression(exps, expression.arg1), skill, srcTypeID, arg1, into);
+            fxData arg2 = fxData();
+                arg2.srcRef = data.srcRef;
+            ParseExpression(exps, GetExpression(exps, expression.arg2), skill, srcTypeID, arg2, into);
+            //  this needs work
+            //if (arg1.srcRef->GetAttribute(arg1.srcAttr) >= arg2.targLoc->GetAttribute(arg2.targAttr))
+            //    data.result = true;
+
+        } break;
+        case Operands::GT: {   //38    %(arg1)s> %(arg2)s
+
+        } break;
+
+        case Operands::UE: {   //73    UserError(%(arg1)s)
+            // not using this yet.
+        } break;
+        case Operands::SKILLCHECK: {   //67    SkillCheck(%(arg1)s)
+            //data.result = true;
+        } break;
+        // module action method calls...not used.
+        case Operands::ATTACK: // 13,
+        case Operands::CARGOSCAN: // 14,
+        case Operands::CHEATTELEDOCK: // 15,
+        case Operands::CHEATTELEGATE: // 16,
+        case Operands::DECLOAKWAVE: // 19,
+        case Operands::ECMBURST: // 30,
+        case Operands::EMPWAVE: // 32,
+        case Operands::LAUNCH: // 44,
+        case Operands::LAUNCHDEFENDERMISSILE: // 45,
+        case Operands::LAUNCHDRONE: // 46,
+        case Operands::LAUNCHFOFMISSILE: // 47,
+        case Operands::MINE: // 50,
+        case Operands::POWERBOOST: // 53,
+        case Operands::SHIPSCAN: // 66,
+        case Operands::SURVEYSCAN: // 69,
+        case Operands::TARGETHOSTILES: // 70,
+        case Operands::TARGETSILENTLY: // 71,
+        case Operands::TOOLTARGETSKILLS: // 72,
+        case Operands::SPEEDBOOST: {   //75    EVEmu-specific operand to apply modified speed attribs to destiny variables and update bubble
+            data.action = expression.operandID;
+           // pItem->AddModifier(data);
+        } break;
+        default: {              // in case the op hasnt been defined, make a note here
+            if (is_log_enabled(EFFECTS__UNDEFINED)) {
+                std::ostringstream ret;
+                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
+                ret << "Operand id:" << expression.operandID << " key:" << operand.operandKey;
+                if (operand.format.empty()) {
+                    ret << " - has not been defined.";
+                } else {                // % {'arg1': arg1, 'arg2': arg2, 'value': expression.expressionValue}
+                    ret << " - should be added as " << operand.format.c_str();
+                }
+                _log(EFFECTS__UNDEFINED, "FX::ParseExpression() - %s", ret.str().c_str());
+            }
+        } break;
+        */
+    }
+}
+
+/* this follows ParseExpression() case for case, but only keeps track of what ParseExpression() would put in fxModifier.
+ * everything ParseExpression() looks up while running is resolved here, once, when effects are loaded:
+ *   association and environment names are turned into their enums,
+ *   source domain (skill or item) is known by which program is being compiled,
+ *   removals are reversed here, as ParseExpression() does when it meets them.
+ * module action operands are left out, as they are in ParseExpression().
+ * the only runtime value left is the source item's typeID, which GetTypeID() may put in typeID.
+ */
+void FX::CompileExpression(const ExpressionMap& exps, uint16 expressionID, bool skill, fxStep& step, fxProgram& into, uint8 depth/*0*/)
+{
+    if (depth > 32) {
+        _log(EFFECTS__ERROR, "FX::CompileExpression(): expression %u is nested too deep.  stopping here.", expressionID);
+        return;
+    }
+
+    const Expression& expression = GetExpression(exps, expressionID);
+    fxModifier& data = step.data;
+
+    switch(expression.operandID) {
+        case Operands::DEFASSOCIATION: { //21
+            data.math = GetAssociationEnum(expression.expressionValue);
+        } break;
+        case Operands::DEFENVIDX: {     //24
+            data.targLoc = GetEnvironmentEnum(expression.expressionValue);
+        } break;
+        case Operands::DEFATTRIBUTE: {  //22
+            if (expression.expressionAttributeID) {
+                if (data.targAttr) {  // always processed first
+                    data.srcAttr = expression.expressionAttributeID;
+                } else {
+                    data.targAttr = expression.expressionAttributeID;
+                }
+            }
+        } break;
+        case Operands::DEFGROUP: {      //26
+            data.fxSrc = Source::Group;
+            if (expression.expressionGroupID)
+                data.grpID = expression.expressionGroupID;
+        } break;
+        case Operands::DEFTYPEID: {     //29
+            if (skill)
+                data.fxSrc = Source::Skill;
+            if (expression.expressionTypeID) {
+                data.typeID = expression.expressionTypeID;
+                step.srcType = false;
+            }
+        } break;
+        case Operands::GETTYPE: { //36
+            if ((!data.typeID) and (!step.srcType))
+                step.srcType = true;
+        } break;
+        case Operands::GM:      //37
+        case Operands::RSA:     //64
+        case Operands::LG: {    //48
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+        } break;
+        case Operands::COMBINE: { //17
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            fxStep step1 = fxStep();
+            step1.data.action = Action::Invalid;
+            CompileExpression(exps, expression.arg2, skill, step1, into, depth +1);
+        } break;
+        case Operands::SRLG: {    //49
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+            if (!data.fxSrc)
+                data.fxSrc = Source::Skill;
+        } break;
+        case Operands::ATT:     //12
+        case Operands::EFF:     //31
+        case Operands::GA:      //34
+        case Operands::GET:     //35
+        case Operands::IA: {    //40
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            if (expression.arg2)
+                CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+        } break;
+        case Operands::AIM:     //6
+        case Operands::AGRSM:   //5
+        case Operands::AGSM: {  //3
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+            into.push_back(step);
+        } break;
+        case Operands::ALGM:    //7
+        case Operands::ALM:     //8
+        case Operands::ALRSM:   //9
+        case Operands::AORSM: { //11
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+            if ((skill) and (!data.fxSrc))
+                data.fxSrc = Source::Skill;
+            into.push_back(step);
+        } break;
+        case Operands::RIM:     //58
+        case Operands::RGGM:    //54
+        case Operands::RGSM:    //55
+        case Operands::RGORSM:  //56
+        case Operands::RGRSM: { //57
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+            data.math = GetReverseMathMethod(data.math);
+            data.remove = true;
+            into.push_back(step);
+        } break;
+        case Operands::RLGM:    //59
+        case Operands::RLM:     //60
+        case Operands::RLRSM:   //61
+        case Operands::RORSM: { //62
+            CompileExpression(exps, expression.arg1, skill, step, into, depth +1);
+            CompileExpression(exps, expression.arg2, skill, step, into, depth +1);
+            if ((skill) and (!data.fxSrc))
+                data.fxSrc = Source::Skill;
+            data.math = GetReverseMathMethod(data.math);
+            data.remove = true;
+            into.push_back(step);
+        } break;
+    }
+}
+
+int8 FX::GetReverseMathMethod(int8 method)
+{
+    switch (method) {
+        case FX::Math::PreMul:         return FX::Math::PreDiv;
+        case FX::Math::PreDiv:         return FX::Math::PreMul;
+        case FX::Math::ModAdd:         return FX::Math::ModSub;
+        case FX::Math::ModSub:         return FX::Math::ModAdd;
+        case FX::Math::PostMul:        return FX::Math::PostDiv;
+        case FX::Math::PostDiv:        return FX::Math::PostMul;
+        case FX::Math::PostPercent:    return FX::Math::RevPostPercent;
+        case FX::Math::PreAssignment:  return FX::Math::PostAssignment;
+        case FX::Math::PostAssignment: return FX::Math::PreAssignment;
+    }
+    return method;
+}
+
+int8 FX::GetAssociationEnum(const std::string& association)
+{   // opID 21
+    if (association == "PreAssignment") {
+        return FX::Math::PreAssignment;
+    } else if (association == "PreDiv") {
+        return FX::Math::PreDiv;
+    } else if (association == "PreMul") {
+        return FX::Math::PreMul;
+    } else if (association == "ModAdd") {
+        return FX::Math::ModAdd;
+    } else if (association == "ModSub") {
+        return FX::Math::ModSub;
+    } else if (association == "PostPercent") {
+        return FX::Math::PostPercent;
+    } else if (association == "PostMul") {
+        return FX::Math::PostMul;
+    } else if (association == "PostDiv") {
+        return FX::Math::PostDiv;
+    } else if (association == "PostAssignment") {
+        return FX::Math::PostAssignment;
+    } else if (association == "SkillCheck") {
+        return FX::Math::SkillCheck;
+    } else if (association == "AddRate") {
+        return FX::Math::AddRate;
+    } else if (association == "SubRate") {
+        return FX::Math::SubRate;
+    } else {
+        return FX::Math::Invalid;  //throw std::bad_typeid();
+    }
+}
+
+int8 FX::GetEnvironmentEnum(const std::string& env)
+{   // opID 24
+    if (env == "Self") {
+        return FX::Target::Self;
+    } else if (env == "Char") {
+        return FX::Target::Char;
+    } else if (env == "Ship") {
+        return FX::Target::Ship;
+    } else if (env == "Target") {
+        return FX::Target::Target;
+    } else if (env == "Area") {
+        return FX::Target::Area;
+    } else if (env == "Other") {
+        return FX::Target::Other;
+    } else if (env == "Charge") {
+        return FX::Target::Charge;
+    } else {
+        return FX::Target::Invalid;  //throw std::bad_typeid();
+    }
+}
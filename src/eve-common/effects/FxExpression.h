@@ -0,0 +1,285 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __EFFECTS__FX_EXPRESSION_H__INCL__
+#define __EFFECTS__FX_EXPRESSION_H__INCL__
+
+#include "eve-core.h"
+
+/*
+ * effect expressions, and the modifiers they make.  nothing here needs items or the db;
+ *  FxProc runs these for items, and eve-test checks compiled expressions against parsed ones.
+ */
+
+struct Expression {
+    int8 operandID;
+    uint16 id;
+    uint16 arg1;
+    uint16 arg2;
+    uint16 expressionTypeID;
+    uint16 expressionGroupID;
+    uint16 expressionAttributeID;
+    std::string expressionValue;
+    std::string description;
+    std::string expressionName;
+};
+
+// k,v of expressionID, expression
+typedef std::map<uint16, Expression> ExpressionMap;
+
+/* modifier made by an expression.  FxProc adds the source item (fxData) */
+struct fxModifier {
+    int8 math;          // math used on data
+    int8 fxSrc;        // effect source location
+    int8 targLoc;       // effect target location
+    uint8 action;        // effect *DOES* something (module action aside from modification)
+    bool remove;        // modifier removes a previously added modifier.  math is reversed
+    uint16 targAttr;
+    uint16 srcAttr;
+    uint16 grpID;       // used to define items in env grouped by item groupID
+    uint16 typeID;      // used to define items in env grouped by skill requirement
+};
+
+/* one modifier of a compiled expression.  see FX::CompileExpression() */
+struct fxStep {
+    bool srcType;       // data.typeID is taken from source item when executed (GetTypeID())
+    fxModifier data;
+};
+
+// flat list of modifiers an expression adds to its item, in order
+typedef std::vector<fxStep> fxProgram;
+
+// these tables are used to decode fields in Effects table
+namespace FX {
+
+    namespace Source {    // formally known as domain
+        enum {
+            Invalid          = -1,
+            //  these define the location for group-, skill-, gang-, and owner-required effects
+            Self             = 0,
+            Skill            = 1,
+            Ship             = 2,
+            Owner            = 3,
+            Gang             = 4,
+            Group            = 5,
+            Target           = 6
+        };
+    }
+
+    namespace Target {    //formally known as environment
+        enum {
+            Invalid         = -1,
+            // these define the item containing the attribute to be modified
+            //  these are found (as text) in the expressionValue field of dgmExpressions table and may need to merge with Association, or test with it
+            Self            = 0,
+            Char            = 1,
+            Ship            = 2,
+            Target          = 3,
+            Other           = 4,
+            Area            = 5,
+            PowerCore       = 6,  //defined but not used
+            Charge          = 7,
+            MaxTargLocation = 7
+        };
+    }
+
+    namespace State {   // formally known as category
+        enum {
+            Invalid        = -1,
+            // these are the effectCategory in dgmEffects table to denote when this effect is applied or removed
+            Passive        = 0, //Applied when item is present and online - implants, skills, modules, charges
+            Active         = 1, //Applied when active module is activated
+            Target         = 2, //Applied onto selected target when module is activated
+            Area           = 3, //defined but not used
+            Online         = 4, //Applied when module is onlined
+            Overloaded     = 5, //Applied when module is overloaded and activated
+            Dungeon        = 6, //Dungeon effects, several effects exist in this category, but not assigned to any item  -passive
+            System         = 7  //System-wide effects, like WH and incursion  -passive
+        };
+    }
+
+    namespace Math {    // formally known as association
+        enum {
+            Invalid        = -1,
+            // these define how the data is manipulated according to the format field in dgmOperands table
+            PreAssignment  = 0,
+            PreMul         = 1,
+            PreDiv         = 2,
+            ModAdd         = 3,
+            ModSub         = 4,
+            PostMul        = 5,
+            PostDiv        = 6,
+            PostPercent    = 7,
+            PostAssignment = 8,
+            SkillCheck     = 9,
+            /* no data or expressions with these next two */
+            AddRate        = 10,
+            SubRate        = 11,
+            RevPostPercent = 12,
+            MaxMathMethod  = 12
+        };
+    }
+
+    namespace Action {  // this are coded and are applied on the fly as needed.
+        enum {
+            Invalid               = 0,
+            ATTACK                   = 13,
+            CARGOSCAN                = 14,
+            CHEATTELEDOCK            = 15,
+            CHEATTELEGATE            = 16,
+            DECLOAKWAVE              = 19,
+            ECMBURST                 = 30,
+            EMPWAVE                  = 32,
+            LAUNCH                   = 44,
+            LAUNCHDEFENDERMISSILE    = 45,
+            LAUNCHDRONE              = 46,
+            LAUNCHFOFMISSILE         = 47,
+            MINE                     = 50,
+            POWERBOOST               = 53,   //effectID 48  - Consumes power booster charges to increase the available power in the capacitor.
+            SHIPSCAN                 = 66,
+            SURVEYSCAN               = 69,
+            TARGETHOSTILES           = 70,
+            TARGETSILENTLY           = 71,
+            TOOLTARGETSKILLS         = 72,
+            VERIFYTARGETGROUP        = 74,
+            /* unique/special to EVEmu */
+            SPEEDBOOST               = 75    //effectID 14  - prop mod to call destiny speed updates
+        };
+    }
+
+    /*  old shit
+             case CALC_NONE:                            return val1;
+             case CALC_ADD:                             return val1 + val2;
+             case CALC_SUBTRACT:                        return val1 - val2;
+             case CALC_MULTIPLY:                        return val1 * val2;
+             case CALC_DIVIDE:                          return ((val2 != 0) ? val1 / val2 : val1);
+             case CALC_PERCENTAGE:                      return val1 * (1 + (val2 / 100));
+             case CALC_REV_PERCENTAGE:                  return val1 / (1 + (val2 / 100));
+             case CALC_ADD_PERCENT:                     return val1 + (val2 / 100);
+             case CALC_SUBTRACT_PERCENT:                return val1 - (val2 / 100);
+             case CALC_ADD_RESIST:                      return val1 - (1 - val2);
+             case CALC_SUBTRACT_RESIST:                 return val1 + (1 - val2);
+     */
+
+    namespace Operands {
+        enum {
+            // @note  '//*' denotes implemented
+            ADD = 1,             //*
+            AGGM = 2,            //*
+            AGSM = 3,            //*
+            AGORSM = 4,          //*
+            AGRSM = 5,           //*
+            AIM = 6,             //*
+            ALGM = 7,            //*
+            ALM = 8,             //*
+            ALRSM = 9,           //*
+            AND = 10,            //*
+            AORSM = 11,          //*
+            ATT = 12,            //*
+            ATTACK = 13,
+            CARGOSCAN = 14,
+            CHEATTELEDOCK = 15,
+            CHEATTELEGATE = 16,
+            COMBINE = 17,        //*
+            DEC = 18,            //*
+            DECLOAKWAVE = 19,
+            DECN = 20,           //*
+            DEFASSOCIATION = 21, //*
+            DEFATTRIBUTE = 22,   //*
+            DEFBOOL = 23,        //*
+            DEFENVIDX = 24,      //*
+            DEFFLOAT = 25,       //*
+            DEFGROUP = 26,       //*
+            DEFINT = 27,         //*
+            DEFSTRING = 28,      //*
+            DEFTYPEID = 29,      //*
+            ECMBURST = 30,
+            EFF = 31,            //*
+            EMPWAVE = 32,
+            EQ = 33,             //*
+            GA = 34,             //*
+            GET = 35,            //*
+            GETTYPE = 36,        //*
+            GM = 37,             //*
+            GT = 38,             //*
+            GTE = 39,            //*
+            IA = 40,             //*
+            IF = 41,             //*
+            INC = 42,            //*
+            INCN = 43,           //*
+            LAUNCH = 44,
+            LAUNCHDEFENDERMISSILE = 45,
+            LAUNCHDRONE = 46,
+            LAUNCHFOFMISSILE = 47,
+            LG = 48,             //*
+            SRLG = 49,           //*
+            MINE = 50,
+            MUL = 51,            //*
+            OR = 52,             //*
+            POWERBOOST = 53,
+            RGGM = 54,           //*
+            RGSM = 55,           //*
+            RGORSM = 56,         //*
+            RGRSM = 57,          //*
+            RIM = 58,            //*
+            RLGM = 59,           //*
+            RLM = 60,            //*
+            RLRSM = 61,          //*
+            RORSM = 62,          //*
+            RS = 63,             //*
+            RSA = 64,            //*
+            SET = 65,            //*
+            SHIPSCAN = 66,
+            SKILLCHECK = 67,     //*
+            SUB = 68,            //*
+            SURVEYSCAN = 69,
+            TARGETHOSTILES = 70,
+            TARGETSILENTLY = 71,
+            TOOLTARGETSKILLS = 72,
+            UE = 73,             //*
+            VERIFYTARGETGROUP = 74,
+            SPEEDBOOST = 75      //*
+        };
+    }
+}
+
+namespace FX {
+    // expression of given id, or expression 0 if unknown
+    const Expression& GetExpression(const ExpressionMap& exps, uint16 expressionID);
+    /* walks expression tree, adding modifiers to into as they are made.
+     * skill denotes source item is skill, implant or booster.  srcTypeID is used by GetTypeID()
+     */
+    void ParseExpression(const ExpressionMap& exps, const Expression& expression, bool skill, uint16 srcTypeID, fxModifier& data, std::vector<fxModifier>& into);
+    /* lowers expression tree into flat list of modifiers, with names resolved and removals reversed.
+     * gives the modifiers ParseExpression() would, once source typeID is put in steps marked srcType
+     */
+    void CompileExpression(const ExpressionMap& exps, uint16 expressionID, bool skill, fxStep& step, fxProgram& into, uint8 depth=0);
+
+    int8 GetReverseMathMethod(int8 method);
+    int8 GetEnvironmentEnum(const std::string& env);
+    int8 GetAssociationEnum(const std::string& association);
+}
+
+#endif /* !__EFFECTS__FX_EXPRESSION_H__INCL__ */
@@ -43,6 +43,7 @@
 #include "database/dbtype.h"
 // log
 #include "log/LogNew.h"
+#include "log/LogWriter.h"
 #include "log/logsys.h"
 // math
 #include "math/gpoint.h"
@@ -41,13 +41,13 @@ bool Marshal( const PyRep* rep, Buffer& into )
     return ret;
 }
 
-bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit )
+bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit, int level )
 {
     Buffer* data(new Buffer());
     bool ret(false);
     if (Marshal(rep, *data)) {
         if ( data->size() >= deflationLimit ) {
-            ret = DeflateData( *data, into );
+            ret = DeflateData( *data, into, level );
         } else {
             into.AppendSeq( data->begin<uint8>(), data->end<uint8>() );
             ret = true;
@@ -75,6 +75,15 @@ bool MarshalStream::Save( const PyRep* rep, Buffer& into )
     return res;
 }
 
+bool MarshalStream::SaveRep( const PyRep* rep, Buffer& into )
+{
+    mBuffer = &into;
+    bool res(rep->visit(*this));
+    mBuffer = nullptr;
+
+    return res;
+}
+
 bool MarshalStream::SaveStream( const PyRep* rep )
 {
     Put<uint8>( MarshalHeaderByte );
@@ -89,10 +98,26 @@ bool MarshalStream::SaveStream( const PyRep* rep )
     return rep->visit( *this );
 }
 
+void MarshalStream::BeginStream( Buffer& into )
+{
+    mBuffer = &into;
+    Put<uint8>( MarshalHeaderByte );
+    Put<uint32>( 0 ); // Mapcount
+}
+
+bool MarshalStream::SaveRep( const PyRep* rep )
+{
+    return rep->visit( *this );
+}
+
 bool MarshalStream::VisitInteger( const PyInt* rep )
 {
-    const int32 val(rep->value());
+    SaveInteger( rep->value() );
+    return true;
+}
 
+void MarshalStream::SaveInteger( int32 val )
+{
     if ( val == -1 ) {
         Put<uint8>( Op_PyMinusOne );
     } else if ( val == 0 ) {
@@ -109,14 +134,16 @@ bool MarshalStream::VisitInteger( const PyInt* rep )
         Put<uint8>( Op_PyByte );
         Put<int8>( val );
     }
-
-    return true;
 }
 
 bool MarshalStream::VisitLong( const PyLong* rep )
 {
-    const int64 val(rep->value());
+    SaveLong( rep->value() );
+    return true;
+}
 
+void MarshalStream::SaveLong( int64 val )
+{
     if ( val == -1 ) {
         Put<uint8>( Op_PyMinusOne );
     } else if ( val == 0 ) {
@@ -124,7 +151,7 @@ bool MarshalStream::VisitLong( const PyLong* rep )
     } else if ( val == 1 ) {
         Put<uint8>( Op_PyOneInteger );
     } else if ( val + 0x800000u > 0xFFFFFFFF ) {
-        SaveVarInteger( rep );
+        SaveVarInteger( val );
     } else if ( val + 0x8000u > 0xFFFF ) {
         Put<uint8>( Op_PyLong );
         Put<int32>(static_cast<int32>(val));
@@ -135,62 +162,66 @@ bool MarshalStream::VisitLong( const PyLong* rep )
         Put<uint8>( Op_PyByte );
         Put<int8>(static_cast<int8>(val));
     }
-
-    return true;
 }
 
 bool MarshalStream::VisitBoolean( const PyBool* rep )
 {
-    if (rep->value())
-        Put<uint8>( Op_PyTrue );
-    else
-        Put<uint8>( Op_PyFalse );
-
+    SaveBoolean( rep->value() );
     return true;
 }
 
 bool MarshalStream::VisitReal( const PyFloat* rep )
 {
-    if ( rep->value() == 0.0 ) {
+    SaveReal( rep->value() );
+    return true;
+}
+
+void MarshalStream::SaveReal( double value )
+{
+    if ( value == 0.0 ) {
         Put<uint8>( Op_PyZeroReal );
     } else {
         Put<uint8>( Op_PyReal );
-        Put<double>( rep->value() );
+        Put<double>( value );
     }
-
-    return true;
 }
 
 bool MarshalStream::VisitNone( const PyNone* rep )
 {
-    Put<uint8>( Op_PyNone );
+    SaveNone();
     return true;
 }
 
 bool MarshalStream::VisitBuffer( const PyBuffer* rep )
 {
-    Put<uint8>( Op_PyBuffer );
-
-    const Buffer& buf = rep->content();
+    SaveBuffer( rep->content() );
+    return true;
+}
 
-    PutSizeEx( (uint32)buf.size() );
-    Put( buf.begin<uint8>(), buf.end<uint8>() );
+void MarshalStream::SaveBuffer( const Buffer& data )
+{
+    Put<uint8>( Op_PyBuffer );
 
-    return true;
+    PutSizeEx( (uint32)data.size() );
+    Put( data.begin<uint8>(), data.end<uint8>() );
 }
 
 bool MarshalStream::VisitString( const PyString* rep )
 {
-    size_t len(rep->content().size());
+    SaveString( rep->content() );
+    return true;
+}
 
+void MarshalStream::SaveString( const char* str, size_t len )
+{
     if ( len == 0 ) {
         Put<uint8>( Op_PyEmptyString );
     } else if ( len == 1 ) {
         Put<uint8>( Op_PyCharString );
-        Put<uint8>( rep->content()[0] );
+        Put<uint8>( str[0] );
     } else {
         //string is long enough for a string table entry, check it.
-        const uint8 index = sMarshalStringTable.LookupIndex( rep->content() );
+        const uint8 index = sMarshalStringTable.LookupIndex( str );
         if ( index > STRING_TABLE_ERROR ) {
             Put<uint8>( Op_PyStringTableItem );
             Put<uint8>( index );
@@ -198,17 +229,19 @@ bool MarshalStream::VisitString( const PyString* rep )
         // NOTE: they seem to have stopped using Op_PyShortString
             Put<uint8>( Op_PyLongString );
             PutSizeEx( (uint32)len );
-            Put( rep->content().begin(), rep->content().end() );
+            Put( str, str + len );
         }
     }
-
-    return true;
 }
 
 bool MarshalStream::VisitWString( const PyWString* rep )
 {
-    size_t len(rep->content().size());
+    SaveWString( rep->content() );
+    return true;
+}
 
+void MarshalStream::SaveWString( const char* str, size_t len )
+{
     if ( len == 0 ) {
         Put<uint8>( Op_PyEmptyWString );
     } else {
@@ -217,27 +250,33 @@ bool MarshalStream::VisitWString( const PyWString* rep )
 
         Put<uint8>( Op_PyWStringUTF8 );
         PutSizeEx( (uint32)len );
-        Put( rep->content().begin(), rep->content().end() );
+        Put( str, str + len );
     }
-
-    return true;
 }
 
 bool MarshalStream::VisitToken( const PyToken* rep )
 {
-    Put<uint8>( Op_PyToken );
-
     const std::string& str = rep->content();
+    SaveToken( str.c_str(), str.size() );
+    return true;
+}
 
-    PutSizeEx( (uint32)str.size() );
-    Put( str.begin(), str.end() );
+void MarshalStream::SaveToken( const char* str, size_t len )
+{
+    Put<uint8>( Op_PyToken );
 
-    return true;
+    PutSizeEx( (uint32)len );
+    Put( str, str + len );
 }
 
 bool MarshalStream::VisitTuple( const PyTuple* rep )
 {
-    uint32 size(rep->size());
+    SaveTupleSize( rep->size() );
+    return PyVisitor::VisitTuple( rep );
+}
+
+void MarshalStream::SaveTupleSize( uint32 size )
+{
     if ( size == 0 ) {
         Put<uint8>( Op_PyEmptyTuple );
     } else if ( size == 1 ) {
@@ -248,13 +287,16 @@ bool MarshalStream::VisitTuple( const PyTuple* rep )
         Put<uint8>( Op_PyTuple );
         PutSizeEx( size );
     }
-
-    return PyVisitor::VisitTuple( rep );
 }
 
 bool MarshalStream::VisitList( const PyList* rep )
 {
-    uint32 size(rep->size());
+    SaveListSize( rep->size() );
+    return PyVisitor::VisitList( rep );
+}
+
+void MarshalStream::SaveListSize( uint32 size )
+{
     if ( size == 0 ) {
         Put<uint8>( Op_PyEmptyList );
     } else if ( size == 1 ) {
@@ -263,15 +305,17 @@ bool MarshalStream::VisitList( const PyList* rep )
         Put<uint8>( Op_PyList );
         PutSizeEx( size );
     }
-
-    return PyVisitor::VisitList( rep );
 }
 
-bool MarshalStream::VisitDict( const PyDict* rep )
+void MarshalStream::SaveDictSize( uint32 size )
 {
-    uint32 size(rep->size());
     Put<uint8>( Op_PyDict );
     PutSizeEx( size );
+}
+
+bool MarshalStream::VisitDict( const PyDict* rep )
+{
+    SaveDictSize( rep->size() );
 
     //we have to reverse the order of key/value to be value/key, so do not call base class.
     PyDict::const_iterator cur = rep->begin(), end = rep->end();
@@ -287,7 +331,7 @@ bool MarshalStream::VisitDict( const PyDict* rep )
 
 bool MarshalStream::VisitObject( const PyObject* rep )
 {
-    Put<uint8>( Op_PyObject );
+    SaveObjectHeader();
     return PyVisitor::VisitObject( rep );
 }
 
@@ -436,7 +480,7 @@ bool MarshalStream::VisitPackedRow( const PyPackedRow* rep )
 
 bool MarshalStream::VisitSubStruct( const PySubStruct* rep )
 {
-    Put<uint8>(Op_PySubStruct);
+    SaveSubStructHeader();
     return PyVisitor::VisitSubStruct( rep );
 }
 
@@ -479,9 +523,8 @@ bool MarshalStream::VisitChecksumedStream( const PyChecksumedStream* rep )
     return PyVisitor::VisitChecksumedStream( rep );
 }
 
-void MarshalStream::SaveVarInteger( const PyLong* v )
+void MarshalStream::SaveVarInteger( int64 value )
 {
-    const int64 value(v->value());
     uint8 integerSize(0);
 
 #define DoIntegerSizeCheck(x) if ( ( (uint8*)&value )[x] != 0 ) integerSize = x + 1;
@@ -45,11 +45,12 @@ extern bool Marshal( const PyRep* rep, Buffer& into );
  * @param[in]  rep            Python object to marshal.
  * @param[out] into           Buffer which receives deflated marshaled stream.
  * @param[in]  deflationLimit The least size of buffer which gets deflated.
+ * @param[in]  level          zlib compression level.
  *
  * @retval true  Marshaling ran successfully.
  * @retval false Error occured during marshaling.
  */
-extern bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit = 0x2000 );
+extern bool MarshalDeflate( const PyRep* rep, Buffer& into, const uint32 deflationLimit = 0x2000, int level = Z_DEFAULT_COMPRESSION );
 
 /**
  * @brief Turns Python objects into marshal bytecode.
@@ -65,6 +66,41 @@ public:
 
     /** saves given rep to given buffer */
     bool Save( const PyRep* rep, Buffer& into );
+    /** saves given rep to given buffer without stream header; used to splice reps into a saved stream */
+    bool SaveRep( const PyRep* rep, Buffer& into );
+
+    /**
+     * Direct writers, used by generated EncodeTo() to write packets without building their PyRep tree.
+     *  BeginStream() binds the buffer and adds the stream header; values are then added in marshal order.
+     *  each writer adds exactly what visiting the matching PyRep would.
+     */
+    void BeginStream( Buffer& into );
+    void EndStream()                                    { mBuffer = nullptr; }
+
+    /** adds given rep to the bound buffer */
+    bool SaveRep( const PyRep* rep );
+
+    void SaveInteger( int32 value );
+    void SaveLong( int64 value );
+    void SaveBoolean( bool value )                      { Put<uint8>( value ? Op_PyTrue : Op_PyFalse ); }
+    void SaveReal( double value );
+    void SaveNone()                                     { Put<uint8>( Op_PyNone ); }
+    void SaveBuffer( const Buffer& data );
+    /** str must be null-terminated, as string table lookup hashes up to the terminator */
+    void SaveString( const char* str, size_t len );
+    void SaveString( const std::string& str )           { SaveString( str.c_str(), str.size() ); }
+    void SaveWString( const char* str, size_t len );
+    void SaveWString( const std::string& str )          { SaveWString( str.c_str(), str.size() ); }
+    void SaveToken( const char* str, size_t len );
+
+    /** container headers.  followed by size items (tuple, list) or size value/key pairs (dict) */
+    void SaveTupleSize( uint32 size );
+    void SaveListSize( uint32 size );
+    void SaveDictSize( uint32 size );
+    /** followed by type string and arguments */
+    void SaveObjectHeader()                             { Put<uint8>( Op_PyObject ); }
+    /** followed by one item */
+    void SaveSubStructHeader()                          { Put<uint8>( Op_PySubStruct ); }
 
 protected:
     /** saves new stream with given rep. */
@@ -139,7 +175,7 @@ protected:
 
 private:
     // utility to handle Op_PyVarInteger (a bit hacky......)
-    void SaveVarInteger( const PyLong* v );
+    void SaveVarInteger( int64 value );
     // zero-compresses given buffer and adds it to the stream
     bool SaveZeroCompressed( const Buffer& data );
 
@@ -36,23 +36,38 @@
 #include "utils/EVEUtils.h"
 
 PyRep* Unmarshal( const Buffer& data )
+{
+    return Unmarshal( data.begin<uint8>(), data.size() );
+}
+
+PyRep* Unmarshal( Buffer::const_iterator<uint8> data, size_t len )
 {
     UnmarshalStream* pUMS = new UnmarshalStream();
-    PyRep* res = pUMS->Load( data );
+    PyRep* res = pUMS->Load( data, len );
     SafeDelete(pUMS);
     return res;
 }
 
 PyRep* InflateUnmarshal( const Buffer& data )
 {
-    if (IsDeflated(data)) {
+    return InflateUnmarshal( data.begin<uint8>(), data.size() );
+}
+
+PyRep* InflateUnmarshal( Buffer::const_iterator<uint8> data, size_t len )
+{
+    if (len == 0) {
+        sLog.Error( "Unmarshal", "Empty stream received." );
+        return nullptr;
+    }
+
+    if (*data == DeflateHeaderByte) {
         Buffer inflatedData;
-        if (!InflateData(data, inflatedData))
+        if (!InflateData(&*data, len, inflatedData))
             return nullptr;
         return Unmarshal(inflatedData);
     }
 
-    return Unmarshal(data);
+    return Unmarshal(data, len);
 }
 
 UnmarshalStream::~UnmarshalStream()
@@ -133,8 +148,13 @@ PyRep* ( UnmarshalStream::* const UnmarshalStream::s_mLoadMap[ PyRepOpcodeMask +
 
 PyRep* UnmarshalStream::Load( const Buffer& data )
 {
-    mInItr = data.begin<uint8>();
-    PyRep* res = LoadStream( data.size() );
+    return Load( data.begin<uint8>(), data.size() );
+}
+
+PyRep* UnmarshalStream::Load( Buffer::const_iterator<uint8> data, size_t len )
+{
+    mInItr = data;
+    PyRep* res = LoadStream( len );
     mInItr = Buffer::const_iterator<uint8>();
 
     return res;
@@ -257,6 +277,12 @@ PyRep* UnmarshalStream::LoadStringShort()
     const uint8 len = Read<uint8>();
     const Buffer::const_iterator<char> str = Read<char>( len );
 
+    if (len > 0) {
+        PyString* interned = PyStatic.GetString( &*str, len );
+        if (interned != nullptr)
+            return interned;
+    }
+
     return new PyString( str, str + len );
 }
 
@@ -265,6 +291,12 @@ PyRep* UnmarshalStream::LoadStringLong()
     const uint32 len = ReadSizeEx();
     const Buffer::const_iterator<char> str = Read<char>( len );
 
+    if (len > 0) {
+        PyString* interned = PyStatic.GetString( &*str, len );
+        if (interned != nullptr)
+            return interned;
+    }
+
     return new PyString( str, str + len );
 }
 
@@ -272,7 +304,7 @@ PyRep* UnmarshalStream::LoadStringTable()
 {
     const uint8 index = Read<uint8>();
 
-    const char* str = sMarshalStringTable.LookupString( index );
+    PyString* str = PyStatic.GetTableString( index );
     if( NULL == str )
     {
         assert( false );
@@ -283,7 +315,7 @@ PyRep* UnmarshalStream::LoadStringTable()
         return new PyString( ebuf );
     }
     else
-        return new PyString( str );
+        return str;
 }
 
 PyRep* UnmarshalStream::LoadWStringUCS2Char()
@@ -322,6 +354,12 @@ PyRep* UnmarshalStream::LoadToken()
     const uint8 len = Read<uint8>();
     const Buffer::const_iterator<char> str = Read<char>( len );
 
+    if (len > 0) {
+        PyToken* interned = PyStatic.GetToken( &*str, len );
+        if (interned != nullptr)
+            return interned;
+    }
+
     return new PyToken( str, str + len );
 }
 
@@ -737,7 +775,7 @@ bool UnmarshalStream::LoadZeroCompressed( Buffer& into )
 #   define OPCODE_DECODE( opIsZero, opLen )     \
         if (opIsZero) {                        \
             uint8 len = opLen + 1;              \
-            while (0 < --len)                   \
+            while (0 < len--)                   \
                 into.Append<uint8>( 0 );        \
         } else {                                \
             const Buffer::const_iterator<uint8> \
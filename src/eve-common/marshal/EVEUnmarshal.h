@@ -37,6 +37,15 @@
  * @return Ownership of Python object.
  */
 extern PyRep* Unmarshal( const Buffer& data );
+/**
+ * @brief Turns marshal stream into Python object.
+ *
+ * @param[in] data Start of marshal stream, within a larger buffer.
+ * @param[in] len  Length of marshal stream.
+ *
+ * @return Ownership of Python object.
+ */
+extern PyRep* Unmarshal( Buffer::const_iterator<uint8> data, size_t len );
 /**
  * @brief Turns possibly inflated marshal stream into Python object.
  *
@@ -45,6 +54,15 @@ extern PyRep* Unmarshal( const Buffer& data );
  * @return Ownership of Python object.
 */
 extern PyRep* InflateUnmarshal( const Buffer& data );
+/**
+ * @brief Turns possibly inflated marshal stream into Python object.
+ *
+ * @param[in] data Start of possibly inflated marshal stream, within a larger buffer.
+ * @param[in] len  Length of marshal stream.
+ *
+ * @return Ownership of Python object.
+*/
+extern PyRep* InflateUnmarshal( Buffer::const_iterator<uint8> data, size_t len );
 
 /**
  * @brief Class which turns marshal bytecode into Python object.
@@ -69,6 +87,15 @@ public:
      * @return Loaded Python object.
      */
     PyRep* Load( const Buffer& data );
+    /**
+     * @brief Loads Python object from given bytecode.
+     *
+     * @param[in] data Start of marshal bytecode, within a larger buffer.
+     * @param[in] len  Length of marshal bytecode.
+     *
+     * @return Loaded Python object.
+     */
+    PyRep* Load( Buffer::const_iterator<uint8> data, size_t len );
 
 protected:
     /** Peeks element from stream. */
@@ -28,8 +28,10 @@
 
 #include "network/EVETCPConnection.h"
 
+class PyDict;
 class PyPacket;
 class PyRep;
+class MarshaledNotification;
 
 class VersionExchangeClient;
 class VersionExchangeServer;
@@ -79,6 +81,14 @@ public:
      * @param[in] p Packed to be queued.
      */
     void QueuePacket( PyPacket* packet );
+    /**
+     * @brief Queues packet of notification shared by multiple sessions.
+     *
+     * @param[in] noti          Marshaled notification.
+     * @param[in] userid        User ID of this session's client.
+     * @param[in] named_payload Named payload of this packet (may be NULL); not consumed.
+     */
+    void QueueNotification( const MarshaledNotification& noti, uint32 userid, const PyDict* named_payload ) { mNet->QueueNotification( noti, userid, named_payload ); }
 
     /**
      * @brief Pops new packet from queue.
@@ -28,6 +28,7 @@
 #include "marshal/EVEMarshal.h"
 #include "marshal/EVEUnmarshal.h"
 #include "network/EVETCPConnection.h"
+#include "network/MarshaledNotification.h"
 
 /*************************************************************************/
 /* EVETCPConnection                                                      */
@@ -47,9 +48,16 @@ EVETCPConnection::EVETCPConnection( Socket* sock, uint32 rIP, uint16 rPort )
 {
 }
 
+EVETCPConnection::~EVETCPConnection()
+{
+    // the loop may still call our overrides; stop it while mInQueue is alive
+    Disconnect();
+    WaitLoop();
+}
+
 void EVETCPConnection::QueueRep( const PyRep* rep, bool compress/*true*/ )
 {
-    Buffer* pBuffer = new Buffer();
+    Buffer* pBuffer = GetSendBuffer();
 
     // make room for length
     const Buffer::iterator<uint32> bufLen = pBuffer->end<uint32>();
@@ -61,9 +69,10 @@ void EVETCPConnection::QueueRep( const PyRep* rep, bool compress/*true*/ )
         return;
     }
 
+    // packets are deflated on the fly; favour speed over ratio
     bool success(false);
     if (compress)
-        success = MarshalDeflate(rep, *pBuffer);
+        success = MarshalDeflate(rep, *pBuffer, 0x2000, Z_BEST_SPEED);
     else
         success = MarshalDeflate(rep, *pBuffer, PACKET_SIZE_LIMIT);
 
@@ -81,24 +90,47 @@ void EVETCPConnection::QueueRep( const PyRep* rep, bool compress/*true*/ )
     SafeDelete( pBuffer );
 }
 
+void EVETCPConnection::QueueNotification( const MarshaledNotification& noti, uint32 userid, const PyDict* named_payload )
+{
+    Buffer* pBuffer = GetSendBuffer();
+
+    // make room for length
+    const Buffer::iterator<uint32> bufLen = pBuffer->end<uint32>();
+    pBuffer->ResizeAt( bufLen, 1 );
+
+    if (noti.Write(userid, named_payload, *pBuffer)) {
+        if (PACKET_SIZE_LIMIT < pBuffer->size()) {
+            sLog.Error( "Network", "Packet length %lu exceeds hardcoded packet length limit %u.", pBuffer->size(), PACKET_SIZE_LIMIT );
+        } else {
+            // write length
+            *bufLen = ( pBuffer->size() - sizeof( uint32 ) );
+            Send( &pBuffer );
+        }
+    } else {
+        sLog.Error( "Network", "Failed to write shared notification packet." );
+    }
+
+    SafeDelete( pBuffer );
+}
+
 PyRep* EVETCPConnection::PopRep()
 {
     PyRep* res(nullptr);
 
+    // the packet is a view into the packetizer's buffer; keep it locked until unmarshaled
     MutexLock lock( mMInQueue );
-    Buffer* packet = mInQueue.PopPacket();
+    Buffer::const_iterator<uint8> packet;
+    size_t len(0);
 
-    if (packet != nullptr) {
-        if ( PACKET_SIZE_LIMIT < packet->size() ) {
-            sLog.Error( "Network", "Packet length %lu exceeds hardcoded packet length limit %u.", packet->size(), PACKET_SIZE_LIMIT );
+    if (mInQueue.PeekPacket( packet, len )) {
+        if ( PACKET_SIZE_LIMIT < len ) {
+            sLog.Error( "Network", "Packet length %lu exceeds hardcoded packet length limit %u.", len, PACKET_SIZE_LIMIT );
         } else {
-           // if (is_log_enabled(DEBUG__DEBUG))
-           //     DumpBuffer( packet, PACKET_INBOUND );
-            res = InflateUnmarshal( *packet );
+            res = InflateUnmarshal( packet, len );
         }
+        mInQueue.ReleasePacket();
     }
 
-    SafeDelete( packet );
     return res;
 }
 
@@ -109,15 +141,25 @@ bool EVETCPConnection::ProcessReceivedData( char* errbuf )
 
     MutexLock lock( mMInQueue );
 
-    // put bytes into packetizer
-    mInQueue.InputData( *mRecvBuf );
-    // process packetizer
+    // bytes are already in packetizer; process it
     mInQueue.Process();
     mTimeoutTimer.Start();
 
     return true;
 }
 
+uint8* EVETCPConnection::GetRecvSpace( size_t len )
+{
+    MutexLock lock( mMInQueue );
+    return mInQueue.GetInputSpace( len );
+}
+
+void EVETCPConnection::CommitRecvSpace( size_t len )
+{
+    MutexLock lock( mMInQueue );
+    mInQueue.CommitInput( len );
+}
+
 bool EVETCPConnection::RecvData( char* errbuf )
 {
     if( !TCPConnection::RecvData( errbuf ) )
@@ -26,8 +26,10 @@
 #ifndef __NETWORK__EVE_TCP_CONNECTION_H__INCL__
 #define __NETWORK__EVE_TCP_CONNECTION_H__INCL__
 
+class PyDict;
 class PyRep;
 class EVETCPServer;
+class MarshaledNotification;
 
 /**
  * @brief EVE derivation of TCP connection.
@@ -49,7 +51,10 @@ public:
      * @brief Creates empty EVE connection.
      */
     EVETCPConnection();
-    virtual ~EVETCPConnection()                         { /* do nothing here */ }
+    /**
+     * @brief Stops processing before our members go away.
+     */
+    virtual ~EVETCPConnection();
 
     /**
      * @brief Queues given PyRep into send queue.
@@ -58,6 +63,16 @@ public:
      */
     // consumes PyRep
     void QueueRep( const PyRep* rep, bool compress=true );
+    /**
+     * @brief Queues packet of notification shared by multiple connections.
+     *
+     * Only the per-recipient fields get marshaled; see MarshaledNotification.
+     *
+     * @param[in] noti          Marshaled notification.
+     * @param[in] userid        User ID of this connection's client.
+     * @param[in] named_payload Named payload of this packet (may be NULL); not consumed.
+     */
+    void QueueNotification( const MarshaledNotification& noti, uint32 userid, const PyDict* named_payload );
 
     /**
      * @brief Pops PyRep from receive queue.
@@ -91,6 +106,9 @@ protected:
 
     bool RecvData( char* errbuf = 0 );
     bool ProcessReceivedData( char* errbuf = 0 );
+    // data is received straight into the packetizer
+    uint8* GetRecvSpace( size_t len );
+    void CommitRecvSpace( size_t len );
 
     void ClearBuffers();
 
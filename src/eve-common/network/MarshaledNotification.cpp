@@ -0,0 +1,221 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "marshal/EVEMarshal.h"
+#include "network/MarshaledNotification.h"
+#include "python/PyPacket.h"
+#include "python/PyRep.h"
+
+/**
+ * @brief MarshalStream which remembers where two placeholder reps were saved.
+ */
+class MarkingMarshalStream
+: public MarshalStream
+{
+public:
+    MarkingMarshalStream( const PyRep* first, const PyRep* second )
+    : mFirst( first ), mSecond( second ), mInto( nullptr ), mFirstOffset( 0 ), mSecondOffset( 0 ) { }
+
+    bool SaveMarked( const PyRep* rep, Buffer& into )
+    {
+        mInto = &into;
+        bool res(Save(rep, into));
+        mInto = nullptr;
+
+        return res;
+    }
+
+    size_t GetFirstOffset() const                       { return mFirstOffset; }
+    size_t GetSecondOffset() const                      { return mSecondOffset; }
+
+protected:
+    bool VisitNone( const PyNone* rep )
+    {
+        if (rep == mFirst)
+            mFirstOffset = mInto->size();
+        else if (rep == mSecond)
+            mSecondOffset = mInto->size();
+
+        return MarshalStream::VisitNone( rep );
+    }
+
+    const PyRep* mFirst;
+    const PyRep* mSecond;
+    const Buffer* mInto;
+    size_t mFirstOffset;
+    size_t mSecondOffset;
+};
+
+/* appends data as stored (uncompressed) deflate blocks; previous output must be byte aligned. */
+static void AppendStoredBlocks( Buffer& into, const Buffer& data, bool final )
+{
+    size_t offset(0);
+    do {
+        const uint16 len(std::min<size_t>( data.size() - offset, 0xFFFF ));
+        const bool last(offset + len == data.size());
+
+        // BFINAL, BTYPE = 00 (stored), padded to byte boundary
+        into.Append<uint8>( (final and last) ? 1 : 0 );
+        into.Append<uint16>( len );
+        into.Append<uint16>( ~len );
+        into.AppendSeq( data.begin<uint8>() + offset, data.begin<uint8>() + offset + len );
+
+        offset += len;
+    } while (offset < data.size());
+}
+
+MarshaledNotification::MarshaledNotification( const PyAddress& source, const PyAddress& dest, EVENotificationStream& noti, const uint32 deflationLimit )
+: RefObject( 0 ),
+  mHeadAdler( 0 ),
+  mBodyAdler( 0 ),
+  mValid( false ),
+  mDeflated( false )
+{
+    // same packet as Client::SendNotification() builds
+    PyPacket* packet = new PyPacket();
+        packet->type_string = "macho.Notification";
+        packet->type = NOTIFICATION;
+        packet->source = source;
+        packet->dest = dest;
+        packet->userid = 0;
+        packet->payload = noti.Encode();
+        packet->named_payload = nullptr;
+    PyRep* rep(packet->Encode());
+    // Encode() has moved payload into rep
+    packet->payload = nullptr;
+    SafeDelete(packet);
+
+    // replace per-recipient fields with placeholders we can find in the stream
+    PyTuple* args(rep->AsObject()->arguments()->AsTuple());
+    PyRep* userMark(new PyNone());
+    PyRep* namedMark(new PyNone());
+    PyDecRef(args->items[3]);
+    args->items[3] = userMark;
+    PyDecRef(args->items[5]);
+    args->items[5] = namedMark;
+
+    Buffer data;
+    MarkingMarshalStream ms( userMark, namedMark );
+    mValid = ms.SaveMarked( rep, data );
+    PyDecRef(rep);
+
+    if (!mValid)
+        return;
+
+    // the placeholders are a single Op_PyNone each
+    const size_t userOffset(ms.GetFirstOffset()), namedOffset(ms.GetSecondOffset());
+    mHead.AppendSeq( data.begin<uint8>(), data.begin<uint8>() + userOffset );
+    mBody.AppendSeq( data.begin<uint8>() + userOffset + 1, data.begin<uint8>() + namedOffset );
+    mTail.AppendSeq( data.begin<uint8>() + namedOffset + 1, data.end<uint8>() );
+
+    if (GetMarshaledSize() < deflationLimit)
+        return;
+
+    // deflate the notification once; sync flush leaves it byte aligned and
+    //  free of back references, so it may follow any other deflate blocks.
+    z_stream zs;
+    memset( &zs, 0, sizeof(zs) );
+    if (deflateInit2( &zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY ) != Z_OK) {
+        sLog.Error( "MarshaledNotification", "deflateInit2() failed; sending notification uncompressed." );
+        return;
+    }
+
+    mBodyDeflated.Resize<uint8>( deflateBound( &zs, mBody.size() ) + 16 );
+    zs.next_in = &mBody[ 0 ];
+    zs.avail_in = mBody.size();
+    zs.next_out = &mBodyDeflated[ 0 ];
+    zs.avail_out = mBodyDeflated.size();
+
+    int res(deflate( &zs, Z_SYNC_FLUSH ));
+    if ((res == Z_OK) and (zs.avail_in == 0) and (zs.avail_out > 0)) {
+        mBodyDeflated.Resize<uint8>( zs.total_out );
+        mHeadAdler = adler32( adler32( 0L, Z_NULL, 0 ), &mHead[ 0 ], mHead.size() );
+        mBodyAdler = adler32( adler32( 0L, Z_NULL, 0 ), &mBody[ 0 ], mBody.size() );
+        mDeflated = true;
+    } else {
+        sLog.Error( "MarshaledNotification", "deflate() failed (%i); sending notification uncompressed.", res );
+        mBodyDeflated.Resize<uint8>( 0 );
+    }
+
+    deflateEnd( &zs );
+}
+
+bool MarshaledNotification::Write( uint32 userid, const PyDict* named_payload, Buffer& into ) const
+{
+    if (!mValid)
+        return false;
+
+    // per-recipient fields, as PyPacket::Encode() would save them
+    PyRep* user(userid == 0 ? PyStatic.NewNone() : new PyInt( userid ));
+    Buffer userData, namedData;
+    MarshalStream ms;
+    bool res(ms.SaveRep( user, userData ));
+    PyDecRef(user);
+    if (named_payload == nullptr)
+        namedData.Append<uint8>( Op_PyNone );
+    else
+        res = res and ms.SaveRep( named_payload, namedData );
+
+    if (!res)
+        return false;
+
+    if (!mDeflated) {
+        into.AppendSeq( mHead.begin<uint8>(), mHead.end<uint8>() );
+        into.AppendSeq( userData.begin<uint8>(), userData.end<uint8>() );
+        into.AppendSeq( mBody.begin<uint8>(), mBody.end<uint8>() );
+        into.AppendSeq( namedData.begin<uint8>(), namedData.end<uint8>() );
+        into.AppendSeq( mTail.begin<uint8>(), mTail.end<uint8>() );
+        return true;
+    }
+
+    // zlib header matching compress(): deflate, 32K window, default level
+    into.Append<uint8>( DeflateHeaderByte );
+    into.Append<uint8>( 0x9C );
+
+    Buffer headData( mHead );
+    headData.AppendSeq( userData.begin<uint8>(), userData.end<uint8>() );
+    AppendStoredBlocks( into, headData, false );
+
+    into.AppendSeq( mBodyDeflated.begin<uint8>(), mBodyDeflated.end<uint8>() );
+
+    // the tail is a few bytes; store it along with named payload
+    namedData.AppendSeq( mTail.begin<uint8>(), mTail.end<uint8>() );
+    AppendStoredBlocks( into, namedData, true );
+
+    uLong adler(mHeadAdler);
+    adler = adler32_combine( adler, adler32( adler32( 0L, Z_NULL, 0 ), &userData[ 0 ], userData.size() ), userData.size() );
+    adler = adler32_combine( adler, mBodyAdler, mBody.size() );
+    adler = adler32_combine( adler, adler32( adler32( 0L, Z_NULL, 0 ), &namedData[ 0 ], namedData.size() ), namedData.size() );
+
+    // zlib trailer is big endian
+    into.Append<uint8>( (adler >> 24) & 0xFF );
+    into.Append<uint8>( (adler >> 16) & 0xFF );
+    into.Append<uint8>( (adler >> 8) & 0xFF );
+    into.Append<uint8>( adler & 0xFF );
+
+    return true;
+}
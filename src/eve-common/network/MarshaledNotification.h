@@ -0,0 +1,105 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __NETWORK__MARSHALED_NOTIFICATION_H__INCL__
+#define __NETWORK__MARSHALED_NOTIFICATION_H__INCL__
+
+#include "memory/RefPtr.h"
+#include "utils/Buffer.h"
+
+class PyAddress;
+class PyDict;
+class EVENotificationStream;
+
+/**
+ * @brief macho.Notification packet marshaled once for many recipients.
+ *
+ * The marshaled packet of a multicast notification only differs between
+ * recipients in the userid and named payload (the "sn" sequence number)
+ * fields.  Everything else is marshaled once on construction and, if the
+ * packet is large enough to be deflated, the notification payload is
+ * deflated once as well.  Write() then only marshals the two per-recipient
+ * fields and splices them around the shared bytes.
+ *
+ * Deflated packets are built as a single zlib stream: the per-recipient parts
+ * are emitted as stored blocks around the shared, sync-flushed deflate blocks
+ * of the payload, with the adler32 checksum combined from the parts.
+ *
+ * @author EVEmu Team
+ */
+class MarshaledNotification
+: public RefObject
+{
+public:
+    /**
+     * @brief Marshals shared part of notification.
+     *
+     * @param[in] source         Address of sending node.
+     * @param[in] dest           Broadcast address of notification.
+     * @param[in] noti           Notification to be sent; not consumed.
+     * @param[in] deflationLimit The least size of packet which gets deflated.
+     */
+    MarshaledNotification( const PyAddress& source, const PyAddress& dest, EVENotificationStream& noti, const uint32 deflationLimit = 0x2000 );
+
+    /** @return True if shared part has been marshaled successfully. */
+    bool IsValid() const                                { return mValid; }
+    /** @return True if packets written by this object are deflated. */
+    bool IsDeflated() const                             { return mDeflated; }
+    /** @return Size of marshaled shared part, in bytes. */
+    size_t GetMarshaledSize() const                     { return mHead.size() + mBody.size() + mTail.size(); }
+
+    /**
+     * @brief Appends packet for single recipient.
+     *
+     * @param[in]  userid        User ID of recipient; 0 is sent as None.
+     * @param[in]  named_payload Named payload of recipient (may be NULL); not consumed.
+     * @param[out] into          Buffer which receives the packet.
+     *
+     * @retval true  Packet has been written.
+     * @retval false Error occured during marshaling.
+     */
+    bool Write( uint32 userid, const PyDict* named_payload, Buffer& into ) const;
+
+protected:
+    /// Marshaled packet up to the userid field.
+    Buffer mHead;
+    /// Marshaled packet between userid and named payload fields (the notification itself).
+    Buffer mBody;
+    /// Marshaled packet after the named payload field.
+    Buffer mTail;
+
+    /// mBody as raw, sync-flushed deflate blocks.
+    Buffer mBodyDeflated;
+    /// adler32 checksums of mHead and mBody, used to build zlib trailer.
+    uLong mHeadAdler;
+    uLong mBodyAdler;
+
+    bool mValid;
+    bool mDeflated;
+};
+
+typedef RefPtr<MarshaledNotification> MarshaledNotificationRef;
+
+#endif /* !__NETWORK__MARSHALED_NOTIFICATION_H__INCL__ */
@@ -547,6 +547,7 @@ bool PyAddress::_DecodeObjectID(PyRep *rep) {
 PyCallStream::PyCallStream()
 : remoteObject(0),
   method(""),
+  methodID(0),
   arg_tuple(nullptr),
   arg_dict(nullptr)
 {
@@ -562,6 +563,7 @@ PyCallStream *PyCallStream::Clone() const {
     res->remoteObject = remoteObject;
     res->remoteObjectStr = remoteObjectStr;
     res->method = method;
+    res->methodID = methodID;
     res->arg_tuple = arg_tuple->Clone()->AsTuple();
     if (arg_dict == nullptr)
         res->arg_dict = nullptr;
@@ -704,6 +706,7 @@ bool PyCallStream::Decode(const std::string &type, PyTuple *&in_payload) {
     //parse tuple[1]: method name
     if (maint->items[1]->IsString()) {
         method = PyRep::StringContent(maint->items[1]);
+        methodID = sCallNames.Find(method);
     } else {
         codelog(NET__PACKET_ERROR, "PyCallStream::Decode() - maint->items[1] has non-string type");
         maint->items[1]->Dump(NET__PACKET_ERROR, " --> ");
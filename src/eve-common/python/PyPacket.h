@@ -27,6 +27,8 @@
 #define EVE_PY_PACKET_H
 
 #include "network/packet_types.h"
+#include "utils/NameTable.h"
+#include "utils/Singleton.h"
 
 class PyRep;
 class PyTuple;
@@ -140,6 +142,22 @@ public:
 #endif
 };
 
+/**
+ * @brief Interned names of callable methods.
+ *
+ * Services intern the methods they register and PyCallStream::Decode()
+ * looks up the called method once, so dispatch compares IDs instead of strings.
+ * Names sent by clients are only looked up, never added.
+ */
+class PyCallNameTable
+: public NameTable,
+  public Singleton<PyCallNameTable>
+{
+};
+
+#define sCallNames \
+    ( PyCallNameTable::get() )
+
 class PyCallStream {
 public:
     PyCallStream();
@@ -154,6 +172,7 @@ public:
     std::string remoteObjectStr;
 
     std::string method;
+    uint32 methodID;     //interned method; 0 if no service has registered it
     PyTuple *arg_tuple;
     PyDict  *arg_dict;   //named parameters
 };
@@ -29,6 +29,7 @@
 #include "marshal/EVEMarshal.h"
 #include "marshal/EVEUnmarshal.h"
 #include "marshal/EVEMarshalOpcodes.h"
+#include "marshal/EVEMarshalStringTable.h"
 #include "python/classes/PyDatabase.h"
 #include "python/PyDumpVisitor.h"
 #include "python/PyVisitor.h"
@@ -1243,3 +1244,189 @@ PyTuple* new_tuple( PyRep* arg1 )
         res->SetItem(0, arg1);
     return res;
 }
+
+/************************************************************************/
+/* pyStatic                                                             */
+/************************************************************************/
+/* interned besides the marshal string table.  class names and keys seen in most calls and notifications */
+static const char* const s_mInternStrings[] =
+{
+    "__builtin__.set",
+    "blue.DBRowDescriptor",
+    "ccp_exceptions.UserError",
+    "collections.defaultdict",
+    "dbutil.CFilterRowset",
+    "dbutil.CIndexedRowset",
+    "dbutil.CRowset",
+    "exceptions.GPSTransportClosed",
+    "foo.SlimItem",
+    "foo.Vector3",
+    "objectCaching.CachedMethodCallResult",
+    "objectCaching.CachedObject",
+    "objectCaching.CacheOK",
+    "util.BookmarkList",
+    "util.CachedObject",
+    "util.IndexRowset",
+    "util.KeyVal",
+    "util.Moniker",
+    "util.PasswordString",
+    "util.Row",
+    "util.Rowset",
+    "util.SparseRowset",
+    "OnMultiEvent",
+    "OnSessionChanged",
+    "allianceid",
+    "charid",
+    "constellationid",
+    "corpid",
+    "corprole",
+    "locationid",
+    "regionid",
+    "role",
+    "shipid",
+    "solarsystemid",
+    "solarsystemid2",
+    "stationid",
+    "userid",
+    "versionCheck",
+    "machoVersion"
+};
+
+pyStatic::pyStatic()
+: m_table( 1, nullptr ),
+  m_maxLen( 0 )
+{
+    m_none = new PyNone();
+    m_zero = new PyInt(0);
+    m_one = new PyInt(1);
+    m_negone = new PyInt(-1);
+    m_true = new PyBool(true);
+    m_false = new PyBool(false);
+    m_dict = new PyDict();
+    m_list = new PyList();
+    m_tuple = new PyTuple(0);
+
+    Pin(m_none);
+    Pin(m_zero);
+    Pin(m_one);
+    Pin(m_negone);
+    Pin(m_true);
+    Pin(m_false);
+    Pin(m_dict);
+    Pin(m_list);
+    Pin(m_tuple);
+
+    for (uint8 i = 1; i < 0xFF; ++i) {
+        const char* str = sMarshalStringTable.LookupString( i );
+        if (str == nullptr)
+            break;
+        Intern( str );
+        m_table.push_back( GetString( str, strlen( str ) ) );
+    }
+
+    for (size_t i = 0; i < sizeof( s_mInternStrings ) / sizeof( const char* ); ++i)
+        Intern( s_mInternStrings[ i ] );
+}
+
+pyStatic::~pyStatic()
+{
+    // references taken by m_table are not counted against the pin
+    m_table.clear();
+
+    for (auto cur : m_strings)
+        Unpin( cur.second );
+    for (auto cur : m_tokens)
+        Unpin( cur.second );
+    m_strings.clear();
+    m_tokens.clear();
+
+    Unpin(m_none);
+    Unpin(m_zero);
+    Unpin(m_one);
+    Unpin(m_negone);
+    Unpin(m_true);
+    Unpin(m_false);
+    Unpin(m_dict);
+    Unpin(m_list);
+    Unpin(m_tuple);
+}
+
+size_t pyStatic::InternHash::operator()( const InternKey& key ) const
+{
+    // FNV-1a
+    size_t h = 2166136261U;
+    for (size_t i = 0; i < key.len; ++i)
+        h = (h ^ (uint8)key.str[ i ]) * 16777619U;
+    return h;
+}
+
+void pyStatic::Intern( const char* str )
+{
+    const size_t len = strlen( str );
+    InternKey key = { str, len };
+    if (m_strings.find( key ) != m_strings.end())
+        return;
+
+    PyString* pStr = new PyString( str, len );
+    pStr->hash();   // fill hash cache now, so shared string is never written to
+    Pin( pStr );
+    key.str = pStr->content().c_str();
+    m_strings.emplace( key, pStr );
+
+    PyToken* pToken = new PyToken( str, len );
+    Pin( pToken );
+    key.str = pToken->content().c_str();
+    m_tokens.emplace( key, pToken );
+
+    if (len > m_maxLen)
+        m_maxLen = len;
+}
+
+void pyStatic::Pin( PyRep* rep )
+{
+    // far from zero and from overflow, whatever other threads do with it
+    rep->mRefCount = (size_t)1 << 30;
+}
+
+void pyStatic::Unpin( PyRep* rep )
+{
+    rep->mRefCount = 1;
+    PyDecRef( rep );
+}
+
+PyString* pyStatic::GetString( const char* str, size_t len )
+{
+    if (len > m_maxLen)
+        return nullptr;
+
+    const InternKey key = { str, len };
+    std::unordered_map<InternKey, PyString*, InternHash, InternEqual>::const_iterator itr = m_strings.find( key );
+    if (itr == m_strings.end())
+        return nullptr;
+
+    PyIncRef( itr->second );
+    return itr->second;
+}
+
+PyToken* pyStatic::GetToken( const char* str, size_t len )
+{
+    if (len > m_maxLen)
+        return nullptr;
+
+    const InternKey key = { str, len };
+    std::unordered_map<InternKey, PyToken*, InternHash, InternEqual>::const_iterator itr = m_tokens.find( key );
+    if (itr == m_tokens.end())
+        return nullptr;
+
+    PyIncRef( itr->second );
+    return itr->second;
+}
+
+PyString* pyStatic::GetTableString( uint8 index )
+{
+    if ((index == 0) or (index >= m_table.size()))
+        return nullptr;
+
+    PyIncRef( m_table[ index ] );
+    return m_table[ index ];
+}
@@ -27,6 +27,8 @@
 #ifndef EVE_PY_REP_H
 #define EVE_PY_REP_H
 
+#include "memory/FreeList.h"
+
 class PyInt;
 class PyLong;
 class PyFloat;
@@ -65,6 +67,9 @@ class DBRowDescriptor;
  */
 class PyRep : public RefObject
 {
+    // pins its shared objects
+    friend class pyStatic;
+
 public:
     /**
      * @brief Python wire object types
@@ -159,6 +164,10 @@ public:
     using RefObject::IncRef;
     using RefObject::DecRef;
 
+    /* most objects are small and short-lived; they are kept on per-thread free lists by size */
+    static void* operator new( size_t size )                    { return FreeList::Alloc( size ); }
+    static void operator delete( void* p, size_t size )         { FreeList::Free( p, size ); }
+
     /**
      * @brief Dumps object to file.
      *
@@ -1151,35 +1160,22 @@ protected:
 
 #include "../../eve-core/utils/Singleton.h"
 
+/**
+ * @brief Shared immutable objects.
+ *
+ * Besides the common constants, holds the interned strings: every entry of the
+ *  marshal string table, plus common class names and identifiers, each as PyString and PyToken.
+ *  The pool is filled on construction and only read afterwards, so lookups need no lock.
+ *
+ * All shared objects are pinned with a huge reference count, so they are never freed
+ *  while in use, even as their counts are changed by several threads at once.
+ */
 class pyStatic
 : public Singleton< pyStatic >
 {
 public:
-    pyStatic()
-    {
-        m_none = new PyNone();
-        m_zero = new PyInt(0);
-        m_one = new PyInt(1);
-        m_negone = new PyInt(-1);
-        m_true = new PyBool(true);
-        m_false = new PyBool(false);
-        m_dict = new PyDict();
-        m_list = new PyList();
-        m_tuple = new PyTuple(0);
-    }
-
-   ~pyStatic()
-   {
-       PyDecRef(m_none);
-       PyDecRef(m_zero);
-       PyDecRef(m_one);
-       PyDecRef(m_negone);
-       PyDecRef(m_true);
-       PyDecRef(m_false);
-       PyDecRef(m_dict);
-       PyDecRef(m_list);
-       PyDecRef(m_tuple);
-    }
+    pyStatic();
+    ~pyStatic();
 
     PyRep* NewNone()            { PyIncRef(m_none); return m_none; }
     PyRep* NewZero()            { PyIncRef(m_zero); return m_zero; }
@@ -1192,6 +1188,48 @@ public:
     PyList* mtList()            { PyIncRef(m_list); return m_list; }
     PyTuple* mtTuple()          { PyIncRef(m_tuple); return m_tuple; }
 
+    /**
+     * @brief Looks up interned string.
+     *
+     * @param[in] str String to look up.
+     * @param[in] len Length of string.
+     *
+     * @return New reference to interned string; NULL if string is not interned.
+     */
+    PyString* GetString( const char* str, size_t len );
+    /** @brief As GetString(), for tokens. */
+    PyToken* GetToken( const char* str, size_t len );
+    /**
+     * @brief Gets interned string of marshal string table entry.
+     *
+     * @param[in] index 1-based index in string table.
+     *
+     * @return New reference to interned string; NULL if index is out of range.
+     */
+    PyString* GetTableString( uint8 index );
+
+protected:
+    struct InternKey
+    {
+        const char* str;
+        size_t len;
+    };
+    struct InternHash
+    {
+        size_t operator()( const InternKey& key ) const;
+    };
+    struct InternEqual
+    {
+        bool operator()( const InternKey& a, const InternKey& b ) const
+        {
+            return ((a.len == b.len) and (memcmp( a.str, b.str, a.len ) == 0));
+        }
+    };
+
+    void Intern( const char* str );
+    void Pin( PyRep* rep );
+    void Unpin( PyRep* rep );
+
 private:
     PyRep* m_none;
     PyRep* m_zero;
@@ -1203,6 +1241,12 @@ private:
     PyDict* m_dict;
     PyList* m_list;
     PyTuple* m_tuple;
+
+    // keys point into content of their value
+    std::unordered_map<InternKey, PyString*, InternHash, InternEqual> m_strings;
+    std::unordered_map<InternKey, PyToken*, InternHash, InternEqual> m_tokens;
+    std::vector<PyString*> m_table;     // indexed by string table index.  [0] is unused
+    size_t m_maxLen;                    // of longest interned string
 };
 
 //Singleton
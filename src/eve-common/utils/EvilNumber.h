@@ -60,8 +60,11 @@ class EvilNumber
 {
 
 private:
-    double fVal;
-    int64 iVal;
+    // only the member denoted by mType is valid.  keeps this at 16 bytes, as attribute maps hold many
+    union {
+        double fVal;
+        int64 iVal;
+    };
     EVIL_NUMBER_TYPE mType;
 
 public:
@@ -462,6 +465,8 @@ protected:
     EvilNumber _SelfDecrement();
 };
 
+static_assert(sizeof(EvilNumber) <= 16, "EvilNumber is held per attribute of every loaded item; keep it small");
+
 //////////////////////////////////////////////////////////////////////////
 // global operators
 EvilNumber operator+(const EvilNumber& val, const EvilNumber& val2);
@@ -0,0 +1,167 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __UTILS__FLAT_MAP_H__INCL__
+#define __UTILS__FLAT_MAP_H__INCL__
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Sorted vector of key, value pairs, with the parts of the std::map interface used for attributes.
+ *
+ * Entries are held in one contiguous block, so a lookup is a binary search over
+ * neighbouring cache lines and each entry costs only its own size, where a
+ * std::map node costs three pointers and a colour on top of a heap allocation.
+ *
+ * Inserts and erases shift the entries after them, so this suits small maps which
+ * are filled once and then mostly read, as item attributes are.  Entries filled in
+ * key order are appended.  As with std::vector, iterators and references are
+ * invalidated by insert and erase.
+ *
+ * @author EVEmu Team
+ */
+template <class Key, class T, class Alloc = std::allocator<std::pair<Key, T>>>
+class FlatMap
+{
+public:
+    typedef Key                                         key_type;
+    typedef T                                           mapped_type;
+    typedef std::pair<Key, T>                           value_type;
+    typedef std::vector<value_type, Alloc>              container_type;
+    typedef typename container_type::size_type          size_type;
+    typedef typename container_type::iterator           iterator;
+    typedef typename container_type::const_iterator     const_iterator;
+
+    FlatMap()                                           { }
+    explicit FlatMap(const Alloc& alloc)                : m_data(alloc) { }
+
+    iterator begin()                                    { return m_data.begin(); }
+    iterator end()                                      { return m_data.end(); }
+    const_iterator begin() const                        { return m_data.begin(); }
+    const_iterator end() const                          { return m_data.end(); }
+
+    bool empty() const                                  { return m_data.empty(); }
+    size_type size() const                              { return m_data.size(); }
+    size_type capacity() const                          { return m_data.capacity(); }
+    void reserve(size_type count)                       { m_data.reserve(count); }
+    void shrink_to_fit()                                { m_data.shrink_to_fit(); }
+    void clear()                                        { m_data.clear(); }
+
+    iterator lower_bound(const Key& key) {
+        return std::lower_bound(m_data.begin(), m_data.end(), key, KeyLess());
+    }
+    const_iterator lower_bound(const Key& key) const {
+        return std::lower_bound(m_data.begin(), m_data.end(), key, KeyLess());
+    }
+
+    iterator find(const Key& key) {
+        iterator itr = lower_bound(key);
+        if ((itr != m_data.end()) and !(key < itr->first))
+            return itr;
+        return m_data.end();
+    }
+    const_iterator find(const Key& key) const {
+        const_iterator itr = lower_bound(key);
+        if ((itr != m_data.end()) and !(key < itr->first))
+            return itr;
+        return m_data.end();
+    }
+
+    size_type count(const Key& key) const               { return (find(key) == end() ? 0 : 1); }
+
+    /* as std::map; an existing entry is not replaced */
+    std::pair<iterator, bool> insert(const value_type& value) {
+        iterator itr = InsertPos(value.first);
+        if ((itr != m_data.end()) and !(value.first < itr->first))
+            return std::make_pair(itr, false);
+        return std::make_pair(m_data.insert(itr, value), true);
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args) {
+        iterator itr = InsertPos(key);
+        if ((itr != m_data.end()) and !(key < itr->first))
+            return std::make_pair(itr, false);
+        return std::make_pair(m_data.emplace(itr, std::piecewise_construct,
+                                             std::forward_as_tuple(key),
+                                             std::forward_as_tuple(std::forward<Args>(args)...)), true);
+    }
+
+    T& operator[](const Key& key)                       { return emplace(key).first->second; }
+
+    T& at(const Key& key) {
+        iterator itr = find(key);
+        if (itr == m_data.end())
+            throw std::out_of_range("FlatMap::at");
+        return itr->second;
+    }
+    const T& at(const Key& key) const {
+        const_iterator itr = find(key);
+        if (itr == m_data.end())
+            throw std::out_of_range("FlatMap::at");
+        return itr->second;
+    }
+
+    iterator erase(const_iterator itr)                  { return m_data.erase(itr); }
+    size_type erase(const Key& key) {
+        iterator itr = find(key);
+        if (itr == m_data.end())
+            return 0;
+        m_data.erase(itr);
+        return 1;
+    }
+
+private:
+    struct KeyLess {
+        bool operator()(const value_type& lhs, const Key& rhs) const { return lhs.first < rhs; }
+    };
+
+    // entries are mostly added in key order (type attributes are loaded sorted), so try the end first
+    iterator InsertPos(const Key& key) {
+        if (m_data.empty() or (m_data.back().first < key))
+            return Grow(m_data.end());
+        iterator itr = lower_bound(key);
+        if ((itr != m_data.end()) and !(key < itr->first))
+            return itr;
+        return Grow(itr);
+    }
+
+    // a full map grows by a quarter rather than doubling; maps seldom grow much once loaded
+    iterator Grow(iterator itr) {
+        if (m_data.size() < m_data.capacity())
+            return itr;
+        size_type pos = itr - m_data.begin();
+        m_data.reserve(m_data.size() + m_data.size() / 4 + 4);
+        return m_data.begin() + pos;
+    }
+
+    container_type m_data;
+};
+
+#endif  // __UTILS__FLAT_MAP_H__INCL__
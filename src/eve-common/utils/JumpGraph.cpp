@@ -0,0 +1,311 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-common.h"
+
+#include "utils/JumpGraph.h"
+
+// security at or above which a system is high security (as shown by the client, rounded to one decimal)
+static const float HIGH_SECURITY = 0.45f;
+
+const uint16 JumpGraph::NoRoute;
+const uint32 JumpGraph::SecurityPenalty;
+const uint32 JumpGraph::NoIndex;
+const uint8 JumpGraph::NoTableEntry;
+
+JumpGraph::JumpGraph()
+{
+}
+
+void JumpGraph::Clear()
+{
+    m_systemIDs.clear();
+    m_security.clear();
+    m_region.clear();
+    m_slot.clear();
+    m_offsets.clear();
+    m_targets.clear();
+    m_regions.clear();
+    m_index.clear();
+    m_jumps.clear();
+    m_regionIDs.clear();
+}
+
+uint32 JumpGraph::GetIndex( uint32 systemID ) const
+{
+    std::unordered_map<uint32, uint32>::const_iterator itr = m_index.find( systemID );
+    if( itr == m_index.end() )
+        return NoIndex;
+    return itr->second;
+}
+
+uint32 JumpGraph::GetIndex( uint32 systemID )
+{
+    std::unordered_map<uint32, uint32>::iterator itr = m_index.find( systemID );
+    if( itr != m_index.end() )
+        return itr->second;
+
+    uint32 idx = (uint32)m_systemIDs.size();
+    m_index[ systemID ] = idx;
+    m_systemIDs.push_back( systemID );
+    m_security.push_back( 0.0f );
+    m_regionIDs.push_back( 0 );
+    return idx;
+}
+
+void JumpGraph::AddSystem( uint32 systemID, uint32 regionID, float security )
+{
+    uint32 idx = GetIndex( systemID );
+    m_security[ idx ] = security;
+    m_regionIDs[ idx ] = regionID;
+}
+
+void JumpGraph::AddJump( uint32 fromID, uint32 toID )
+{
+    uint32 from = GetIndex( fromID );
+    m_jumps.push_back( std::make_pair( from, GetIndex( toID ) ) );
+}
+
+void JumpGraph::Build()
+{
+    const uint32 count = (uint32)m_systemIDs.size();
+
+    // pack neighbours.  sorted so rows do not depend on load order
+    std::sort( m_jumps.begin(), m_jumps.end() );
+    m_jumps.erase( std::unique( m_jumps.begin(), m_jumps.end() ), m_jumps.end() );
+
+    m_offsets.assign( count + 1, 0 );
+    m_targets.resize( m_jumps.size() );
+    for( uint32 i = 0; i < m_jumps.size(); ++i ) {
+        ++m_offsets[ m_jumps[ i ].first + 1 ];
+        m_targets[ i ] = m_jumps[ i ].second;
+    }
+    for( uint32 i = 0; i < count; ++i )
+        m_offsets[ i + 1 ] += m_offsets[ i ];
+    m_jumps.clear();
+    m_jumps.shrink_to_fit();
+
+    // group systems by region
+    std::map<uint32, uint32> regions;   // regionID/index
+    m_region.resize( count );
+    m_slot.resize( count );
+    m_regions.clear();
+    for( uint32 i = 0; i < count; ++i ) {
+        std::map<uint32, uint32>::iterator itr = regions.find( m_regionIDs[ i ] );
+        if( itr == regions.end() ) {
+            itr = regions.insert( std::make_pair( m_regionIDs[ i ], (uint32)m_regions.size() ) ).first;
+            Region region;
+            region.regionID = m_regionIDs[ i ];
+            region.size = 0;
+            m_regions.push_back( region );
+        }
+        m_region[ i ] = itr->second;
+        m_slot[ i ] = m_regions[ itr->second ].size++;
+    }
+    m_regionIDs.clear();
+    m_regionIDs.shrink_to_fit();
+
+    for( std::vector<Region>::iterator itr = m_regions.begin(); itr != m_regions.end(); ++itr )
+        itr->jumps.assign( (size_t)itr->size * itr->size, NoTableEntry );
+
+    // fill region tables with a search from each system, which stops once every system of its region is found
+    std::vector<uint16> jumps( count, NoRoute );
+    std::vector<uint32> queue( count );
+    for( uint32 from = 0; from < count; ++from ) {
+        Region& region = m_regions[ m_region[ from ] ];
+        uint8* row = &region.jumps[ (size_t)m_slot[ from ] * region.size ];
+
+        uint32 head = 0, tail = 0, found = 0;
+        jumps[ from ] = 0;
+        queue[ tail++ ] = from;
+        while( (head < tail) and (found < region.size) ) {
+            uint32 cur = queue[ head++ ];
+            if( m_region[ cur ] == m_region[ from ] ) {
+                ++found;
+                if( jumps[ cur ] < NoTableEntry )
+                    row[ m_slot[ cur ] ] = (uint8)jumps[ cur ];
+            }
+            for( uint32 i = m_offsets[ cur ]; i < m_offsets[ cur + 1 ]; ++i ) {
+                uint32 next = m_targets[ i ];
+                if( jumps[ next ] != NoRoute )
+                    continue;
+                jumps[ next ] = jumps[ cur ] + 1;
+                queue[ tail++ ] = next;
+            }
+        }
+
+        // reset only what this search touched
+        for( uint32 i = 0; i < tail; ++i )
+            jumps[ queue[ i ] ] = NoRoute;
+    }
+}
+
+size_t JumpGraph::GetTableSize() const
+{
+    size_t size = 0;
+    for( std::vector<Region>::const_iterator itr = m_regions.begin(); itr != m_regions.end(); ++itr )
+        size += itr->jumps.size();
+    return size;
+}
+
+void JumpGraph::Search( uint32 from, std::vector<uint16>& jumps, std::vector<uint32>* parents/*nullptr*/, uint32 to/*NoIndex*/ ) const
+{
+    const uint32 count = (uint32)m_systemIDs.size();
+    jumps.assign( count, NoRoute );
+    if( parents != nullptr )
+        parents->assign( count, NoIndex );
+
+    std::vector<uint32> queue( count );
+    uint32 head = 0, tail = 0;
+    jumps[ from ] = 0;
+    queue[ tail++ ] = from;
+    while( head < tail ) {
+        uint32 cur = queue[ head++ ];
+        if( cur == to )
+            return;
+        for( uint32 i = m_offsets[ cur ]; i < m_offsets[ cur + 1 ]; ++i ) {
+            uint32 next = m_targets[ i ];
+            if( jumps[ next ] != NoRoute )
+                continue;
+            jumps[ next ] = jumps[ cur ] + 1;
+            if( parents != nullptr )
+                (*parents)[ next ] = cur;
+            queue[ tail++ ] = next;
+        }
+    }
+}
+
+uint16 JumpGraph::GetJumps( uint32 fromID, uint32 toID ) const
+{
+    if( fromID == toID )
+        return 0;
+
+    uint32 from = GetIndex( fromID ), to = GetIndex( toID );
+    if( (from == NoIndex) or (to == NoIndex) or m_offsets.empty() )
+        return NoRoute;
+
+    if( m_region[ from ] == m_region[ to ] ) {
+        const Region& region = m_regions[ m_region[ from ] ];
+        uint8 jumps = region.jumps[ (size_t)m_slot[ from ] * region.size + m_slot[ to ] ];
+        return (jumps == NoTableEntry ? NoRoute : jumps);
+    }
+
+    std::vector<uint16> jumps;
+    Search( from, jumps, nullptr, to );
+    return jumps[ to ];
+}
+
+bool JumpGraph::IsAvoided( uint32 idx, uint8 pref ) const
+{
+    switch( pref ) {
+        case Safer:         return (m_security[ idx ] < HIGH_SECURITY);
+        case LessSecure:    return (m_security[ idx ] >= HIGH_SECURITY);
+    }
+    return false;
+}
+
+bool JumpGraph::GetRoute( uint32 fromID, uint32 toID, uint8 pref, std::vector<uint32>& into ) const
+{
+    into.clear();
+    uint32 from = GetIndex( fromID ), to = GetIndex( toID );
+    if( (from == NoIndex) or (to == NoIndex) or m_offsets.empty() )
+        return false;
+
+    const uint32 count = (uint32)m_systemIDs.size();
+    std::vector<uint32> parents;
+    if( pref == Shortest ) {
+        std::vector<uint16> jumps;
+        Search( from, jumps, &parents, to );
+        if( jumps[ to ] == NoRoute )
+            return false;
+    } else {
+        // weighted search; entering an avoided system costs SecurityPenalty jumps
+        typedef std::pair<uint32, uint32> Entry;    // cost/index
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > open;
+        std::vector<uint32> cost( count, 0xFFFFFFFF );
+        parents.assign( count, NoIndex );
+        cost[ from ] = 0;
+        open.push( Entry( 0, from ) );
+        while( !open.empty() ) {
+            Entry cur = open.top();
+            open.pop();
+            if( cur.second == to )
+                break;
+            if( cur.first > cost[ cur.second ] )
+                continue;
+            for( uint32 i = m_offsets[ cur.second ]; i < m_offsets[ cur.second + 1 ]; ++i ) {
+                uint32 next = m_targets[ i ];
+                uint32 nextCost = cur.first + (IsAvoided( next, pref ) ? SecurityPenalty : 1);
+                if( nextCost >= cost[ next ] )
+                    continue;
+                cost[ next ] = nextCost;
+                parents[ next ] = cur.second;
+                open.push( Entry( nextCost, next ) );
+            }
+        }
+        if( cost[ to ] == 0xFFFFFFFF )
+            return false;
+    }
+
+    for( uint32 cur = to; cur != NoIndex; cur = parents[ cur ] )
+        into.push_back( m_systemIDs[ cur ] );
+    std::reverse( into.begin(), into.end() );
+    return true;
+}
+
+void JumpGraph::GetNeighbours( uint32 systemID, std::vector<uint32>& into ) const
+{
+    uint32 idx = GetIndex( systemID );
+    if( (idx == NoIndex) or m_offsets.empty() )
+        return;
+
+    for( uint32 i = m_offsets[ idx ]; i < m_offsets[ idx + 1 ]; ++i )
+        into.push_back( m_systemIDs[ m_targets[ i ] ] );
+}
+
+void JumpGraph::GetSystemsInRange( uint32 systemID, uint16 jumps, std::vector<uint32>& into ) const
+{
+    uint32 from = GetIndex( systemID );
+    if( (from == NoIndex) or m_offsets.empty() )
+        return;
+
+    std::vector<uint16> reached( m_systemIDs.size(), NoRoute );
+    std::vector<uint32> queue;
+    reached[ from ] = 0;
+    queue.push_back( from );
+    for( size_t head = 0; head < queue.size(); ++head ) {
+        uint32 cur = queue[ head ];
+        if( reached[ cur ] >= jumps )
+            continue;
+        for( uint32 i = m_offsets[ cur ]; i < m_offsets[ cur + 1 ]; ++i ) {
+            uint32 next = m_targets[ i ];
+            if( reached[ next ] != NoRoute )
+                continue;
+            reached[ next ] = reached[ cur ] + 1;
+            queue.push_back( next );
+            into.push_back( m_systemIDs[ next ] );
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __UTILS__JUMP_GRAPH_H__INCL__
+#define __UTILS__JUMP_GRAPH_H__INCL__
+
+#include "eve-core.h"
+
+/**
+ * @brief Stargate graph of solar systems, for jump counts and routes.
+ *
+ * Systems and jumps are added, then Build() packs the neighbours of every system
+ * into one array (compressed rows; each system holds an offset into it) and fills
+ * a table of jump counts between all systems of each region.  Jump counts are
+ * shortest paths over the whole graph, even where those leave the region.
+ *
+ * After Build(), jump counts within a region are a table lookup.  Jump counts
+ * between regions and routes are searched on each call.  The graph is not changed
+ * by queries, so it may be queried from any thread once built.
+ *
+ * @author EVEmu Team
+ */
+class JumpGraph
+{
+public:
+    /** Returned by GetJumps() for unknown or unreachable systems. */
+    static const uint16 NoRoute = 0xFFFF;
+
+    // route preferences, as in the client's autopilot settings
+    enum {
+        Shortest    = 0,
+        Safer       = 1,    // avoid systems below high security
+        LessSecure  = 2     // avoid high security systems
+    };
+
+    JumpGraph();
+
+    void AddSystem( uint32 systemID, uint32 regionID, float security );
+    /** @brief Adds a stargate jump.  jumps are one-way; add both directions for a gate pair. */
+    void AddJump( uint32 fromID, uint32 toID );
+    /** @brief Packs jumps and fills region tables.  systems only seen in jumps are added with region 0. */
+    void Build();
+    void Clear();
+
+    uint32 GetSystemCount() const                       { return (uint32)m_systemIDs.size(); }
+    uint32 GetGateCount() const                         { return (uint32)m_targets.size(); }
+    uint32 GetRegionCount() const                       { return (uint32)m_regions.size(); }
+    /** @return Bytes held by region tables. */
+    size_t GetTableSize() const;
+
+    /** @return Least number of jumps from one system to another, or NoRoute. */
+    uint16 GetJumps( uint32 fromID, uint32 toID ) const;
+    /**
+     * @brief Finds a route between two systems.
+     *
+     * @param[in]  pref Route preference; systems to avoid cost SecurityPenalty jumps each.
+     * @param[out] into Systems along route, from fromID to toID inclusive.
+     *
+     * @return False if there is no route.
+     */
+    bool GetRoute( uint32 fromID, uint32 toID, uint8 pref, std::vector<uint32>& into ) const;
+    /** @brief Gets systems one jump from given system. */
+    void GetNeighbours( uint32 systemID, std::vector<uint32>& into ) const;
+    /** @brief Gets systems within given number of jumps of given system (not including itself). */
+    void GetSystemsInRange( uint32 systemID, uint16 jumps, std::vector<uint32>& into ) const;
+
+    /** Cost of entering an avoided system on a Safer or LessSecure route. */
+    static const uint32 SecurityPenalty = 50;
+
+protected:
+    static const uint32 NoIndex = 0xFFFFFFFF;
+    static const uint8 NoTableEntry = 0xFF;
+
+    uint32 GetIndex( uint32 systemID ) const;
+    uint32 GetIndex( uint32 systemID );
+    /** @brief Breadth-first search from system index.  fills jumps to every system reached (NoRoute otherwise). */
+    void Search( uint32 from, std::vector<uint16>& jumps, std::vector<uint32>* parents = nullptr, uint32 to = NoIndex ) const;
+    bool IsAvoided( uint32 idx, uint8 pref ) const;
+
+    struct Region {
+        uint32 regionID;
+        uint32 size;                    // systems in region
+        std::vector<uint8> jumps;       // size x size, by region slot; NoTableEntry if over 254 or unreachable
+    };
+
+    // per system, by index
+    std::vector<uint32> m_systemIDs;
+    std::vector<float> m_security;
+    std::vector<uint32> m_region;       // index into m_regions
+    std::vector<uint32> m_slot;         // row/column in its region table
+    std::vector<uint32> m_offsets;      // neighbours of system i are m_targets[m_offsets[i] .. m_offsets[i+1])
+    std::vector<uint32> m_targets;
+
+    std::vector<Region> m_regions;
+
+    std::unordered_map<uint32, uint32> m_index;                 // systemID/index
+    std::vector<std::pair<uint32, uint32> > m_jumps;            // from/to index, until Build()
+    std::vector<uint32> m_regionIDs;                            // per system regionID, until Build()
+};
+
+#endif /* !__UTILS__JUMP_GRAPH_H__INCL__ */
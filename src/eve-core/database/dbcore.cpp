@@ -35,6 +35,9 @@
 
 #define COLUMN_BOUNDS_CHECKING
 
+/* set on threads whose writes are held for RunDeferredWrites() */
+static thread_local bool s_deferWrites = false;
+
 // this is to enable profile tracking for db
 #define sProfiler ( Profiler::get() )
 
@@ -42,7 +45,57 @@ class Profiler
 : public Singleton<Profiler>
 {
 public:
-    void AddTime(uint8 key, double value);
+    uint16 RegisterKey(const char* name, const char* unit);
+    void AddTime(uint16 key, double value);
+};
+
+/**
+ * @brief Queued asynchronous query.
+ */
+struct DBcore::Request
+{
+    Request() : result(nullptr), success(false), queued(0.0) { }
+
+    std::string query;
+    DBReadCallback callback;    // empty for writes
+    DBQueryResult* result;
+    bool success;
+    double queued;
+};
+
+/**
+ * @brief Pooled connection with its own thread and FIFO queue.
+ */
+class DBcore::Worker
+{
+public:
+    Worker( uint8 idx )
+    : mIdx( idx ), mysql( nullptr ), mStatus( Closed ), mRunning( true ), mBusy( false ), mThread( 0 )
+    {
+        pthread_mutex_init( &mMutex, nullptr );
+        pthread_cond_init( &mWork, nullptr );
+        pthread_cond_init( &mDrained, nullptr );
+    }
+    ~Worker()
+    {
+        pthread_cond_destroy( &mDrained );
+        pthread_cond_destroy( &mWork );
+        pthread_mutex_destroy( &mMutex );
+    }
+
+    uint8 mIdx;
+    MYSQL* mysql;               // only used by this worker's thread
+    eStatus mStatus;
+
+    // guarded by mMutex
+    bool mRunning;
+    bool mBusy;
+    std::deque<Request*> mQueue;
+
+    pthread_t mThread;
+    pthread_mutex_t mMutex;
+    pthread_cond_t mWork;       // signalled when queue gets a request or worker is stopped
+    pthread_cond_t mDrained;    // signalled when queue is empty and worker is idle
 };
 
 
@@ -55,31 +108,42 @@ pProfile(false)
 {
     mysql_thread_init();    // this is for each thread used for db connections
     mysql = mysql_init(nullptr);
+    memset(&mStats, 0, sizeof(mStats));
 }
 
 void DBcore::Connect(uint* errnum, char* errbuf)
 {
-    sLog.Cyan("          DB User", " %s", pUser.c_str());
-    sLog.Cyan("         DataBase", " %s", pDatabase.c_str());
+    Connect(mysql, pStatus, errnum, errbuf, true);
+}
+
+void DBcore::Connect(MYSQL* conn, eStatus& status, uint* errnum, char* errbuf, bool verbose)
+{
+    if (verbose) {
+        sLog.Cyan("          DB User", " %s", pUser.c_str());
+        sLog.Cyan("         DataBase", " %s", pDatabase.c_str());
+    }
 
     // options should be called BEFORE mysql_real_connect()
     if (pSocket) {
         enum mysql_protocol_type prot_type = MYSQL_PROTOCOL_SOCKET;
-        if (mysql_options(mysql, MYSQL_OPT_PROTOCOL, (void*)&prot_type) == 0) {
-            sLog.Cyan("        DB Server", " Unix Socket Connection");
+        if (mysql_options(conn, MYSQL_OPT_PROTOCOL, (void*)&prot_type) == 0) {
+            if (verbose)
+                sLog.Cyan("        DB Server", " Unix Socket Connection");
         } else {
             sLog.Error("        DB Server", " Unix Socket Connection Option Failed");
             enum mysql_protocol_type prot_type = MYSQL_PROTOCOL_TCP;
-            if (mysql_options(mysql, MYSQL_OPT_PROTOCOL, (void*)&prot_type) == 0)
-                sLog.Cyan("        DB Server", " %s:%d", pHost.c_str(), pPort);
-            else
+            if (mysql_options(conn, MYSQL_OPT_PROTOCOL, (void*)&prot_type) == 0) {
+                if (verbose)
+                    sLog.Cyan("        DB Server", " %s:%d", pHost.c_str(), pPort);
+            } else
                 sLog.Error("        DB Server", " TCP Connection Option Failed");
         }
     } else {
         enum mysql_protocol_type prot_type = MYSQL_PROTOCOL_TCP;
-        if (mysql_options(mysql, MYSQL_OPT_PROTOCOL, (void*)&prot_type) == 0)
-            sLog.Cyan("        DB Server", " %s:%d", pHost.c_str(), pPort);
-        else
+        if (mysql_options(conn, MYSQL_OPT_PROTOCOL, (void*)&prot_type) == 0) {
+            if (verbose)
+                sLog.Cyan("        DB Server", " %s:%d", pHost.c_str(), pPort);
+        } else
             sLog.Error("        DB Server", " TCP Connection Option Failed");
     }
 
@@ -89,11 +153,12 @@ void DBcore::Connect(uint* errnum, char* errbuf)
     // sql-ssl  needs more info/settings to properly use....however, not needed when using socket under linux
     if (pSSL and !pSocket)
         flags |= CLIENT_SSL;
-    sLog.Cyan("    Connect Flags", " %x", flags);
+    if (verbose)
+        sLog.Cyan("    Connect Flags", " %x", flags);
     /*
      *    unsigned int conn_timeout = 2;
      *    // not sure if this one will really be used here
-     *    if (mysql_options(mysql, MYSQL_OPT_CONNECT_TIMEOUT, (void*)&conn_timeout) == 0) {
+     *    if (mysql_options(conn, MYSQL_OPT_CONNECT_TIMEOUT, (void*)&conn_timeout) == 0) {
      *        if (conn_timeout > 60)
      *            sLog.Error(" DataBase Manager", "Connection Timeout set to %us", conn_timeout);
      *        else if (conn_timeout > 40)
@@ -107,52 +172,68 @@ void DBcore::Connect(uint* errnum, char* errbuf)
 */
     if (pReconnect) {
         my_bool reconnect = true;
-        if (mysql_options(mysql, MYSQL_OPT_RECONNECT, (void*)&reconnect) == 0) // this will enable auto-reconnect...and render my Reconnect() worthless
-            sLog.Green(" DataBase Manager", "DataBase AutoReconnect Enabled");
-        else
+        if (mysql_options(conn, MYSQL_OPT_RECONNECT, (void*)&reconnect) == 0) { // this will enable auto-reconnect...and render my Reconnect() worthless
+            if (verbose)
+                sLog.Green(" DataBase Manager", "DataBase AutoReconnect Enabled");
+        } else
             sLog.Error(" DataBase Manager", "DataBase AutoReconnect Option Failed");
-    } else
+    } else if (verbose)
         sLog.Yellow(" DataBase Manager", "DataBase AutoReconnect Disabled");
 
-    if (mysql_real_connect(mysql, pHost.c_str(), pUser.c_str(), pPassword.c_str(), pDatabase.c_str(), pPort, 0, flags) == nullptr) {
-        pStatus = Error;
-        *errnum = mysql_errno(mysql);
+    if (mysql_real_connect(conn, pHost.c_str(), pUser.c_str(), pPassword.c_str(), pDatabase.c_str(), pPort, 0, flags) == nullptr) {
+        status = Error;
+        *errnum = mysql_errno(conn);
         if (errbuf != nullptr)
-            snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(mysql), mysql_error(mysql));
+            snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", mysql_errno(conn), mysql_error(conn));
         DBerror err;
         err.SetError(*errnum, errbuf);
         sLog.Error( "       ServerInit", "Unable to connect to the database: %s", err.c_str() );
         return;
     } else {
-        pStatus = Connected;
+        status = Connected;
         //mysql_get_socket();
-        sLog.Blue(" DataBase Manager", "DataBase Connected");
+        if (verbose)
+            sLog.Blue(" DataBase Manager", "DataBase Connected");
     }
 
     // Setup character set we wish to use
-    if (mysql_set_character_set(mysql, "utf8") == 0)
-        sLog.Cyan(" DataBase Manager", "DataBase Character set: %s", mysql_character_set_name(mysql));
+    if ((mysql_set_character_set(conn, "utf8") == 0) and verbose)
+        sLog.Cyan(" DataBase Manager", "DataBase Character set: %s", mysql_character_set_name(conn));
 }
 
 bool DBcore::Reconnect()
+{
+    MutexLock lock(MDatabase);
+    return Reconnect(mysql, pStatus);
+}
+
+bool DBcore::Reconnect(MYSQL*& conn, eStatus& status)
 {
     _log(DATABASE__MESSAGE, "DBCore attempting to recover...");
-    Close();
-    mysql = mysql_init(nullptr);
+    // only drop this connection; the library (and pooled connections) stay up
+    if (conn != nullptr)
+        mysql_close(conn);
+    status = Closed;
+    conn = mysql_init(nullptr);
+    if (conn == nullptr) {
+        status = Error;
+        return false;
+    }
+
     uint errnum = 0;
     char errbuf[1024];
     errbuf[0] = 0;
-    MutexLock lock(MDatabase);
-    Connect(&errnum, errbuf);
+    Connect(conn, status, &errnum, errbuf, false);
 
-    if (pStatus == Connected)
+    if (status == Connected)
         _log(DATABASE__MESSAGE, "DBCore recovery successful.  Continuing.");
 
-    return pStatus;
+    return (status == Connected);
 }
 
 void DBcore::Initialize(std::string host, std::string user, std::string password, std::string database, bool compress/*false*/,
-                        bool SSL/*false*/, int16 port/*3306*/, bool socket/*false*/, bool reconnect/*false*/, bool profile/*false*/)
+                        bool SSL/*false*/, int16 port/*3306*/, bool socket/*false*/, bool reconnect/*false*/, bool profile/*false*/,
+                        uint8 poolSize/*0*/)
 {
     if (mysql == nullptr)
         mysql = mysql_init(nullptr);    // try again
@@ -186,16 +267,373 @@ void DBcore::Initialize(std::string host, std::string user, std::string password
     MutexLock lock(MDatabase);
 
     Connect(&errnum, errbuf);
+    if (pStatus == Connected)
+        StartPool(poolSize);
     sLog.Blue(" DataBase Manager", "DataBase Manager Initialized");
 }
 
 void DBcore::Close() {
+    // pooled connections finish their queues first
+    StopPool();
+
     pStatus = Closed;
     mysql_close(mysql);
     mysql_server_end();
     mysql_thread_end();   // this is for each thread used for db connections
 }
 
+void DBcore::StartPool(uint8 poolSize)
+{
+    memset(&mStats, 0, sizeof(mStats));
+    for (uint8 i = 0; i < poolSize; ++i) {
+        Worker* worker = new Worker(i);
+        if (pthread_create(&worker->mThread, nullptr, WorkerThread, worker)) {
+            sLog.Error(" DataBase Manager", "Unable to start pooled connection %u; %u running.", i, (uint32)mWorkers.size());
+            SafeDelete(worker);
+            break;
+        }
+        mWorkers.push_back(worker);
+    }
+
+    if (!mWorkers.empty())
+        sLog.Blue(" DataBase Manager", "%u Pooled Connections Started", (uint32)mWorkers.size());
+}
+
+void DBcore::StopPool()
+{
+    if (mWorkers.empty())
+        return;
+
+    // workers exit once their queue is empty
+    for (auto cur : mWorkers) {
+        pthread_mutex_lock(&cur->mMutex);
+        cur->mRunning = false;
+        pthread_cond_signal(&cur->mWork);
+        pthread_mutex_unlock(&cur->mMutex);
+    }
+    for (auto cur : mWorkers) {
+        pthread_join(cur->mThread, nullptr);
+        SafeDelete(cur);
+    }
+    mWorkers.clear();
+
+    // nobody is left to take these results
+    MutexLock lock(mMCompleted);
+    if (!mCompleted.empty())
+        _log(DATABASE__MESSAGE, "DBcore::StopPool() - dropping %u completed reads.", (uint32)mCompleted.size());
+    for (auto cur : mCompleted) {
+        SafeDelete(cur->result);
+        SafeDelete(cur);
+    }
+    mCompleted.clear();
+    mLatencies.clear();
+
+    sLog.Blue(" DataBase Manager", "Pooled Connections Stopped");
+}
+
+void* DBcore::WorkerThread(void* arg)
+{
+    Worker* worker = (Worker*)arg;
+    mysql_thread_init();    // this is for each thread used for db connections
+    _log(THREAD__INFO, "DBcore::WorkerThread() - Pooled connection %u running in thread 0x%X", worker->mIdx, pthread_self());
+
+    // errors are logged; DoQuery() will try to reconnect on first use
+    worker->mysql = mysql_init(nullptr);
+    if (worker->mysql != nullptr) {
+        uint errnum = 0;
+        char errbuf[1024];
+        errbuf[0] = 0;
+        sDatabase.Connect(worker->mysql, worker->mStatus, &errnum, errbuf, false);
+    }
+
+    while (true) {
+        pthread_mutex_lock(&worker->mMutex);
+        while (worker->mQueue.empty() and worker->mRunning)
+            pthread_cond_wait(&worker->mWork, &worker->mMutex);
+        if (worker->mQueue.empty()) {
+            // stopped and drained
+            pthread_mutex_unlock(&worker->mMutex);
+            break;
+        }
+        Request* req = worker->mQueue.front();
+        worker->mQueue.pop_front();
+        worker->mBusy = true;
+        pthread_mutex_unlock(&worker->mMutex);
+
+        sDatabase.RunRequest(worker->mysql, worker->mStatus, req);
+
+        pthread_mutex_lock(&worker->mMutex);
+        worker->mBusy = false;
+        if (worker->mQueue.empty())
+            pthread_cond_broadcast(&worker->mDrained);
+        pthread_mutex_unlock(&worker->mMutex);
+    }
+
+    if (worker->mysql != nullptr)
+        mysql_close(worker->mysql);
+    worker->mysql = nullptr;
+    worker->mStatus = Closed;
+    mysql_thread_end();
+
+    _log(THREAD__INFO, "DBcore::WorkerThread() - Pooled connection %u stopped.", worker->mIdx);
+    return nullptr;
+}
+
+void DBcore::Enqueue(uint32 key, Request* req)
+{
+    req->queued = GetTimeUSeconds();
+    {
+        MutexLock lock(mMCompleted);
+        ++mStats.queued;
+        if (mStats.queued > mStats.queuedMax)
+            mStats.queuedMax = mStats.queued;
+    }
+
+    Worker* worker = mWorkers[key % mWorkers.size()];
+    pthread_mutex_lock(&worker->mMutex);
+    worker->mQueue.push_back(req);
+    pthread_cond_signal(&worker->mWork);
+    pthread_mutex_unlock(&worker->mMutex);
+}
+
+void DBcore::RunRequest(MYSQL*& conn, eStatus& status, Request* req)
+{
+    if (req->callback) {
+        req->result = new DBQueryResult();
+        req->success = DoQuery(conn, status, req->result->error, req->query.c_str(), req->query.length(), true, false);
+        if (req->success) {
+            uint col_count = mysql_field_count(conn);
+            if (col_count == 0) {
+                req->result->error.SetError(0xFFFF, "DBcore::QueueRead: No Result");
+                codelog(DATABASE__ERROR, "DBCore::QueueRead: %s failed because it did not return a result", req->query.c_str());
+                req->success = false;
+            } else {
+                req->result->SetResult(mysql_store_result(conn), col_count);
+            }
+        }
+    } else {
+        // DoQuery() logs errors; there is nobody else to tell
+        DBerror err;
+        req->success = DoQuery(conn, status, err, req->query.c_str(), req->query.length(), true, false);
+    }
+
+    double latency = GetTimeUSeconds() - req->queued;
+
+    MutexLock lock(mMCompleted);
+    --mStats.queued;
+    if (req->callback)
+        ++mStats.reads;
+    else
+        ++mStats.writes;
+    if (!req->success)
+        ++mStats.errors;
+    mStats.latency += latency;
+    if (latency > mStats.latencyMax)
+        mStats.latencyMax = latency;
+    if (pProfile)
+        mLatencies.push_back(latency);
+
+    if (req->callback)
+        mCompleted.push_back(req);
+    else
+        SafeDelete(req);
+}
+
+void DBcore::QueueWrite(uint32 key, const char *query_fmt, ...)
+{
+    va_list args;
+    va_start(args, query_fmt);
+    char* query(nullptr);
+    int querylen = vasprintf(&query, query_fmt, args);
+    va_end(args);
+
+    if (querylen < 0) {
+        codelog(DATABASE__ERROR, "DBcore::QueueWrite - unable to format query '%s'", query_fmt);
+        return;
+    }
+
+    QueueWrite(key, std::string(query, querylen));
+    free(query);
+}
+
+void DBcore::QueueWrite(uint32 key, const std::string& query)
+{
+    if (s_deferWrites) {
+        DeferredWrite write;
+        write.key = key;
+        write.query = query;
+        MutexLock lock(mMDeferred);
+        mDeferred.push_back(write);
+        return;
+    }
+
+    if (mWorkers.empty()) {
+        MutexLock lock(MDatabase);
+        DBerror err;
+        DoQuery_locked(err, query.c_str(), query.length());
+        return;
+    }
+
+    Request* req = new Request();
+    req->query = query;
+    Enqueue(key, req);
+}
+
+void DBcore::QueueRead(uint32 key, DBReadCallback callback, const char *query_fmt, ...)
+{
+    va_list args;
+    va_start(args, query_fmt);
+    char* query(nullptr);
+    int querylen = vasprintf(&query, query_fmt, args);
+    va_end(args);
+
+    if (querylen < 0) {
+        codelog(DATABASE__ERROR, "DBcore::QueueRead - unable to format query '%s'", query_fmt);
+        return;
+    }
+
+    Request* req = new Request();
+    req->query.assign(query, querylen);
+    req->callback = callback;
+    free(query);
+
+    if (!mWorkers.empty()) {
+        Enqueue(key, req);
+        return;
+    }
+
+    // no pool; run it here and complete right away
+    {
+        MutexLock lock(MDatabase);
+        RunRequest(mysql, pStatus, req);
+    }
+    ProcessCompletions();
+}
+
+void DBcore::ProcessCompletions()
+{
+    std::vector<Request*> completed;
+    std::vector<double> latencies;
+    uint32 queued(0);
+    {
+        MutexLock lock(mMCompleted);
+        if (mWorkers.empty() and mCompleted.empty())
+            return;
+        completed.swap(mCompleted);
+        latencies.swap(mLatencies);
+        queued = mStats.queued;
+    }
+
+    if (pProfile) {
+        static const uint16 asyncKey(sProfiler.RegisterKey("DB Async", "us"));
+        static const uint16 queueKey(sProfiler.RegisterKey("DB Queue", "queries"));
+        for (auto cur : latencies)
+            sProfiler.AddTime(asyncKey, cur);
+        sProfiler.AddTime(queueKey, queued);
+    }
+
+    for (auto cur : completed) {
+        cur->callback(*cur->result, cur->success);
+        SafeDelete(cur->result);
+        SafeDelete(cur);
+    }
+}
+
+void DBcore::Drain(Worker* worker)
+{
+    pthread_mutex_lock(&worker->mMutex);
+    while (!worker->mQueue.empty() or worker->mBusy)
+        pthread_cond_wait(&worker->mDrained, &worker->mMutex);
+    pthread_mutex_unlock(&worker->mMutex);
+}
+
+void DBcore::WaitFor(uint32 key)
+{
+    if (mWorkers.empty())
+        return;
+
+    double start = GetTimeUSeconds();
+    Drain(mWorkers[key % mWorkers.size()]);
+    if (is_log_enabled(DATABASE__MESSAGE)) {
+        double waited = GetTimeUSeconds() - start;
+        if (waited > 1000)
+            _log(DATABASE__MESSAGE, "DBcore::WaitFor(%u) - waited %.3fus for queued queries.", key, waited);
+    }
+}
+
+void DBcore::WaitFor(const std::vector<uint32>& keys)
+{
+    if (mWorkers.empty())
+        return;
+
+    std::vector<bool> drained(mWorkers.size(), false);
+    double start = GetTimeUSeconds();
+    for (auto cur : keys) {
+        size_t idx = cur % mWorkers.size();
+        if (drained[idx])
+            continue;
+        Drain(mWorkers[idx]);
+        drained[idx] = true;
+    }
+    if (is_log_enabled(DATABASE__MESSAGE)) {
+        double waited = GetTimeUSeconds() - start;
+        if (waited > 1000)
+            _log(DATABASE__MESSAGE, "DBcore::WaitFor() - waited %.3fus for queued queries of %lu keys.", waited, keys.size());
+    }
+}
+
+void DBcore::Flush()
+{
+    for (auto cur : mWorkers)
+        Drain(cur);
+
+    ProcessCompletions();
+}
+
+void DBcore::BeginDeferWrites()
+{
+    s_deferWrites = true;
+}
+
+void DBcore::EndDeferWrites()
+{
+    s_deferWrites = false;
+}
+
+void DBcore::RunDeferredWrites()
+{
+    std::vector<DeferredWrite> writes;
+    {
+        MutexLock lock(mMDeferred);
+        writes.swap(mDeferred);
+    }
+
+    for (auto& cur : writes)
+        QueueWrite(cur.key, cur.query);
+}
+
+void DBcore::GetPoolStats(DBPoolStats& stats)
+{
+    MutexLock lock(mMCompleted);
+    stats = mStats;
+}
+
+void DBcore::PrintPoolStats()
+{
+    if (mWorkers.empty()) {
+        sLog.Warning(" DataBase Manager", "Connection pool is disabled.");
+        return;
+    }
+
+    DBPoolStats stats;
+    GetPoolStats(stats);
+    int64 done(stats.reads + stats.writes);
+    sLog.Green(" DataBase Manager", "%u pooled connections: %u queued (max %u), %li writes, %li reads, %li errors",
+               (uint32)mWorkers.size(), stats.queued, stats.queuedMax, stats.writes, stats.reads, stats.errors);
+    sLog.Green(" DataBase Manager", "Query latency - Avg: %.3fus  Hi: %.3fus",
+               (done > 0 ? stats.latency / done : 0.0), stats.latencyMax);
+}
+
 /*
 void DBcore::CallShutdown()
 {
@@ -246,14 +684,13 @@ bool DBcore::RunQuery(DBQueryResult &into, const char *query_fmt, ...) {
 
 //query which returns only error status
 bool DBcore::RunQuery(DBerror &err, const char *query_fmt, ...) {
-    MutexLock lock(MDatabase);
-
     va_list args;
     va_start(args, query_fmt);
     char* query(nullptr);
     int querylen = vasprintf(&query, query_fmt, args);
     va_end(args);
 
+    MutexLock lock(MDatabase);
     if (!DoQuery_locked(err, query, querylen)) {
         free(query);
         return false;
@@ -306,50 +743,55 @@ bool DBcore::RunQueryLID(DBerror &err, uint32 &last_insert_id, const char *query
 }
 
 bool DBcore::DoQuery_locked(DBerror &err, const char *query, int querylen, bool retry/*true*/)
+{
+    return DoQuery(mysql, pStatus, err, query, querylen, retry, pProfile);
+}
+
+bool DBcore::DoQuery(MYSQL*& conn, eStatus& status, DBerror &err, const char *query, int querylen, bool retry, bool profile)
 {
     double profileStartTime = GetTimeUSeconds();
 
-    if (mysql == nullptr) {
-        pStatus = Error;
+    if (conn == nullptr) {
+        status = Error;
         codelog(DATABASE__ERROR, "DBCore - mysql = null");
-        if (!Reconnect())
+        if (!Reconnect(conn, status))
             return false;
     }
 
-    if (pStatus != Connected) {
+    if (status != Connected) {
         codelog(DATABASE__ERROR, "DBCore - Status != Connected");
         _log(DATABASE__MESSAGE, "DBCore error detected.  Look for error msgs in logs prior to this point.");
-        if (!Reconnect())
+        if (!Reconnect(conn, status))
             return false;
     }
 
     if (is_log_enabled(DATABASE__QUERIES))
         _log(DATABASE__QUERIES, "DBcore Query - %s", query);
 
-    if (mysql_real_query(mysql, query, querylen)) {
-        uint num = mysql_errno(mysql);
+    if (mysql_real_query(conn, query, querylen)) {
+        uint num = mysql_errno(conn);
         if (num > 0)
-            pStatus = Error;
+            status = Error;
 
         // there are many correctable errors to check for
         if ((num == CR_SERVER_LOST) or (num == CR_SERVER_GONE_ERROR)) {
             _log(DATABASE__ERROR, "DBCore error - server lost or gone.");
-            if (!Reconnect())
+            if (!Reconnect(conn, status))
                 return false;
         }
 
-        if ((pStatus == Connected) and retry)
-            return DoQuery_locked(err, query, querylen, retry);
+        if ((status == Connected) and retry)
+            return DoQuery(conn, status, err, query, querylen, retry, profile);
 
-        err.SetError(num, mysql_error(mysql));
+        err.SetError(num, mysql_error(conn));
         codelog(DATABASE__ERROR, "DBCore Query - #%u in '%s': %s", err.GetErrNo(), query, err.c_str());
         return false;
     }
 
     err.ClearError();
 
-    if (pProfile)
-        sProfiler.AddTime(9, GetTimeUSeconds() - profileStartTime);
+    if (profile)
+        sProfiler.AddTime(9, GetTimeUSeconds() - profileStartTime);    // Profile::db
 
     return true;
 }
@@ -129,6 +129,30 @@ protected:
     DBQueryResult* mResult;
 };
 
+/**
+ * @brief Completion handler of an asynchronous read.
+ *
+ * Called on the main thread from DBcore::ProcessCompletions(); error is stored
+ * in the result if success is false.  The result is deleted after the call.
+ */
+typedef std::function<void(DBQueryResult& res, bool success)> DBReadCallback;
+
+/**
+ * @brief Counters of the asynchronous query pool.
+ *
+ * Latencies are in microseconds, from queueing to completion.
+ */
+struct DBPoolStats
+{
+    uint32 queued;          // queries currently waiting in all queues
+    uint32 queuedMax;       // highest total queue depth seen
+    int64 writes;           // completed writes
+    int64 reads;            // completed reads
+    int64 errors;           // failed queries
+    double latency;         // summed latency of completed queries
+    double latencyMax;
+};
+
 class DBcore
 : public Singleton<DBcore>
 {
@@ -140,7 +164,7 @@ public:
 
     void    Close();
     void    Initialize(std::string host, std::string user, std::string password, std::string database, bool compress=false, bool SSL=false,
-                       int16 port=3306, bool socket=false, bool reconnect=false, bool profile=false);
+                       int16 port=3306, bool socket=false, bool reconnect=false, bool profile=false, uint8 poolSize=0);
 
     //new shorter syntax:
     //query which returns a result (error is stored in the result if it occurs)
@@ -156,6 +180,40 @@ public:
     // NOTE:  result is cleared before populating with most recent data for multiple statements using same DBQueryResult object.
     bool    RunQueryLID(DBerror& err, uint32& last_insert_id, const char* query_fmt, ...);
 
+    /* asynchronous queries, run by the connection pool.
+     * queries with the same key run in queue order on the same pooled connection (use itemID, charID, etc.)
+     * there is no ordering between pooled and synchronous queries; call Flush() before reading back queued writes.
+     * all of these run synchronously when the pool is not running.
+     */
+    //fire-and-forget write; errors are logged
+    void    QueueWrite(uint32 key, const char *query_fmt, ...);
+    //same as above, for prebuilt queries (these may contain '%')
+    void    QueueWrite(uint32 key, const std::string& query);
+    //read whose result is handed to callback on the main thread
+    void    QueueRead(uint32 key, DBReadCallback callback, const char *query_fmt, ...);
+    //runs callbacks of completed reads and sends pool counters to profiler.  main thread only.
+    void    ProcessCompletions();
+    //blocks until queries queued so far with given key have completed.  use before synchronous reads of data written with that key.
+    void    WaitFor(uint32 key);
+    //same as above, for each key.  each worker is waited on once
+    void    WaitFor(const std::vector<uint32>& keys);
+    //blocks until all queued queries have completed, then runs completions
+    void    Flush();
+
+    /* QueueWrite() calls made on the calling thread between BeginDeferWrites() and EndDeferWrites() are held, and queued
+     * in order by RunDeferredWrites() from the main thread.  used by work running off the main thread (system tics).
+     * QueueWrite() callers already get no result and accept the write landing later, so holding it changes nothing for them,
+     *  but WaitFor() does not wait for writes still held.
+     * all other queries, RunQuery(DBerror&, ...) included, run at once, so their result is real.
+     */
+    void    BeginDeferWrites();
+    void    EndDeferWrites();
+    void    RunDeferredWrites();
+
+    uint8   GetPoolSize() const { return (uint8)mWorkers.size(); }
+    void    GetPoolStats(DBPoolStats& stats);
+    void    PrintPoolStats();
+
     int32   DoEscapeString(char* tobuf, const char* frombuf, int32 fromlen);
     void    DoEscapeString(std::string &to, const std::string &from);
     static bool IsSafeString(const char *str);
@@ -167,16 +225,35 @@ public:
     eStatus GetStatus() const { return pStatus; }
 
 protected:
+    class Worker;
+    struct Request;
+
     MYSQL*  getMySQL()              { return mysql; }
 
     void Connect(uint* errnum = 0, char* errbuf = 0);
+    //connects given handle using our settings; verbose prints the settings to console
+    void Connect(MYSQL* conn, eStatus& status, uint* errnum, char* errbuf, bool verbose);
 
     bool Reconnect();
+    bool Reconnect(MYSQL*& conn, eStatus& status);
     //void CallShutdown();
 
+    void StartPool(uint8 poolSize);
+    void StopPool();
+    void Enqueue(uint32 key, Request* req);
+    //blocks until worker's queue is empty and it is idle
+    void Drain(Worker* worker);
+    //runs request on given connection; called by workers
+    void RunRequest(MYSQL*& conn, eStatus& status, Request* req);
+
+    /** Thread entry point; casts arg to Worker and runs it. */
+    static void* WorkerThread(void* arg);
+
 private:
     //MDatabase must be locked before these calls:
     bool    DoQuery_locked(DBerror &err, const char *query, int querylen, bool retry = true);
+    //runs query on given connection; caller must own conn
+    bool    DoQuery(MYSQL*& conn, eStatus& status, DBerror &err, const char *query, int querylen, bool retry, bool profile);
 
     MYSQL*  mysql;
     Mutex   MDatabase;
@@ -194,6 +271,20 @@ private:
     std::string pUser;
     std::string pPassword;
     std::string pDatabase;
+
+    // connection pool
+    std::vector<Worker*> mWorkers;
+    Mutex   mMCompleted;        // guards following members
+    std::vector<Request*> mCompleted;
+    std::vector<double> mLatencies;     // latencies not yet sent to profiler
+    DBPoolStats mStats;
+
+    struct DeferredWrite {
+        uint32 key;
+        std::string query;
+    };
+    Mutex   mMDeferred;         // guards mDeferred
+    std::vector<DeferredWrite> mDeferred;
 };
 
 #define sDatabase \
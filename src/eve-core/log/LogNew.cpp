@@ -26,28 +26,15 @@
 #include "eve-core.h"
 
 #include "log/LogNew.h"
+#include "log/LogWriter.h"
 #include "log/logtypes.h"
 #include "log/logsys.h"
 
 /*************************************************************************/
 /* NewLog                                                                */
 /*************************************************************************/
-const char* const NewLog::COLOR_TABLE[ COLOR_COUNT ] =
-{
-    "\033[" "00"    "m", // COLOR_DEFAULT
-    "\033[" "30;22" "m", // COLOR_BLACK
-    "\033[" "31;22" "m", // COLOR_RED
-    "\033[" "32;22" "m", // COLOR_GREEN
-    "\033[" "33;01" "m", // COLOR_YELLOW
-    "\033[" "34;01" "m", // COLOR_BLUE
-    "\033[" "35;22" "m", // COLOR_MAGENTA
-    "\033[" "36;01" "m", // COLOR_CYAN
-    "\033[" "37;01" "m"  // COLOR_WHITE
-};
-
 NewLog::NewLog()
-: mLogfile( NULL ),
-  mTime( 0 ),
+: mTime( 0 ),
   m_initialized(false)
 {
     // open default logfile
@@ -58,8 +45,7 @@ NewLog::NewLog()
 }
 
 NewLog::NewLog(std::string logPath)
-: mLogfile( NULL ),
-mTime( 0 )
+: mTime( 0 )
 {
     // open default logfile
     if( logPath.empty() )
@@ -202,28 +188,22 @@ void NewLog::Debug( const char* source, const char* fmt, ... )
 
 bool NewLog::SetLogfile( const char* filename )
 {
-    MutexLock l( mMutex );
-
-    FILE* file = NULL;
-
-    if( NULL != filename )
+    if( NULL == filename )
     {
-        file = fopen( filename, "w" );
-        if( NULL == file )
-            return false;
+        sLogWriter.Close( LogWriter::Main );
+        return true;
     }
 
-    return SetLogfile( file );
+    return sLogWriter.Open( LogWriter::Main, filename );
 }
 
 bool NewLog::SetLogfile( FILE* file )
 {
-    MutexLock l( mMutex );
-
-    if( NULL != mLogfile )
-        assert( 0 == fclose( mLogfile ) );
+    if( NULL == file )
+        sLogWriter.Close( LogWriter::Main );
+    else
+        sLogWriter.Open( LogWriter::Main, file );
 
-    mLogfile = file;
     return true;
 }
 
@@ -232,90 +212,11 @@ void NewLog::PrintMsg( Color color, char pfx, const char* source, const char* fm
     if( !m_initialized )
         return;
 
-    MutexLock l( mMutex );
-
-    PrintTime();
-
-    SetColor( color );
-    Print( " %c ", pfx );
-
-    if( source && *source )
-    {
-        SetColor( COLOR_WHITE );
-        Print( "%s: ", source );
-
-        SetColor( color );
-    }
-
-    PrintVa( fmt, ap );
-    Print( "\n" );
-
-    SetColor( COLOR_DEFAULT );
-}
-
-void NewLog::PrintTime()
-{
-    MutexLock l( mMutex );
-
-    // this will be replaced my a timing thread somehow
-    SetTime( time( NULL ) );
-
-    tm t;
-    localtime_r( &mTime, &t );
-
-    Print( "%02u:%02u:%02u", t.tm_hour, t.tm_min, t.tm_sec );
-}
-
-void NewLog::Print( const char* fmt, ... )
-{
-    va_list ap;
-    va_start( ap, fmt );
-
-    PrintVa( fmt, ap );
-
-    va_end( ap );
-}
-
-void NewLog::PrintVa( const char* fmt, va_list ap )
-{
-    MutexLock l( mMutex );
-
-    if( NULL != mLogfile )
-    {
-        // this is a design flaw ( UNIX related )
-        va_list ap2;
-        va_copy( ap2, ap );
-
-        vfprintf( mLogfile, fmt, ap2 );
-
-#ifndef NDEBUG
-        // flush immediately so logfile is accurate if we crash
-        fflush( mLogfile );
-#endif /* !NDEBUG */
-
-        va_end( ap2 );
-    }
-
-    vprintf( fmt, ap );
-}
-
-void NewLog::SetColor( Color color )
-{
-    assert( 0 <= color && color < COLOR_COUNT );
-
-    MutexLock l( mMutex );
-
-#ifdef HAVE_WINDOWS_H
-    ::SetConsoleTextAttribute( mStdOutHandle, COLOR_TABLE[ color ] );
-#else /* !HAVE_WINDOWS_H */
-    ::fputs( COLOR_TABLE[ color ], stdout );
-#endif /* !HAVE_WINDOWS_H */
+    sLogWriter.Write( LogWriter::Main, color, pfx, source, 0, fmt, ap );
 }
 
 void NewLog::SetLogfileDefault(std::string logPath)
 {
-    MutexLock l( mMutex );
-
     // set initial log system time
     SetTime( time( NULL ) );
 
@@ -33,7 +33,8 @@
  * @brief a small and simple logging system.
  *
  * This class is designed to be a simple logging system that both logs to file
- * and console regarding the settings.
+ * and console regarding the settings.  Output is written by LogWriter, which
+ * does so on its own thread once started.
  *
  * @author Captnoord.
  * @date August 2009
@@ -158,7 +159,7 @@ public:
     void SetTime( time_t time ) { mTime = time; }
 
 protected:
-    /// A convenience color enum.
+    /// A convenience color enum.  LogWriter keeps the escape codes, in this order.
     enum Color
     {
         COLOR_DEFAULT, ///< A default color.
@@ -186,64 +187,15 @@ protected:
      * @param[in] ap     The arguments.
      */
     void PrintMsg( Color color, char pfx, const char* source, const char* fmt, va_list ap );
-    /**
-     * @brief Prints current time.
-     */
-    void PrintTime();
-
-    /**
-     * @brief Prints a raw message.
-     *
-     * This method only handles printing to all desired
-     * destinations (standard output and logfile at the moment).
-     *
-     * @param[in] fmt The format string.
-     * @param[in] ... The arguments.
-     */
-    void Print( const char* fmt, ... );
-    /**
-     * @brief Prints a raw message.
-     *
-     * This method only handles printing to all desired
-     * destinations (standard output and logfile at the moment).
-     *
-     * @param[in] fmt The format string.
-     * @param[in] ap  The arguments.
-     */
-    void PrintVa( const char* fmt, va_list ap );
-
-    /**
-     * @brief Sets the color of the output text.
-     *
-     * @param[in] color The new color of output text.
-     */
-    void SetColor( Color color );
     /**
      * @brief Sets the default logfile.
      */
     void SetLogfileDefault(std::string logPath);
 
-    /// The active logfile.
-    FILE* mLogfile;
     /// Current timestamp.
     time_t mTime; // crap there should be 1 generic easy to understand time manager.
-    /// Protection against concurrent log messages
-    Mutex mMutex;
 
     bool m_initialized;
-
-#ifdef HAVE_WINDOWS_H
-    /// Handle to standard output stream.
-    const HANDLE mStdOutHandle;
-    /// Handle to standard error stream.
-    const HANDLE mStdErrHandle;
-
-    /// Color translation table.
-    static const WORD COLOR_TABLE[ COLOR_COUNT ];
-#else /* !HAVE_WINDOWS_H */
-    /// Color translation table.
-    static const char* const COLOR_TABLE[ COLOR_COUNT ];
-#endif /* !HAVE_WINDOWS_H */
 };
 
 /// Evaluates to a NewLog instance.
@@ -0,0 +1,588 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "log/LogNew.h"
+#include "log/LogWriter.h"
+
+/* indexed by NewLog::Color */
+static const char* const s_colors[] =
+{
+#ifndef HAVE_WINDOWS_H
+    "\033[" "00"    "m", // COLOR_DEFAULT
+    "\033[" "30;22" "m", // COLOR_BLACK
+    "\033[" "31;22" "m", // COLOR_RED
+    "\033[" "32;22" "m", // COLOR_GREEN
+    "\033[" "33;01" "m", // COLOR_YELLOW
+    "\033[" "34;01" "m", // COLOR_BLUE
+    "\033[" "35;22" "m", // COLOR_MAGENTA
+    "\033[" "36;01" "m", // COLOR_CYAN
+    "\033[" "37;01" "m"  // COLOR_WHITE
+#else /* HAVE_WINDOWS_H */
+    "", "", "", "", "", "", "", "", ""
+#endif /* HAVE_WINDOWS_H */
+};
+static const uint8 s_colorCount = sizeof(s_colors) / sizeof(s_colors[0]);
+static const uint8 s_colorDefault = 0;
+static const uint8 s_colorRed = 2;
+static const uint8 s_colorWhite = 8;
+
+/* record header.  followed by source and text, padded to 8 bytes */
+struct LogWriter::Record
+{
+    uint32 size;        // bytes of record, with header.  padding to end of ring has channel ChannelCount
+    uint8 channel;
+    uint8 color;
+    char pfx;
+    uint8 indent;
+    uint16 sourceLen;
+    uint16 textLen;
+    uint32 pad;
+    uint64_t seq;
+    int64 time;
+};
+
+/**
+ * @brief Single-producer, single-consumer byte ring of one logging thread.
+ *
+ * Only the owning thread moves head and only the writer thread moves tail,
+ * so neither takes a lock.  A record never wraps; space to the end of the ring
+ * is skipped when a record does not fit in it.
+ */
+class LogWriter::Ring
+{
+public:
+    Ring()
+    : m_data( (char*)malloc( RingSize ) ), m_head( 0 ), m_tail( 0 ), m_dropped( 0 ), m_truncated( 0 ), m_closed( false ) { }
+    ~Ring()                                             { free( m_data ); }
+
+    /** @return False if record was dropped, as ring is full. */
+    bool Push( Record& rec, const char* source, const char* text )
+    {
+        rec.size = (sizeof(Record) + rec.sourceLen + rec.textLen + 7) & ~7;
+        uint64_t head = m_head.load( std::memory_order_relaxed );
+        size_t pos = head & (RingSize - 1);
+        size_t skip = 0;
+        if (pos + rec.size > RingSize)
+            skip = RingSize - pos;
+        if (head + skip + rec.size - m_tail.load( std::memory_order_acquire ) > RingSize) {
+            m_dropped.store( m_dropped.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+            return false;
+        }
+        if (skip >= sizeof(Record)) {
+            Record* pad = (Record*)(m_data + pos);
+            pad->size = skip;
+            pad->channel = ChannelCount;
+        }
+        char* dst = m_data + ((head + skip) & (RingSize - 1));
+        memcpy( dst, &rec, sizeof(Record) );
+        memcpy( dst + sizeof(Record), source, rec.sourceLen );
+        memcpy( dst + sizeof(Record) + rec.sourceLen, text, rec.textLen );
+        m_head.store( head + skip + rec.size, std::memory_order_release );
+        return true;
+    }
+
+    /** @brief Gets records from tail up to given head.  writer thread only. */
+    void Peek( uint64_t head, std::vector<const Record*>& into )
+    {
+        uint64_t tail = m_tail.load( std::memory_order_relaxed );
+        while (tail < head) {
+            size_t pos = tail & (RingSize - 1);
+            if (RingSize - pos < sizeof(Record)) {
+                tail += RingSize - pos;
+                continue;
+            }
+            const Record* rec = (const Record*)(m_data + pos);
+            if (rec->channel < ChannelCount)
+                into.push_back( rec );
+            tail += rec->size;
+        }
+    }
+
+    char* m_data;
+    std::atomic<uint64_t> m_head;     // written by owning thread
+    std::atomic<uint64_t> m_tail;     // written by writer thread
+    std::atomic<uint64_t> m_dropped;  // written by owning thread
+    std::atomic<uint64_t> m_truncated;
+    std::atomic<bool> m_closed;     // owning thread has exited.  freed by writer thread once drained
+};
+
+/* marks ring of a thread closed when the thread exits */
+struct LogWriter::RingOwner
+{
+    RingOwner() : ring( nullptr ) { }
+    ~RingOwner()
+    {
+        if (ring != nullptr)
+            ring->m_closed.store( true, std::memory_order_release );
+        ring = nullptr;
+    }
+
+    Ring* ring;
+};
+
+
+LogWriter::LogWriter()
+: m_running( false ),
+  m_console( true ),
+  m_thread( 0 ),
+  m_seq( 0 ),
+  m_freedDropped( 0 ),
+  m_freedTruncated( 0 ),
+  m_dropped( 0 ),
+  m_maxBytes( 0 ),
+  m_maxSeconds( 0 ),
+  m_lastTime( 0 ),
+  m_stop( false ),
+  m_flushReq( 0 ),
+  m_flushDone( 0 )
+{
+    for (uint8 i = 0; i < ChannelCount; ++i) {
+        m_file[i] = nullptr;
+        m_size[i] = 0;
+        m_opened[i] = 0;
+    }
+    m_timeStr[0] = '\0';
+    memset( &m_stats, 0, sizeof(m_stats) );
+
+    pthread_mutex_init( &m_wakeMutex, nullptr );
+    pthread_cond_init( &m_wake, nullptr );
+    pthread_cond_init( &m_flushed, nullptr );
+}
+
+LogWriter::~LogWriter()
+{
+    Stop();
+    for (uint8 i = 0; i < ChannelCount; ++i)
+        Close( (Channel)i );
+    for (auto cur : m_rings)
+        delete cur;
+
+    pthread_cond_destroy( &m_flushed );
+    pthread_cond_destroy( &m_wake );
+    pthread_mutex_destroy( &m_wakeMutex );
+}
+
+LogWriter& LogWriter::get()
+{
+    static LogWriter* instance = new LogWriter();
+    return *instance;
+}
+
+bool LogWriter::Start()
+{
+    if (m_running)
+        return true;
+
+    m_stop = false;
+    m_running = true;
+    if (pthread_create( &m_thread, nullptr, WriterThread, this )) {
+        m_running = false;
+        return false;
+    }
+
+    static bool registered = false;
+    if (!registered) {
+        // records still queued at exit are written
+        atexit( StopAtExit );
+        registered = true;
+    }
+    return true;
+}
+
+void LogWriter::StopAtExit()
+{
+    get().Stop();
+}
+
+void LogWriter::Stop()
+{
+    if (!m_running)
+        return;
+
+    // records from now on are written by their threads
+    m_running = false;
+
+    pthread_mutex_lock( &m_wakeMutex );
+    m_stop = true;
+    pthread_cond_signal( &m_wake );
+    pthread_mutex_unlock( &m_wakeMutex );
+    pthread_join( m_thread, nullptr );
+
+    // records queued by threads which were still logging as writer stopped
+    WriteQueued();
+}
+
+void LogWriter::Flush()
+{
+    if (!m_running) {
+        MutexLock lock( m_outMutex );
+        fflush( stdout );
+        for (uint8 i = 0; i < ChannelCount; ++i)
+            if (m_file[i] != nullptr)
+                fflush( m_file[i] );
+        return;
+    }
+
+    pthread_mutex_lock( &m_wakeMutex );
+    uint64_t req = ++m_flushReq;
+    pthread_cond_signal( &m_wake );
+    while (m_running and (m_flushDone < req))
+        pthread_cond_wait( &m_flushed, &m_wakeMutex );
+    pthread_mutex_unlock( &m_wakeMutex );
+}
+
+void* LogWriter::WriterThread( void* arg )
+{
+    LogWriter* self = (LogWriter*)arg;
+
+    while (true) {
+        pthread_mutex_lock( &self->m_wakeMutex );
+        if (!self->m_stop and (self->m_flushReq == self->m_flushDone)) {
+            timespec until;
+            clock_gettime( CLOCK_REALTIME, &until );
+            until.tv_nsec += Interval * 1000000L;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_nsec -= 1000000000L;
+                ++until.tv_sec;
+            }
+            pthread_cond_timedwait( &self->m_wake, &self->m_wakeMutex, &until );
+        }
+        bool stop = self->m_stop;
+        uint64_t req = self->m_flushReq;
+        pthread_mutex_unlock( &self->m_wakeMutex );
+
+        // records queued before req was taken are in this batch
+        self->WriteQueued();
+
+        pthread_mutex_lock( &self->m_wakeMutex );
+        self->m_flushDone = req;
+        pthread_cond_broadcast( &self->m_flushed );
+        pthread_mutex_unlock( &self->m_wakeMutex );
+
+        if (stop)
+            break;
+    }
+
+    return nullptr;
+}
+
+LogWriter::Ring* LogWriter::GetRing()
+{
+    static thread_local RingOwner owner;
+    if (owner.ring == nullptr) {
+        owner.ring = new Ring();
+        MutexLock lock( m_ringMutex );
+        m_rings.push_back( owner.ring );
+    }
+    return owner.ring;
+}
+
+void LogWriter::Write( Channel channel, uint8 color, char pfx, const char* source, uint8 indent, const char* fmt, va_list ap )
+{
+    char text[MaxText];
+    int len = vsnprintf( text, MaxText, fmt, ap );
+    bool truncated = false;
+    if (len < 0) {
+        len = 0;
+    } else if (len >= (int)MaxText) {
+        len = MaxText - 1;
+        truncated = true;
+    }
+
+    Record rec;
+    rec.size = 0;
+    rec.channel = channel;
+    rec.color = (color < s_colorCount ? color : s_colorDefault);
+    rec.pfx = pfx;
+    rec.indent = indent;
+    rec.sourceLen = (source == nullptr ? 0 : strnlen( source, 0xFF ));
+    rec.textLen = len;
+    rec.pad = 0;
+    rec.seq = 0;
+    rec.time = time( nullptr );
+
+    if (m_running) {
+        Ring* ring = GetRing();
+        if (truncated)
+            ring->m_truncated.store( ring->m_truncated.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+        rec.seq = m_seq.fetch_add( 1, std::memory_order_relaxed );
+        ring->Push( rec, source, text );
+        return;
+    }
+
+    MutexLock lock( m_outMutex );
+    if (truncated)
+        ++m_stats.truncated;
+    Format( &rec, source, text );
+    WriteOut();
+}
+
+bool LogWriter::WriteQueued()
+{
+    std::vector<Ring*> rings;
+    {
+        MutexLock lock( m_ringMutex );
+        rings = m_rings;
+    }
+
+    // heads are taken once, so records queued while this batch is written wait for the next
+    std::vector<uint64_t> heads( rings.size() );
+    std::vector<bool> closed( rings.size() );
+    std::vector<const Record*> recs;
+    uint64_t dropped(m_freedDropped);
+    for (size_t i = 0; i < rings.size(); ++i) {
+        closed[i] = rings[i]->m_closed.load( std::memory_order_acquire );
+        heads[i] = rings[i]->m_head.load( std::memory_order_acquire );
+        rings[i]->Peek( heads[i], recs );
+        dropped += rings[i]->m_dropped.load( std::memory_order_relaxed );
+    }
+
+    if (!recs.empty() or (dropped > m_dropped)) {
+        std::sort( recs.begin(), recs.end(), [](const Record* a, const Record* b) { return a->seq < b->seq; } );
+
+        MutexLock lock( m_outMutex );
+        for (auto cur : recs)
+            Format( cur, (const char*)(cur + 1), (const char*)(cur + 1) + cur->sourceLen );
+
+        if (dropped > m_dropped) {
+            char text[64];
+            Record rec;
+            memset( &rec, 0, sizeof(rec) );
+            rec.channel = Main;
+            rec.color = s_colorRed;
+            rec.pfx = 'E';
+            rec.sourceLen = 9;
+            rec.textLen = snprintf( text, sizeof(text), "%lu records dropped, as rings were full.", dropped - m_dropped );
+            rec.time = time( nullptr );
+            Format( &rec, "LogWriter", text );
+            rec.channel = Sys;
+            Format( &rec, "LogWriter", text, false );
+            m_dropped = dropped;
+        }
+        ++m_stats.batches;
+        WriteOut();
+    }
+
+    // records are written; give their space back
+    std::vector<Ring*> freed;
+    for (size_t i = 0; i < rings.size(); ++i) {
+        rings[i]->m_tail.store( heads[i], std::memory_order_release );
+        if (closed[i])
+            freed.push_back( rings[i] );
+    }
+    if (!freed.empty()) {
+        MutexLock lock( m_ringMutex );
+        for (auto cur : freed) {
+            m_freedDropped += cur->m_dropped.load( std::memory_order_relaxed );
+            m_freedTruncated += cur->m_truncated.load( std::memory_order_relaxed );
+            m_rings.erase( std::find( m_rings.begin(), m_rings.end(), cur ) );
+            delete cur;
+        }
+    }
+
+    return !recs.empty();
+}
+
+void LogWriter::Format( const Record* rec, const char* source, const char* text, bool console/*true*/ )
+{
+    if (rec->time != m_lastTime) {
+        time_t time = rec->time;
+        tm t;
+        localtime_r( &time, &t );
+        snprintf( m_timeStr, sizeof(m_timeStr), "%02u:%02u:%02u", t.tm_hour, t.tm_min, t.tm_sec );
+        m_lastTime = rec->time;
+    }
+
+    ++m_stats.records;
+    FILE* file = m_file[rec->channel];
+    std::string& fileBuf = m_fileBuf[rec->channel];
+    size_t fileStart = fileBuf.size();
+
+    if (rec->channel == Main) {
+        // TIME P source: text
+        if (m_console and console) {
+            m_consoleBuf.append( m_timeStr );
+            m_consoleBuf.append( s_colors[rec->color] );
+            m_consoleBuf.append( 1, ' ' ).append( 1, rec->pfx ).append( 1, ' ' );
+            if (rec->sourceLen > 0) {
+                m_consoleBuf.append( s_colors[s_colorWhite] );
+                m_consoleBuf.append( source, rec->sourceLen ).append( ": " );
+                m_consoleBuf.append( s_colors[rec->color] );
+            }
+            m_consoleBuf.append( text, rec->textLen ).append( 1, '\n' );
+            m_consoleBuf.append( s_colors[s_colorDefault] );
+        }
+        if (file != nullptr) {
+            fileBuf.append( m_timeStr );
+            fileBuf.append( 1, ' ' ).append( 1, rec->pfx ).append( 1, ' ' );
+            if (rec->sourceLen > 0)
+                fileBuf.append( source, rec->sourceLen ).append( ": " );
+            fileBuf.append( text, rec->textLen ).append( 1, '\n' );
+        }
+    } else {
+        // TIME [source] text
+        size_t start = fileBuf.size();
+        fileBuf.append( m_timeStr ).append( " [" );
+        fileBuf.append( source, rec->sourceLen ).append( "] " );
+        fileBuf.append( rec->indent, ' ' );
+        fileBuf.append( text, rec->textLen ).append( 1, '\n' );
+        if (m_console and console)
+            m_consoleBuf.append( fileBuf, start, std::string::npos );
+        if (file == nullptr)
+            fileBuf.resize( start );
+    }
+
+    m_size[rec->channel] += fileBuf.size() - fileStart;
+}
+
+void LogWriter::WriteOut()
+{
+    if (!m_consoleBuf.empty()) {
+        fwrite( m_consoleBuf.data(), 1, m_consoleBuf.size(), stdout );
+        fflush( stdout );
+        m_stats.bytes += m_consoleBuf.size();
+        m_consoleBuf.clear();
+    }
+
+    time_t now = 0;
+    for (uint8 i = 0; i < ChannelCount; ++i) {
+        if (m_fileBuf[i].empty())
+            continue;
+        if (m_file[i] != nullptr) {
+            fwrite( m_fileBuf[i].data(), 1, m_fileBuf[i].size(), m_file[i] );
+            fflush( m_file[i] );
+            m_stats.bytes += m_fileBuf[i].size();
+        }
+        m_fileBuf[i].clear();
+
+        if (m_path[i].empty())
+            continue;
+        if (now == 0)
+            now = time( nullptr );
+        if (((m_maxBytes > 0) and (m_size[i] >= m_maxBytes))
+        or  ((m_maxSeconds > 0) and (now - m_opened[i] >= m_maxSeconds)))
+            Rotate( (Channel)i, now );
+    }
+}
+
+void LogWriter::Rotate( Channel channel, time_t now )
+{
+    tm t;
+    localtime_r( &now, &t );
+    char suffix[32];
+    snprintf( suffix, sizeof(suffix), ".%04u%02u%02u-%02u%02u%02u",
+              t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec );
+
+    fclose( m_file[channel] );
+    std::string rotated = m_path[channel] + suffix;
+    // on failure, keep writing to the current file
+    bool renamed = (rename( m_path[channel].c_str(), rotated.c_str() ) == 0);
+    m_file[channel] = fopen( m_path[channel].c_str(), (renamed ? "w" : "a") );
+    if (m_file[channel] == nullptr)
+        m_path[channel].clear();
+    m_size[channel] = 0;
+    m_opened[channel] = now;
+    ++m_stats.rotations;
+}
+
+bool LogWriter::Open( Channel channel, const char* filename )
+{
+    FILE* file = fopen( filename, "w" );
+    if (file == nullptr)
+        return false;
+
+    Open( channel, file );
+    MutexLock lock( m_outMutex );
+    m_path[channel] = filename;
+    return true;
+}
+
+void LogWriter::Open( Channel channel, FILE* file )
+{
+    // records queued so far go to the old file
+    Flush();
+
+    MutexLock lock( m_outMutex );
+    if (m_file[channel] != nullptr)
+        fclose( m_file[channel] );
+    m_file[channel] = file;
+    m_path[channel].clear();
+    m_size[channel] = 0;
+    m_opened[channel] = time( nullptr );
+}
+
+void LogWriter::Close( Channel channel )
+{
+    Flush();
+
+    MutexLock lock( m_outMutex );
+    if (m_file[channel] != nullptr)
+        fclose( m_file[channel] );
+    m_file[channel] = nullptr;
+    m_path[channel].clear();
+}
+
+bool LogWriter::IsOpen( Channel channel )
+{
+    MutexLock lock( m_outMutex );
+    return (m_file[channel] != nullptr);
+}
+
+void LogWriter::SetRotation( uint64_t maxBytes, uint32 maxSeconds )
+{
+    MutexLock lock( m_outMutex );
+    m_maxBytes = maxBytes;
+    m_maxSeconds = maxSeconds;
+}
+
+void LogWriter::GetStats( LogWriterStats& into )
+{
+    {
+        MutexLock lock( m_outMutex );
+        into = m_stats;
+    }
+
+    // truncated in m_stats are those written on calling thread
+    MutexLock lock( m_ringMutex );
+    into.dropped = m_freedDropped;
+    into.truncated += m_freedTruncated;
+    for (auto cur : m_rings) {
+        into.dropped += cur->m_dropped.load( std::memory_order_relaxed );
+        into.truncated += cur->m_truncated.load( std::memory_order_relaxed );
+    }
+    into.rings = m_rings.size();
+}
+
+void LogWriter::PrintStats()
+{
+    LogWriterStats stats;
+    GetStats( stats );
+    sLog.Blue( "        LogWriter", "%s, %u rings.  %lu records in %lu batches, %lu bytes.", \
+                (m_running ? "Running" : "Stopped"), stats.rings, stats.records, stats.batches, stats.bytes );
+    sLog.Blue( "        LogWriter", "%lu records dropped, %lu truncated.  %lu logfile rotations.", \
+                stats.dropped, stats.truncated, stats.rotations );
+}
@@ -0,0 +1,188 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __LOG__LOG_WRITER_H__INCL__
+#define __LOG__LOG_WRITER_H__INCL__
+
+#include <atomic>
+
+#include "threading/Mutex.h"
+
+/** @brief Counters of LogWriter, since it was created. */
+struct LogWriterStats
+{
+    uint64_t records;     // records written
+    uint64_t dropped;     // records dropped on full rings
+    uint64_t truncated;   // records cut at MaxText
+    uint64_t bytes;       // bytes written to console and files
+    uint64_t batches;     // writes done by writer thread
+    uint64_t rotations;   // logfiles rotated
+    uint32 rings;       // threads with a ring
+};
+
+/**
+ * @brief Output of NewLog and logsys, on a background thread.
+ *
+ * Until Start() is called, and after Stop(), records are written on the calling thread.
+ *
+ * Once started, each thread logging gets its own ring buffer, which only it writes to
+ * and only the writer thread reads from, so logging takes no lock and does no I/O.
+ * A record holds the time, channel, color and source as given, and the message formatted
+ * by the caller (arguments may not outlive the call, so formatting cannot be deferred).
+ * Time and colors are formatted by the writer thread.
+ *
+ * The writer thread wakes every Interval ms, or on Flush(), and writes all records
+ * queued since in one write per output.  Records from different threads are written in
+ * the order they were queued.
+ *
+ * A record which does not fit in its thread's ring is dropped and counted, so memory is
+ * bounded by ring size times threads logging.  Counts of dropped records are written to
+ * all outputs with the next batch.
+ *
+ * Logfiles opened by name can be rotated by size and age; the full file is renamed with
+ * a time suffix and a new one is opened in its place.
+ *
+ * @author EVEmu Team
+ */
+class LogWriter
+{
+public:
+    // outputs.  each goes to console and its own logfile, if one is open
+    enum Channel {
+        Main        = 0,    // NewLog (sLog)
+        Sys         = 1,    // logsys (_log)
+        ChannelCount
+    };
+
+    static const size_t MaxText = 4096;         // longer messages are cut
+    static const size_t RingSize = 0x40000;     // 256KB per thread, power of 2
+    static const uint32 Interval = 10;          // ms between batches
+
+    LogWriter();
+    ~LogWriter();
+
+    /** @return The instance.  never destroyed, as other singletons log from their destructors. */
+    static LogWriter& get();
+
+    /** @brief Starts writer thread; records are queued from now on. */
+    bool Start();
+    /** @brief Writes all queued records and stops writer thread; records are written on calling thread from now on. */
+    void Stop();
+    bool IsRunning() const                              { return m_running; }
+    /** @brief Blocks until all records queued before the call are written. */
+    void Flush();
+
+    /**
+     * @brief Opens logfile of channel, closing the previous one.
+     *
+     * @param[in] filename Logfile, which is truncated.  files opened by name may be rotated.
+     *
+     * @return True if the file was opened.
+     */
+    bool Open(Channel channel, const char* filename);
+    /** @brief Uses given file as logfile of channel, closing the previous one.  file is closed with Close(). */
+    void Open(Channel channel, FILE* file);
+    void Close(Channel channel);
+    bool IsOpen(Channel channel);
+
+    /** @brief Enables or disables console output.  logfiles are written either way. */
+    void SetConsole(bool enable)                        { m_console = enable; }
+    /**
+     * @brief Sets rotation of logfiles opened by name.
+     *
+     * @param[in] maxBytes Size after which a logfile is rotated.  0 disables.
+     * @param[in] maxSeconds Age after which a logfile is rotated.  0 disables.
+     */
+    void SetRotation(uint64_t maxBytes, uint32 maxSeconds);
+
+    /**
+     * @brief Queues a record, or writes it if not running.
+     *
+     * @param[in] color Console color, as NewLog::Color.  Main channel only.
+     * @param[in] pfx Single-character prefix.  Main channel only; 0 for none.
+     * @param[in] source Origin of message (Main channel) or log type name (Sys channel).  may be null.
+     * @param[in] indent Spaces before message.  Sys channel only.
+     */
+    void Write(Channel channel, uint8 color, char pfx, const char* source, uint8 indent, const char* fmt, va_list ap);
+
+    void GetStats(LogWriterStats& into);
+    void PrintStats();
+
+protected:
+    struct Record;
+    class Ring;
+    struct RingOwner;
+
+    /* thread entry point */
+    static void* WriterThread(void* arg);
+    static void StopAtExit();
+
+    Ring* GetRing();
+    // writes queued records of all rings.  returns false when there were none
+    bool WriteQueued();
+    void Format(const Record* rec, const char* source, const char* text, bool console=true);
+    void WriteOut();
+    void Rotate(Channel channel, time_t now);
+
+private:
+    std::atomic<bool> m_running;
+    bool m_console;
+    pthread_t m_thread;
+    std::atomic<uint64_t> m_seq;  // order of records across rings
+
+    // rings of all threads which logged since start.  rings of exited threads are freed once drained
+    Mutex m_ringMutex;
+    std::vector<Ring*> m_rings;
+    uint64_t m_freedDropped;      // counts of freed rings
+    uint64_t m_freedTruncated;
+    uint64_t m_dropped;           // writer thread only; dropped records already reported
+
+    // guards outputs, formatting buffers and counters.  held by writer thread for each batch
+    Mutex m_outMutex;
+    FILE* m_file[ChannelCount];
+    std::string m_path[ChannelCount];   // empty if not opened by name
+    uint64_t m_size[ChannelCount];
+    time_t m_opened[ChannelCount];
+    uint64_t m_maxBytes;
+    uint32 m_maxSeconds;
+    std::string m_consoleBuf;
+    std::string m_fileBuf[ChannelCount];
+    time_t m_lastTime;          // time formatted in m_timeStr
+    char m_timeStr[16];
+    LogWriterStats m_stats;
+
+    // signalled by Flush() and Stop()
+    pthread_mutex_t m_wakeMutex;
+    pthread_cond_t m_wake;
+    bool m_stop;
+    uint64_t m_flushReq;          // guarded by m_wakeMutex
+    uint64_t m_flushDone;
+    pthread_cond_t m_flushed;
+};
+
+#define sLogWriter \
+    ( LogWriter::get() )
+
+#endif /* !__LOG__LOG_WRITER_H__INCL__ */
@@ -26,12 +26,8 @@
 #include "eve-core.h"
 
 #include "log/logsys.h"
+#include "log/LogWriter.h"
 #include "utils/utils_hex.h"
-#include "threading/Mutex.h"
-
-Mutex mLogSys;
-
-FILE *logsys_log_file(nullptr);
 
 #define LOG_CATEGORY(category) #category ,
 const char *log_category_names[NUMBER_OF_LOG_CATEGORIES] = {
@@ -83,52 +79,7 @@ void log_messageVA(LogType type, const char *fmt, va_list args) {
 
 extern void log_messageVA( LogType type, uint32 iden, const char *fmt, va_list args )
 {
-    /* allocate enough room for a med message  (changed from 4k to 1k) */
-    size_t log_msg_size = 0x400;
-    size_t log_msg_index = 0;
-    char* log_msg = (char*)malloc(log_msg_size);
-
-    /* handle the time part.. cross platform */
-    tm t;
-    time_t tTime;
-    time(&tTime);
-    localtime_r( &tTime, &t );
-    int va_size = snprintf(&log_msg[log_msg_index], log_msg_size, "%02u:%02u:%02u [%s] ", t.tm_hour, t.tm_min, t.tm_sec, log_type_info[type].display_name );
-
-    /* store the resulting size */
-    log_msg_size-=va_size;
-    log_msg_index+=va_size;
-
-    /* add the required spaces */
-    for (uint32 i = 0; i < iden; i++)
-        log_msg[log_msg_index++] = ' ';
-
-    /* make sure the resulting size is corrected */
-    log_msg_size-=iden;
-
-    /* put in the rest of the va stuff */
-    va_size = vsnprintf(&log_msg[log_msg_index], log_msg_size, fmt, args);
-    log_msg_index+=va_size;
-
-    /* make sure that there is a new line at the end */
-    log_msg[log_msg_index++] = '\n';
-    log_msg[log_msg_index++] = '\0';
-
-    MutexLock lock(mLogSys);
-
-    fputs(log_msg, stdout);
-
-    //print into the logfile (if any)
-    if (logsys_log_file != nullptr) {
-        //fprintf(logsys_log_file, "%s\n", message.c_str());
-        fputs(log_msg, logsys_log_file);
-        //keep the logfile updated
-        fflush(logsys_log_file);
-    }
-
-    lock.Unlock();
-
-    free(log_msg);
+    sLogWriter.Write( LogWriter::Sys, 0, 0, log_type_info[type].display_name, (iden > 0xFF ? 0xFF : iden), fmt, args );
 }
 
 void log_enable( LogType t )
@@ -148,21 +99,13 @@ void log_toggle( LogType t )
 
 bool log_open_logfile( const char* filename )
 {
-    MutexLock lock(mLogSys);
-    if (logsys_log_file)
-        if (!log_close_logfile())
-            return false;
-
-    logsys_log_file = fopen(filename, "w");
-    return ( nullptr != logsys_log_file);
+    return sLogWriter.Open( LogWriter::Sys, filename );
 }
 
 bool log_close_logfile()
 {
-    MutexLock lock(mLogSys);
-    if (!logsys_log_file)
-        return true;
-    return ( 0 == fclose( logsys_log_file ) );
+    sLogWriter.Close( LogWriter::Sys );
+    return true;
 }
 
 bool load_log_settings(const char *filename) {
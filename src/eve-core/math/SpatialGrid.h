@@ -0,0 +1,326 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __MATH__SPATIAL_GRID_H__INCL__
+#define __MATH__SPATIAL_GRID_H__INCL__
+
+#include "math/gpoint.h"
+
+/**
+ * @brief Sparse uniform hash grid of objects in 3D space.
+ *
+ * Objects are kept in cubic cells of cellSize meters, and only occupied cells are stored.
+ * A query only looks at the cells overlapping the bounds of its sphere; when those
+ * outnumber the occupied cells (a dscan of a whole system), the occupied cells are walked instead.
+ *
+ * The grid keeps its own copy of each object's position, which is used for all
+ * distance tests, so objects must be moved with Move() whenever they change position.
+ *
+ * Queries return objects in no particular order, except QueryNearest() which
+ * returns them nearest first.  Ranges are exclusive (distance < radius).
+ *
+ * @author EVEmu Team
+ */
+template<class T>
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(double cellSize)
+    : mCellSize(cellSize), mInvCellSize(1.0 / cellSize) { }
+
+    /** @brief Adds obj at pos, or moves it there if already in grid. */
+    void Insert(T* obj, const GPoint& pos) {
+        if (Move(obj, pos))
+            return;
+        AddToCell(obj, pos, GetKey(pos));
+    }
+
+    /** @brief Removes obj.  does nothing if obj is not in grid. */
+    void Remove(T* obj) {
+        typename SlotMap::iterator itr = mSlots.find(obj);
+        if (itr == mSlots.end())
+            return;
+        RemoveFromCell(itr->second);
+        mSlots.erase(itr);
+    }
+
+    /**
+     * @brief Updates position of obj.
+     *
+     * @return False if obj is not in grid.
+     */
+    bool Move(T* obj, const GPoint& pos) {
+        typename SlotMap::iterator itr = mSlots.find(obj);
+        if (itr == mSlots.end())
+            return false;
+        CellKey key(GetKey(pos));
+        if (key == mCells[itr->second.cell].key) {
+            mCells[itr->second.cell].entries[itr->second.index].pos = pos;
+            return true;
+        }
+        // AddToCell() overwrites the slot
+        RemoveFromCell(itr->second);
+        AddToCell(obj, pos, key);
+        return true;
+    }
+
+    void Clear()                                        { mCells.clear(); mCellIndex.clear(); mSlots.clear(); }
+
+    bool Contains(T* obj) const                         { return (mSlots.find(obj) != mSlots.end()); }
+    size_t size() const                                 { return mSlots.size(); }
+    bool empty() const                                  { return mSlots.empty(); }
+    size_t GetCellCount() const                         { return mCells.size(); }
+    double GetCellSize() const                          { return mCellSize; }
+
+    /** @brief Appends objects within radius of center to into. */
+    void QueryRadius(const GPoint& center, double radius, std::vector<T*>& into) const {
+        const double radius2 = radius * radius;
+        ForEachCell(center, radius, [&](const Cell& cell) {
+            for (const Entry& cur : cell.entries)
+                if (GVector(center, cur.pos).lengthSquared() < radius2)
+                    into.push_back(cur.obj);
+        });
+    }
+
+    /**
+     * @brief Appends objects within range of apex which lie inside a cone.
+     *
+     * @param[in] apex      Vertex of the cone.
+     * @param[in] axis      Direction of the cone; need not be normalized.
+     * @param[in] halfAngle Angle between axis and side of the cone, in radians.
+     * @param[in] range     Length of the cone.
+     *
+     * An object at apex is not inside the cone.
+     */
+    void QueryCone(const GPoint& apex, const GVector& axis, double halfAngle, double range, std::vector<T*>& into) const {
+        GVector dir(axis);
+        if (dir.normalize() == 0)
+            return;
+        const double range2 = range * range;
+        const double cosAngle = cos(halfAngle);
+        // cells whose bounding sphere (half diagonal) lies outside the cone are skipped.  only done for cones narrower than a half space
+        const double sinAngle = sin(halfAngle);
+        const double cellRadius = mCellSize * 0.8660254037844386;
+        const bool prune(halfAngle < M_PI / 2);
+        ForEachCell(apex, range, [&](const Cell& cell) {
+            if (prune) {
+                GVector toCell(apex, GetCenter(cell.key));
+                double along = toCell.dotProduct(dir);
+                double across = sqrt(std::max(0.0, toCell.lengthSquared() - along * along));
+                // distance of cell center from side of cone
+                if ((across * cosAngle - along * sinAngle > cellRadius) and (along > -cellRadius))
+                    return;
+                if (along < -cellRadius)
+                    return;
+            }
+            for (const Entry& cur : cell.entries) {
+                GVector to(apex, cur.pos);
+                double dist2 = to.lengthSquared();
+                if ((dist2 <= 0) or (dist2 >= range2))
+                    continue;
+                if (to.dotProduct(dir) > cosAngle * sqrt(dist2))
+                    into.push_back(cur.obj);
+            }
+        });
+    }
+
+    /**
+     * @brief Gets up to count objects nearest to center, nearest first.
+     *
+     * @param[in] maxRange Only objects within this range are returned.  0 for no limit.
+     */
+    void QueryNearest(const GPoint& center, size_t count, std::vector<T*>& into, double maxRange = 0) const {
+        if ((count == 0) or mSlots.empty())
+            return;
+
+        // grow the search sphere until it holds enough objects.
+        //  every object closer than the found ones is inside the sphere, so the nearest of them are the nearest overall
+        //  once the sphere would cover more cells than are occupied, all objects (in range) are looked at in one last pass
+        std::vector<std::pair<double, T*>> found;
+        double radius(mCellSize);
+        while (true) {
+            if ((maxRange > 0) and (radius > maxRange))
+                radius = maxRange;
+            CellKey lo, hi;
+            GetBounds(center, radius, lo, hi);
+            bool last((radius == maxRange) or (GetSpan(lo, hi) > mCells.size()));
+            if (last and (maxRange > 0))
+                radius = maxRange;
+            const double radius2 = (last and (maxRange <= 0) ? HUGE_VAL : radius * radius);
+            found.clear();
+            auto collect = [&](const Cell& cell) {
+                for (const Entry& cur : cell.entries) {
+                    double dist2 = GVector(center, cur.pos).lengthSquared();
+                    if (dist2 < radius2)
+                        found.push_back(std::make_pair(dist2, cur.obj));
+                }
+            };
+            if (last and (maxRange <= 0)) {
+                for (const Cell& cur : mCells)
+                    collect(cur);
+            } else {
+                ForEachCell(center, radius, collect);
+            }
+            if (last or (found.size() >= count))
+                break;
+            radius *= 2;
+        }
+
+        if (found.size() > count) {
+            std::partial_sort(found.begin(), found.begin() + count, found.end(), CompareFirst);
+            found.resize(count);
+        } else {
+            std::sort(found.begin(), found.end(), CompareFirst);
+        }
+        for (auto cur : found)
+            into.push_back(cur.second);
+    }
+
+private:
+    struct CellKey {
+        int64 x, y, z;
+        bool operator==(const CellKey& oth) const       { return (x == oth.x) and (y == oth.y) and (z == oth.z); }
+    };
+    struct CellHash {
+        size_t operator()(const CellKey& key) const {
+            return (size_t)(((uint64_t)key.x * 73856093) ^ ((uint64_t)key.y * 19349663) ^ ((uint64_t)key.z * 83492791));
+        }
+    };
+    struct Entry {
+        T* obj;
+        GPoint pos;
+    };
+    struct Cell {
+        CellKey key;
+        std::vector<Entry> entries;
+    };
+    // where an object is kept
+    struct Slot {
+        size_t cell;        // index in mCells
+        size_t index;       // index in entries of cell
+    };
+    typedef std::unordered_map<CellKey, size_t, CellHash> CellIndexMap;
+    typedef std::unordered_map<T*, Slot> SlotMap;
+
+    static bool CompareFirst(const std::pair<double, T*>& a, const std::pair<double, T*>& b) { return a.first < b.first; }
+
+    int64 GetCoord(double v) const                      { return (int64)floor(v * mInvCellSize); }
+    CellKey GetKey(const GPoint& pos) const {
+        CellKey key;
+        key.x = GetCoord(pos.x);
+        key.y = GetCoord(pos.y);
+        key.z = GetCoord(pos.z);
+        return key;
+    }
+
+    GPoint GetCenter(const CellKey& key) const {
+        return GPoint((key.x + 0.5) * mCellSize, (key.y + 0.5) * mCellSize, (key.z + 0.5) * mCellSize);
+    }
+
+    // cells overlapping bounds of sphere
+    void GetBounds(const GPoint& center, double radius, CellKey& lo, CellKey& hi) const {
+        lo = GetKey(GPoint(center.x - radius, center.y - radius, center.z - radius));
+        hi = GetKey(GPoint(center.x + radius, center.y + radius, center.z + radius));
+    }
+    static double GetSpan(const CellKey& lo, const CellKey& hi) {
+        return double(hi.x - lo.x + 1) * double(hi.y - lo.y + 1) * double(hi.z - lo.z + 1);
+    }
+
+    void AddToCell(T* obj, const GPoint& pos, const CellKey& key) {
+        Slot slot;
+        typename CellIndexMap::iterator itr = mCellIndex.find(key);
+        if (itr == mCellIndex.end()) {
+            slot.cell = mCells.size();
+            mCellIndex[key] = slot.cell;
+            mCells.push_back(Cell());
+            mCells.back().key = key;
+        } else {
+            slot.cell = itr->second;
+        }
+        Cell& cell = mCells[slot.cell];
+        slot.index = cell.entries.size();
+        Entry entry;
+        entry.obj = obj;
+        entry.pos = pos;
+        cell.entries.push_back(entry);
+        mSlots[obj] = slot;
+    }
+
+    // swaps last entry of the cell into the hole, and last cell into the place of an emptied cell.
+    //  does not touch obj's own slot
+    void RemoveFromCell(const Slot& slot) {
+        Cell& cell = mCells[slot.cell];
+        if (slot.index + 1 < cell.entries.size()) {
+            cell.entries[slot.index] = cell.entries.back();
+            mSlots[cell.entries[slot.index].obj].index = slot.index;
+        }
+        cell.entries.pop_back();
+        if (!cell.entries.empty())
+            return;
+
+        mCellIndex.erase(cell.key);
+        if (slot.cell + 1 < mCells.size()) {
+            std::swap(cell, mCells.back());
+            mCellIndex[cell.key] = slot.cell;
+            for (const Entry& cur : cell.entries)
+                mSlots[cur.obj].cell = slot.cell;
+        }
+        mCells.pop_back();
+    }
+
+    // calls fn(cell) for each occupied cell which may hold objects within radius of center
+    template<class Fn>
+    void ForEachCell(const GPoint& center, double radius, Fn fn) const {
+        if (mCells.empty())
+            return;
+        CellKey lo, hi;
+        GetBounds(center, radius, lo, hi);
+        if (GetSpan(lo, hi) > mCells.size()) {
+            for (const Cell& cur : mCells)
+                if ((cur.key.x >= lo.x) and (cur.key.x <= hi.x)
+                and (cur.key.y >= lo.y) and (cur.key.y <= hi.y)
+                and (cur.key.z >= lo.z) and (cur.key.z <= hi.z))
+                    fn(cur);
+            return;
+        }
+        CellKey key;
+        for (key.x = lo.x; key.x <= hi.x; ++key.x)
+            for (key.y = lo.y; key.y <= hi.y; ++key.y)
+                for (key.z = lo.z; key.z <= hi.z; ++key.z) {
+                    typename CellIndexMap::const_iterator itr = mCellIndex.find(key);
+                    if (itr != mCellIndex.end())
+                        fn(mCells[itr->second]);
+                }
+    }
+
+    const double mCellSize;
+    const double mInvCellSize;
+
+    std::vector<Cell> mCells;           // occupied cells
+    CellIndexMap mCellIndex;            // key/index in mCells
+    SlotMap mSlots;
+};
+
+#endif /* !__MATH__SPATIAL_GRID_H__INCL__ */
@@ -0,0 +1,124 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "memory/FreeList.h"
+
+namespace {
+    const size_t ClassCount = FreeList::MaxSize / FreeList::Granularity;
+
+    struct Block
+    {
+        Block* next;
+    };
+
+    struct ThreadLists
+    {
+        Block* head[ ClassCount ];
+        size_t count[ ClassCount ];
+        size_t heap;
+        size_t reused;
+
+        ~ThreadLists();
+    };
+
+    // zero-initialized on thread start.  destroyed at thread exit, after which frees go to heap
+    thread_local ThreadLists tLists;
+    thread_local bool tListsDone = false;
+
+    ThreadLists::~ThreadLists()
+    {
+        tListsDone = true;
+        for (size_t i = 0; i < ClassCount; ++i) {
+            while (head[ i ] != nullptr) {
+                Block* b = head[ i ];
+                head[ i ] = b->next;
+                ::operator delete( b );
+            }
+            count[ i ] = 0;
+        }
+    }
+
+    inline size_t SizeClass( size_t size )
+    {
+        return (size == 0 ? 0 : (size - 1) / FreeList::Granularity);
+    }
+}
+
+void* FreeList::Alloc( size_t size )
+{
+    if (size > MaxSize)
+        return ::operator new( size );
+
+    // always allocate the full class size, as the block may serve any size of its class once freed
+    const size_t idx = SizeClass( size );
+    if (tListsDone)
+        return ::operator new( (idx + 1) * Granularity );
+
+    Block* b = tLists.head[ idx ];
+    if (b != nullptr) {
+        tLists.head[ idx ] = b->next;
+        --tLists.count[ idx ];
+        ++tLists.reused;
+        return b;
+    }
+
+    ++tLists.heap;
+    return ::operator new( (idx + 1) * Granularity );
+}
+
+void FreeList::Free( void* p, size_t size )
+{
+    if (p == nullptr)
+        return;
+
+    if ((size > MaxSize) or tListsDone) {
+        ::operator delete( p );
+        return;
+    }
+
+    const size_t idx = SizeClass( size );
+    if (tLists.count[ idx ] >= MaxCached) {
+        ::operator delete( p );
+        return;
+    }
+
+    Block* b = static_cast<Block*>( p );
+    b->next = tLists.head[ idx ];
+    tLists.head[ idx ] = b;
+    ++tLists.count[ idx ];
+}
+
+void FreeList::GetStats( size_t& heap, size_t& reused )
+{
+    if (tListsDone) {
+        heap = reused = 0;
+        return;
+    }
+
+    heap = tLists.heap;
+    reused = tLists.reused;
+}
@@ -0,0 +1,77 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __MEMORY__FREE_LIST_H__INCL__
+#define __MEMORY__FREE_LIST_H__INCL__
+
+#include <cstddef>
+
+/**
+ * @brief Per-thread free lists of small blocks.
+ *
+ * Blocks are grouped in size classes of Granularity bytes, up to MaxSize.
+ *  A freed block is kept on a list of the freeing thread, up to MaxCached per class,
+ *  and handed out again by the next allocation of its class on that thread.
+ *  Lists are never shared, so no locking is needed; a block freed by another thread
+ *  than allocated it simply joins the list of the freeing thread.
+ *
+ * Larger blocks, blocks over the cache limit and blocks freed while a thread exits
+ *  go straight to the global operator new/delete.
+ *
+ * Used as class-level operator new/delete of small, often created objects (PyRep).
+ */
+class FreeList
+{
+public:
+    static const size_t Granularity = 16;
+    static const size_t MaxSize = 128;
+    static const size_t MaxCached = 1024;
+
+    /**
+     * @brief Allocates block of at least given size.
+     *
+     * @param[in] size Size of block; zero is treated as one.
+     *
+     * @return Pointer to block.  throws std::bad_alloc as operator new.
+     */
+    static void* Alloc( size_t size );
+    /**
+     * @brief Frees block allocated by Alloc().
+     *
+     * @param[in] p    Block to free; may be NULL.
+     * @param[in] size Size given to Alloc() for this block.
+     */
+    static void Free( void* p, size_t size );
+
+    /**
+     * @brief Gets allocation counts of calling thread.
+     *
+     * @param[out] heap   Blocks allocated from heap.
+     * @param[out] reused Blocks taken from free lists.
+     */
+    static void GetStats( size_t& heap, size_t& reused );
+};
+
+#endif /* !__MEMORY__FREE_LIST_H__INCL__ */
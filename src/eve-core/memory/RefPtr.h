@@ -28,6 +28,7 @@
 #define __UTILS__REF_PTR_H__INCL__
 
 
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <iostream>
@@ -62,6 +63,20 @@ public:
         mDeleted = false;
     }
 
+    /* std::atomic is not copyable; these keep the member-wise copy this class always had. */
+    RefObject( const RefObject& oth )
+    : mRefCount( oth.mRefCount.load() ),
+    mDeleted( oth.mDeleted )
+    {
+    }
+
+    RefObject& operator=( const RefObject& oth )
+    {
+        mRefCount = oth.mRefCount.load();
+        mDeleted = oth.mDeleted;
+        return *this;
+    }
+
     /**
      * @brief Destructor; must be virtual.
      *
@@ -84,7 +99,7 @@ protected:
     void IncRef() const
     {
         if (mDeleted) {
-            _log(REFPTR__ERROR, "IncRef() - mDeleted = true.  Count is %u", mRefCount);
+            _log(REFPTR__ERROR, "IncRef() - mDeleted = true.  Count is %u", (uint32)mRefCount.load());
             EvE::traceStack();
             return;
         }
@@ -101,22 +116,22 @@ protected:
     void DecRef() const
     {
         if (mDeleted) {
-            _log(REFPTR__ERROR, "DecRef() - mDeleted = true.  Count is %u", mRefCount);
+            _log(REFPTR__ERROR, "DecRef() - mDeleted = true.  Count is %u", (uint32)mRefCount.load());
             EvE::traceStack();
             return;
         }
 
         assert( mDeleted == false );
         assert( mRefCount > 0 );
-        --mRefCount;
         //_log(REFPTR__DEC, "DecRef() is %u.", mRefCount);
 
-        if (mRefCount < 1)
+        // test the decremented value, so only the thread dropping the last reference deletes
+        if (--mRefCount < 1)
             delete this;
     }
 
-    /// Reference count of instance.
-    mutable size_t mRefCount;
+    /// Reference count of instance.  atomic, as objects (PyReps mostly) are shared by pooled system tics.
+    mutable std::atomic<size_t> mRefCount;
     mutable bool mDeleted;
 };
 
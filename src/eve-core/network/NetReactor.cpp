@@ -0,0 +1,375 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "log/logsys.h"
+#include "log/LogNew.h"
+#include "network/NetReactor.h"
+#include "network/TCPConnection.h"
+#include "utils/utils_time.h"
+
+const uint32 NETREACTOR_IDLE_GRANULARITY = 1000;  /* 1s */
+const uint32 NETREACTOR_MAX_EVENTS = 256;
+
+/**
+ * @brief One epoll instance and the thread running it.
+ *
+ * All members except mPending/mWakeTime are protected by mMProcess, which the
+ * loop holds while dispatching; Remove() takes it to synchronize with the loop.
+ */
+class NetReactor::Loop
+{
+public:
+    Loop( uint8 idx )
+    : mIdx( idx ),
+      mEpoll( -1 ),
+      mWake( -1 ),
+      mRun( true ),
+      mThread( 0 ),
+      mWakeTime( 0.0 ),
+      mLastIdle( 0 )
+    {
+        memset( &mStats, 0, sizeof( mStats ) );
+    }
+
+    uint8 mIdx;
+    int mEpoll;
+    int mWake;
+    bool mRun;
+    pthread_t mThread;
+
+    /** Held while the loop dispatches events. */
+    Mutex mMProcess;
+    /** Registered connections and their descriptors. */
+    std::unordered_map<TCPConnection*, SOCKET> mConns;
+    NetReactorStats mStats;
+
+    /** Protects the wake request list. */
+    Mutex mMPending;
+    std::vector<TCPConnection*> mPending;
+    /** Time of first unserviced wake request (us). */
+    double mWakeTime;
+
+    uint32 mLastIdle;
+};
+
+NetReactor::NetReactor()
+: mRunning( false )
+{
+}
+
+NetReactor::~NetReactor()
+{
+    Shutdown();
+}
+
+bool NetReactor::Initialize( uint8 threads )
+{
+    if (mRunning)
+        return true;
+
+    if (threads == 0)
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    for (uint8 i = 0; i < threads; ++i) {
+        Loop* loop = new Loop( i );
+        loop->mEpoll = ::epoll_create1( EPOLL_CLOEXEC );
+        loop->mWake = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        if ((loop->mEpoll == -1) or (loop->mWake == -1)) {
+            _log(THREAD__ERROR, "NetReactor::Initialize() - Unable to create epoll instance: %s", strerror( errno ));
+            if (loop->mEpoll != -1)
+                ::close( loop->mEpoll );
+            if (loop->mWake != -1)
+                ::close( loop->mWake );
+            SafeDelete( loop );
+            Shutdown();
+            return false;
+        }
+
+        epoll_event ev = epoll_event();
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.ptr = nullptr;  // null marks the wake descriptor
+        ::epoll_ctl( loop->mEpoll, EPOLL_CTL_ADD, loop->mWake, &ev );
+
+        if (pthread_create( &loop->mThread, nullptr, LoopThread, loop )) {
+            _log(THREAD__ERROR, "NetReactor::Initialize() - Error creating loop thread: %s", strerror( errno ));
+            ::close( loop->mEpoll );
+            ::close( loop->mWake );
+            SafeDelete( loop );
+            Shutdown();
+            return false;
+        }
+        mLoops.push_back( loop );
+    }
+
+    mRunning = true;
+    sLog.Blue( "       NetReactor", "Network Reactor Initialized with %u epoll loops.", (uint8)mLoops.size() );
+    return true;
+}
+
+void NetReactor::Shutdown()
+{
+    mRunning = false;
+    for (auto cur : mLoops) {
+        cur->mRun = false;
+        uint64_t one = 1;
+        if (::write( cur->mWake, &one, sizeof( one ) ) < 0)
+            _log(THREAD__ERROR, "NetReactor::Shutdown() - Unable to wake loop %u: %s", cur->mIdx, strerror( errno ));
+        pthread_join( cur->mThread, nullptr );
+        ::close( cur->mEpoll );
+        ::close( cur->mWake );
+        SafeDelete( cur );
+    }
+    mLoops.clear();
+}
+
+bool NetReactor::Add( TCPConnection* conn )
+{
+    if (!mRunning or mLoops.empty())
+        return false;
+
+    // pick loop with fewest connections
+    Loop* loop(nullptr);
+    size_t count(0);
+    for (auto cur : mLoops) {
+        MutexLock lock( cur->mMProcess );
+        if ((loop == nullptr) or (cur->mConns.size() < count)) {
+            count = cur->mConns.size();
+            loop = cur;
+        }
+    }
+
+    MutexLock lock( loop->mMProcess );
+    MutexLock sockLock( conn->mMSock );
+    if (conn->mSock == nullptr)
+        return false;
+
+    SOCKET fd = conn->mSock->fd();
+    epoll_event ev = epoll_event();
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.ptr = conn;
+    if (::epoll_ctl( loop->mEpoll, EPOLL_CTL_ADD, fd, &ev ) == -1) {
+        _log(TCP_CLIENT__ERROR, "NetReactor::Add() - epoll_ctl() failed for %s: %s", conn->GetAddress().c_str(), strerror( errno ));
+        return false;
+    }
+
+    conn->mReactorLoop = loop->mIdx;
+    loop->mConns[conn] = fd;
+    loop->mStats.connections = (uint32)loop->mConns.size();
+    _log(TCP_CLIENT__TRACE, "NetReactor::Add() - %s assigned to loop %u", conn->GetAddress().c_str(), loop->mIdx);
+    return true;
+}
+
+void NetReactor::Remove( TCPConnection* conn )
+{
+    int8 idx = conn->mReactorLoop;
+    if ((idx < 0) or (idx >= (int8)mLoops.size()))
+        return;
+
+    Loop* loop = mLoops[idx];
+    MutexLock lock( loop->mMProcess );
+    std::unordered_map<TCPConnection*, SOCKET>::iterator itr = loop->mConns.find( conn );
+    if (itr == loop->mConns.end()) {
+        conn->mReactorLoop = -1;
+        return;
+    }
+
+    ::epoll_ctl( loop->mEpoll, EPOLL_CTL_DEL, itr->second, nullptr );
+    loop->mConns.erase( itr );
+    loop->mStats.connections = (uint32)loop->mConns.size();
+
+    // flush what is left, same as the connection thread would before exiting
+    if (conn->GetState() == TCPConnection::STATE_DISCONNECTING)
+        conn->Process();
+    conn->DoDisconnect();
+    conn->mReactorLoop = -1;
+
+    // drop stale wake requests
+    MutexLock pendLock( loop->mMPending );
+    loop->mPending.erase( std::remove( loop->mPending.begin(), loop->mPending.end(), conn ), loop->mPending.end() );
+}
+
+void NetReactor::RequestWrite( TCPConnection* conn )
+{
+    int8 idx = conn->mReactorLoop;
+    if ((idx < 0) or (idx >= (int8)mLoops.size()))
+        return;
+
+    Loop* loop = mLoops[idx];
+    MutexLock lock( loop->mMPending );
+    // a write already pending for this loop will pick up this connection too
+    bool wake = loop->mPending.empty();
+    if (std::find( loop->mPending.begin(), loop->mPending.end(), conn ) == loop->mPending.end())
+        loop->mPending.push_back( conn );
+
+    if (wake) {
+        loop->mWakeTime = GetTimeUSeconds();
+        uint64_t one = 1;
+        if (::write( loop->mWake, &one, sizeof( one ) ) < 0)
+            _log(TCP_CLIENT__ERROR, "NetReactor::RequestWrite() - Unable to wake loop %u: %s", loop->mIdx, strerror( errno ));
+    }
+}
+
+void NetReactor::GetStats( uint8 idx, NetReactorStats& stats )
+{
+    if (idx >= mLoops.size()) {
+        memset( &stats, 0, sizeof( stats ) );
+        return;
+    }
+
+    MutexLock lock( mLoops[idx]->mMProcess );
+    stats = mLoops[idx]->mStats;
+}
+
+void NetReactor::ClearStats()
+{
+    for (auto cur : mLoops) {
+        MutexLock lock( cur->mMProcess );
+        uint32 conns = cur->mStats.connections;
+        memset( &cur->mStats, 0, sizeof( cur->mStats ) );
+        cur->mStats.connections = conns;
+    }
+}
+
+void NetReactor::PrintStats()
+{
+    if (!mRunning) {
+        sLog.Warning( "       NetReactor", "Network Reactor is not running.  Connections use their own threads." );
+        return;
+    }
+
+    NetReactorStats stats = NetReactorStats();
+    for (uint8 i = 0; i < mLoops.size(); ++i) {
+        GetStats( i, stats );
+        sLog.Warning( "       NetReactor", "Loop %u: %u conns | %li wakeups | %li events | %li writes | %li idle",
+                    i, stats.connections, stats.wakeups, stats.events, stats.writeRequests, stats.housekeeping );
+        sLog.Warning( "       NetReactor", "    wake latency avg %.1fus max %.1fus | dispatch avg %.1fus max %.1fus",
+                    (stats.writeRequests ? stats.wakeLatency / stats.writeRequests : 0.0), stats.wakeLatencyMax,
+                    (stats.wakeups ? stats.dispatchTime / stats.wakeups : 0.0), stats.dispatchTimeMax );
+    }
+}
+
+void* NetReactor::LoopThread( void* arg )
+{
+    Loop* loop = reinterpret_cast< Loop* >( arg );
+    assert( loop != nullptr );
+
+    _log(THREAD__INFO, "NetReactor::LoopThread() - Loop %u running in thread 0x%X", loop->mIdx, pthread_self());
+
+    epoll_event events[NETREACTOR_MAX_EVENTS];
+    std::vector<TCPConnection*> pending, dead;
+    loop->mLastIdle = GetTickCount();
+    while (loop->mRun) {
+        int count = ::epoll_wait( loop->mEpoll, events, NETREACTOR_MAX_EVENTS, NETREACTOR_IDLE_GRANULARITY );
+        if (count == -1) {
+            if (errno == EINTR)
+                continue;
+            _log(THREAD__ERROR, "NetReactor::LoopThread() - epoll_wait() failed on loop %u: %s", loop->mIdx, strerror( errno ));
+            break;
+        }
+
+        double start = GetTimeUSeconds();
+        bool woken(false);
+        MutexLock lock( loop->mMProcess );
+        ++loop->mStats.wakeups;
+
+        dead.clear();
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.ptr == nullptr) {
+                woken = true;
+                continue;
+            }
+
+            TCPConnection* conn = reinterpret_cast< TCPConnection* >( events[i].data.ptr );
+            // connection may have been removed after epoll_wait() returned
+            if (loop->mConns.find( conn ) == loop->mConns.end())
+                continue;
+
+            ++loop->mStats.events;
+            if (!conn->Process() or (conn->GetState() == TCPConnection::STATE_DISCONNECTED))
+                dead.push_back( conn );
+        }
+
+        if (woken) {
+            uint64_t val(0);
+            while (::read( loop->mWake, &val, sizeof( val ) ) > 0);
+
+            double wakeTime(0.0);
+            pending.clear();
+            {
+                MutexLock pendLock( loop->mMPending );
+                pending.swap( loop->mPending );
+                wakeTime = loop->mWakeTime;
+            }
+
+            for (auto conn : pending) {
+                if (loop->mConns.find( conn ) == loop->mConns.end())
+                    continue;
+                ++loop->mStats.writeRequests;
+                if (!conn->Process() or (conn->GetState() == TCPConnection::STATE_DISCONNECTED))
+                    dead.push_back( conn );
+            }
+
+            if (!pending.empty()) {
+                double latency = GetTimeUSeconds() - wakeTime;
+                loop->mStats.wakeLatency += latency * pending.size();
+                if (latency > loop->mStats.wakeLatencyMax)
+                    loop->mStats.wakeLatencyMax = latency;
+            }
+        }
+
+        // periodic pass so idle connections still get their timeouts checked
+        if ((GetTickCount() - loop->mLastIdle) >= NETREACTOR_IDLE_GRANULARITY) {
+            loop->mLastIdle = GetTickCount();
+            ++loop->mStats.housekeeping;
+            for (auto cur : loop->mConns)
+                if (!cur.first->Process() or (cur.first->GetState() == TCPConnection::STATE_DISCONNECTED))
+                    dead.push_back( cur.first );
+        }
+
+        for (auto conn : dead) {
+            std::unordered_map<TCPConnection*, SOCKET>::iterator itr = loop->mConns.find( conn );
+            if (itr == loop->mConns.end())
+                continue;
+            ::epoll_ctl( loop->mEpoll, EPOLL_CTL_DEL, itr->second, nullptr );
+            loop->mConns.erase( itr );
+            conn->DoDisconnect();
+            conn->mReactorLoop = -1;
+        }
+        loop->mStats.connections = (uint32)loop->mConns.size();
+
+        double elapsed = GetTimeUSeconds() - start;
+        loop->mStats.dispatchTime += elapsed;
+        if (elapsed > loop->mStats.dispatchTimeMax)
+            loop->mStats.dispatchTimeMax = elapsed;
+    }
+
+    _log(THREAD__INFO, "NetReactor::LoopThread() - Loop %u stopped", loop->mIdx);
+    return nullptr;
+}
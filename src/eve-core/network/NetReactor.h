@@ -0,0 +1,136 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __NETWORK__NET_REACTOR_H__INCL__
+#define __NETWORK__NET_REACTOR_H__INCL__
+
+#include "threading/Mutex.h"
+#include "utils/Singleton.h"
+
+class TCPConnection;
+
+/** Time (in milliseconds) between housekeeping passes over idle connections (timeouts, pending disconnects). */
+extern const uint32 NETREACTOR_IDLE_GRANULARITY;
+/** Maximal number of epoll events handled per wakeup. */
+extern const uint32 NETREACTOR_MAX_EVENTS;
+
+/**
+ * @brief Counters kept by each reactor loop.
+ *
+ * Latencies are in microseconds.
+ */
+struct NetReactorStats
+{
+    uint32 connections;     // connections currently driven by this loop
+    int64 wakeups;          // epoll_wait() returns
+    int64 events;           // socket events dispatched
+    int64 writeRequests;    // wake requests from Send()/Disconnect()
+    int64 housekeeping;     // idle passes over all connections
+    double wakeLatency;     // summed time from wake request to flush
+    double wakeLatencyMax;
+    double dispatchTime;    // summed time spent dispatching per wakeup
+    double dispatchTimeMax;
+};
+
+/**
+ * @brief Fixed-size pool of edge-triggered epoll loops driving TCPConnections.
+ *
+ * Replaces the thread-per-connection model of TCPConnection::TCPConnectionLoop.
+ * Each connection is pinned to one loop for its lifetime; the loop calls
+ * TCPConnection::Process() when the socket becomes readable/writable or when
+ * data is queued with TCPConnection::Send().
+ *
+ * @author EVEmu Team
+ */
+class NetReactor
+: public Singleton<NetReactor>
+{
+public:
+    NetReactor();
+    ~NetReactor();
+
+    /**
+     * @brief Creates and starts the loops.
+     *
+     * @param[in] threads Number of loops (threads); 0 picks hardware concurrency.
+     *
+     * @return True if all loops have been started.
+     */
+    bool Initialize( uint8 threads );
+    /**
+     * @brief Stops all loops and joins their threads.
+     *
+     * Connections still registered are no longer processed; call this only
+     * after all clients have been closed.
+     */
+    void Shutdown();
+
+    /** @return True if loops are running and new connections should be handed to the reactor. */
+    bool IsRunning() const                              { return mRunning; }
+    /** @return Number of running loops. */
+    uint8 GetLoopCount() const                          { return (uint8)mLoops.size(); }
+
+    /**
+     * @brief Registers connection with least loaded loop.
+     *
+     * @param[in] conn Connection in STATE_CONNECTED with a valid socket.
+     *
+     * @return True if the connection is now driven by the reactor.
+     */
+    bool Add( TCPConnection* conn );
+    /**
+     * @brief Unregisters connection.
+     *
+     * Blocks until the owning loop is not processing the connection.  A connection
+     * which is still disconnecting gets its send queue flushed first.
+     */
+    void Remove( TCPConnection* conn );
+    /**
+     * @brief Wakes the owning loop so queued data (or a state change) gets processed.
+     */
+    void RequestWrite( TCPConnection* conn );
+
+    /** @brief Copies counters of given loop into stats. */
+    void GetStats( uint8 idx, NetReactorStats& stats );
+    /** @brief Clears counters of all loops. */
+    void ClearStats();
+    /** @brief Prints counters of all loops to console. */
+    void PrintStats();
+
+protected:
+    class Loop;
+
+    /** Thread entry point; casts arg to Loop and runs it. */
+    static void* LoopThread( void* arg );
+
+    bool mRunning;
+    std::vector<Loop*> mLoops;
+};
+
+//Singleton
+#define sNetReactor \
+    ( NetReactor::get() )
+
+#endif /* !__NETWORK__NET_REACTOR_H__INCL__ */
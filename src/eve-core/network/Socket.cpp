@@ -76,6 +76,11 @@ unsigned int Socket::sendto( const void* buf, unsigned int len, int flags, const
     return ::sendto( mSock, (const char*)buf, len, flags, to, tolen );
 }
 
+unsigned int Socket::sendmsg( const msghdr* msg, int flags )
+{
+    return ::sendmsg( mSock, msg, flags );
+}
+
 int Socket::bind( const sockaddr* name, unsigned int namelen )
 {
     return ::bind( mSock, name, namelen );
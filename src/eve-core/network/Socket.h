@@ -43,6 +43,7 @@ public:
     unsigned int recvfrom( void* buf, unsigned int len, int flags, sockaddr* from, unsigned int* fromlen );
     unsigned int send( const void* buf, unsigned int len, int flags );
     unsigned int sendto( const void* buf, unsigned int len, int flags, const sockaddr* to, unsigned int tolen );
+    unsigned int sendmsg( const msghdr* msg, int flags );
 
     int bind( const sockaddr* name, unsigned int namelen );
     int listen( int backlog = SOMAXCONN );
@@ -52,6 +53,9 @@ public:
     int setopt( int level, int optname, const void* optval, unsigned int optlen );
     int fcntl( int cmd, long arg );
 
+    /** @return Underlying socket descriptor; used to register the socket with a poller. */
+    SOCKET fd() const { return mSock; }
+
 protected:
     Socket( SOCKET sock );
 
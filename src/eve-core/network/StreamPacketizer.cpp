@@ -27,6 +27,13 @@
 
 #include "network/StreamPacketizer.h"
 
+StreamPacketizer::StreamPacketizer()
+: mReadPos( 0 ),
+  mScanPos( 0 ),
+  mWritePos( 0 )
+{
+}
+
 StreamPacketizer::~StreamPacketizer()
 {
     ClearBuffers();
@@ -34,44 +41,84 @@ StreamPacketizer::~StreamPacketizer()
 
 void StreamPacketizer::InputData( const Buffer& data )
 {
-    mBuffer.AppendSeq( data.begin<uint8>(), data.end<uint8>() );
+    if (data.size() == 0)
+        return;
+
+    memcpy( GetInputSpace( data.size() ), &data[ 0 ], data.size() );
+    CommitInput( data.size() );
 }
 
-void StreamPacketizer::Process()
+uint8* StreamPacketizer::GetInputSpace( size_t len )
 {
-    Buffer::const_iterator<uint8> cur = mBuffer.begin<uint8>(), end = mBuffer.end<uint8>();
-    while( true ) {
-        if (sizeof(uint32) > (end - cur))
-            break;
+    if (mWritePos + len > mBuffer.size()) {
+        // reclaim space of released packets first
+        if (mReadPos > 0) {
+            const size_t used( mWritePos - mReadPos );
+            if (used > 0)
+                memmove( &mBuffer[ 0 ], &mBuffer[ mReadPos ], used );
 
-        const Buffer::const_iterator<uint32> len = cur.As<uint32>();
-        const Buffer::const_iterator<uint8> start = ( len + 1 ).As<uint8>();
+            std::queue< std::pair<size_t, size_t> > packets;
+            while (!mPackets.empty()) {
+                packets.push( std::make_pair( mPackets.front().first - mReadPos, mPackets.front().second ) );
+                mPackets.pop();
+            }
+            mPackets.swap( packets );
 
-        if (*len > (uint32)(end - start))
-            break;
+            mScanPos -= mReadPos;
+            mWritePos = used;
+            mReadPos = 0;
+        }
 
-        mPackets.push( new Buffer(start, start + *len));
-        cur = (start + *len);
+        // use all allocated space, so the buffer is not reallocated on every call
+        if (mWritePos + len > mBuffer.size())
+            mBuffer.Resize<uint8>( std::max<size_t>( mWritePos + len, mBuffer.capacity() ) );
     }
 
-    if( cur != mBuffer.begin<uint8>() )
-        mBuffer.AssignSeq( cur, end );
+    return &mBuffer[ mWritePos ];
+}
+
+void StreamPacketizer::CommitInput( size_t len )
+{
+    assert( mWritePos + len <= mBuffer.size() );
+    mWritePos += len;
 }
 
-Buffer* StreamPacketizer::PopPacket()
+void StreamPacketizer::Process()
 {
-    Buffer* buf(nullptr);
-    if (!mPackets.empty()) {
-        buf = mPackets.front();
-        mPackets.pop();
+    while (mWritePos - mScanPos >= sizeof( uint32 )) {
+        uint32 len(0);
+        memcpy( &len, &mBuffer[ mScanPos ], sizeof( uint32 ) );
+        if (len > mWritePos - mScanPos - sizeof( uint32 ))
+            break;
+
+        mPackets.push( std::make_pair( mScanPos + sizeof( uint32 ), (size_t)len ) );
+        mScanPos += sizeof( uint32 ) + len;
     }
+}
+
+bool StreamPacketizer::PeekPacket( Buffer::const_iterator<uint8>& data, size_t& len ) const
+{
+    if (mPackets.empty())
+        return false;
+
+    data = mBuffer.begin<uint8>() + mPackets.front().first;
+    len = mPackets.front().second;
+    return true;
+}
+
+void StreamPacketizer::ReleasePacket()
+{
+    if (mPackets.empty())
+        return;
 
-    return buf;
+    mReadPos = mPackets.front().first + mPackets.front().second;
+    mPackets.pop();
 }
 
 void StreamPacketizer::ClearBuffers()
 {
-    Buffer* buf(nullptr);
-    while ((buf = PopPacket()))
-        SafeDelete( buf );
+    std::queue< std::pair<size_t, size_t> > empty;
+    mPackets.swap( empty );
+    mReadPos = mScanPos = mWritePos = 0;
+    mBuffer.Resize<uint8>( 0 );
 }
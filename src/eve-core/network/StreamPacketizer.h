@@ -28,24 +28,77 @@
 
 #include "utils/Buffer.h"
 
+/**
+ * @brief Splits a stream of length-prefixed packets into packets.
+ *
+ * Received data is written straight into one buffer and packets are handed out
+ * as views into it, so no packet is copied or allocated on its own.  Space of
+ * released packets is reclaimed by moving the unreleased rest to the front of
+ * the buffer, which only happens when more room is needed for input.
+ *
+ * GetInputSpace() and InputData() may move the buffer, invalidating views
+ * returned by PeekPacket(); callers sharing a packetizer between threads must
+ * lock around both.
+ *
+ * @author Zhur, Bloody.Rabbit
+ */
 class StreamPacketizer
 {
 public:
+    StreamPacketizer();
     ~StreamPacketizer();
 
+    /**
+     * @brief Copies data into the packetizer.
+     *
+     * @param[in] data Data to append.
+     */
     void InputData( const Buffer& data );
+    /**
+     * @brief Gets space at the end of the buffer to receive into.
+     *
+     * @param[in] len Number of bytes which will be written at most.
+     *
+     * @return Pointer to the space; valid until next call to GetInputSpace() or InputData().
+     */
+    uint8* GetInputSpace( size_t len );
+    /**
+     * @brief Appends bytes written into space from GetInputSpace().
+     *
+     * @param[in] len Number of bytes written.
+     */
+    void CommitInput( size_t len );
+
+    /** @brief Finds complete packets in received data. */
     void Process();
 
-    Buffer* PopPacket();
+    /**
+     * @brief Gets the oldest complete packet.
+     *
+     * @param[out] data Start of the packet.
+     * @param[out] len  Length of the packet.
+     *
+     * @return False if there is no complete packet.
+     */
+    bool PeekPacket( Buffer::const_iterator<uint8>& data, size_t& len ) const;
+    /** @brief Releases the packet returned by PeekPacket(). */
+    void ReleasePacket();
+
+    /** @return Number of complete packets. */
+    size_t GetPacketCount() const                       { return mPackets.size(); }
 
     void ClearBuffers();
 
 protected:
+    /* bytes [mReadPos, mScanPos) hold complete packets, [mScanPos, mWritePos) a partial one.
+     *  mBuffer is never shrunk; its size is the space available. */
     Buffer mBuffer;
+    size_t mReadPos;
+    size_t mScanPos;
+    size_t mWritePos;
 
-    std::queue<Buffer*> mPackets;
+    // offset and length of complete packets
+    std::queue< std::pair<size_t, size_t> > mPackets;
 };
 
 #endif /* !__STREAM_PACKETIZER_H__INCL__ */
-
-
@@ -35,12 +35,20 @@
 
 const uint32 TCPCONN_RECVBUF_SIZE = 0x1000;
 const uint32 TCPCONN_LOOP_GRANULARITY = 5;  /* 5ms */
+const uint32 TCPCONN_SEND_BATCH = 64;
+const uint32 TCPCONN_SPARE_BUFFERS = 16;
+const uint32 TCPCONN_SPARE_BUFFER_SIZE = 0x10000;
+
+Mutex TCPConnection::sMSendStats;
+TCPSendStats TCPConnection::sSendStats = TCPSendStats();
 
 TCPConnection::TCPConnection()
 : mSock( nullptr ),
   mSockState( STATE_DISCONNECTED ),
   mrIP( 0 ),
   mrPort( 0 ),
+  mReactorLoop( -1 ),
+  mSendOffset( 0 ),
   mRecvBuf( nullptr )
 {
 }
@@ -50,10 +58,11 @@ TCPConnection::TCPConnection( Socket* socket, uint32 mrIP, uint16 mrPort )
   mSockState( STATE_CONNECTED ),
   mrIP( mrIP ),
   mrPort( mrPort ),
+  mReactorLoop( -1 ),
+  mSendOffset( 0 ),
   mRecvBuf( nullptr )
 {
-    // Start worker thread
-    StartLoop();
+    // processing is started by TCPServer::AddConnection() once we are fully constructed
 }
 
 TCPConnection::~TCPConnection()
@@ -163,6 +172,10 @@ void TCPConnection::Disconnect()
 
     // Change state
     mSockState = STATE_DISCONNECTING;
+
+    // reactor has to be told, as it only looks at us on socket events
+    if (mReactorLoop != -1)
+        sNetReactor.RequestWrite( this );
 }
 
 bool TCPConnection::Send( Buffer** data )
@@ -185,15 +198,38 @@ bool TCPConnection::Send( Buffer** data )
     mSendQueue.push_back( buf );
     buf = nullptr;
 
+    if (mReactorLoop != -1)
+        sNetReactor.RequestWrite( this );
+
     return true;
 }
 
+Buffer* TCPConnection::GetSendBuffer()
+{
+    MutexLock queueLock( mMSendQueue );
+
+    if (mSpareBuffers.empty())
+        return new Buffer();
+
+    Buffer* buf = mSpareBuffers.back();
+    mSpareBuffers.pop_back();
+    return buf;
+}
+
+void TCPConnection::GetSendStats( TCPSendStats& into )
+{
+    MutexLock lock( sMSendStats );
+    into = sSendStats;
+}
+
 void TCPConnection::StartLoop()
 {
-    /** @note  update this to use thread pool instead of creating new threads.
-     * check with sThread.XXXX() for avalible thread from current thread pool.
-     * if one is avalible, it will be used, and if not, sThread will create a new one
-     */
+    // connected sockets are driven by the reactor when it is running.
+    //  pending async connects still need a thread, as Connect() blocks.
+    if ((mSock != nullptr) and sNetReactor.IsRunning())
+        if (sNetReactor.Add( this ))
+            return;
+
     sThread.CreateThread(TCPConnectionLoop, this);
     /*   ORIGINAL CODE HERE
     // Spawn new thread
@@ -205,6 +241,11 @@ void TCPConnection::StartLoop()
 
 void TCPConnection::WaitLoop()
 {
+    if (mReactorLoop != -1) {
+        sNetReactor.Remove( this );
+        return;
+    }
+
     // Block calling thread until work thread terminates
     mMLoopRunning.Lock();
     mMLoopRunning.Unlock();
@@ -261,46 +302,84 @@ bool TCPConnection::SendData( char* errbuf )
     if( state != STATE_CONNECTED && state != STATE_DISCONNECTING )
         return false;
 
-    mMSendQueue.Lock();
-    Buffer* buf(nullptr);
-    int status(0);
+    MutexLock queueLock( mMSendQueue );
+
+    iovec iov[ TCPCONN_SEND_BATCH ];
     while (!mSendQueue.empty()) {
-        buf = mSendQueue.front();
-        mSendQueue.pop_front();
-        mMSendQueue.Unlock();
-        if (mSendQueue.empty())
-            status = mSock->send( &(*buf)[ 0 ], (uint)buf->size(), MSG_NOSIGNAL);
-        else
-            status = mSock->send( &(*buf)[ 0 ], (uint)buf->size(), (MSG_NOSIGNAL | MSG_MORE) );
-        if (status == SOCKET_ERROR) {
-            if (errno == EWOULDBLOCK) {
-                status = 0;
-            } else {
+        // gather as much of the queue as one call takes
+        size_t count(0), total(0);
+        std::deque<Buffer*>::const_iterator cur = mSendQueue.begin(), end = mSendQueue.end();
+        for (; (cur != end) and (count < TCPCONN_SEND_BATCH); ++cur) {
+            const size_t offset( cur == mSendQueue.begin() ? mSendOffset : 0 );
+            if ((*cur)->size() <= offset)
+                continue;
+
+            iov[ count ].iov_base = &(**cur)[ offset ];
+            iov[ count ].iov_len = (*cur)->size() - offset;
+            total += iov[ count ].iov_len;
+            ++count;
+        }
+
+        int status(0);
+        if (total > 0) {
+            msghdr msg;
+            memset( &msg, 0, sizeof( msg ) );
+            msg.msg_iov = iov;
+            msg.msg_iovlen = count;
+
+            status = mSock->sendmsg( &msg, (cur != end ? (MSG_NOSIGNAL | MSG_MORE) : MSG_NOSIGNAL) );
+            if (status == SOCKET_ERROR) {
+                // socket is full; we get called again once it is writable
+                if (errno == EWOULDBLOCK)
+                    return true;
+
                 if( errbuf )
                     snprintf( errbuf, TCPCONN_ERRBUF_SIZE, "%s", strerror( errno ) );
-                SafeDelete( buf );
+                return false;
+            }
+
+            if ((size_t)status > total) {
+                if (errbuf)
+                    snprintf( errbuf, TCPCONN_ERRBUF_SIZE, "WTF?!?   status > size." );
                 return false;
             }
         }
 
-        if ((size_t)status > buf->size()) {
-            if (errbuf)
-                snprintf( errbuf, TCPCONN_ERRBUF_SIZE, "WTF?!?   status > size." );
+        // release buffers which have been sent completely
+        size_t sent( status ), released( 0 );
+        while (!mSendQueue.empty()) {
+            Buffer* buf = mSendQueue.front();
+            const size_t left( buf->size() - std::min( buf->size(), mSendOffset ) );
+            if (left > sent) {
+                mSendOffset += sent;
+                break;
+            }
 
-            SafeDelete( buf );
-            return false;
-        } else if ((size_t)status < buf->size()) {
-            if (status > 0)
-                buf->AssignSeq( buf->begin<uint8>() + status, buf->end<uint8>() );
-            MutexLock queueLock( mMSendQueue );
-            mSendQueue.push_front( buf );
-            buf = nullptr;
-        } else {
-            SafeDelete( buf );
+            sent -= left;
+            mSendOffset = 0;
+            mSendQueue.pop_front();
+            ++released;
+
+            if ((mSpareBuffers.size() < TCPCONN_SPARE_BUFFERS) and (buf->capacity() <= TCPCONN_SPARE_BUFFER_SIZE)) {
+                buf->Resize<uint8>( 0 );
+                mSpareBuffers.push_back( buf );
+            } else {
+                SafeDelete( buf );
+            }
         }
-        mMSendQueue.Lock();
+
+        if (status > 0) {
+            MutexLock statsLock( sMSendStats );
+            ++sSendStats.calls;
+            sSendStats.bytes += status;
+            sSendStats.buffers += released;
+        }
+
+        // socket took less than offered; it is full
+        if ((size_t)status < total)
+            return true;
     }
-    mMSendQueue.Unlock();
+
     return true;
 }
 
@@ -317,12 +396,9 @@ bool TCPConnection::RecvData( char* errbuf )
 
     int status = 0;
     while (true) {
-        if (!mRecvBuf)
-            mRecvBuf = new Buffer( TCPCONN_RECVBUF_SIZE );
-        else if( mRecvBuf->size() < TCPCONN_RECVBUF_SIZE )
-            mRecvBuf->Resize<uint8>( TCPCONN_RECVBUF_SIZE );
+        uint8* space = GetRecvSpace( TCPCONN_RECVBUF_SIZE );
 
-        status = mSock->recv( &(*mRecvBuf)[ 0 ], (uint)mRecvBuf->size(), MSG_DONTWAIT);
+        status = mSock->recv( space, TCPCONN_RECVBUF_SIZE, MSG_DONTWAIT);
         if (status == SOCKET_ERROR) {
             if (errno == EWOULDBLOCK)
                 return true;
@@ -334,7 +410,7 @@ bool TCPConnection::RecvData( char* errbuf )
                 snprintf( errbuf, TCPCONN_ERRBUF_SIZE, "No Data Received.");
             return false;
         } else if (status) {
-            mRecvBuf->Resize<uint8>(status);
+            CommitRecvSpace( status );
             if (!ProcessReceivedData(errbuf))
                 return false;
         } else {
@@ -347,6 +423,21 @@ bool TCPConnection::RecvData( char* errbuf )
     return true;
 }
 
+uint8* TCPConnection::GetRecvSpace( size_t len )
+{
+    if (!mRecvBuf)
+        mRecvBuf = new Buffer( len );
+    else if( mRecvBuf->size() < len )
+        mRecvBuf->Resize<uint8>( len );
+
+    return &(*mRecvBuf)[ 0 ];
+}
+
+void TCPConnection::CommitRecvSpace( size_t len )
+{
+    mRecvBuf->Resize<uint8>( len );
+}
+
 void TCPConnection::DoDisconnect()
 {
     MutexLock lock( mMSock );
@@ -372,6 +463,10 @@ void TCPConnection::ClearBuffers()
         mSendQueue.pop_front();
         SafeDelete(buf);
     }
+    mSendOffset = 0;
+    for (auto cur : mSpareBuffers)
+        SafeDelete(cur);
+    mSpareBuffers.clear();
     SafeDelete(mRecvBuf);
 }
 
@@ -26,6 +26,7 @@
 #ifndef __NETWORK__TCP_CONNECTION_H__INCL__
 #define __NETWORK__TCP_CONNECTION_H__INCL__
 
+#include "network/NetReactor.h"
 #include "network/Socket.h"
 #include "threading/Mutex.h"
 #include "utils/Buffer.h"
@@ -36,6 +37,22 @@ static const uint32 TCPCONN_ERRBUF_SIZE = 1024;
 extern const uint32 TCPCONN_RECVBUF_SIZE;
 /** Time (in milliseconds) between periodical process for incoming/outgoing data. */
 extern const uint32 TCPCONN_LOOP_GRANULARITY;
+/** Most queued buffers sent by a single sendmsg() call. */
+extern const uint32 TCPCONN_SEND_BATCH;
+/** Most sent buffers a connection keeps for reuse. */
+extern const uint32 TCPCONN_SPARE_BUFFERS;
+/** Sent buffers bigger than this (in bytes) are freed instead of being kept for reuse. */
+extern const uint32 TCPCONN_SPARE_BUFFER_SIZE;
+
+/**
+ * @brief Send counters, summed over all connections.
+ */
+struct TCPSendStats
+{
+    uint64_t calls;     // sendmsg() calls which sent data
+    uint64_t bytes;     // bytes sent
+    uint64_t buffers;   // queued buffers completely sent
+};
 
 /**
  * @brief Generic class for TCP connections.
@@ -44,6 +61,9 @@ extern const uint32 TCPCONN_LOOP_GRANULARITY;
  */
 class TCPConnection
 {
+    friend class NetReactor;
+    template<typename X> friend class TCPServer;
+
 public:
     /** Describes all states this object may be in. */
     enum state_t
@@ -118,6 +138,18 @@ public:
      * @return True if data has been accepted, false if not.
      */
     bool Send( Buffer** data );
+    /**
+     * @brief Gets an empty buffer to be filled and passed to Send().
+     *
+     * Buffers which have been sent are kept by the connection and
+     * handed out again, so queuing data does not allocate.
+     *
+     * @return Empty buffer; caller takes ownership.
+     */
+    Buffer* GetSendBuffer();
+
+    /** @brief Gets send counters of all connections. */
+    static void GetSendStats( TCPSendStats& into );
 
 protected:
     /**
@@ -130,14 +162,16 @@ protected:
     TCPConnection( Socket* sock, uint32 rIP, uint16 rPort );
 
     /**
-     * @brief Starts working thread.
+     * @brief Starts processing of the connection.
      *
-     * This function just starts a thread, does not check
-     * whether there is already one running!
+     * Hands the connection to NetReactor if it is running, otherwise
+     * starts a working thread.  Does not check whether the connection
+     * is already being processed!
      */
     void StartLoop();
     /**
-     * @brief Blocks calling thread until working thread terminates.
+     * @brief Blocks calling thread until working thread terminates
+     *  (or the reactor has released the connection).
      */
     void WaitLoop();
 
@@ -159,6 +193,23 @@ protected:
      * @return True if processing ran fine, false if not.
      */
     virtual bool ProcessReceivedData( char* errbuf = 0 ) = 0;
+    /**
+     * @brief Gets space to receive data into.
+     *
+     * Default is the receive buffer.  Children may return their own
+     * storage, to avoid copying received data.
+     *
+     * @param[in] len Number of bytes which will be received at most.
+     *
+     * @return Pointer to at least len bytes.
+     */
+    virtual uint8* GetRecvSpace( size_t len );
+    /**
+     * @brief Called after data has been received into space from GetRecvSpace(), before ProcessReceivedData().
+     *
+     * @param[in] len Number of bytes received.
+     */
+    virtual void CommitRecvSpace( size_t len );
 
     /**
      * @brief Sends data in send queue.
@@ -213,11 +264,22 @@ protected:
 
     /** When a thread is running TCPConnectionLoop, it acquires this mutex first; used for synchronization. */
     mutable Mutex mMLoopRunning;
+    /** Index of the NetReactor loop driving this connection; -1 if it has its own thread. */
+    int8 mReactorLoop;
 
     /** Mutex protecting send queue. */
     mutable Mutex mMSendQueue;
     /** Send queue. */
     std::deque<Buffer*> mSendQueue;
+    /** Number of bytes of the front buffer of send queue which have been sent already. */
+    size_t mSendOffset;
+    /** Sent buffers kept for GetSendBuffer(); protected by mMSendQueue. */
+    std::vector<Buffer*> mSpareBuffers;
+
+    /** Mutex protecting send counters. */
+    static Mutex sMSendStats;
+    /** Send counters of all connections. */
+    static TCPSendStats sSendStats;
 
     /** Receive buffer. */
     Buffer* mRecvBuf;
@@ -175,6 +175,9 @@ protected:
      */
     void AddConnection( X* con )
     {
+        // start processing now that the connection is fully constructed
+        con->StartLoop();
+
         MutexLock lock( mMQueue );
 
         mQueue.push( con );
@@ -34,35 +34,124 @@ bool IsDeflated( const Buffer& data )
     return ( DeflateHeaderByte == data[0] );
 }
 
-bool DeflateData( Buffer& data )
+/**
+ * @brief zlib stream of one thread.
+ *
+ * Initializing a stream allocates its state (~256kB for deflate), so each
+ * thread keeps one inflate stream, and one deflate stream per level and
+ * strategy used, and resets it per call.
+ *
+ * Parameters of a deflate stream are never changed: deflateParams() on a reset
+ * stream flushes into the output buffer of the previous call on some zlib
+ * versions (1.2.9 - 1.2.11 keep high_water across deflateReset()).
+ */
+class ZlibStream
+{
+public:
+    ZlibStream( bool deflater )
+    : mDeflater( deflater ),
+      mInit( false )
+    {
+        memset( &mStream, 0, sizeof( mStream ) );
+    }
+    ~ZlibStream()
+    {
+        if (!mInit)
+            return;
+
+        if (mDeflater)
+            deflateEnd( &mStream );
+        else
+            inflateEnd( &mStream );
+    }
+
+    /**
+     * @return Deflate stream, reset; nullptr on error.
+     *
+     * level and strategy are used on first call only; keep one stream for each.
+     */
+    z_stream* GetDeflate( int level, int strategy )
+    {
+        if (!mInit) {
+            if (deflateInit2( &mStream, level, Z_DEFLATED, MAX_WBITS, 8, strategy ) != Z_OK)
+                return nullptr;
+            mInit = true;
+        } else if (deflateReset( &mStream ) != Z_OK) {
+            return nullptr;
+        }
+
+        return &mStream;
+    }
+
+    /** @return Inflate stream, reset; nullptr on error. */
+    z_stream* GetInflate()
+    {
+        if (!mInit) {
+            if (inflateInit( &mStream ) != Z_OK)
+                return nullptr;
+            mInit = true;
+        } else if (inflateReset( &mStream ) != Z_OK) {
+            return nullptr;
+        }
+
+        return &mStream;
+    }
+
+protected:
+    const bool mDeflater;
+    bool mInit;
+    z_stream mStream;
+};
+
+// k,v of (level, strategy), stream.  zlib keeps a pointer to the z_stream, so streams are never moved
+static thread_local std::map<std::pair<int, int>, std::unique_ptr<ZlibStream> > sDeflateStreams;
+static thread_local ZlibStream sInflateStream( false );
+
+static z_stream* GetDeflateStream( int level, int strategy )
+{
+    std::unique_ptr<ZlibStream>& stream = sDeflateStreams[ std::make_pair( level, strategy ) ];
+    if (stream.get() == nullptr)
+        stream.reset( new ZlibStream( true ) );
+    return stream->GetDeflate( level, strategy );
+}
+
+bool DeflateData( Buffer& data, int level/*Z_DEFAULT_COMPRESSION*/, int strategy/*Z_DEFAULT_STRATEGY*/ )
 {
     Buffer dataDeflated;
-    if( !DeflateData( data, dataDeflated ) )
+    if( !DeflateData( data, dataDeflated, level, strategy ) )
         return false;
 
     data = dataDeflated;
     return true;
 }
 
-bool DeflateData( const Buffer& input, Buffer& output )
+bool DeflateData( const Buffer& input, Buffer& output, int level/*Z_DEFAULT_COMPRESSION*/, int strategy/*Z_DEFAULT_STRATEGY*/ )
+{
+    return DeflateData( &input[0], input.size(), output, level, strategy );
+}
+
+bool DeflateData( const uint8* input, size_t len, Buffer& output, int level/*Z_DEFAULT_COMPRESSION*/, int strategy/*Z_DEFAULT_STRATEGY*/ )
 {
-    const Buffer::iterator<uint8> out = output.end<uint8>();
+    z_stream* zs = GetDeflateStream( level, strategy );
+    if (zs == nullptr)
+        return false;
 
-    size_t outputSize = compressBound( input.size() );
-    output.ResizeAt( out, outputSize );
+    // deflateBound() of an initialized stream bounds output for its parameters, so one call finishes
+    const size_t start( output.size() );
+    output.Resize<uint8>( start + deflateBound( zs, len ) );
 
-    int res = compress( &*out, (uLongf*)&outputSize, &input[0], input.size() );
+    zs->next_in = const_cast<Bytef*>( input );
+    zs->avail_in = len;
+    zs->next_out = &output[ start ];
+    zs->avail_out = output.size() - start;
 
-    if( Z_OK == res )
-    {
-        output.ResizeAt( out, outputSize );
-        return true;
-    }
-    else
-    {
-        output.ResizeAt( out, 0 );
+    if (deflate( zs, Z_FINISH ) != Z_STREAM_END) {
+        output.Resize<uint8>( start );
         return false;
     }
+
+    output.Resize<uint8>( start + zs->total_out );
+    return true;
 }
 
 bool InflateData( Buffer& data )
@@ -75,30 +164,49 @@ bool InflateData( Buffer& data )
     return true;
 }
 
-bool InflateData( const Buffer& input, Buffer& output )
+bool InflateData( const Buffer& input, Buffer& output, size_t sizeHint/*0*/ )
 {
-    const Buffer::iterator<uint8> out = output.end<uint8>();
-
-    size_t outputSize = 0;
-    size_t sizeMultiplier = 0;
-
-    int res = 0;
-    do
-    {
-        outputSize = ( input.size() << ++sizeMultiplier );
-        output.ResizeAt( out, outputSize );
+    return InflateData( &input[0], input.size(), output, sizeHint );
+}
 
-        res = uncompress( &*out, (uLongf*)&outputSize, &input[0], input.size() );
-    } while( Z_BUF_ERROR == res );
+bool InflateData( const uint8* input, size_t len, Buffer& output, size_t sizeHint/*0*/ )
+{
+    z_stream* zs = sInflateStream.GetInflate();
+    if (zs == nullptr)
+        return false;
 
-    if( Z_OK == res )
-    {
-        output.ResizeAt( out, outputSize );
-        return true;
+    const size_t start( output.size() );
+    // without a hint, guess a compression ratio of 75%; output is doubled whenever it is full
+    size_t space( sizeHint > 0 ? sizeHint : std::max<size_t>( len << 2, 0x100 ) );
+    output.Resize<uint8>( start + space );
+
+    zs->next_in = const_cast<Bytef*>( input );
+    zs->avail_in = len;
+
+    int res(Z_OK);
+    while (true) {
+        // output may have moved when grown
+        zs->next_out = &output[ start + zs->total_out ];
+        zs->avail_out = space - zs->total_out;
+
+        res = inflate( zs, Z_NO_FLUSH );
+        if (res == Z_STREAM_END)
+            break;
+        if ((res != Z_OK) and (res != Z_BUF_ERROR))
+            break;
+        // not at stream end with output left; input is truncated
+        if (zs->avail_out > 0)
+            break;
+
+        space <<= 1;
+        output.Resize<uint8>( start + space );
     }
-    else
-    {
-        output.ResizeAt( out, 0 );
+
+    if (res != Z_STREAM_END) {
+        output.Resize<uint8>( start );
         return false;
     }
+
+    output.Resize<uint8>( start + zs->total_out );
+    return true;
 }
@@ -43,22 +43,42 @@ bool IsDeflated( const Buffer& data );
 /**
  * @brief Deflates given data.
  *
- * @param[in,out] data Data to be deflated, overwritten by result.
+ * @param[in,out] data     Data to be deflated, overwritten by result.
+ * @param[in]     level    zlib compression level.
+ * @param[in]     strategy zlib compression strategy.
  *
  * @retval true  Deflation ran successfully.
  * @retval false Error occurred during deflation.
  */
-bool DeflateData( Buffer& data );
+bool DeflateData( Buffer& data, int level = Z_DEFAULT_COMPRESSION, int strategy = Z_DEFAULT_STRATEGY );
 /**
  * @brief Deflates given data.
  *
- * @param[in]  input  Data to be deflated.
- * @param[out] output Destination of deflated data.
+ * @param[in]  input    Data to be deflated.
+ * @param[out] output   Destination of deflated data; result is appended.
+ * @param[in]  level    zlib compression level.
+ * @param[in]  strategy zlib compression strategy.
  *
  * @retval true  Deflation ran successfully.
  * @retval false Error occurred during deflation.
  */
-bool DeflateData( const Buffer& input, Buffer& output );
+bool DeflateData( const Buffer& input, Buffer& output, int level = Z_DEFAULT_COMPRESSION, int strategy = Z_DEFAULT_STRATEGY );
+/**
+ * @brief Deflates given data.
+ *
+ * Uses a deflate stream kept by the calling thread, so the zlib
+ * state is not allocated on every call.
+ *
+ * @param[in]  input    Data to be deflated.
+ * @param[in]  len      Length of data to be deflated.
+ * @param[out] output   Destination of deflated data; result is appended.
+ * @param[in]  level    zlib compression level.
+ * @param[in]  strategy zlib compression strategy.
+ *
+ * @retval true  Deflation ran successfully.
+ * @retval false Error occurred during deflation.
+ */
+bool DeflateData( const uint8* input, size_t len, Buffer& output, int level = Z_DEFAULT_COMPRESSION, int strategy = Z_DEFAULT_STRATEGY );
 
 /**
  * @brief Inflates given data.
@@ -72,29 +92,30 @@ bool InflateData( Buffer& data );
 /**
  * @brief Inflates given data.
  *
- * One of the key things of the ZLIB stuff is that we 'sometimes'
- * don't know the size of the uncompressed data. My idea is to fix
- * this regarding the first phase of the parsing of the data
- * (the parser) is to go trough a couple of output buffer size.
- *
- * The first buffer size would be 2x the initial buffer size,
- * implying that the compression ratio is about 50%.
- * The second buffer size would be 4x the initial buffer size,
- * implying that the compression ratio is about 75%.
- * The third buffer size would be 8x the initial buffer size
- * implying that the compression ratio is about 87.5%.
+ * @param[in]  input    Data to be inflated.
+ * @param[out] output   Destination for inflated data; result is appended.
+ * @param[in]  sizeHint Expected size of inflated data, 0 if unknown.
  *
- * We would go on in this progress until we find buffer size
- * big enough to hold uncompressed data.
+ * @retval true  Inflation ran successfully.
+ * @retval false Failed to inflate data.
+ */
+bool InflateData( const Buffer& input, Buffer& output, size_t sizeHint = 0 );
+/**
+ * @brief Inflates given data.
  *
- * This theory is really stupid because there is no way to actually know.
+ * The size of the inflated data is not stored in the stream, so data
+ * is inflated in a single pass into output, which is grown as needed.
+ * Starting at sizeHint (if known) saves growing it.  Uses an inflate
+ * stream kept by the calling thread.
  *
- * @param[in]  input  Data to be inflated.
- * @param[out] output Destination for inflated data.
+ * @param[in]  input    Data to be inflated.
+ * @param[in]  len      Length of data to be inflated.
+ * @param[out] output   Destination for inflated data; result is appended.
+ * @param[in]  sizeHint Expected size of inflated data, 0 if unknown.
  *
  * @retval true  Inflation ran successfully.
  * @retval false Failed to inflate data.
  */
-bool InflateData( const Buffer& input, Buffer& output );
+bool InflateData( const uint8* input, size_t len, Buffer& output, size_t sizeHint = 0 );
 
 #endif
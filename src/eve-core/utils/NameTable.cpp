@@ -0,0 +1,73 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-core.h"
+
+#include "utils/NameTable.h"
+
+NameTable::NameTable()
+{
+}
+
+uint32 NameTable::Intern( const std::string& name )
+{
+    MutexLock lock( mMutex );
+
+    std::unordered_map<std::string, uint32>::const_iterator itr = mIDs.find( name );
+    if (itr != mIDs.end())
+        return itr->second;
+
+    mNames.push_back( name );
+    const uint32 id = mNames.size();
+    mIDs.insert( std::make_pair( name, id ) );
+    return id;
+}
+
+uint32 NameTable::Find( const std::string& name ) const
+{
+    MutexLock lock( mMutex );
+
+    std::unordered_map<std::string, uint32>::const_iterator itr = mIDs.find( name );
+    if (itr == mIDs.end())
+        return 0;
+
+    return itr->second;
+}
+
+std::string NameTable::GetName( uint32 id ) const
+{
+    MutexLock lock( mMutex );
+
+    if ((id == 0) or (id > mNames.size()))
+        return std::string();
+
+    return mNames[ id - 1 ];
+}
+
+size_t NameTable::GetCount() const
+{
+    MutexLock lock( mMutex );
+    return mNames.size();
+}
@@ -0,0 +1,63 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __UTILS__NAME_TABLE_H__INCL__
+#define __UTILS__NAME_TABLE_H__INCL__
+
+#include "threading/Mutex.h"
+
+/**
+ * @brief Append-only table giving each distinct name a small integer ID.
+ *
+ * IDs start at 1; 0 means the name is not in the table.  Names are never
+ * removed, so IDs stay valid for the lifetime of the table.  GetName()
+ * returns a copy, as the table may grow on another thread.
+ *
+ * @author EVEmu Team
+ */
+class NameTable
+{
+public:
+    NameTable();
+
+    /** @return ID of name; adds name to the table if needed. */
+    uint32 Intern( const std::string& name );
+    /** @return ID of name, 0 if it is not in the table. */
+    uint32 Find( const std::string& name ) const;
+    /** @return Name with given ID; empty string for unknown IDs. */
+    std::string GetName( uint32 id ) const;
+
+    /** @return Number of names in the table. */
+    size_t GetCount() const;
+
+protected:
+    mutable Mutex mMutex;
+
+    std::unordered_map<std::string, uint32> mIDs;
+    // name of ID is at [ID - 1]
+    std::vector<std::string> mNames;
+};
+
+#endif /* !__UTILS__NAME_TABLE_H__INCL__ */
@@ -48,6 +48,7 @@
 #include "system/DestinyManager.h"
 #include "system/SystemManager.h"
 #include "system/SystemBubble.h"
+#include "system/SystemTicPool.h"
 #include "system/cosmicMgrs/AnomalyMgr.h"
 #include "exploration/Scan.h"
 #include "station/Station.h"
@@ -684,6 +685,14 @@ void Client::MoveToLocation(uint32 locationID, const GPoint& pt) {
         return;
     }
 
+    // location changes boot and leave systems, so must not run inside pooled system tics.
+    //  deferred calls run in this same EntityList::Process() pass, so this client is still valid.
+    if (SystemTicPool::InTic()) {
+        GPoint pos(pt);
+        sEntityList.Defer([this, locationID, pos] () { MoveToLocation(locationID, pos); });
+        return;
+    }
+
     _log(AUTOPILOT__TRACE, "MoveToLocation() - m_autoPilot = %s", (m_autoPilot ? "true" : "false"));
 
     if (!m_login and (m_locationID == locationID) and !IsStation(locationID)) {
@@ -1245,6 +1254,12 @@ void Client::ResetAfterPodded() {
      * reset skill effects if clone != current SP and skills lost
      */
 
+    // pods die in system tics.  the new ship is spawned at the clone station, so wait for the move
+    if (SystemTicPool::InTic()) {
+        sEntityList.Defer([this] () { ResetAfterPodded(); });
+        return;
+    }
+
     m_autoPilot = false;
 
     MoveToLocation(GetCloneStationID(), NULL_ORIGIN);
@@ -2166,6 +2181,18 @@ void Client::SendNotification(const PyAddress &dest, EVENotificationStream &noti
     QueuePacket(packet);
 }
 
+void Client::SendNotification(const MarshaledNotification& noti, bool seq/*true*/) {
+    // only userid and sequence number differ between recipients
+    PyDict* named(nullptr);
+    if (seq) {
+        named = new PyDict();
+        named->SetItemString("sn", new PyInt(++m_nextNotifySequence));
+    }
+
+    QueueNotification(noti, GetUserID(), named);
+    PySafeDecRef(named);
+}
+
 /************************************************************************/
 /* EVEAdministration Interface                                          */
 /************************************************************************/
@@ -2547,7 +2574,7 @@ bool Client::Handle_CallReq(PyPacket* packet, PyCallStream& req)
 
     //parts of call may be consumed here
     m_canThrow = true;      // test for throwable.  -allan 29Jul16      should we use try/catch here?   yes
-    PyResult result(dest->Call(req.method, args));
+    PyResult result(dest->Call(req.method, req.methodID, args));
     m_canThrow = false;
 
     SendSessionChange();  //send out the session change before the return.
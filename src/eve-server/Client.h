@@ -424,6 +424,8 @@ public:
     void SendNotification(const PyAddress &dest, EVENotificationStream &noti, bool seq=true);
     void SendNotification(const char *notifyType, const char *idType, PyTuple *payload, bool seq=true);
     void SendNotification(const char *notifyType, const char *idType, PyTuple **payload, bool seq=true);
+    // queues notification marshaled once for multiple clients (see EntityList::Multicast)
+    void SendNotification(const MarshaledNotification& noti, bool seq=true);
 
     // this is to check Throw status, to avoid throws/segfault when not applicable  (should use try/catch block)
     bool CanThrow()                                     { return m_canThrow; }
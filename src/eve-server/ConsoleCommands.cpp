@@ -92,12 +92,12 @@ bool ConsoleCommand::Process() {
                 sLog.Warning("      (b)roadcast", " Broadcasts a message to all clients thru the LocalChat window.  *Not Implemented*");
                 sLog.Warning("           (n)ote", " Broadcasts a message to all clients thru a notification window.");
                 sLog.Warning("        (m)essage", " Broadcasts a message to all clients thru a message window.");
-                sLog.Warning("        (p)rofile", " Prints a profile of current server runtimes.  *Incomplete*");
+                sLog.Warning("        (p)rofile", " Prints a profile of current server runtimes.  'pr' also resets the profile.");
                 sLog.Warning("          r(o)les", " Prints a list of common roles and their values.");
                 sLog.Warning("       c(o)mmands", " Prints a list of currently loaded Commands and their required role. (long list)");
                 sLog.Warning("           (t)est", " Prints the current test object *varies*");
                 sLog.Warning("        e(f)fects", " Compiles and prints all item effects.");
-                sLog.Warning("        threa(d)s", " Prints a list of current threads.");
+                sLog.Warning("        threa(d)s", " Prints a list of current threads and network reactor counters.");
                 sLog.Warning("    reload (l)ogs", " Reloads log.ini to change values without restarting server.");
                 sLog.Warning("(q)uery stat data", " Prints current statistic data.");
                 sLog.Warning("       hea(r) all", " Echo all chat msgs to console. *Not Implemented*");
@@ -233,6 +233,7 @@ bool ConsoleCommand::Process() {
                 sLog.Warning("  Console Command", " Modal Message sent to all online clients." );
             } else if (strncmp(buf, "p", 1) == 0) {
                 sLog.Green("  EVEmu", "Server Profile:");
+                sTickScheduler.PrintStats();
                 if (sConfig.debug.UseProfiling) {
                     sLog.Warning("    Current Stamp", " %u", sEntityList.GetStamp());
                     std::string uptime;
@@ -241,6 +242,10 @@ bool ConsoleCommand::Process() {
                     sLog.Warning("      Connections", " %u Current Clients Online.", sEntityList.GetClientCount());
                     sLog.Warning("      Connections", " %u Clients Connected since startup.", sEntityList.GetConnections() );
                     sProfiler.PrintProfile();
+                    if (buf[1] == 'r') {
+                        sProfiler.ClearAll();
+                        sLog.Warning("   Server Profile", "Profile has been reset.");
+                    }
                 } else {
                     sLog.Error("   Server Profile", "Profiling is turned off.");
                 }
@@ -281,6 +286,10 @@ bool ConsoleCommand::Process() {
                 } else {
                     sThread.ListThreads();
                 }
+                sNetReactor.PrintStats();
+                sDatabase.PrintPoolStats();
+                sLogWriter.PrintStats();
+                SystemEntity::PrintCacheStats();
             } else if (strncmp(buf, "l", 1) == 0) {
                 /*
                 sLog.~NewLog();
@@ -413,6 +422,12 @@ void ConsoleCommand::FxProc(uint8 idx/*0*/) {
             std::printf("\n");     // spacer
             ItemDB::GetItems(EVEDB::invCategories::Ship, typeIDs);
         } break;
+        case 8: {
+            sLog.Green("        FxProcess", "Verifying Compiled Effects against Parsed Effects for All Types.");
+            std::printf("\n");     // spacer
+            sFxProc.VerifyPrograms();
+            return;
+        } break;
         case 9: {
             sLog.Green("        FxProcess", "Parsing Effects for All Possible Items.");
             std::printf("\n");     // spacer
@@ -426,7 +441,7 @@ void ConsoleCommand::FxProc(uint8 idx/*0*/) {
         default: {
             sLog.Green("        FxProcess", "Usage of Item Fx process reporting.");
             sLog.Green("        FxProcess", "fx where 'x' is a number corresponding to the item category you wish to process.");
-            sLog.Green("        FxProcess", "1=Modules, 2=Charges, 3=Subsystems, 4=Skills, 5=Implants/Boosters, 6=Ships, 9=all");
+            sLog.Green("        FxProcess", "1=Modules, 2=Charges, 3=Subsystems, 4=Skills, 5=Implants/Boosters, 6=Ships, 9=all, 8=verify compiled effects");
             return;
         }
     }
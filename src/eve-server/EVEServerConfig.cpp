@@ -76,6 +76,7 @@ EVEServerConfig::EVEServerConfig()
     world.StationDockDelay = 4 /*s*/;
     world.apWarptoDistance = 15000;
     world.shipBoardDistance = 300;
+    world.saveInterval = 10 /*m*/;
 
     // rates
     rates.npcBountyMultiply = 1.0;
@@ -171,6 +172,7 @@ EVEServerConfig::EVEServerConfig()
     cosmic.WormHoleEnabled = false;
     cosmic.CiviliansEnabled = false;
     cosmic.BumpEnabled = false;
+    cosmic.BatchedMovement = false;
 
     // exploring
     exploring.Gravametric = 5;
@@ -248,10 +250,14 @@ EVEServerConfig::EVEServerConfig()
     // files
     files.logDir = "../log/";
     files.logSettings = "../etc/log.ini";
+    files.logAsync = false;
+    files.logRotateSize = 0;
+    files.logRotateTime = 0;
     files.cacheDir = "../server_cache/";
     files.imageDir = "../image_cache/";
 
     // net
+    net.useReactor = true;
     net.port = 26000;
     net.imageServer = "localhost";
     net.imageServerPort = 26001;
@@ -260,8 +266,8 @@ EVEServerConfig::EVEServerConfig()
     threads.ConsoleThreads = 1;//P
     threads.DatabaseThreads = 2;//N
     threads.ImageServerThreads = 1;//N
-    threads.NetworkThreads = 2;//N
-    threads.WorldThreads = 2;//N
+    threads.NetworkThreads = 2;
+    threads.WorldThreads = 0;
 
 }
 
@@ -376,6 +382,7 @@ bool EVEServerConfig::ProcessWorld( const TiXmlElement* ele )
     AddValueParser( "StationDockDelay",  world.StationDockDelay );
     AddValueParser( "apWarptoDistance",  world.apWarptoDistance );
     AddValueParser( "shipBoardDistance", world.shipBoardDistance );
+    AddValueParser( "saveInterval",      world.saveInterval );
 
     const bool result = ParseElementChildren( ele );
 
@@ -391,6 +398,7 @@ bool EVEServerConfig::ProcessWorld( const TiXmlElement* ele )
     RemoveParser( "StationDockDelay" );
     RemoveParser( "apWarptoDistance" );
     RemoveParser( "shipBoardDistance" );
+    RemoveParser( "saveInterval" );
 
     return result;
 }
@@ -626,6 +634,9 @@ bool EVEServerConfig::ProcessFiles( const TiXmlElement* ele )
 {
     AddValueParser( "logDir",           files.logDir );
     AddValueParser( "logSettings",      files.logSettings );
+    AddValueParser( "logAsync",         files.logAsync );
+    AddValueParser( "logRotateSize",    files.logRotateSize );
+    AddValueParser( "logRotateTime",    files.logRotateTime );
     AddValueParser( "cacheDir",         files.cacheDir );
     AddValueParser( "imageDir",         files.imageDir );
 
@@ -633,6 +644,9 @@ bool EVEServerConfig::ProcessFiles( const TiXmlElement* ele )
 
     RemoveParser( "logDir" );
     RemoveParser( "logSettings" );
+    RemoveParser( "logAsync" );
+    RemoveParser( "logRotateSize" );
+    RemoveParser( "logRotateTime" );
     RemoveParser( "cacheDir" );
     RemoveParser( "imageDir" );
 
@@ -641,12 +655,14 @@ bool EVEServerConfig::ProcessFiles( const TiXmlElement* ele )
 
 bool EVEServerConfig::ProcessNet( const TiXmlElement* ele )
 {
+    AddValueParser( "useReactor",       net.useReactor );
     AddValueParser( "port",             net.port );
     AddValueParser( "imageServerPort",  net.imageServerPort);
     AddValueParser( "imageServer",      net.imageServer);
 
     const bool result = ParseElementChildren( ele );
 
+    RemoveParser( "useReactor" );
     RemoveParser( "port" );
     RemoveParser( "imageServerPort" );
     RemoveParser( "imageServer" );
@@ -685,6 +701,7 @@ bool EVEServerConfig::ProcessCosmic( const TiXmlElement* ele )
     AddValueParser( "WormHoleEnabled",      cosmic.WormHoleEnabled );
     AddValueParser( "CiviliansEnabled",     cosmic.CiviliansEnabled);
     AddValueParser( "BumpEnabled",          cosmic.BumpEnabled );
+    AddValueParser( "BatchedMovement",      cosmic.BatchedMovement );
 
     const bool result = ParseElementChildren( ele );
 
@@ -698,6 +715,7 @@ bool EVEServerConfig::ProcessCosmic( const TiXmlElement* ele )
     RemoveParser( "WormHoleEnabled" );
     RemoveParser( "CiviliansEnabled" );
     RemoveParser( "BumpEnabled" );
+    RemoveParser( "BatchedMovement" );
 
     return result;
 }
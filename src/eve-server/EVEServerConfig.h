@@ -81,6 +81,7 @@ public:
         uint16 shipBoardDistance;
         uint16 gridUnloadTime;
         uint16 apWarptoDistance;
+        uint16 saveInterval;        // minutes between checkpoints of changed items.  0 = save on shutdown only
     } world;
 
     // From <rates>
@@ -226,6 +227,12 @@ public:
         std::string logDir;
         /// A log configuration file.
         std::string logSettings;
+        /// Write log output on a background thread, instead of the thread logging.  off by default; output queued at a crash is lost.
+        bool logAsync;
+        /// Size in MB after which logfile is rotated.  0 = never
+        uint32 logRotateSize;
+        /// Age in minutes after which logfile is rotated.  0 = never
+        uint32 logRotateTime;
         /// A directory at which the cache files should be stored.
         std::string cacheDir;
         // used as the base directory for the image server
@@ -234,6 +241,8 @@ public:
 
     // From <net>
     struct {
+        /// Drive client sockets from the epoll reactor pool (threads.NetworkThreads) instead of a thread per client.
+        bool useReactor;
         /// Port at which the server should listen.
         uint16 port;
         /// Port at which the imageServer should listen.
@@ -260,6 +269,7 @@ public:
         bool WormHoleEnabled;
         bool CiviliansEnabled;
         bool BumpEnabled;
+        bool BatchedMovement;
         uint8 BeltRespawn;
         uint8 BeltGrowth;
         float roidRadiusMultiplier;
@@ -50,9 +50,6 @@
 
 EntityList::EntityList()
 : m_services( nullptr ),
-m_targTimer(0, true),
-m_stampTimer(0, true),
-m_minuteTimer(0, true),
 m_startTime(0),
 m_npcs(0),
 m_stamp(1000),   /* arbitrary.  start at 1k.  in seconds.  used for destiny and client counters */
@@ -79,17 +76,18 @@ EntityList::~EntityList() {
 void EntityList::Initialize() {
     m_startTime = GetFileTimeNow();
 
-    /* start the timers */
-    m_targTimer.Start(250);     // testing targeting and scan probes at 4/sec
-    m_stampTimer.Start(1000);   // 1hz tic timer
-    m_minuteTimer.Start(60000); // does this need to be accurate?
-
     m_clientSeedID = ServiceDB::SetClientSeed();
     sLog.Green( "       ServerInit", "ClientSeed Initialized." );
 
     if (is_log_enabled(SERVER__STACKTRACE))
         sConfig.debug.StackTrace = true;
 
+    if (m_ticPool.Initialize(sConfig.threads.WorldThreads)) {
+        sLog.Warning("       EntityList", "Processing systems on %u threads.  This is experimental.", m_ticPool.GetThreadCount());
+    } else {
+        sLog.Blue("       EntityList", "Processing systems on main thread.");
+    }
+
     sLog.Blue("       EntityList", "Entity Manager Initialized.");
 }
 
@@ -115,6 +113,8 @@ void EntityList::Close()
                     m_clients.size(), m_systems.size(), m_agents.size(), m_stations.size());
     }
 
+    m_ticPool.Shutdown();
+
     for (auto cur : m_clients)
         SafeDelete(cur);
 
@@ -198,7 +198,8 @@ void EntityList::Process() {
         }
     }
 
-    if (m_targTimer.Check()) {
+    // target and probe tics run at 4Hz, offset from the 1Hz tic
+    if (sTickScheduler.IsDue(250, 125)) {
         std::unordered_map<SystemEntity*, TargetManager*>::iterator titr = m_targMgrs.begin();
         while (titr != m_targMgrs.end()) {
             if (titr->second->Process()) {
@@ -217,8 +218,8 @@ void EntityList::Process() {
         }
     }
 
-    /* check for 1Hz timer tic */
-    if (m_stampTimer.Check()) {
+    /* check for 1Hz tic */
+    if (sTickScheduler.IsDue(1000)) {
         double profileStartTime = GetTimeUSeconds();
 
         ++m_stamp;
@@ -227,64 +228,123 @@ void EntityList::Process() {
             if (cur.second->IsValidSession())   // verify client is constructed before calling ProcessClient() on it
                 cur.second->ProcessClient();
 
-    /** @todo test for adding OpenMP here to enable MP per system. */
-    // this wont work....possibility of removing systems, therefore invalidating the iterator.
-    // bad things can happen if this is running parallel on MP
-    //#pragma omp parallel  // starts a new team
+        /* tic a snapshot of loaded systems, so systems booted during this tic dont invalidate it.
+         *  idle systems are unloaded after all tics are done, as is anything the tics deferred.
+         */
+        std::vector<SystemManager*> systems;
+        systems.reserve(m_systems.size());
         std::map<uint32, SystemManager*>::iterator itr = m_systems.begin();
         while (itr != m_systems.end()) {
             if (itr->second == nullptr) { /* this shouldnt happen.  log error to make note */
                 sLog.Error(" EntityList::Proc", "Deleting System %u", itr->first);
                 itr = m_systems.erase(itr);
                 continue;
-            } else if (!itr->second->ProcessTic()) {    /* Process each loaded system */
-                itr->second->UnloadSystem();
-                SafeDelete(itr->second);
-                itr = m_systems.erase(itr);
-                continue;
             }
+            systems.push_back(itr->second);
             ++itr;
         }
 
+        std::vector<uint8> results;
+        if (m_ticPool.IsRunning()) {
+            m_ticPool.Run(systems, results);
+        } else {
+            results.reserve(systems.size());
+            for (auto cur : systems)
+                results.push_back(cur->ProcessTic() ? 1 : 0);
+        }
+
+        RunDeferred();
+
+        for (size_t i = 0; i < systems.size(); ++i) {
+            if (results[i])
+                continue;
+            m_systems.erase(systems[i]->GetID());
+            systems[i]->UnloadSystem();
+            SafeDelete(systems[i]);
+        }
+
         // these need 1Hz tics
         sCivMgr.Process();
         sBubbleMgr.Process();
 
-        // these minute tics do not need to be precise
-        if (m_minuteTimer.Check()) {
+        /* periodic jobs.  each runs on its own second of its period, so they dont all land on the same tic */
+        const uint32 seconds(m_stamp - 1000);
+        if (seconds % 60 == 0)
             ++m_minutes;
+        if (seconds % 60 == 7)
             sMissionDataMgr.Process();  // 1m
-
-            if (m_minutes % 5 == 0) { // ~5m
-                sWHMgr.Process();
-                // write something to tic corps vote cases.
-                for (auto cur : m_systems)
-                    cur.second->UpdateData();   // update active system timers and dynamic data every 5m
-            }
-            if (m_minutes % 15 == 0) { // ~15m
-                //sMktBotMgr.Process();  // 15m to 30m
-                sConsole.UpdateStatus();
-            }
-            if (m_minutes % 60 == 0) { // ~1h
-                MapDB::ManipulateTimeData();
-                sMktMgr.Process();  // not used - does nothing at this time
-            }
+        if (seconds % 300 == 23) {
+            sWHMgr.Process();   // 5m
+            // write something to tic corps vote cases.
+        }
+        // update active system timers and dynamic data every 5m, spread over the 5m by systemID
+        for (auto cur : m_systems)
+            if (cur.first % 300 == seconds % 300)
+                cur.second->UpdateData();
+        if (seconds % 900 == 41) {
+            //sMktBotMgr.Process();  // 15m to 30m
+            sConsole.UpdateStatus();    // 15m
         }
+        if (sConfig.world.saveInterval > 0)
+            if (seconds % (sConfig.world.saveInterval * 60) == 37)
+                sItemFactory.SaveItems();   // 10m default.  writes only changed items
+        if (seconds % 3600 == 53)
+            MapDB::ManipulateTimeData();    // 1h
+        if (seconds % 3600 == 1853)
+            sMktMgr.Process();  // 1h  not used - does nothing at this time
 
         if (sConfig.debug.UseProfiling)
             sProfiler.AddTime(Profile::entityS, GetTimeUSeconds() - profileStartTime);
     }
 }
 
+void EntityList::Defer(std::function<void()> fn)
+{
+    if (!SystemTicPool::InTic()) {
+        fn();
+        return;
+    }
+
+    MutexLock lock(mMutex);
+    m_deferred.push_back(fn);
+}
+
+void EntityList::RunDeferred()
+{
+    // writes first, as deferred calls may read them back
+    sDatabase.RunDeferredWrites();
+
+    std::vector<std::function<void()>> deferred;
+    {
+        MutexLock lock(mMutex);
+        deferred.swap(m_deferred);
+    }
+
+    for (auto& cur : deferred)
+        cur();
+}
+
 SystemManager* EntityList::FindOrBootSystem(uint32 systemID) {
     if (!IsSolarSystem(systemID)) {
         _log(SERVER__INIT_ERR, "BootSystem() called with invalid systemID (%u)", systemID);
         return nullptr;
     }
 
-    std::map<uint32, SystemManager*>::iterator itr = m_systems.find(systemID);
-    if (itr != m_systems.end())
-        return itr->second;
+    {
+        MutexLock lock(mMutex);
+        std::map<uint32, SystemManager*>::iterator itr = m_systems.find(systemID);
+        if (itr != m_systems.end())
+            return itr->second;
+    }
+
+    /* systems are only booted from the main thread, while the tic pool is idle.
+     *  location changes made in pooled tics are deferred, so nothing there should need a new system.
+     *  booting takes ItemFactory's lock, so the list lock is not held while booting.
+     */
+    if (SystemTicPool::InTic()) {
+        _log(SERVER__INIT_ERR, "BootSystem() - system %u is not loaded and cannot be booted during a system tic", systemID);
+        return nullptr;
+    }
 
     SystemManager* pSM = new SystemManager(systemID, *m_services);
     if ((pSM == nullptr) or (!pSM->BootSystem())) {
@@ -294,6 +354,7 @@ SystemManager* EntityList::FindOrBootSystem(uint32 systemID) {
     }
 
     _log(SERVER__INIT, "BootSystem() - Booted system %u", systemID);
+    MutexLock lock(mMutex);
     m_systems[systemID] = pSM;
     return pSM;
 }
@@ -586,12 +647,12 @@ void EntityList::CorpNotify(uint32 corpID, uint8 bCastType, const char* notifyTy
         } break;
     }
 
-    for (auto cur : cMap) {
-        PyIncRef(payload);
-        cur.second->SendNotification( notifyType, idType, payload, false );   // are any of these sequenced?
-    }
+    std::vector<Client*> cVec;
+    cVec.reserve(cMap.size());
+    for (auto cur : cMap)
+        cVec.push_back(cur.second);
 
-    PyDecRef(payload);
+    Multicast(cVec, notifyType, idType, &payload, false);   // are any of these sequenced?
 }
 
 void EntityList::Broadcast(const char* notifyType, const char* idType, PyTuple** payload) const {
@@ -610,17 +671,20 @@ void EntityList::Broadcast(const char* notifyType, const char* idType, PyTuple**
 }
 
 void EntityList::Broadcast(const PyAddress &dest, EVENotificationStream &noti) const {
-    for (auto cur : m_players)
-        cur.second->SendNotification(dest, noti);
+    std::vector<Client*> cVec;
+    GetClients(cVec);
+    Multicast(cVec, dest, noti);
 }
 
 void EntityList::Multicast(const character_set &cset, const PyAddress &dest, EVENotificationStream &noti) const {
+    std::vector<Client*> cVec;
     std::map<uint32, Client*>::const_iterator itr = m_players.begin();
     for (auto cur : cset) {
         itr = m_players.find(cur);
         if (itr != m_players.end())
-            itr->second->SendNotification(dest, noti);
+            cVec.push_back(itr->second);
     }
+    Multicast(cVec, dest, noti);
 }
 
 // updated to remove looping thru entire client list for each call....still needs work
@@ -657,12 +721,7 @@ void EntityList::Multicast( const char* notifyType, const char* idType, PyTuple*
         } break;
     };
 
-    for (auto cur : cVec) {
-        PyIncRef(payload);
-        cur->SendNotification( notifyType, idType, &payload, seq );
-    }
-
-    PyDecRef( payload );
+    Multicast(cVec, notifyType, idType, &payload, seq);
 }
 
 // updated.  so much better this way.
@@ -672,19 +731,16 @@ void EntityList::Multicast(const char* notifyType, const char* idType, PyTuple**
     PyTuple* payload = *in_payload;
     in_payload = nullptr;
 
+    std::vector<Client*> cVec;
     if (!mcset.characters.empty())
         for (auto cur : mcset.characters) {
             std::map<uint32, Client*>::iterator itr = m_players.find(cur);
-            if ( itr != m_players.end()) {
-                PyIncRef(payload);
-                itr->second->SendNotification( notifyType, idType, &payload, seq );
-            }
+            if ( itr != m_players.end())
+                cVec.push_back(itr->second);
         }
 
     if (!mcset.locations.empty()) {
         SystemManager* pSysMgr(nullptr);
-        std::vector<Client*> cVec;
-        cVec.clear();
         for (auto cur : mcset.locations) {
             if (IsStation(cur)) {
                 GetStationGuestList(cur, cVec);
@@ -698,10 +754,6 @@ void EntityList::Multicast(const char* notifyType, const char* idType, PyTuple**
                 EvE::traceStack();
             }
         }
-        for (auto cur : cVec) {
-            PyIncRef(payload);
-            cur->SendNotification( notifyType, idType, &payload, seq );
-        }
     }
 
     // this will need list of interested parties from corp.  update this call to use CorpNotify() where possible.
@@ -714,14 +766,13 @@ void EntityList::Multicast(const char* notifyType, const char* idType, PyTuple**
                 continue;
             corpRole::const_iterator itr = cItr->second.begin();
             while (itr != cItr->second.end()) {
-                PyIncRef(payload);
-                itr->first->SendNotification( notifyType, idType, &payload, seq );
+                cVec.push_back(itr->first);
                 ++itr;
             }
         }
     }
 
-    PyDecRef( payload );
+    Multicast(cVec, notifyType, idType, &payload, seq);
 }
 
 void EntityList::Multicast(const character_set &cset, const char* notifyType, const char* idType, PyTuple** in_payload, bool seq) const
@@ -730,15 +781,79 @@ void EntityList::Multicast(const character_set &cset, const char* notifyType, co
     PyTuple* payload = *in_payload;
     in_payload = nullptr;
 
+    std::vector<Client*> cVec;
     std::map<uint32, Client*>::const_iterator itr = m_players.begin();
     for (auto cur : cset) {
         itr = m_players.find(cur);
-        if (itr != m_players.end()) {
-            PyIncRef(payload);
-            itr->second->SendNotification(notifyType, idType, &payload, seq);
-        }
+        if (itr != m_players.end())
+            cVec.push_back(itr->second);
+    }
+
+    Multicast(cVec, notifyType, idType, &payload, seq);
+}
+
+void EntityList::Multicast(const std::vector<Client*>& cVec, const char* notifyType, const char* idType, PyTuple** in_payload, bool seq) const
+{
+    // consume payload
+    PyTuple* payload = *in_payload;
+    in_payload = nullptr;
+
+    if (cVec.empty()) {
+        PyDecRef( payload );
+        return;
     }
-    PyDecRef( payload );
+
+    //build a little notification out of it.
+    EVENotificationStream notify;
+        notify.notifyType = notifyType;
+        notify.remoteObject = 1;
+        notify.args = payload;      // consumed by notify
+
+    PyAddress dest;
+        dest.type = PyAddress::Broadcast;
+        dest.service = notifyType;
+        dest.bcast_idtype = idType;
+
+    Multicast(cVec, dest, notify, seq);
+}
+
+void EntityList::Multicast(const std::vector<Client*>& cVec, const PyAddress &dest, EVENotificationStream &noti, bool seq) const
+{
+    if (cVec.empty())
+        return;
+
+    // nothing to share with a single recipient
+    if (cVec.size() == 1) {
+        cVec.front()->SendNotification(dest, noti, seq);
+        return;
+    }
+
+    // marshal (and deflate, if needed) the notification once; each client only adds its userid and sequence number
+    PyAddress source;
+        source.type = PyAddress::Node;
+        source.objectID = m_services->GetNodeID();
+
+    MarshaledNotificationRef pNoti(new MarshaledNotification(source, dest, noti));
+    if (!pNoti->IsValid()) {
+        sLog.Error("EntityList::Multicast", "Failed to marshal notify of type %s.", dest.service.c_str());
+        return;
+    }
+
+    _log(CLIENT__NOTIFY_REP, "Multicast notify of type %s with ID type %s to %lu clients (%lu bytes shared%s)", \
+            dest.service.c_str(), dest.bcast_idtype.c_str(), cVec.size(), pNoti->GetMarshaledSize(), pNoti->IsDeflated() ? ", deflated" : "");
+
+    // recipients may be in other systems; queue them from the main thread if called from a parallel tic
+    if (SystemTicPool::InTic()) {
+        std::vector<Client*> clients(cVec);
+        sEntityList.Defer([clients, pNoti, seq] () {
+            for (auto cur : clients)
+                cur->SendNotification(*pNoti, seq);
+        });
+        return;
+    }
+
+    for (auto cur : cVec)
+        cur->SendNotification(*pNoti, seq);
 }
 
 void EntityList::Unicast(uint32 charID, const char* notifyType, const char* idType, PyTuple** payload, bool seq) {
@@ -34,6 +34,7 @@
 #include "eve-common.h"
 #include "utils/Singleton.h"
 #include "threading/Mutex.h"
+#include "system/SystemTicPool.h"
 
 class Agent;
 class Client;
@@ -79,13 +80,19 @@ public:
     void AddPlayer(Client* pClient);
     //  this must only be called for a logged-in character.
     void RemovePlayer(Client* pClient);
-    void AddNPC()                                       { ++m_npcs; }
-    void RemoveNPC()                                    { --m_npcs; }
+    void AddNPC()                                       { MutexLock lock(mMutex); ++m_npcs; }
+    void RemoveNPC()                                    { MutexLock lock(mMutex); --m_npcs; }
     void SetService(PyServiceMgr* svc)                  { m_services = svc; }
 
     // updated to use station guest list instead of full clientlist loop
     void GetStationGuestList(uint32 stationID, std::vector<Client* > &result) const;
 
+    /* queues fn to run on the main thread once all systems have finished their tic, if called
+     *  from a system tic running on the tic pool.  otherwise fn is run immediately.
+     * use this for anything touching other systems or clients outside the calling system.
+     */
+    void Defer(std::function<void()> fn);
+
     // for main loop thread sleeping
     bool HasClients()                                   { return !m_players.empty(); }
 
@@ -147,30 +154,32 @@ public:
     void Multicast(const character_set &cset, const PyAddress &dest, EVENotificationStream &noti) const;
     void Multicast(const character_set &cset, const char* notifyType, const char* idType, PyTuple** payload, bool seq=true) const;
     void Unicast(uint32 charID, const char* notifyType, const char* idType, PyTuple** payload, bool seq=true);
+    // these marshal the notification once and queue the shared packet to every client in cVec
+    void Multicast(const std::vector<Client*>& cVec, const char* notifyType, const char* idType, PyTuple** payload, bool seq=true) const;
+    void Multicast(const std::vector<Client*>& cVec, const PyAddress &dest, EVENotificationStream &noti, bool seq=true) const;
 
     //testing target tics in <1hz
     // add SE* and targMgr* to map
     void AddTargMgr(SystemEntity* pSE, TargetManager* pTM)
-                                                        { m_targMgrs.emplace(pSE, pTM); }
+                                                        { MutexLock lock(mMutex); m_targMgrs.emplace(pSE, pTM); }
     // remove SE* and targMgr* from map
-    void DeleteTargMgr(SystemEntity* pSE)               { m_targMgrs.erase(pSE); }
+    void DeleteTargMgr(SystemEntity* pSE)               { MutexLock lock(mMutex); m_targMgrs.erase(pSE); }
 
     // add ProbeSE* to map
-    void AddProbe(uint32 probeID, ProbeSE* pSE)         { m_probes[probeID] = pSE; }
+    void AddProbe(uint32 probeID, ProbeSE* pSE)         { MutexLock lock(mMutex); m_probes[probeID] = pSE; }
     // remove ProbeSE* from map
-    void RemoveProbe(uint32 probeID)                    { m_probes.erase(probeID); }
+    void RemoveProbe(uint32 probeID)                    { MutexLock lock(mMutex); m_probes.erase(probeID); }
 
 
 protected:
     PyServiceMgr* m_services;    //we do not own this, only used for booting systems.
 
+    // guards members which system tics running on the tic pool may change
     Mutex mMutex;
 
-private:
-    Timer m_stampTimer;
-    Timer m_minuteTimer;
-    Timer m_targTimer;
+    void RunDeferred();
 
+private:
     // connected clients (incomplete client class data)
     //  use this to delete Client*
     std::vector<Client*> m_clients;
@@ -188,6 +197,11 @@ private:
     // also running scan probes at sub-hz tics
     std::map<uint32, ProbeSE*> m_probes;
 
+    // runs system tics in parallel when threads.WorldThreads > 1
+    SystemTicPool m_ticPool;
+    // actions queued by Defer() during the parallel tic
+    std::vector<std::function<void()>> m_deferred;
+
     // make list for corp members and their roles for easy access of notifications etc.
     typedef std::map<Client*, int64> corpRole;
     std::map<uint32, corpRole> m_corpMembers;     //corpID/{Client*/corpRole}
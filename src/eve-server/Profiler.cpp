@@ -10,10 +10,132 @@
 #include "EVEServerConfig.h"
 #include "../eve-core/utils/misc.h"
 
-Profiler::Profiler() { }
+/* histogram layout.  see ProfileHistogram */
+static const uint8 HIST_SUB_BITS = 5;
+static const uint64_t HIST_SUB_COUNT = 1 << HIST_SUB_BITS;
+static const uint8 HIST_MAX_BITS = 40;
+static const uint64_t HIST_MAX_VALUE = (1ULL << HIST_MAX_BITS) - 1;
+static const size_t HIST_BUCKETS = HIST_SUB_COUNT * (HIST_MAX_BITS - HIST_SUB_BITS + 1);
+static const double HIST_SCALE = 1000.0;
+
+static size_t GetBucket(uint64_t value)
+{
+    if (value < HIST_SUB_COUNT)
+        return value;
+    if (value > HIST_MAX_VALUE)
+        value = HIST_MAX_VALUE;
+
+    // top HIST_SUB_BITS bits of value select the sub-bucket within its power of two
+    const uint8 shift(63 - __builtin_clzll(value) - HIST_SUB_BITS);
+    return HIST_SUB_COUNT + shift * HIST_SUB_COUNT + ((value >> shift) - HIST_SUB_COUNT);
+}
+
+static double GetBucketValue(size_t bucket)
+{
+    if (bucket < HIST_SUB_COUNT)
+        return bucket;
+
+    // middle of the bucket's range
+    const uint8 shift((bucket - HIST_SUB_COUNT) / HIST_SUB_COUNT);
+    const uint64_t lower(((bucket - HIST_SUB_COUNT) % HIST_SUB_COUNT + HIST_SUB_COUNT) << shift);
+    return lower + ((1ULL << shift) - 1) / 2.0;
+}
+
+ProfileHistogram::ProfileHistogram(const std::string& name, const std::string& unit)
+: m_name(name),
+m_unit(unit),
+m_buckets(HIST_BUCKETS, 0)
+{
+    Clear();
+}
+
+void ProfileHistogram::Add(double value)
+{
+    if (value < 0)
+        value = 0;
+
+    ++m_buckets[GetBucket((uint64_t)(value * HIST_SCALE))];
+    if ((m_count == 0) or (value < m_min))
+        m_min = value;
+    if (value > m_max)
+        m_max = value;
+    m_sum += value;
+    ++m_count;
+}
+
+void ProfileHistogram::Clear()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_min = 0.0;
+    m_max = 0.0;
+    m_start = GetTimeMSeconds();
+}
+
+double ProfileHistogram::GetPercentile(double pct) const
+{
+    if (m_count == 0)
+        return 0.0;
+
+    int64 target = (int64)std::ceil(pct / 100.0 * m_count);
+    if (target < 1)
+        target = 1;
+    if (target >= m_count)
+        return m_max;
+
+    int64 seen(0);
+    for (size_t i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= target)
+            return std::max(m_min, std::min(m_max, GetBucketValue(i) / HIST_SCALE));
+    }
+
+    return m_max;
+}
+
+double ProfileHistogram::GetSpan() const
+{
+    return (GetTimeMSeconds() - m_start) / 1000.0;
+}
+
+
+Profiler::Profiler()
+{
+    // built-in keys.  these are printed in their own sections by PrintProfile()
+    m_keys.resize(Profile::count, nullptr);
+    m_keys[Profile::destiny]    = new ProfileHistogram("Destiny", "us");
+    m_keys[Profile::map]        = new ProfileHistogram("Map", "us");
+    m_keys[Profile::client]     = new ProfileHistogram("Client", "us");
+    m_keys[Profile::npc]        = new ProfileHistogram("NPC", "us");
+    m_keys[Profile::bubbles]    = new ProfileHistogram("Bubble", "us");
+    m_keys[Profile::items]      = new ProfileHistogram("Item", "us");
+    m_keys[Profile::modules]    = new ProfileHistogram("Module", "us");
+    m_keys[Profile::functions]  = new ProfileHistogram("Function", "us");
+    m_keys[Profile::db]         = new ProfileHistogram("DB", "us");
+    m_keys[Profile::ship]       = new ProfileHistogram("Ship", "us");
+    m_keys[Profile::targets]    = new ProfileHistogram("Target", "us");
+    m_keys[Profile::server]     = new ProfileHistogram("Server", "us");
+    m_keys[Profile::missile]    = new ProfileHistogram("Missile", "us");
+    m_keys[Profile::system]     = new ProfileHistogram("System", "us");
+    m_keys[Profile::entityS]    = new ProfileHistogram("EntityTic", "us");
+    m_keys[Profile::loot]       = new ProfileHistogram("Loot", "us");
+    m_keys[Profile::salvage]    = new ProfileHistogram("Salvage", "us");
+    m_keys[Profile::spawn]      = new ProfileHistogram("Spawn", "us");
+    m_keys[Profile::collision]  = new ProfileHistogram("Collision", "us");
+    m_keys[Profile::drone]      = new ProfileHistogram("Drone", "us");
+    m_keys[Profile::itemload]   = new ProfileHistogram("ItemLoad", "us");
+    m_keys[Profile::concord]    = new ProfileHistogram("Concord", "us");
+    m_keys[Profile::colony]     = new ProfileHistogram("Colony", "us");
+    m_keys[Profile::damage]     = new ProfileHistogram("Damage", "us");
+    m_keys[Profile::parseFX]    = new ProfileHistogram("ParseFX", "us");
+    m_keys[Profile::applyFX]    = new ProfileHistogram("ApplyFX", "us");
+    m_keys[Profile::onTarg]     = new ProfileHistogram("OnTarget", "us");
+}
 
 Profiler::~Profiler() {
-    //ClearAll();
+    for (auto cur : m_keys)
+        SafeDelete(cur);
 }
 
 int Profiler::Initialize() {
@@ -22,158 +144,90 @@ int Profiler::Initialize() {
     return 1;
 }
 
-void Profiler::AddTime(uint8 key, double value) {
+uint16 Profiler::RegisterKey(const char* name, const char* unit/*"us"*/)
+{
+    MutexLock lock(mMutex);
+    for (uint16 i = Profile::count; i < m_keys.size(); ++i)
+        if (m_keys[i]->GetName() == name)
+            return i;
+
+    m_keys.push_back(new ProfileHistogram(name, unit));
+    return m_keys.size() - 1;
+}
+
+void Profiler::AddTime(uint16 key, double value) {
+    MutexLock lock(mMutex);
+    if ((key >= m_keys.size()) or (m_keys[key] == nullptr)) {
+        sLog.Error("Profile::AddTime()", "Invalid key %u.", key );
+        return;
+    }
+
     if (sConfig.debug.ProfileTraceTime > 0)
-        if (value > sConfig.debug.ProfileTraceTime *1000) {
-            sLog.Warning("  Profile Manager", "Long Profile Time on key %s, time %.3f.", GetKeyName(key).c_str(), value);
+        if ((m_keys[key]->GetUnit() == "us") and (value > sConfig.debug.ProfileTraceTime *1000)) {
+            sLog.Warning("  Profile Manager", "Long Profile Time on key %s, time %.3f.", m_keys[key]->GetName().c_str(), value);
             //EvE::traceStack();
         }
-    /*
-    Profile::destiny     = 1,    *
-    Profile::map         = 2,
-    Profile::client      = 3,    *
-    Profile::npc         = 4,    *
-    Profile::bubbles     = 5,    *
-    Profile::items       = 6,
-    Profile::modules     = 7,    *
-    Profile::functions   = 8,
-    Profile::db          = 9,    *
-    Profile::ship        = 10,   *
-    Profile::targets     = 11,
-    Profile::server      = 12,
-    Profile::missile     = 13,
-    Profile::system      = 14,
-    Profile::entityS     = 15,   *
-    Profile::loot        = 16,   *
-    Profile::salvage     = 17,
-    Profile::spawn       = 18,   *
-    Profile::collision   = 19,   *
-    Profile::drone       = 20,   *
-    Profile::itemload    = 21,   *
-    Profile::concord     = 22,   *
-    Profile::colony      = 23,   *
-    Profile::damage      = 24,   *
-    Profile::parseFX     = 25,   *
-    Profile::applyFX     = 26,   *
-    Profile::onTarg      = 27
-    */
-    switch(key) {
-        case 1:
-            m_destiny.push_back(value);
-            break;
-        case 2:
-            m_map.push_back(value);
-            break;
-        case 3:
-            m_client.push_back(value);
-            break;
-        case 4:
-            m_npc.push_back(value);
-            break;
-        case 5:
-            m_bubbles.push_back(value);
-            break;
-        case 6:
-            m_items.push_back(value);
-            break;
-        case 7:
-            m_modules.push_back(value);
-            break;
-        case 8:
-            m_functions.push_back(value);
-            break;
-        case 9:
-            m_db.push_back(value);
-            break;
-        case 10:
-            m_ship.push_back(value);
-            break;
-        case 11:
-            m_targets.push_back(value);
-            break;
-        case 12:
-            m_server.push_back(value);
-            break;
-        case 13:
-            m_missile.push_back(value);
-            break;
-        case 14:
-            m_system.push_back(value);
-            break;
-        case 15:
-            m_entityS.push_back(value);
-            break;
-        case 16:
-            m_loot.push_back(value);
-            break;
-        case 17:
-            m_salvage.push_back(value);
-            break;
-        case 18:
-            m_spawn.push_back(value);
-            break;
-        case 19:
-            m_collision.push_back(value);
-            break;
-        case 20:
-            m_drone.push_back(value);
-            break;
-        case 21:
-            m_itemload.push_back(value);
-            break;
-        case 22:
-            m_concord.push_back(value);
-            break;
-        case 23:
-            m_colony.push_back(value);
-            break;
-        case 24:
-            m_damage.push_back(value);
-            break;
-        case 25:
-            m_effects1.push_back(value);
-            break;
-        case 26:
-            m_effects2.push_back(value);
-            break;
-        case 27:
-            m_ontarget.push_back(value);
-            break;
-        default:
-            sLog.Error("Profile::AddTime()", "Default reached on key %u.", key );
-            break;
-    }
+
+    m_keys[key]->Add(value);
 }
 
 void Profiler::ClearAll()
 {
-    m_server.clear();
-    m_destiny.clear();
-    m_map.clear();
-    m_client.clear();
-    m_npc.clear();
-    m_bubbles.clear();
-    m_items.clear();
-    m_modules.clear();
-    m_functions.clear();
-    m_db.clear();
-    m_ship.clear();
-    m_targets.clear();
-    m_ontarget.clear();
-    m_missile.clear();
-    m_system.clear();
-    m_entityS.clear();
-    m_loot.clear();
-    m_salvage.clear();
-    m_spawn.clear();
-    m_collision.clear();
-    m_drone.clear();
-    m_itemload.clear();
-    m_concord.clear();
-    m_colony.clear();
-    m_damage.clear();
-    m_effects1.clear();
-    m_effects2.clear();
+    MutexLock lock(mMutex);
+    for (auto cur : m_keys)
+        if (cur != nullptr)
+            cur->Clear();
+}
+
+void Profiler::GetSnapshot(uint16 key, const ProfileHistogram* hist, ProfileSnapshot& into)
+{
+    into.key = key;
+    into.name = hist->GetName();
+    into.unit = hist->GetUnit();
+    into.count = hist->GetCount();
+    double span(hist->GetSpan());
+    into.rate = (span > 0 ? into.count / span : 0.0);
+    into.min = hist->GetMin();
+    into.avg = hist->GetAvg();
+    into.p50 = hist->GetPercentile(50);
+    into.p90 = hist->GetPercentile(90);
+    into.p99 = hist->GetPercentile(99);
+    into.max = hist->GetMax();
+}
+
+bool Profiler::GetSnapshot(uint16 key, ProfileSnapshot& into)
+{
+    MutexLock lock(mMutex);
+    if ((key >= m_keys.size()) or (m_keys[key] == nullptr))
+        return false;
+
+    GetSnapshot(key, m_keys[key], into);
+    return true;
+}
+
+void Profiler::GetSnapshot(std::vector<ProfileSnapshot>& into)
+{
+    MutexLock lock(mMutex);
+    for (uint16 i = 0; i < m_keys.size(); ++i) {
+        if ((m_keys[i] == nullptr) or (m_keys[i]->GetCount() == 0))
+            continue;
+        ProfileSnapshot snap;
+        GetSnapshot(i, m_keys[i], snap);
+        into.push_back(snap);
+    }
+}
+
+void Profiler::PrintKey(uint16 key, const char* label)
+{
+    ProfileSnapshot snap;
+    if (!GetSnapshot(key, snap))
+        return;
+
+    std::string fSize;
+    GetSize(snap.count, fSize);
+    const char* unit(snap.unit == "us" ? "us" : "");
+    std::printf("%14s   %s times.  %8.1f/s  \tp50: %.1f%s  \tp99: %.1f%s  \tMax: %.1f%s  \tAvg: %.2f%s\n",
+                label, fSize.c_str(), snap.rate, snap.p50, unit, snap.p99, unit, snap.max, unit, snap.avg, unit );
 }
 
 void Profiler::PrintProfile()
@@ -181,113 +235,69 @@ void Profiler::PrintProfile()
     /** @todo figure out how to color this based on times....R,Y,G,M,B,W  */
 
     double startTime = GetTimeUSeconds();
-    std::string fSize;
-    float h(0.0f), l(0.0f), a(0.0f);
     sLog.Green("   Server Profile", " Current Process Profile times for this run:");
     //std::printf("\n");     // spacer
     std::printf("\t\tLoop Calls\n");
-    GetRunTimes(m_entityS, h, l, a);
-    GetSize(m_entityS.size(), fSize);
-    std::printf("    EntityList   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_client, h, l, a);
-    GetSize(m_client.size(), fSize);
-    std::printf("        Client   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_system, h, l, a);
-    GetSize(m_system.size(), fSize);
-    std::printf("     SystemMgr   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_bubbles, h, l, a);
-    GetSize(m_bubbles.size(), fSize);
-    std::printf("       Bubbles   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_destiny, h, l, a);
-    GetSize(m_destiny.size(), fSize);
-    std::printf("       Destiny   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_npc, h, l, a);
-    GetSize(m_npc.size(), fSize);
-    std::printf("           NPC   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_modules, h, l, a);
-    GetSize(m_modules.size(), fSize);
-    std::printf("       Modules   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_ship, h, l, a);
-    GetSize(m_ship.size(), fSize);
-    std::printf("          Ship   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    //GetRunTimes(m_ontarget, h, l, a);
-    //GetSize(m_ontarget.size(), fSize);
-    //std::printf("      OnTarget   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_targets, h, l, a);
-    GetSize(m_targets.size(), fSize);
-    std::printf("    TargetProc   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_missile, h, l, a);
-    GetSize(m_missile.size(), fSize);
-    std::printf("       Missile   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_damage, h, l, a);
-    GetSize(m_damage.size(), fSize);
-    std::printf("        Damage   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+    PrintKey(Profile::server, "Main Loop");
+    PrintKey(Profile::entityS, "EntityList");
+    PrintKey(Profile::client, "Client");
+    PrintKey(Profile::system, "SystemMgr");
+    PrintKey(Profile::bubbles, "Bubbles");
+    PrintKey(Profile::destiny, "Destiny");
+    PrintKey(Profile::npc, "NPC");
+    PrintKey(Profile::modules, "Modules");
+    PrintKey(Profile::ship, "Ship");
+    //PrintKey(Profile::onTarg, "OnTarget");
+    PrintKey(Profile::targets, "TargetProc");
+    PrintKey(Profile::missile, "Missile");
+    PrintKey(Profile::damage, "Damage");
     if (sConfig.npc.RoamingSpawns or sConfig.npc.StaticSpawns) {
-        GetRunTimes(m_spawn, h, l, a);
-        GetSize(m_spawn.size(), fSize);
-        std::printf("        Spawns   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+        PrintKey(Profile::spawn, "Spawns");
     } else {
         std::printf("        Spawns   Disabled.\n");
     }
     if (sConfig.cosmic.BumpEnabled) {
-        GetRunTimes(m_collision, h, l, a);
-        GetSize(m_collision.size(), fSize);
-        std::printf("    Collisions   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+        PrintKey(Profile::collision, "Collisions");
     } else {
         std::printf("    Collisions   Disabled.\n");
     }
     if (sConfig.testing.EnableDrones) {
-        GetRunTimes(m_drone, h, l, a);
-        GetSize(m_drone.size(), fSize);
-        std::printf("        Drones   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+        PrintKey(Profile::drone, "Drones");
     } else {
         std::printf("        Drones   Disabled.\n");
     }
 
     //std::printf("\n");     // spacer
     std::printf("\t\tPeriodic Calls\n");
-    GetRunTimes(m_db, h, l, a);
-    GetSize(m_db.size(), fSize);
-    std::printf("            DB   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_effects1, h, l, a);
-    GetSize(m_effects1.size(), fSize);
-    std::printf(" Parse Effects   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_effects2, h, l, a);
-    GetSize(m_effects2.size(), fSize);
-    std::printf(" Apply Effects   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_itemload, h, l, a);
-    GetSize(m_itemload.size(), fSize);
-    std::printf("  Item Loading   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_loot, h, l, a);
-    GetSize(m_loot.size(), fSize);
-    std::printf("          Loot   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_salvage, h, l, a);
-    GetSize(m_salvage.size(), fSize);
-    std::printf("       Salvage   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+    PrintKey(Profile::db, "DB");
+    PrintKey(Profile::parseFX, "Parse Effects");
+    PrintKey(Profile::applyFX, "Apply Effects");
+    PrintKey(Profile::itemload, "Item Loading");
+    PrintKey(Profile::loot, "Loot");
+    PrintKey(Profile::salvage, "Salvage");
     if (sConfig.cosmic.PIEnabled) {
-        GetRunTimes(m_colony, h, l, a);
-        GetSize(m_colony.size(), fSize);
-        std::printf("        Colony   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+        PrintKey(Profile::colony, "Colony");
     } else {
         std::printf("        Colony   Disabled.\n");
     }
     if (sConfig.crime.Enabled) {
-        GetRunTimes(m_concord, h, l, a);GetSize(m_concord.size(), fSize);
-        std::printf("       Concord   %s times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+        PrintKey(Profile::concord, "Concord");
     } else {
         std::printf("       Concord   Disabled.\n");
     }
 
+    // keys registered at runtime, in order of registration
+    if (m_keys.size() > Profile::count) {
+        std::printf("\t\tRegistered Calls\n");
+        for (uint16 i = Profile::count; i < m_keys.size(); ++i)
+            PrintKey(i, m_keys[i]->GetName().c_str());
+    }
+
     //std::printf("\n");     // spacer
     std::printf("\t\tUnimplemented Calls\n");
-    GetRunTimes(m_server, h, l, a);
-    std::printf("        *Main()  %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_server.size(), h, l, a );
-    GetRunTimes(m_map, h, l, a);
-    std::printf("          *Map   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_map.size(), h, l, a );
-    GetRunTimes(m_items, h, l, a);
-    std::printf("        *Items   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_items.size(),  h, l, a );
-    GetRunTimes(m_functions, h, l, a);
-    std::printf("    *Functions   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_functions.size(), h, l, a );
+    PrintKey(Profile::map, "*Map");
+    PrintKey(Profile::items, "*Items");
+    PrintKey(Profile::functions, "*Functions");
 
     std::printf(" Profile Times Compiled in %.4fus\n", (GetTimeUSeconds() -startTime) );
 }
@@ -295,54 +305,19 @@ void Profiler::PrintProfile()
 void Profiler::PrintStartUpData()
 {
     double startTime = GetTimeUSeconds();
-    std::string fSize;
-    float h(0.0f), l(0.0f), a(0.0f);
     sLog.Green("   Server Profile", " Current Process Profile times for this run:");
 
-    GetRunTimes(m_db, h, l, a);
-    GetSize(m_db.size(), fSize);
-    std::printf("            DB   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_itemload, h, l, a);
-    GetSize(m_itemload.size(), fSize);
-    std::printf("  Item Loading   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+    PrintKey(Profile::db, "DB");
+    PrintKey(Profile::itemload, "Item Loading");
     std::printf("\n");     // spacer
     std::printf("\t\tUnimplemented Calls\n");
-    GetRunTimes(m_server, h, l, a);
-    std::printf("        *Main()  %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_server.size(), h, l, a );
-    GetRunTimes(m_map, h, l, a);
-    std::printf("          *Map   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_map.size(), h, l, a );
-    GetRunTimes(m_items, h, l, a);
-    std::printf("        *Items   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_items.size(),  h, l, a );
-    GetRunTimes(m_functions, h, l, a);
-    std::printf("    *Functions   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_functions.size(), h, l, a );
+    PrintKey(Profile::map, "*Map");
+    PrintKey(Profile::items, "*Items");
+    PrintKey(Profile::functions, "*Functions");
 
     std::printf(" Profile Times Compiled in %.4fus\n", (GetTimeUSeconds() -startTime) );
 }
 
-void Profiler::GetRunTimes(std::vector< double >& container, float& h, float& l, float& a)
-{
-    if (container.empty()) {
-        h = 0.0f;
-        l = 0.0f;
-        a = 0.0f;
-        return;
-    }
-
-    uint32 size = container.size();
-    float total(0.0f), lo(0.0f), hi(0.0f);
-    for (uint32 i = 0; i < size; ++i) {
-        total += container.at(i);
-        if ((lo > container.at(i)) or (lo < 0.000001f))
-            lo = container.at(i);
-        if (hi < container.at(i))
-            hi = container.at(i);
-    }
-
-    h = hi;
-    l = lo;
-    a = total / size;
-}
-
 void Profiler::GetSize(size_t cSize, std::string& fSize)
 {
     if (cSize > 999999) {
@@ -356,37 +331,12 @@ void Profiler::GetSize(size_t cSize, std::string& fSize)
     }
 }
 
-std::string Profiler::GetKeyName(uint8& key)
+std::string Profiler::GetKeyName(uint16 key)
 {
-    switch (key) {
-        case Profile::destiny:       return "Destiny";   //  1,
-        case Profile::map:           return "Map";       //  2,
-        case Profile::client:        return "Client";    //  3,
-        case Profile::npc:           return "NPC";       //  4,
-        case Profile::bubbles:       return "Bubble";    //  5,
-        case Profile::items:         return "Item";      //  6,
-        case Profile::modules:       return "Module";    //  7,
-        case Profile::functions:     return "Function";  //  8,
-        case Profile::db:            return "DB";        //  9,
-        case Profile::ship:          return "Ship";      //  10,
-        case Profile::targets:       return "Target";    //  11,
-        case Profile::server:        return "Server";    //  12,
-        case Profile::missile:       return "Missile";   //  13,
-        case Profile::system:        return "System";    //  14,
-        case Profile::entityS:       return "EntityTic"; //  15,
-        case Profile::loot:          return "Loot";      //  16,
-        case Profile::salvage:       return "Salvage";   //  17,
-        case Profile::spawn:         return "Spawn";     //  18,
-        case Profile::collision:     return "Collision"; //  19,
-        case Profile::drone:         return "Drone";     //  20,
-        case Profile::itemload:      return "ItemLoad";  //  21,
-        case Profile::concord:       return "Concord";   //  22,
-        case Profile::colony:        return "Colony";    //  23,
-        case Profile::damage:        return "Damage";    //  24,
-        case Profile::parseFX:       return "ParseFX";   //  25,
-        case Profile::applyFX:       return "ApplyFX";   //  26
-        default:                     return "Invalid Key";
-    }
+    MutexLock lock(mMutex);
+    if ((key >= m_keys.size()) or (m_keys[key] == nullptr))
+        return "Invalid Key";
+    return m_keys[key]->GetName();
 }
 
 /*  color shit....
@@ -7,13 +7,15 @@
  */
 
 /**   Allan's EvEmu Profiler
- * simple singleton profiler using std::vector<double> being simple mem object storage.
- * vector object denotes call type, (db, client, map, etc.)
- * double precision float holds elapsed time for that particular call
- * output functions use size() to count calls, and give readouts as
- *     CALL_TYPE: called N times, hi: Xus, lo: Yus, avg: Zus
+ * simple singleton profiler keeping one fixed-size histogram per key.
+ * key denotes call type, (db, client, map, etc.)
+ * each sample (elapsed time for that particular call) is counted in a log-linear bucket,
+ *  so memory use does not grow with run time and percentiles are within ~3% of the real value.
+ * output functions give readouts as
+ *     CALL_TYPE: called N times, rate: R/s, p50: Xus, p99: Yus, max: Zus, avg: Aus
  *  Times are measured in microseconds via GetTimeUSeconds() from core/utils/utils_time.cpp
  *
+ * the keys in Profile:: are always registered.  other code may register its own keys with RegisterKey().
  */
 
 
@@ -22,6 +24,7 @@
 
 
 #include "eve-common.h"
+#include "threading/Mutex.h"
 
 namespace Profile {
     enum {          // implemented?  (* = yes)
@@ -51,10 +54,66 @@ namespace Profile {
         damage      = 24,   //*
         parseFX     = 25,   //*
         applyFX     = 26,   //*
-        onTarg      = 27    //
+        onTarg      = 27,   //
+        count               // first key given out by RegisterKey()
     };
 }
 
+/**
+ * @brief Log-linear histogram of samples of one profile key.
+ *
+ * Values are counted in 1/1000 units (ns for times in us).  Below 32 units buckets are exact;
+ *  above, each power of two is split in 32 buckets.  Values above ~1.1e9 units are counted in the top bucket.
+ */
+class ProfileHistogram
+{
+public:
+    ProfileHistogram(const std::string& name, const std::string& unit);
+
+    void Add(double value);
+    void Clear();
+
+    /** @return value at or below which pct percent of samples fall. */
+    double GetPercentile(double pct) const;
+
+    const std::string& GetName() const                  { return m_name; }
+    const std::string& GetUnit() const                  { return m_unit; }
+    int64 GetCount() const                              { return m_count; }
+    double GetMin() const                               { return m_min; }
+    double GetMax() const                               { return m_max; }
+    double GetAvg() const                               { return (m_count > 0 ? m_sum / m_count : 0.0); }
+    /** @return seconds since histogram was cleared. */
+    double GetSpan() const;
+
+private:
+    std::string m_name;
+    std::string m_unit;
+
+    std::vector<uint64_t> m_buckets;
+
+    int64 m_count;
+    double m_sum;
+    double m_min;
+    double m_max;
+    double m_start;     // GetTimeMSeconds() at last clear
+};
+
+/** @brief Summary of one profile key, as of the time it was taken. */
+struct ProfileSnapshot
+{
+    uint16 key;
+    std::string name;
+    std::string unit;
+    int64 count;
+    double rate;        // samples per second since profile was cleared
+    double min;
+    double avg;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+};
+
 class Profiler
 : public Singleton<Profiler>
 {
@@ -64,46 +123,39 @@ public:
 
     int Initialize();
 
-    void AddTime(uint8 key, double value);
+    /**
+     * @brief Registers a profile key.
+     *
+     * @param[in] name Name of the key, as printed.  Registering a name again returns the existing key.
+     * @param[in] unit Unit of values added to the key.
+     *
+     * @return New key, to be used with AddTime().
+     */
+    uint16 RegisterKey(const char* name, const char* unit = "us");
+
+    void AddTime(uint16 key, double value);
     void PrintProfile();
     void PrintStartUpData();
     void ClearAll();
 
-    void GetSize(size_t cSize, std::string& ret);
+    /** @brief Gets summary of given key.  returns false for unknown keys. */
+    bool GetSnapshot(uint16 key, ProfileSnapshot& into);
+    /** @brief Gets summaries of all keys which have samples. */
+    void GetSnapshot(std::vector<ProfileSnapshot>& into);
 
-    void GetRunTimes(std::vector< double >& container, float& h, float& l, float& a);
+    void GetSize(size_t cSize, std::string& ret);
 
 protected:
-    std::string GetKeyName(uint8& key);
+    std::string GetKeyName(uint16 key);
+    void PrintKey(uint16 key, const char* label);
+
+    void GetSnapshot(uint16 key, const ProfileHistogram* hist, ProfileSnapshot& into);
 
 private:
-    std::vector<double> m_server;
-    std::vector<double> m_functions;
-    std::vector<double> m_db;
-    std::vector<double> m_client;
-    std::vector<double> m_map;
-    std::vector<double> m_destiny;
-    std::vector<double> m_system;
-    std::vector<double> m_entityS;
-    std::vector<double> m_npc;
-    std::vector<double> m_drone;
-    std::vector<double> m_bubbles;
-    std::vector<double> m_items;
-    std::vector<double> m_itemload;
-    std::vector<double> m_modules;
-    std::vector<double> m_ship;
-    std::vector<double> m_targets;
-    std::vector<double> m_ontarget;
-    std::vector<double> m_missile;
-    std::vector<double> m_loot;
-    std::vector<double> m_salvage;
-    std::vector<double> m_spawn;
-    std::vector<double> m_collision;
-    std::vector<double> m_concord;
-    std::vector<double> m_colony;
-    std::vector<double> m_damage;
-    std::vector<double> m_effects1;
-    std::vector<double> m_effects2;
+    Mutex mMutex;   // AddTime() is called by systems ticking on other threads
+
+    // indexed by key.  key 0 is unused
+    std::vector<ProfileHistogram*> m_keys;
 };
 
 #define sProfiler \
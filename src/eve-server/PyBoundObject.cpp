@@ -39,11 +39,11 @@ PyBoundObject::~PyBoundObject()
 {
 }
 
-PyResult PyBoundObject::Call(const std::string &method, PyCallArgs &args) {
+PyResult PyBoundObject::Call(const std::string &method, uint32 methodID, PyCallArgs &args) {
     _log(SERVICE__CALLS_BOUND, "%s::%s()", GetName(), method.c_str());
     args.Dump(SERVICE__CALL_TRACE);
 
-    return PyCallable::Call(method, args);
+    return PyCallable::Call(method, methodID, args);
 }
 
 std::string PyBoundObject::GetBindStr() const {
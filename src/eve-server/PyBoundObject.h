@@ -44,7 +44,7 @@ public:
     const char* GetName() const                         { return m_strBoundObjectName.c_str(); };
 
     //just to say who we are:
-    virtual PyResult Call(const std::string &method, PyCallArgs &args);
+    virtual PyResult Call(const std::string &method, uint32 methodID, PyCallArgs &args);
 
 protected:
     friend class PyServiceMgr;    //for access to _SetNodeBindID only.
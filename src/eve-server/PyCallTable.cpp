@@ -0,0 +1,90 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-server.h"
+
+#include "PyCallTable.h"
+
+Mutex PyCallTableBase::sMutex;
+
+PyCallTableBase::PyCallTableBase()
+{
+    MutexLock lock(sMutex);
+    GetTables().push_back(this);
+}
+
+PyCallTableBase::~PyCallTableBase()
+{
+    MutexLock lock(sMutex);
+    std::vector<PyCallTableBase*>& tables = GetTables();
+    tables.erase(std::remove(tables.begin(), tables.end(), this), tables.end());
+}
+
+std::vector<PyCallTableBase*>& PyCallTableBase::GetTables()
+{
+    // tables are static members of templates; avoid depending on static init order
+    static std::vector<PyCallTableBase*> tables;
+    return tables;
+}
+
+void PyCallTableBase::GetAllStats(std::vector<PyCallStat>& into)
+{
+    {
+        MutexLock lock(sMutex);
+        for (auto cur : GetTables())
+            cur->GetStats(into);
+    }
+
+    std::sort(into.begin(), into.end(), [](const PyCallStat& a, const PyCallStat& b) { return a.calls > b.calls; });
+}
+
+void PyCallTableBase::PrintTopCalls(size_t count)
+{
+    std::vector<PyCallStat> stats;
+    GetAllStats(stats);
+
+    uint64_t total(0);
+    std::map<std::string, uint64_t> owners;
+    for (auto cur : stats) {
+        total += cur.calls;
+        owners[cur.owner] += cur.calls;
+    }
+
+    if (total == 0) {
+        sLog.Cyan("    Service Calls", " No calls yet.");
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> byOwner;
+    for (auto cur : owners)
+        byOwner.push_back(std::make_pair(cur.second, cur.first));
+    std::sort(byOwner.rbegin(), byOwner.rend());
+
+    sLog.Cyan("    Service Calls", " %lu calls to %lu methods of %lu services.", total, stats.size(), owners.size());
+    for (size_t i = 0; (i < count) and (i < byOwner.size()); ++i)
+        sLog.Cyan("    Service Calls", " %-28s %10lu (%.1f%%)", byOwner[i].second.c_str(), byOwner[i].first, byOwner[i].first * 100.0 / total);
+    for (size_t i = 0; (i < count) and (i < stats.size()); ++i)
+        sLog.Cyan("    Service Calls", " %-28s %-32s %10lu (%.1f%%)", stats[i].owner.c_str(), stats[i].method.c_str(), stats[i].calls, stats[i].calls * 100.0 / total);
+}
@@ -0,0 +1,163 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __PYCALLTABLE_H_INCL__
+#define __PYCALLTABLE_H_INCL__
+
+/** @brief Call counter of one registered method. */
+struct PyCallStat
+{
+    std::string owner;      // service or bound object name
+    std::string method;
+    uint64_t calls;
+};
+
+/**
+ * @brief Base of the method tables of PyCallableDispatcher.
+ *
+ * Keeps a list of all tables, so call counters can be reported.
+ */
+class PyCallTableBase
+{
+public:
+    PyCallTableBase();
+    virtual ~PyCallTableBase();
+
+    /** @return Name of service or bound object using this table; empty until first call. */
+    const std::string& GetOwner() const                 { return mOwner; }
+    void SetOwner( const char* owner )                  { mOwner = owner; }
+
+    /** @brief Appends counters of methods called at least once. */
+    virtual void GetStats( std::vector<PyCallStat>& into ) const = 0;
+
+    /** @brief Gets counters of all called methods, most called first. */
+    static void GetAllStats( std::vector<PyCallStat>& into );
+    /** @brief Prints the most called methods and services. */
+    static void PrintTopCalls( size_t count );
+
+protected:
+    std::string mOwner;
+
+    static Mutex sMutex;
+    static std::vector<PyCallTableBase*>& GetTables();
+};
+
+/**
+ * @brief Open-addressing table of methods, keyed on interned method name.
+ *
+ * Filled by RegisterCall() when the first object of a service class is constructed;
+ * later registrations find their method already present.  Lookup hashes the
+ * method ID and probes linearly; the table is kept at most half full.
+ */
+template <class Proc>
+class PyCallTable
+: public PyCallTableBase
+{
+public:
+    struct Entry
+    {
+        uint32 id;          // sCallNames ID; 0 for empty slots
+        Proc proc;
+        uint64_t calls;
+        uint16 profileKey;  // sProfiler key for call times; 0 until first profiled call
+    };
+
+    PyCallTable()
+    : mCount(0) {
+    }
+
+    void Add(uint32 id, Proc proc) {
+        Entry* entry = Find(id);
+        if (entry != nullptr) {
+            entry->proc = proc;
+            return;
+        }
+
+        if ((mCount + 1) * 2 > mEntries.size())
+            Grow();
+
+        Insert(id, proc);
+    }
+
+    /** @return Entry of method, nullptr if it is not registered. */
+    Entry* Find(uint32 id) {
+        if ((id == 0) or mEntries.empty())
+            return nullptr;
+
+        const size_t mask = mEntries.size() - 1;
+        for (size_t idx = Hash(id) & mask; true; idx = (idx + 1) & mask) {
+            if (mEntries[idx].id == id)
+                return &mEntries[idx];
+            if (mEntries[idx].id == 0)
+                return nullptr;
+        }
+    }
+
+    virtual void GetStats(std::vector<PyCallStat>& into) const {
+        for (const Entry& cur : mEntries) {
+            if ((cur.id == 0) or (cur.calls == 0))
+                continue;
+
+            PyCallStat stat;
+                stat.owner = mOwner;
+                stat.method = sCallNames.GetName(cur.id);
+                stat.calls = cur.calls;
+            into.push_back(stat);
+        }
+    }
+
+protected:
+    static size_t Hash(uint32 id)                       { return id * 2654435761U; }
+
+    void Insert(uint32 id, Proc proc) {
+        const size_t mask = mEntries.size() - 1;
+        size_t idx = Hash(id) & mask;
+        while (mEntries[idx].id != 0)
+            idx = (idx + 1) & mask;
+
+        mEntries[idx].id = id;
+        mEntries[idx].proc = proc;
+        mEntries[idx].calls = 0;
+        mEntries[idx].profileKey = 0;
+        ++mCount;
+    }
+
+    void Grow() {
+        std::vector<Entry> old;
+        old.swap(mEntries);
+
+        Entry empty = Entry();
+        mEntries.resize(std::max<size_t>(16, old.size() * 2), empty);
+        mCount = 0;
+        for (auto cur : old)
+            if (cur.id != 0)
+                Insert(cur.id, cur.proc);
+    }
+
+    std::vector<Entry> mEntries;    // size is a power of two
+    size_t mCount;
+};
+
+#endif // __PYCALLTABLE_H_INCL__
@@ -36,10 +36,10 @@ PyCallable::~PyCallable()
 {
 }
 
-PyResult PyCallable::Call(const std::string &method, PyCallArgs &args) {
+PyResult PyCallable::Call(const std::string &method, uint32 methodID, PyCallArgs &args) {
     //call the dispatcher, capturing the result.
     try {
-        PyResult res(m_serviceDispatch->Dispatch(method, args));
+        PyResult res(m_serviceDispatch->Dispatch(methodID, method, args));
 
         if (is_log_enabled(SERVICE__CALL_TRACE)) {
             _log(SERVICE__CALL_TRACE, "Call %s returned:", method.c_str());
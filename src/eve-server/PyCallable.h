@@ -86,14 +86,14 @@ public:
     public:
         virtual ~CallDispatcher() {}
 
-        virtual PyResult Dispatch( const std::string& method_name, PyCallArgs& call ) = 0;
+        virtual PyResult Dispatch( uint32 methodID, const std::string& method_name, PyCallArgs& call ) = 0;
     };
 
     PyCallable();
     virtual ~PyCallable();
 
-    //returns ownership:
-    virtual PyResult Call( const std::string& method, PyCallArgs& args );
+    //returns ownership.  methodID is the sCallNames ID of method
+    virtual PyResult Call( const std::string& method, uint32 methodID, PyCallArgs& args );
 
 protected:
     void _SetCallDispatcher( CallDispatcher* d ) { m_serviceDispatch = d; }
@@ -33,6 +33,9 @@ PyService::PyService(PyServiceMgr *mgr, const char *serviceName)
 : m_manager(mgr),
   m_name(serviceName)
 {
+    // handled by Call() of every service; interned before any call is decoded
+    sCallNames.Intern("MachoResolveObject");
+    sCallNames.Intern("MachoBindObject");
 }
 
 PyService::~PyService()
@@ -40,17 +43,20 @@ PyService::~PyService()
 }
 
 //overload this to hack in our special bind routines at the service level
-PyResult PyService::Call(const std::string &method, PyCallArgs &args) {
-    if (method == "MachoResolveObject"){
+PyResult PyService::Call(const std::string &method, uint32 methodID, PyCallArgs &args) {
+    static const uint32 resolveID(sCallNames.Find("MachoResolveObject"));
+    static const uint32 bindID(sCallNames.Find("MachoBindObject"));
+
+    if (methodID == resolveID) {
         _log(SERVICE__CALLS, "%s::MachoResolveObject()", GetName());
         return Handle_MachoResolveObject(args);
-    } else if (method == "MachoBindObject") {
+    } else if (methodID == bindID) {
         _log(SERVICE__CALLS, "%s::MachoBindObject()", GetName());
         return Handle_MachoBindObject(args);
     } else {
         _log(SERVICE__CALLS, "%s::%s()", GetName(), method.c_str());
         args.Dump(SERVICE__CALL_TRACE);
-        return PyCallable::Call(method, args);
+        return PyCallable::Call(method, methodID, args);
     }
 }
 
@@ -106,7 +112,7 @@ PyResult PyService::Handle_MachoBindObject( PyCallArgs& call )
         PyCallArgs sub_args(call.client, boundcall.arguments, boundcall.dict_arguments);
 
         //do the call:
-        PyResult result = obj->Call(boundcall.method_name, sub_args);
+        PyResult result = obj->Call(boundcall.method_name, sCallNames.Find(boundcall.method_name), sub_args);
 
         rsp->SetItem(1, result.ssResult);
     }
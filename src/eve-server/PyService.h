@@ -49,7 +49,7 @@ public:
     virtual ~PyService();
 
     //overload Callable for binding:
-    virtual PyResult Call(const std::string &method, PyCallArgs &args);
+    virtual PyResult Call(const std::string &method, uint32 methodID, PyCallArgs &args);
 
     const char* GetName() const                         { return m_name; }
 
@@ -28,6 +28,7 @@
 
 #include "Client.h"
 #include "PyCallable.h"
+#include "PyCallTable.h"
 
 /*
  * This whole concept exists to allow the generic PyService to make a
@@ -38,7 +39,7 @@ class PyCallableDispatcher
     : public PyCallable::CallDispatcher
 {
     typedef PyResult (Svc::*CallProc)(PyCallArgs &call);
-    typedef typename std::map<std::string, CallProc>::iterator mapitr;
+    typedef PyCallTable<CallProc> CallTable;
 public:
     PyCallableDispatcher(Svc *parent)
     : m_parent(parent) {
@@ -48,28 +49,44 @@ public:
     }
 
     void RegisterCall(const char *call_name, CallProc p) {
-        m_serviceCalls[call_name] = p;
+        GetTable().Add(sCallNames.Intern(call_name), p);
     }
 
     //CallDispatcher interface:
-    virtual PyResult Dispatch(const std::string &method_name, PyCallArgs &call) {
-        //this could be done a lot more efficiently with a custom data structure IF NEEDED
-        mapitr res = m_serviceCalls.find(method_name);
-        if (res == m_serviceCalls.end()) {
+    virtual PyResult Dispatch(uint32 methodID, const std::string &method_name, PyCallArgs &call) {
+        CallTable& table = GetTable();
+        typename CallTable::Entry* entry = table.Find(methodID);
+        if (entry == nullptr) {
             sLog.Error("Server","Unknown call to '%s' by '%s'", method_name.c_str(), call.client->GetName());
-            //  list registered calls for named service
-            //if (is_log_enabled(SERVICE__WARNING))
-            //    for (auto cur : m_serviceCalls)
-            //        _log(SERVICE__WARNING, "    %s", cur.first.c_str());
             return nullptr;
         }
 
-        CallProc p = res->second;
-        return (m_parent->*p)(call);
+        ++entry->calls;
+        if (table.GetOwner().empty())
+            table.SetOwner(m_parent->GetName());
+        if (!sConfig.debug.UseProfiling)
+            return (m_parent->*entry->proc)(call);
+
+        if (entry->profileKey == 0)
+            entry->profileKey = sProfiler.RegisterKey((table.GetOwner() + "::" + method_name).c_str());
+
+        double start(GetTimeUSeconds());
+        try {
+            PyResult res((m_parent->*entry->proc)(call));
+            sProfiler.AddTime(entry->profileKey, GetTimeUSeconds() - start);
+            return res;
+        } catch (PyException &e) {
+            sProfiler.AddTime(entry->profileKey, GetTimeUSeconds() - start);
+            throw;
+        }
     }
 
-protected:   //_MAY_ consume args
-    std::map<std::string, CallProc> m_serviceCalls;
+protected:
+    /* one table per service class, shared by all its objects (bound objects are created often) */
+    static CallTable& GetTable() {
+        static CallTable table;
+        return table;
+    }
 
     Svc *const m_parent;    //we do not own this pointer
 };
@@ -10,13 +10,17 @@
 
 
 #include "StatisticMgr.h"
+#include "EVEServerConfig.h"
+#include "PyCallTable.h"
 #include "system/cosmicMgrs/ManagerDB.h"
 
 
 StatisticMgr::StatisticMgr()
-: m_counter(3)  // do first update 15m after server starts
+: m_counter(3),  // do first update 15m after server starts
+m_sendTime(0.0)
 {
     m_data = StatisticData();
+    m_sendStats = TCPSendStats();
 }
 
 void StatisticMgr::Close()
@@ -31,6 +35,8 @@ int StatisticMgr::Initialize()
     //ClearAll();
     // reset current data for new session
     ManagerDB::UpdateStatisticHistory(m_data);
+    TCPConnection::GetSendStats(m_sendStats);
+    m_sendTime = GetTimeMSeconds();
     sLog.Blue( "     StatisticMgr", "Statistics Manager Initialized." );
     return 1;
 }
@@ -72,6 +78,7 @@ void StatisticMgr::SaveData()
 
 void StatisticMgr::Add(uint8 key, double value)
 {
+    MutexLock lock(mMutex);
     m_data.span = sEntityList.GetMinutes();
     switch(key) {
         case Stat::pcBounties:
@@ -94,6 +101,7 @@ void StatisticMgr::Add(uint8 key, double value)
 
 void StatisticMgr::Increment(uint8 key)
 {
+    MutexLock lock(mMutex);
     m_data.span = sEntityList.GetMinutes();
     switch(key) {
         case Stat::pcShots:
@@ -134,6 +142,39 @@ void StatisticMgr::PrintInfo()
     sLog.Cyan("     StatisticMgr", " ISK Spent in Market: %.2f isk", m_data.iskMarket);
     sLog.Cyan("     StatisticMgr", " Ships Salvaged: %u", m_data.shipsSalvaged);
     sLog.Cyan("     StatisticMgr", " R.A.M. Jobs: %u", m_data.ramJobs);
+
+    std::vector<ProfileSnapshot> profile;
+    GetProfile(profile);
+    for (auto cur : profile)
+        sLog.Cyan("     StatisticMgr", " Profile %s: %li samples, %.1f/s, p50 %.1f%s, p99 %.1f%s, max %.1f%s", cur.name.c_str(), cur.count, cur.rate, \
+                  cur.p50, cur.unit.c_str(), cur.p99, cur.unit.c_str(), cur.max, cur.unit.c_str());
+
+    double calls(0.0), bytes(0.0), buffers(0.0);
+    GetSendRates(calls, bytes, buffers);
+    sLog.Cyan("     StatisticMgr", " Network Sends: %.1f syscalls/s, %.1f bytes/syscall, %.2f packets/syscall", calls, bytes, buffers);
+
+    PyCallTableBase::PrintTopCalls(10);
+}
+
+void StatisticMgr::GetSendRates(double& callsPerSec, double& bytesPerCall, double& buffersPerCall)
+{
+    TCPSendStats now;
+    TCPConnection::GetSendStats(now);
+    double time(GetTimeMSeconds());
+
+    uint64_t calls(now.calls - m_sendStats.calls);
+    callsPerSec = (time > m_sendTime ? calls * 1000.0 / (time - m_sendTime) : 0.0);
+    bytesPerCall = (calls > 0 ? (double)(now.bytes - m_sendStats.bytes) / calls : 0.0);
+    buffersPerCall = (calls > 0 ? (double)(now.buffers - m_sendStats.buffers) / calls : 0.0);
+
+    m_sendStats = now;
+    m_sendTime = time;
+}
+
+void StatisticMgr::GetProfile(std::vector<ProfileSnapshot>& into)
+{
+    if (sConfig.debug.UseProfiling)
+        sProfiler.GetSnapshot(into);
 }
 
 void StatisticMgr::CompileData()
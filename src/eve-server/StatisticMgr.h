@@ -53,14 +53,23 @@ public:
     void Add(uint8 key, double value);
     void Increment(uint8 key);
 
+    // summaries of all profile keys with samples.  empty if profiling is off
+    void GetProfile(std::vector<ProfileSnapshot>& into);
+    // network sends since previous call: sendmsg() calls per second, and bytes and packets per call
+    void GetSendRates(double& callsPerSec, double& bytesPerCall, double& buffersPerCall);
+
 protected:
     void SaveData();
     void CompileData();
 
 private:
+    Mutex mMutex;   // Add() and Increment() are called by systems ticking on other threads
+
     StatisticData m_data;
+    TCPSendStats m_sendStats;   // counters as of last GetSendRates()
 
     int8 m_counter;
+    double m_sendTime;          // GetTimeMSeconds() of last GetSendRates()
 };
 
 
@@ -0,0 +1,160 @@
+/**
+ * @name TickScheduler.cpp
+ *   fixed-timestep scheduler for the server main loop
+ *
+ * @Author:         EVEmu Team
+ */
+
+#include "TickScheduler.h"
+#include "EVEServerConfig.h"
+#include "Profiler.h"
+
+
+const uint32 TICK_MAX_CATCHUP = 1000;
+const uint32 TICK_SAMPLE_COUNT = 4096;
+
+
+TickScheduler::TickScheduler()
+: m_period(10),
+m_tick(0),
+m_lastTick(0),
+m_ticks(0),
+m_overruns(0),
+m_skipped(0),
+m_drift(0.0),
+m_driftMax(0.0),
+m_max(0.0),
+m_sampleIdx(0)
+{
+}
+
+void TickScheduler::Initialize(uint32 periodMs)
+{
+    if (periodMs == 0)
+        periodMs = 1;
+    m_period = periodMs;
+    m_tick = 0;
+    m_lastTick = 0;
+    m_next = Clock::now();
+    m_samples.reserve(TICK_SAMPLE_COUNT);
+    ClearStats();
+
+    sLog.Blue("    TickScheduler", "Main loop running at %ums per tick.", m_period);
+}
+
+void TickScheduler::BeginTick()
+{
+    m_start = Clock::now();
+
+    // time this tick started past its deadline
+    double late = std::chrono::duration<double, std::micro>(m_start - m_next).count();
+    if (late > 0) {
+        m_drift += late;
+        if (late > m_driftMax)
+            m_driftMax = late;
+    }
+
+    ++m_tick;
+}
+
+void TickScheduler::EndTick()
+{
+    using namespace std::chrono;
+
+    Clock::time_point now = Clock::now();
+    double elapsed = duration<double, std::micro>(now - m_start).count();
+
+    ++m_ticks;
+    if (elapsed > m_period * 1000)
+        ++m_overruns;
+    if (elapsed > m_max)
+        m_max = elapsed;
+    if (m_samples.size() < TICK_SAMPLE_COUNT) {
+        m_samples.push_back(elapsed);
+    } else {
+        m_samples[m_sampleIdx] = elapsed;
+        m_sampleIdx = (m_sampleIdx + 1) % TICK_SAMPLE_COUNT;
+    }
+
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::server, elapsed);
+
+    m_lastTick = m_tick;
+
+    m_next += milliseconds(m_period);
+    if (now < m_next) {
+        std::this_thread::sleep_until(m_next);
+        return;
+    }
+
+    // behind schedule.  following ticks run without sleep until caught up, unless too far behind
+    if (now - m_next > milliseconds(TICK_MAX_CATCHUP)) {
+        int64 missed = duration_cast<milliseconds>(now - m_next).count() / m_period;
+        m_next += milliseconds(missed * m_period);
+        m_tick += missed;
+        m_skipped += missed;
+        sLog.Warning("    TickScheduler", "Main loop is %li ticks behind schedule; dropping them.", missed);
+    }
+}
+
+bool TickScheduler::IsDue(uint32 intervalMs, uint32 phaseMs/*0*/) const
+{
+    if (intervalMs <= m_period)
+        return true;
+
+    // schedule time at current and previous tick, shifted back by phase
+    int64 now = m_tick * m_period - phaseMs;
+    int64 last = m_lastTick * m_period - phaseMs;
+    if (now < 0)
+        return false;
+    if (last < 0)
+        return true;
+
+    return (now / intervalMs) != (last / intervalMs);
+}
+
+void TickScheduler::GetStats(TickStats& stats)
+{
+    stats.ticks = m_ticks;
+    stats.overruns = m_overruns;
+    stats.skipped = m_skipped;
+    stats.drift = m_drift;
+    stats.driftMax = m_driftMax;
+    stats.max = m_max;
+    stats.p50 = 0.0;
+    stats.p99 = 0.0;
+
+    if (m_samples.empty())
+        return;
+
+    std::vector<double> sorted(m_samples);
+    std::vector<double>::iterator itr = sorted.begin() + (sorted.size() - 1) / 2;
+    std::nth_element(sorted.begin(), itr, sorted.end());
+    stats.p50 = *itr;
+    itr = sorted.begin() + ((sorted.size() - 1) * 99) / 100;
+    std::nth_element(sorted.begin(), itr, sorted.end());
+    stats.p99 = *itr;
+}
+
+void TickScheduler::PrintStats()
+{
+    TickStats stats;
+    GetStats(stats);
+
+    sLog.Green("    TickScheduler", "%li ticks at %ums.  %li overruns (%.2f%%), %li skipped.",
+               stats.ticks, m_period, stats.overruns, (stats.ticks > 0 ? stats.overruns * 100.0 / stats.ticks : 0.0), stats.skipped);
+    sLog.Green("    TickScheduler", "Tick time - p50: %.1fus  p99: %.1fus  max: %.1fus", stats.p50, stats.p99, stats.max);
+    sLog.Green("    TickScheduler", "Drift - total: %.3fms  max: %.3fms", stats.drift / 1000, stats.driftMax / 1000);
+}
+
+void TickScheduler::ClearStats()
+{
+    m_ticks = 0;
+    m_overruns = 0;
+    m_skipped = 0;
+    m_drift = 0.0;
+    m_driftMax = 0.0;
+    m_max = 0.0;
+    m_samples.clear();
+    m_sampleIdx = 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @name TickScheduler.h
+ *   fixed-timestep scheduler for the server main loop
+ *
+ * @Author:         EVEmu Team
+ */
+
+/* the main loop runs one tick every ServerSleepTime ms.  tick deadlines are fixed
+ * (start + n * period), so a tick which runs long shortens the following sleep instead
+ * of pushing the whole schedule back.  when the loop falls behind, following ticks run
+ * back-to-back until it has caught up.  if it falls more than TICK_MAX_CATCHUP behind,
+ * the missed ticks are dropped and counted as skipped.
+ *
+ * code gated on IsDue() runs at its own rate regardless of the loop period, and the
+ * phase lets jobs of the same rate run on different ticks.
+ */
+
+
+#ifndef EVEMU_EVESERVER_TICKSCHEDULER_H_
+#define EVEMU_EVESERVER_TICKSCHEDULER_H_
+
+
+#include "eve-common.h"
+
+/** Longest time (in milliseconds) the loop may fall behind before missed ticks are dropped. */
+extern const uint32 TICK_MAX_CATCHUP;
+/** Number of most recent tick durations kept for percentiles. */
+extern const uint32 TICK_SAMPLE_COUNT;
+
+/**
+ * @brief Tick counters.
+ *
+ * Times are in microseconds.
+ */
+struct TickStats
+{
+    int64 ticks;            // ticks run
+    int64 overruns;         // ticks which took longer than the period
+    int64 skipped;          // ticks dropped while catching up
+    double drift;           // summed time ticks started past their deadline
+    double driftMax;
+    double p50;             // tick duration percentiles, over last TICK_SAMPLE_COUNT ticks
+    double p99;
+    double max;             // longest tick since stats were cleared
+};
+
+class TickScheduler
+: public Singleton<TickScheduler>
+{
+public:
+    TickScheduler();
+    ~TickScheduler() { /* do nothing here */ }
+
+    /** @brief Sets the tick period and schedules the first tick. */
+    void Initialize(uint32 periodMs);
+
+    /** @brief Marks the start of the work of current tick. */
+    void BeginTick();
+    /** @brief Records duration of current tick and sleeps until deadline of the next one. */
+    void EndTick();
+
+    /** @return Number of current tick, counting skipped ticks. */
+    int64 GetTick() const                               { return m_tick; }
+    uint32 GetPeriod() const                            { return m_period; }
+
+    /**
+     * @brief Checks if a job running every intervalMs is due on current tick.
+     *
+     * @param[in] intervalMs Interval of the job, in milliseconds.
+     * @param[in] phaseMs    Offset of the job inside its interval, in milliseconds.
+     *
+     * @return True on the first tick at or past each interval boundary (+ phase) of the schedule.
+     */
+    bool IsDue(uint32 intervalMs, uint32 phaseMs = 0) const;
+
+    void GetStats(TickStats& stats);
+    void PrintStats();
+    void ClearStats();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    uint32 m_period;            // ms
+    int64 m_tick;
+    int64 m_lastTick;           // last tick which has been run to its end
+
+    Clock::time_point m_next;   // deadline of next tick
+    Clock::time_point m_start;  // start of current tick's work
+
+    int64 m_ticks;
+    int64 m_overruns;
+    int64 m_skipped;
+    double m_drift;
+    double m_driftMax;
+    double m_max;
+
+    // ring of recent tick durations
+    std::vector<double> m_samples;
+    uint32 m_sampleIdx;
+};
+
+#define sTickScheduler \
+    ( TickScheduler::get() )
+
+#endif  // EVEMU_EVESERVER_TICKSCHEDULER_H_
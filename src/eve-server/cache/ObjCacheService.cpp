@@ -281,14 +281,11 @@ PyResult ObjCacheService::Handle_GetCachableObject(PyCallArgs &call) {
     if(!_LoadCachableObject(args.objectID))
         return nullptr;   //print done already
 
-    //should we check their version? I am pretty sure they check it and only request what they want.
-    //well, we want to do something like this, but this doesn't seem to be it. taken
-    // out until we have time to figure out how to properly throw the CacheOK exception.
-    /*if(m_cache.IsCacheUpToDate(args.objectID, args.version, args.timestamp)) {
-        //they throw an exception for "its up to date", lets give it a try...
-        return new CacheOK();
+    // client sends the version of its own copy.  when it matches ours, client keeps its copy on CacheOK
+    if (m_cache.IsCacheUpToDate(args.objectID, (uint32)args.version, args.timestamp)) {
+        _log(CACHE__MESSAGE, "Client copy of '%s' is current.  Sending CacheOK.", CachedObjectMgr::OIDToString(args.objectID).c_str());
+        throw PyException(new CacheOK());
     }
-    */
 
     PyObject *result = m_cache.GetCachedObject(args.objectID);
 
@@ -425,6 +422,9 @@ bool ObjCacheService::IsCacheLoaded(const PyRep *objectID) const {
 
 void ObjCacheService::InvalidateCache(const PyRep *objectID) {
     m_cache.InvalidateCache(objectID);
+    // or the old contents are loaded again from file
+    if (!m_cacheDir.empty())
+        CachedObjectMgr::RemoveCachedFile(m_cacheDir, objectID);
 }
 
 void ObjCacheService::GiveCache(const PyRep *objectID, PyRep **contents) {
@@ -33,6 +33,7 @@
 #include "cache/ObjCacheService.h"
 #include "character/CharUnboundMgrService.h"
 #include "imageserver/ImageServer.h"
+#include "market/MarketMgr.h"
 #include "station/StationDataMgr.h"
 
 PyCallable_Make_InnerDispatcher(CharUnboundMgrService)
@@ -83,7 +84,9 @@ PyResult CharUnboundMgrService::Handle_GetCharactersToSelect(PyCallArgs &call)
 
 PyResult CharUnboundMgrService::Handle_DeleteCharacter(PyCallArgs &call)
 {
-    m_db.DeleteCharacter(PyRep::IntegerValue(call.tuple->GetItem(0)));
+    uint32 charID(PyRep::IntegerValue(call.tuple->GetItem(0)));
+    sMktMgr.RemoveOwnerOrders(charID);
+    m_db.DeleteCharacter(charID);
     return nullptr;
 }
 
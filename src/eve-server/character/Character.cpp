@@ -36,6 +36,7 @@
 #include "effects/EffectsProcessor.h"
 #include "fleet/FleetService.h"
 #include "inventory/AttributeEnum.h"
+#include "market/MarketMgr.h"
 #include "ship/Ship.h"
 
 /*
@@ -283,6 +284,7 @@ bool Character::_Load() {
         SkillRef sRef = GetSkill(m_skillQueue.front().typeID);
         if (sRef.get() != nullptr) {
             sRef->SetFlag(flagSkillInTraining, false);
+            SkillsChanged();
             m_inTraining = sRef.get();
         }
     } else {
@@ -354,6 +356,7 @@ void Character::Delete() {
     // delete contents
     pInventory->DeleteContents();
     // delete character record
+    sMktMgr.RemoveOwnerOrders(m_itemID);
     m_db.DeleteCharacter(m_itemID);
     // let the parent care about the rest
     InventoryItem::Delete();
@@ -492,6 +495,27 @@ void Character::ResetModifiers()
     }
 }
 
+void Character::UpdateSkillModifiers(InventoryItem* pSkill, bool update/*false*/)
+{
+    if (m_pClient == nullptr)
+        return;
+    ShipItemRef pShip = m_pClient->GetShip();
+    if (pShip.get() == nullptr)
+        return;
+    // only modifiers using this skill's level are recalculated
+    pShip->GetFxGraph().UpdateSource(pSkill, AttrSkillLevel, update);
+}
+
+void Character::SkillsChanged()
+{
+    if (m_pClient == nullptr)
+        return;
+    ShipItemRef pShip = m_pClient->GetShip();
+    if (pShip.get() == nullptr)
+        return;
+    pShip->GetFxGraph().ResetSkillIndex();
+}
+
 void Character::ProcessEffects(ShipItem* pShip)
 {
     _log(EFFECTS__TRACE, "Character::ProcessEffects()");
@@ -508,10 +532,7 @@ void Character::ProcessEffects(ShipItem* pShip)
         sFxDataMgr.GetTypeEffect(curSkill->typeID(), typeFx);
         for (auto curFx : typeFx) {
             curEffect = sFxDataMgr.GetEffect(curFx.effectID);
-            fxData data = fxData();
-            data.action = FX::Action::Invalid;
-            data.srcRef = curSkill;
-            sFxProc.ParseExpression(this, sFxDataMgr.GetExpression(curEffect.preExpression), data);
+            sFxProc.ExecuteExpression(this, curEffect.preExpression, curSkill);
         }
     }
     // apply processed char effects
@@ -551,6 +572,7 @@ void Character::ClearSkillFlags()
     pInventory->GetItemsByFlag(flagSkill, skills);
     for (auto cur : skills)
         cur->SetFlag(flagSkill, false);
+    SkillsChanged();
 }
 
 uint8 Character::GetSPPerMin(Skill* skill)
@@ -627,6 +649,7 @@ int64 Character::GetEndOfTraining() {
         sLog.Error("SkillQueue", "%s(%u) flagged as training but queue empty", \
                 m_inTraining->name(), m_inTraining->itemID());
         m_inTraining->SetFlag(flagSkill, true);
+        SkillsChanged();
         m_inTraining = nullptr;
         m_pClient->SetTrainingEndTime(0);
         return 0;
@@ -732,6 +755,7 @@ uint8 Character::InjectSkillIntoBrain(SkillRef skill) {
 
     skill->ChangeSingleton(true);
     skill->Move(m_itemID, flagSkill, true);
+    SkillsChanged();
     skill->SetAttribute(AttrSkillPoints, EvilZero.get_uint32());
     skill->SetAttribute(AttrSkillLevel, EvilZero.get_uint32(), false);
 
@@ -794,6 +818,7 @@ void Character::LoadPausedSkillQueue(uint16 typeID)
     // get first skill, add start history and send begin training packet
     skill = GetSkill(m_skillQueue.front().typeID).get();
     skill->SetFlag(flagSkillInTraining, true);
+    SkillsChanged();
     skill->SaveItem();
 
     OnSkillStartTraining osst;
@@ -847,6 +872,7 @@ void Character::CancelSkillInTraining(bool update/*false*/)
 
         m_inTraining->SetAttribute(AttrSkillPoints, currentSP, update);
         m_inTraining->SetFlag(flagSkill, update);
+        SkillsChanged();
         m_inTraining->SaveItem();
         m_inTraining = nullptr;
         // either way, training canceled.
@@ -867,6 +893,7 @@ void Character::CancelSkillInTraining(bool update/*false*/)
 
         // update attribs and save
         m_inTraining->SetAttribute(AttrSkillLevel, nextLvl, false);
+        UpdateSkillModifiers(m_inTraining, update);
         currentSP = m_inTraining->GetSPForLevel(nextLvl);
         SaveSkillHistory(EvESkill::Event::TrainingComplete, qs.endTime, m_itemID, m_inTraining->typeID(), nextLvl, currentSP);
 
@@ -891,6 +918,7 @@ void Character::CancelSkillInTraining(bool update/*false*/)
 
     m_inTraining->SetAttribute(AttrSkillPoints, currentSP, update);
     m_inTraining->SetFlag(flagSkill, update);
+    SkillsChanged();
     m_inTraining->SaveItem();
 
     // remove from queue, if applicable
@@ -922,6 +950,7 @@ void Character::AddToSkillQueue(uint16 typeID, uint8 level) {
         // level to train is below current level. update client data and return.
         SaveSkillHistory(EvESkill::Event::TaskMaster, curTime, m_itemID, typeID, level, currentSP);
         skill->SetFlag(flagSkill, true);
+        SkillsChanged();
         skill->SaveItem();
 
         OnSkillTrained ost;
@@ -941,6 +970,7 @@ void Character::AddToSkillQueue(uint16 typeID, uint8 level) {
         // it's not.  update client data and return.
         SaveSkillHistory(EvESkill::Event::TaskMaster, curTime, m_itemID, typeID, level, currentSP);
         skill->SetFlag(flagSkill, true);
+        SkillsChanged();
         skill->SaveItem();
 
         OnSkillTrained ost;
@@ -960,6 +990,7 @@ void Character::AddToSkillQueue(uint16 typeID, uint8 level) {
     if (m_skillQueue.empty()) {
         // nothing in queue.  begin training this skill
         skill->SetFlag(flagSkillInTraining, true);
+        SkillsChanged();
         m_inTraining = skill;
         qs.startTime = curTime;
         qs.endTime = EvEMath::Skill::EndTime(currentSP, nextSP, GetSPPerMin(skill), curTime);
@@ -1033,6 +1064,7 @@ void Character::SkillQueueLoop(bool update/*true*/)
             // this should not hit at this point.
             _log(SKILL__ERROR, "endTime wasnt set.  Erase from queue and continue.");
             skill->SetFlag(flagSkill, true);
+            SkillsChanged();
             skill->SaveItem();
             m_skillQueue.erase( m_skillQueue.begin() );
             skill = nullptr;
@@ -1050,8 +1082,10 @@ void Character::SkillQueueLoop(bool update/*true*/)
 
             // update attribs and save
             skill->SetAttribute(AttrSkillLevel, qs.level, update);
+            UpdateSkillModifiers(skill, update);
             skill->SetAttribute(AttrSkillPoints, currentSP, update);
             skill->SetFlag(flagSkill, update);
+            SkillsChanged();
             skill->SaveItem();
 
             // remove completed skill level from queue
@@ -1116,6 +1150,7 @@ void Character::SkillQueueLoop(bool update/*true*/)
         uint32 nextSP(skill->GetSPForLevel(qs.level));
         SaveSkillHistory(EvESkill::Event::TrainingStarted, qs.startTime, m_itemID, qs.typeID, qs.level, nextSP);
         skill->SetFlag(flagSkillInTraining, true);
+        SkillsChanged();
         skill->SaveItem();
         m_inTraining = skill;
 
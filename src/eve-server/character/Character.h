@@ -378,6 +378,10 @@ public:
     // NOTE:  implants and boosters not implemented yet
     void                    ProcessEffects(ShipItem* pShip);
     void                    ResetModifiers();   // this will reset ALL char and skill attribs and modifier maps to default
+    // skill level changed.  recalculates attributes in current ship which depend on it
+    void                    UpdateSkillModifiers(InventoryItem* pSkill, bool update=false);
+    // skill moved into or out of flagSkill.  current ship reindexes skills on next use
+    void                    SkillsChanged();
 
 protected:
     Character(
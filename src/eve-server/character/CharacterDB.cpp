@@ -143,6 +143,7 @@ void CharacterDB::DeleteCharacter(uint32 characterID) {
     sDatabase.RunQuery(err, "DELETE FROM bookmarks WHERE ownerID = %u",  characterID);
     sDatabase.RunQuery(err, "DELETE FROM bookmarkFolders WHERE ownerID = %u",  characterID);
     //sDatabase.RunQuery(err, "DELETE FROM bookmarkVouchers WHERE ownerID = %u",  characterID);
+    sDatabase.WaitFor(characterID);     // queued orders and transactions
     sDatabase.RunQuery(err, "DELETE FROM mktOrders WHERE ownerID = %u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM mktTransactions WHERE clientID = %u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM repStandings WHERE (fromID = %u OR toID = %u)", characterID, characterID);
@@ -157,6 +158,7 @@ void CharacterDB::DeleteCharacter(uint32 characterID) {
     sDatabase.RunQuery(err, "DELETE FROM crpApplications WHERE characterID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrCharacterAttributes WHERE charID = %u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrPausedSkillQueue WHERE characterID = %u", characterID);
+    sDatabase.Flush();  // queued ship state of owned items
     sDatabase.RunQuery(err, "DELETE FROM entity_attributes"
                             " WHERE itemID IN (SELECT itemID FROM entity WHERE ownerID = %u)", characterID);
     sDatabase.RunQuery(err, "DELETE FROM entity WHERE ownerID = %u", characterID);
@@ -2424,7 +2424,8 @@ PyRep* CorporationDB::GetKillsAndLosses(uint32 corpID, uint32 number, uint32 off
 
 PyRep* CorporationDB::GetMktInfo(uint32 corpID)
 {
-    // bid = buy order
+    // bid = buy order.  order changes are written through the write queue
+    sDatabase.WaitFor(corpID);
     DBQueryResult res;
     if (!sDatabase.RunQuery(res,
         "SELECT sell.typeID AS typeID, sell.price AS sellPrice, sell.volRemaining AS sellQuantity, sell.issued AS sellDate, sell.stationID AS sellStationID, "
@@ -14,6 +14,8 @@
 
 #include "../eve-server.h"
 
+#include "effects/FxExpression.h"
+
 
 // POD for effect data in mem objects
 struct Effect {
@@ -40,19 +42,6 @@ struct Effect {
     std::string guid;
 };
 
-struct Expression {
-    int8 operandID;
-    uint16 id;
-    uint16 arg1;
-    uint16 arg2;
-    uint16 expressionTypeID;
-    uint16 expressionGroupID;
-    uint16 expressionAttributeID;
-    std::string expressionValue;
-    std::string description;
-    std::string expressionName;
-};
-
 struct Operand {
     uint8 resultCategoryID;
     uint16 arg1categoryID;
@@ -66,214 +55,15 @@ struct TypeEffects {
     uint16 effectID;
 };
 
-struct fxData {
-    int8 math;          // math used on data
-    int8 fxSrc;        // effect source location
-    int8 targLoc;       // effect target location
-    uint8 action;        // effect *DOES* something (module action aside from modification)
-    uint16 targAttr;
-    uint16 srcAttr;
-    uint16 grpID;       // used to define items in env grouped by item groupID
-    uint16 typeID;      // used to define items in env grouped by skill requirement
+/* modifier with the item it came from.  see fxModifier for the rest */
+struct fxData
+: public fxModifier
+{
     InventoryItemRef srcRef;   // source item ref, if required
 };
 
 typedef std::map<uint16, Effect> effectMapType;
 
-// these tables are used to decode fields in Effects table
-namespace FX {
-
-    namespace Source {    // formally known as domain
-        enum {
-            Invalid          = -1,
-            //  these define the location for group-, skill-, gang-, and owner-required effects
-            Self             = 0,
-            Skill            = 1,
-            Ship             = 2,
-            Owner            = 3,
-            Gang             = 4,
-            Group            = 5,
-            Target           = 6
-        };
-    }
-
-    namespace Target {    //formally known as environment
-        enum {
-            Invalid         = -1,
-            // these define the item containing the attribute to be modified
-            //  these are found (as text) in the expressionValue field of dgmExpressions table and may need to merge with Association, or test with it
-            Self            = 0,
-            Char            = 1,
-            Ship            = 2,
-            Target          = 3,
-            Other           = 4,
-            Area            = 5,
-            PowerCore       = 6,  //defined but not used
-            Charge          = 7,
-            MaxTargLocation = 7
-        };
-    }
-
-    namespace State {   // formally known as category
-        enum {
-            Invalid        = -1,
-            // these are the effectCategory in dgmEffects table to denote when this effect is applied or removed
-            Passive        = 0, //Applied when item is present and online - implants, skills, modules, charges
-            Active         = 1, //Applied when active module is activated
-            Target         = 2, //Applied onto selected target when module is activated
-            Area           = 3, //defined but not used
-            Online         = 4, //Applied when module is onlined
-            Overloaded     = 5, //Applied when module is overloaded and activated
-            Dungeon        = 6, //Dungeon effects, several effects exist in this category, but not assigned to any item  -passive
-            System         = 7  //System-wide effects, like WH and incursion  -passive
-        };
-    }
-
-    namespace Math {    // formally known as association
-        enum {
-            Invalid        = -1,
-            // these define how the data is manipulated according to the format field in dgmOperands table
-            PreAssignment  = 0,
-            PreMul         = 1,
-            PreDiv         = 2,
-            ModAdd         = 3,
-            ModSub         = 4,
-            PostMul        = 5,
-            PostDiv        = 6,
-            PostPercent    = 7,
-            PostAssignment = 8,
-            SkillCheck     = 9,
-            /* no data or expressions with these next two */
-            AddRate        = 10,
-            SubRate        = 11,
-            RevPostPercent = 12,
-            MaxMathMethod  = 12
-        };
-    }
-
-    namespace Action {  // this are coded and are applied on the fly as needed.
-        enum {
-            Invalid               = 0,
-            ATTACK                   = 13,
-            CARGOSCAN                = 14,
-            CHEATTELEDOCK            = 15,
-            CHEATTELEGATE            = 16,
-            DECLOAKWAVE              = 19,
-            ECMBURST                 = 30,
-            EMPWAVE                  = 32,
-            LAUNCH                   = 44,
-            LAUNCHDEFENDERMISSILE    = 45,
-            LAUNCHDRONE              = 46,
-            LAUNCHFOFMISSILE         = 47,
-            MINE                     = 50,
-            POWERBOOST               = 53,   //effectID 48  - Consumes power booster charges to increase the available power in the capacitor.
-            SHIPSCAN                 = 66,
-            SURVEYSCAN               = 69,
-            TARGETHOSTILES           = 70,
-            TARGETSILENTLY           = 71,
-            TOOLTARGETSKILLS         = 72,
-            VERIFYTARGETGROUP        = 74,
-            /* unique/special to EVEmu */
-            SPEEDBOOST               = 75    //effectID 14  - prop mod to call destiny speed updates
-        };
-    }
-
-    /*  old shit
-             case CALC_NONE:                            return val1;
-             case CALC_ADD:                             return val1 + val2;
-             case CALC_SUBTRACT:                        return val1 - val2;
-             case CALC_MULTIPLY:                        return val1 * val2;
-             case CALC_DIVIDE:                          return ((val2 != 0) ? val1 / val2 : val1);
-             case CALC_PERCENTAGE:                      return val1 * (1 + (val2 / 100));
-             case CALC_REV_PERCENTAGE:                  return val1 / (1 + (val2 / 100));
-             case CALC_ADD_PERCENT:                     return val1 + (val2 / 100);
-             case CALC_SUBTRACT_PERCENT:                return val1 - (val2 / 100);
-             case CALC_ADD_RESIST:                      return val1 - (1 - val2);
-             case CALC_SUBTRACT_RESIST:                 return val1 + (1 - val2);
-     */
-
-    namespace Operands {
-        enum {
-            // @note  '//*' denotes implemented
-            ADD = 1,             //*
-            AGGM = 2,            //*
-            AGSM = 3,            //*
-            AGORSM = 4,          //*
-            AGRSM = 5,           //*
-            AIM = 6,             //*
-            ALGM = 7,            //*
-            ALM = 8,             //*
-            ALRSM = 9,           //*
-            AND = 10,            //*
-            AORSM = 11,          //*
-            ATT = 12,            //*
-            ATTACK = 13,
-            CARGOSCAN = 14,
-            CHEATTELEDOCK = 15,
-            CHEATTELEGATE = 16,
-            COMBINE = 17,        //*
-            DEC = 18,            //*
-            DECLOAKWAVE = 19,
-            DECN = 20,           //*
-            DEFASSOCIATION = 21, //*
-            DEFATTRIBUTE = 22,   //*
-            DEFBOOL = 23,        //*
-            DEFENVIDX = 24,      //*
-            DEFFLOAT = 25,       //*
-            DEFGROUP = 26,       //*
-            DEFINT = 27,         //*
-            DEFSTRING = 28,      //*
-            DEFTYPEID = 29,      //*
-            ECMBURST = 30,
-            EFF = 31,            //*
-            EMPWAVE = 32,
-            EQ = 33,             //*
-            GA = 34,             //*
-            GET = 35,            //*
-            GETTYPE = 36,        //*
-            GM = 37,             //*
-            GT = 38,             //*
-            GTE = 39,            //*
-            IA = 40,             //*
-            IF = 41,             //*
-            INC = 42,            //*
-            INCN = 43,           //*
-            LAUNCH = 44,
-            LAUNCHDEFENDERMISSILE = 45,
-            LAUNCHDRONE = 46,
-            LAUNCHFOFMISSILE = 47,
-            LG = 48,             //*
-            SRLG = 49,           //*
-            MINE = 50,
-            MUL = 51,            //*
-            OR = 52,             //*
-            POWERBOOST = 53,
-            RGGM = 54,           //*
-            RGSM = 55,           //*
-            RGORSM = 56,         //*
-            RGRSM = 57,          //*
-            RIM = 58,            //*
-            RLGM = 59,           //*
-            RLM = 60,            //*
-            RLRSM = 61,          //*
-            RORSM = 62,          //*
-            RS = 63,             //*
-            RSA = 64,            //*
-            SET = 65,            //*
-            SHIPSCAN = 66,
-            SKILLCHECK = 67,     //*
-            SUB = 68,            //*
-            SURVEYSCAN = 69,
-            TARGETHOSTILES = 70,
-            TARGETSILENTLY = 71,
-            TOOLTARGETSKILLS = 72,
-            UE = 73,             //*
-            VERIFYTARGETGROUP = 74,
-            SPEEDBOOST = 75      //*
-        };
-    }
-}
-
 
 /*  not sure what these are...
  * dgmEffActivation = 1
@@ -139,9 +139,19 @@ void FxDataMgr::Populate()
     m_effectMap[0] = mEffect;
     sLog.Cyan("        FxDataMgr", "%u Effect Types loaded in %.3fms.", m_effectMap.size(), (GetTimeMSeconds() - start));
 
+    start = GetTimeMSeconds();
+    GetPenalizedAttributes(*res);
+    while (res->GetRow(row))
+        m_penalized.insert(row.GetInt(0));
+    sLog.Cyan("        FxDataMgr", "%u Stacking Penalized Attributes loaded in %.3fms.", m_penalized.size(), (GetTimeMSeconds() - start));
+
     //cleanup
     SafeDelete(res);
 
+    start = GetTimeMSeconds();
+    CompilePrograms();
+    sLog.Cyan("        FxDataMgr", "%u Expressions compiled in %.3fms.", (uint32)m_programs[0].size(), (GetTimeMSeconds() - start));
+
     m_loaded = true;
     sLog.Cyan("        FxDataMgr", "Effects Data loaded in %.3fms.", (GetTimeMSeconds() - begin));
 }
@@ -161,6 +171,40 @@ void FxDataMgr::GetTypeEffect(uint16 typeID, std::vector< TypeEffects >& typeEff
         typeEffMap.push_back(it->second);
 }
 
+void FxDataMgr::GetTypeIDs(std::vector< uint16 >& typeIDs)
+{
+    for (auto cur : m_typeFxMap)
+        typeIDs.push_back(cur.first);
+    std::sort(typeIDs.begin(), typeIDs.end());
+    typeIDs.erase(std::unique(typeIDs.begin(), typeIDs.end()), typeIDs.end());
+}
+
+void FxDataMgr::CompilePrograms()
+{
+    for (uint8 skill = 0; skill < 2; ++skill) {
+        m_programs[skill].clear();
+        m_programs[skill][0] = fxProgram();     // empty program for effects without pre/post expression
+        for (auto cur : m_effectMap) {
+            uint16 expressions[2] = {cur.second.preExpression, cur.second.postExpression};
+            for (auto expID : expressions) {
+                if (m_programs[skill].find(expID) != m_programs[skill].end())
+                    continue;
+                fxStep step = fxStep();
+                step.data.action = FX::Action::Invalid;
+                FX::CompileExpression(m_expMap, expID, (skill > 0), step, m_programs[skill][expID]);
+            }
+        }
+    }
+}
+
+const fxProgram& FxDataMgr::GetProgram(uint16 expID, bool skill)
+{
+    std::unordered_map<uint16, fxProgram>::const_iterator itr = m_programs[skill ? 1 : 0].find(expID);
+    if (itr != m_programs[skill ? 1 : 0].end())
+        return itr->second;
+    return m_programs[skill ? 1 : 0].at(0);
+}
+
 Expression FxDataMgr::GetExpression(uint16 eID)
 {
     std::map<uint16, Expression>::const_iterator itr = m_expMap.find(eID);
@@ -307,3 +351,15 @@ void FxDataMgr::GetDgmTypeEffects(DBQueryResult &res)
         codelog(DATABASE__ERROR, "Error in GetDgmTypeEffects: %s", res.error.c_str());
     }
 }
+
+void FxDataMgr::GetPenalizedAttributes(DBQueryResult &res)
+{
+    if( !sDatabase.RunQuery(res,
+        " SELECT"
+        "  attributeID"
+        " FROM dgmAttributeTypes "
+        " WHERE stackable = 0"))
+    {
+        codelog(DATABASE__ERROR, "Error in GetPenalizedAttributes: %s", res.error.c_str());
+    }
+}
@@ -33,8 +33,17 @@ public:
     Effect GetEffect(uint16 eID);
     Operand GetOperand(uint16 oID);
     Expression GetExpression(uint16 eID);
+    const ExpressionMap& GetExpressions()               { return m_expMap; }
 
     void GetTypeEffect(uint16 typeID, std::vector< TypeEffects >& typeEffMap);
+    // gets all typeIDs having effects
+    void GetTypeIDs(std::vector< uint16 >& typeIDs);
+
+    /* compiled expression, as run by FxProc::ExecuteExpression().  skill denotes source is skill, implant or booster */
+    const fxProgram& GetProgram(uint16 expID, bool skill);
+
+    // attribute is not stackable.  multiplying modifiers on it are stacking penalized
+    bool IsPenalized(uint16 attrID)                     { return (m_penalized.find(attrID) != m_penalized.end()); }
 
     float GetFxTime()                                   { return m_time; }
     uint16 GetFxSize()                                  { return m_fxMap.size(); }
@@ -44,6 +53,10 @@ protected:
     void GetDgmEffects(DBQueryResult& res);
     void GetExpressions(DBQueryResult& res);
     void GetDgmTypeEffects(DBQueryResult &res);
+    void GetPenalizedAttributes(DBQueryResult &res);
+
+    // compiles pre and post expressions of all effects
+    void CompilePrograms();
 
 private:
     bool m_loaded;
@@ -54,9 +67,11 @@ private:
 
     effectMapType m_effectMap;  //std::map<uint16, Effect>
     std::map<uint16, Operand> m_opMap;
-    std::map<uint16, Expression> m_expMap;
+    ExpressionMap m_expMap;
     std::map<std::string, uint16> m_effectName;  // k,v of effectID, effectName.  maps all effectIDs to their name.
     std::unordered_multimap<uint16, TypeEffects> m_typeFxMap;  // k,v of typeID, data<effectID, isDefault>
+    std::unordered_map<uint16, fxProgram> m_programs[2];  // k,v of expressionID, compiled expression.  [0] item source, [1] skill source
+    std::unordered_set<uint16> m_penalized;     // attributeIDs of non-stackable attributes
 };
 
 #define sFxDataMgr \
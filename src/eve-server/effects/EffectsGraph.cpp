@@ -0,0 +1,427 @@
+/**
+ * @name EffectsGraph.cpp
+ *   This file is for keeping applied modifiers of a ship, so a change only recalculates what it affects
+ *   Copyright 2017  EVEmu Team
+ *
+ * @Author:    EVEmu Team
+ *
+ */
+
+
+#include "effects/EffectsGraph.h"
+#include "effects/EffectsProcessor.h"
+#include "character/Character.h"
+
+
+const uint8 FX_GRAPH_MAX_DEPTH = 16;
+// dogma stacking penalty.  nth strongest modifier is applied at exp(-(n/2.67)^2)
+const double FX_STACKING_DIVISOR = 2.67;
+
+
+FxGraph::FxGraph()
+: m_skillIndex(false)
+{
+}
+
+FxGraph::~FxGraph()
+{
+}
+
+void FxGraph::Clear()
+{
+    m_nodes.clear();
+    m_dependents.clear();
+    m_groupFilters.clear();
+    m_moduleFilters.clear();
+    m_chargeFilters.clear();
+    m_skillsBySkill.clear();
+    m_skillIndex = false;
+}
+
+void FxGraph::AddModule(InventoryItemRef iRef, bool update/*false*/)
+{
+    AddIndex(m_modsByGroup, iRef->groupID(), iRef);
+    for (auto cur : iRef->type().GetReqSkills())
+        AddIndex(m_modsBySkill, cur.first, iRef);
+
+    auto range = m_groupFilters.equal_range(iRef->groupID());
+    for (auto itr = range.first; itr != range.second; ++itr)
+        AddModifier(iRef, itr->second, update);
+    for (auto cur : iRef->type().GetReqSkills()) {
+        range = m_moduleFilters.equal_range(cur.first);
+        for (auto itr = range.first; itr != range.second; ++itr)
+            AddModifier(iRef, itr->second, update);
+    }
+}
+
+void FxGraph::AddCharge(InventoryItemRef iRef, bool update/*false*/)
+{
+    for (auto cur : iRef->type().GetReqSkills()) {
+        AddIndex(m_chargesBySkill, cur.first, iRef);
+        auto range = m_chargeFilters.equal_range(cur.first);
+        for (auto itr = range.first; itr != range.second; ++itr)
+            AddModifier(iRef, itr->second, update);
+    }
+}
+
+void FxGraph::RemoveModule(InventoryItemRef iRef, bool update/*false*/)
+{
+    RemoveIndex(m_modsByGroup, iRef->groupID(), iRef->itemID());
+    for (auto cur : iRef->type().GetReqSkills())
+        RemoveIndex(m_modsBySkill, cur.first, iRef->itemID());
+    RemoveItem(iRef, update);
+}
+
+void FxGraph::RemoveCharge(InventoryItemRef iRef, bool update/*false*/)
+{
+    for (auto cur : iRef->type().GetReqSkills())
+        RemoveIndex(m_chargesBySkill, cur.first, iRef->itemID());
+    RemoveItem(iRef, update);
+}
+
+void FxGraph::RemoveItem(InventoryItemRef iRef, bool update)
+{
+    uint32 itemID = iRef->itemID();
+
+    // reset item's modified attributes
+    std::map<uint64_t, fxNode>::iterator first = m_nodes.lower_bound(Key(itemID, 0));
+    std::map<uint64_t, fxNode>::iterator last = m_nodes.lower_bound(Key(itemID + 1, 0));
+    for (std::map<uint64_t, fxNode>::iterator itr = first; itr != last; ++itr) {
+        for (auto& edge : itr->second.edges) {
+            auto range = m_dependents.equal_range(Key(edge.srcRef->itemID(), edge.srcAttr));
+            for (auto dep = range.first; dep != range.second; ++dep)
+                if (dep->second == itr->first) {
+                    m_dependents.erase(dep);
+                    break;
+                }
+        }
+        if (itr->second.value != itr->second.base)
+            iRef->SetAttribute((uint16)(itr->first & 0xFFFF), itr->second.base, update);
+    }
+    m_nodes.erase(first, last);
+
+    // drop modifiers it is source of
+    std::multimap<uint64_t, uint64_t>::iterator dFirst = m_dependents.lower_bound(Key(itemID, 0));
+    std::multimap<uint64_t, uint64_t>::iterator dLast = m_dependents.lower_bound(Key(itemID + 1, 0));
+    std::set<uint64_t> targets;
+    for (std::multimap<uint64_t, uint64_t>::iterator itr = dFirst; itr != dLast; ++itr)
+        targets.insert(itr->second);
+    m_dependents.erase(dFirst, dLast);
+    for (auto key : targets) {
+        std::map<uint64_t, fxNode>::iterator itr = m_nodes.find(key);
+        if (itr == m_nodes.end())
+            continue;
+        std::vector<fxEdge>& edges = itr->second.edges;
+        for (std::vector<fxEdge>::iterator edge = edges.begin(); edge != edges.end(); )
+            if (edge->srcRef->itemID() == itemID) {
+                edge = edges.erase(edge);
+            } else {
+                ++edge;
+            }
+        Recalculate(key, update);
+    }
+
+    std::unordered_multimap<uint16, fxData>* filters[3] = {&m_groupFilters, &m_moduleFilters, &m_chargeFilters};
+    for (auto filter : filters)
+        for (auto itr = filter->begin(); itr != filter->end(); )
+            if (itr->second.srcRef->itemID() == itemID) {
+                itr = filter->erase(itr);
+            } else {
+                ++itr;
+            }
+}
+
+void FxGraph::GetModulesByGroup(uint16 groupID, std::vector<InventoryItemRef>& into)
+{
+    GetIndex(m_modsByGroup, groupID, into);
+}
+
+void FxGraph::GetModulesByReqSkill(uint16 skillID, std::vector<InventoryItemRef>& into)
+{
+    GetIndex(m_modsBySkill, skillID, into);
+}
+
+void FxGraph::GetChargesByReqSkill(uint16 skillID, std::vector<InventoryItemRef>& into)
+{
+    GetIndex(m_chargesBySkill, skillID, into);
+}
+
+void FxGraph::GetSkillsByReqSkill(Character* pChar, uint16 skillID, std::vector<InventoryItemRef>& into)
+{
+    if (!m_skillIndex) {
+        std::vector<InventoryItemRef> allSkills;
+        pChar->GetSkillsList(allSkills);
+        for (auto curSkill : allSkills)
+            for (auto cur : curSkill->type().GetReqSkills())
+                AddIndex(m_skillsBySkill, cur.first, curSkill);
+        m_skillIndex = true;
+    }
+    GetIndex(m_skillsBySkill, skillID, into);
+}
+
+void FxGraph::ApplyModifier(InventoryItemRef targRef, const fxData& data, bool update/*false*/)
+{
+    if (data.remove) {
+        RemoveModifier(targRef, data, update);
+    } else {
+        AddModifier(targRef, data, update);
+    }
+}
+
+void FxGraph::ApplyFilter(const fxData& data)
+{
+    using namespace FX;
+    std::unordered_multimap<uint16, fxData>* filters(nullptr);
+    uint16 key(0);
+    if (data.fxSrc == Source::Group) {
+        filters = &m_groupFilters;
+        key = data.grpID;
+    } else if ((data.fxSrc == Source::Skill) and (data.typeID)) {
+        if (data.targLoc == Target::Ship) {
+            filters = &m_moduleFilters;
+        } else if (data.targLoc == Target::Charge) {
+            filters = &m_chargeFilters;
+        }
+        key = data.typeID;
+    }
+    if (filters == nullptr)
+        return;
+
+    if (!data.remove) {
+        filters->emplace(key, data);
+        return;
+    }
+
+    int8 math = FX::GetReverseMathMethod(data.math);
+    auto range = filters->equal_range(key);
+    for (auto itr = range.first; itr != range.second; ++itr)
+        if ((itr->second.math == math)
+        and (itr->second.targLoc == data.targLoc)
+        and (itr->second.targAttr == data.targAttr)
+        and (itr->second.srcAttr == data.srcAttr)
+        and (itr->second.srcRef->itemID() == data.srcRef->itemID())) {
+            filters->erase(itr);
+            return;
+        }
+}
+
+void FxGraph::UpdateSource(InventoryItem* pItem, uint16 attrID, bool update/*false*/)
+{
+    RecalculateDependents(Key(pItem->itemID(), attrID), update, 0);
+}
+
+bool FxGraph::IsPenalized(const fxData& data)
+{
+    switch (data.math) {
+        case FX::Math::PreMul:
+        case FX::Math::PreDiv:
+        case FX::Math::PostMul:
+        case FX::Math::PostDiv:
+        case FX::Math::PostPercent:
+            break;
+        default:
+            return false;
+    }
+    switch (data.srcRef->categoryID()) {
+        case EVEDB::invCategories::Ship:
+        case EVEDB::invCategories::Charge:
+        case EVEDB::invCategories::Skill:
+        case EVEDB::invCategories::Implant:
+        case EVEDB::invCategories::Subsystem:
+            return false;
+    }
+    return sFxDataMgr.IsPenalized(data.targAttr);
+}
+
+void FxGraph::AddModifier(InventoryItemRef targRef, const fxData& data, bool update)
+{
+    uint64_t key = Key(targRef->itemID(), data.targAttr);
+    std::map<uint64_t, fxNode>::iterator itr = m_nodes.find(key);
+    if (itr == m_nodes.end()) {
+        fxNode node = fxNode();
+            node.base = targRef->GetAttribute(data.targAttr);
+            node.value = node.base;
+            node.itemRef = targRef;
+        itr = m_nodes.emplace(key, node).first;
+    }
+
+    fxEdge edge = fxEdge();
+        edge.math = data.math;
+        edge.penalized = IsPenalized(data);
+        edge.srcAttr = data.srcAttr;
+        edge.srcRef = data.srcRef;
+    itr->second.edges.push_back(edge);
+    m_dependents.emplace(Key(data.srcRef->itemID(), data.srcAttr), key);
+
+    Recalculate(key, update);
+}
+
+void FxGraph::RemoveModifier(InventoryItemRef targRef, const fxData& data, bool update)
+{
+    uint64_t key = Key(targRef->itemID(), data.targAttr);
+    std::map<uint64_t, fxNode>::iterator itr = m_nodes.find(key);
+    if (itr != m_nodes.end()) {
+        int8 math = FX::GetReverseMathMethod(data.math);
+        std::vector<fxEdge>& edges = itr->second.edges;
+        for (std::vector<fxEdge>::iterator edge = edges.begin(); edge != edges.end(); ++edge) {
+            if ((edge->math != math)
+            or  (edge->srcAttr != data.srcAttr)
+            or  (edge->srcRef->itemID() != data.srcRef->itemID()))
+                continue;
+
+            edges.erase(edge);
+            uint64_t srcKey = Key(data.srcRef->itemID(), data.srcAttr);
+            auto range = m_dependents.equal_range(srcKey);
+            for (auto dep = range.first; dep != range.second; ++dep)
+                if (dep->second == key) {
+                    m_dependents.erase(dep);
+                    break;
+                }
+            Recalculate(key, update);
+            return;
+        }
+    }
+
+    // attributes have been reset since modifier was added.  nothing to remove
+    _log(EFFECTS__DEBUG, "FxGraph::RemoveModifier(): %s(%u) has no %s modifier on %s(%u) attr %u.", \
+            data.srcRef->name(), data.srcRef->itemID(), sFxProc.GetMathMethodName(data.math), \
+            targRef->name(), targRef->itemID(), data.targAttr);
+}
+
+void FxGraph::Recalculate(uint64_t key, bool update, uint8 depth/*0*/)
+{
+    if (depth > FX_GRAPH_MAX_DEPTH) {
+        _log(EFFECTS__ERROR, "FxGraph::Recalculate(): attribute %u of item %u is nested too deep.  stopping here.", \
+                (uint16)(key & 0xFFFF), (uint32)(key >> 16));
+        return;
+    }
+
+    std::map<uint64_t, fxNode>::iterator itr = m_nodes.find(key);
+    if (itr == m_nodes.end())
+        return;
+
+    fxNode& node = itr->second;
+    EvilNumber newValue(node.base);
+    if (!node.edges.empty())
+        newValue = Calculate(node);
+
+    bool changed = (newValue != node.value);
+    if (changed) {
+        _log(EFFECTS__MESSAGE, "FxGraph::Recalculate(): %s(%u) attr %u from %.3f to %.3f with %u modifiers.", \
+                node.itemRef->name(), node.itemRef->itemID(), (uint16)(key & 0xFFFF), \
+                node.value.get_float(), newValue.get_float(), node.edges.size());
+        node.value = newValue;
+        // update is used to send attrib changes to client when changing module states while in space, but NOT for pilot login. (client acts funky)
+        node.itemRef->SetAttribute((uint16)(key & 0xFFFF), newValue, update);
+    }
+
+    // a node without modifiers is at its base value.  drop it, so base is taken again from item when next modified
+    if (node.edges.empty())
+        m_nodes.erase(itr);
+
+    if (changed)
+        RecalculateDependents(key, update, depth);
+}
+
+void FxGraph::RecalculateDependents(uint64_t key, bool update, uint8 depth)
+{
+    auto range = m_dependents.equal_range(key);
+    if (range.first == range.second)
+        return;
+
+    // copy, as recalculating may change dependents
+    std::set<uint64_t> targets;
+    for (auto itr = range.first; itr != range.second; ++itr)
+        targets.insert(itr->second);
+    for (auto target : targets)
+        Recalculate(target, update, depth +1);
+}
+
+static double StackingFactor(std::vector<double>& factors)
+{
+    std::sort(factors.begin(), factors.end(), [](double a, double b) { return std::fabs(a - 1.0) > std::fabs(b - 1.0); });
+    double result(1.0);
+    for (size_t i = 0; i < factors.size(); ++i)
+        result *= 1.0 + (factors[i] - 1.0) * std::exp(-std::pow(i / FX_STACKING_DIVISOR, 2));
+    return result;
+}
+
+EvilNumber FxGraph::Calculate(const fxNode& node)
+{
+    using namespace FX;
+    EvilNumber value(node.base);
+    std::vector<double> bonus, malus;
+    // Math enum is in dogma order
+    for (int8 math = Math::PreAssignment; math <= Math::SkillCheck; ++math) {
+        bonus.clear();
+        malus.clear();
+        for (auto& edge : node.edges) {
+            if (edge.math != math)
+                continue;
+
+            EvilNumber srcValue = edge.srcRef->GetAttribute(edge.srcAttr);
+            if (edge.penalized) {
+                double factor(1.0);
+                switch (math) {
+                    case Math::PreMul:
+                    case Math::PostMul:     factor = srcValue.get_double(); break;
+                    case Math::PreDiv:
+                    case Math::PostDiv:     factor = (srcValue == EvilZero ? 1.0 : 1.0 / srcValue.get_double()); break;
+                    case Math::PostPercent: factor = 1.0 + srcValue.get_double() / 100.0; break;
+                }
+                if (factor > 1.0) {
+                    bonus.push_back(factor);
+                } else if (factor < 1.0) {
+                    malus.push_back(factor);
+                }
+                continue;
+            }
+
+            switch (math) {
+                case Math::PreMul:
+                case Math::PostMul:
+                case Math::PreDiv:
+                case Math::PostDiv: {
+                    if (value == EvilZero)
+                        value = EvilOne;
+                } break;
+            }
+            value = sFxProc.CalculateAttributeValue(value, srcValue, math);
+        }
+
+        if (bonus.empty() and malus.empty())
+            continue;
+        if ((value == EvilZero) and (math != Math::PostPercent))
+            value = EvilOne;
+        value = value * EvilNumber(StackingFactor(bonus) * StackingFactor(malus));
+    }
+
+    return value;
+}
+
+void FxGraph::AddIndex(std::unordered_map<uint16, std::vector<InventoryItemRef>>& index, uint16 key, InventoryItemRef iRef)
+{
+    index[key].push_back(iRef);
+}
+
+void FxGraph::RemoveIndex(std::unordered_map<uint16, std::vector<InventoryItemRef>>& index, uint16 key, uint32 itemID)
+{
+    std::unordered_map<uint16, std::vector<InventoryItemRef>>::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
+    std::vector<InventoryItemRef>& items = itr->second;
+    for (std::vector<InventoryItemRef>::iterator cur = items.begin(); cur != items.end(); ++cur)
+        if ((*cur)->itemID() == itemID) {
+            items.erase(cur);
+            break;
+        }
+    if (items.empty())
+        index.erase(itr);
+}
+
+void FxGraph::GetIndex(std::unordered_map<uint16, std::vector<InventoryItemRef>>& index, uint16 key, std::vector<InventoryItemRef>& into)
+{
+    std::unordered_map<uint16, std::vector<InventoryItemRef>>::const_iterator itr = index.find(key);
+    if (itr != index.end())
+        into.insert(into.end(), itr->second.begin(), itr->second.end());
+}
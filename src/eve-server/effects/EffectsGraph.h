@@ -0,0 +1,116 @@
+/**
+ * @name EffectsGraph.h
+ *   This file is for keeping applied modifiers of a ship, so a change only recalculates what it affects
+ *   Copyright 2017  EVEmu Team
+ *
+ * @Author:    EVEmu Team
+ *
+ */
+
+
+#ifndef _EVE_FX_GRAPH_H__
+#define _EVE_FX_GRAPH_H__
+
+#include "effects/EffectsData.h"
+#include "inventory/InventoryItem.h"
+
+class Character;
+
+/* one modifier applied to a target attribute */
+struct fxEdge {
+    int8 math;          // FX::Math method, as added
+    bool penalized;     // in stacking penalty group of target attribute
+    uint16 srcAttr;
+    InventoryItemRef srcRef;
+};
+
+/* one modified attribute of one item */
+struct fxNode {
+    EvilNumber base;    // value before any modifier.  taken from item when first modifier is added
+    EvilNumber value;   // value as last calculated
+    InventoryItemRef itemRef;
+    std::vector<fxEdge> edges;
+};
+
+/**
+ * @brief Modifiers currently applied to a ship, its pilot, pilot's skills, modules and charges.
+ *
+ * Each modified attribute is a node keyed by (itemID, attributeID), holding its base value
+ * and every modifier on it.  Adding or removing a modifier recalculates that one attribute
+ * from its base, in dogma order with stacking penalties, and sends only a changed value to client.
+ * Attributes using a changed attribute as source are then recalculated in turn.
+ *
+ * Modules and charges on the ship are indexed by group and required skill, so modifiers
+ * with a group or skill filter find their targets without walking the fit.  These filtered
+ * modifiers are kept, and applied to modules and charges added to the ship later.
+ *
+ * Owned by ShipItem.  Cleared with the ship's attributes, on every full effects reset.
+ */
+class FxGraph
+{
+public:
+    FxGraph();
+    ~FxGraph();
+
+    // drops all modifiers, but keeps modules and charges.  called when attributes of ship and pilot are reset
+    void Clear();
+
+    // module or charge fitted or loaded.  applies kept filtered modifiers which match item
+    void AddModule(InventoryItemRef iRef, bool update=false);
+    void AddCharge(InventoryItemRef iRef, bool update=false);
+    // module or charge removed.  resets item's modified attributes and drops modifiers it is source of
+    void RemoveModule(InventoryItemRef iRef, bool update=false);
+    void RemoveCharge(InventoryItemRef iRef, bool update=false);
+
+    // target lookups for FxProc::ApplyEffects()
+    void GetModulesByGroup(uint16 groupID, std::vector<InventoryItemRef>& into);
+    void GetModulesByReqSkill(uint16 skillID, std::vector<InventoryItemRef>& into);
+    void GetChargesByReqSkill(uint16 skillID, std::vector<InventoryItemRef>& into);
+    void GetSkillsByReqSkill(Character* pChar, uint16 skillID, std::vector<InventoryItemRef>& into);
+    // skill added, removed or changed training state.  skill index is rebuilt on next use
+    void ResetSkillIndex()                              { m_skillsBySkill.clear(); m_skillIndex = false; }
+
+    // data is as from FxProc.  data.remove denotes removal of previously added modifier
+    void ApplyModifier(InventoryItemRef targRef, const fxData& data, bool update=false);
+    // keeps modifier with group or skill filter for modules and charges added later
+    void ApplyFilter(const fxData& data);
+
+    // attribute changed outside of effects system.  recalculates attributes using it as source
+    void UpdateSource(InventoryItem* pItem, uint16 attrID, bool update=false);
+
+    size_t GetNodeCount()                               { return m_nodes.size(); }
+
+protected:
+    static uint64_t Key(uint32 itemID, uint16 attrID)   { return ((uint64_t)itemID << 16) | attrID; }
+    static bool IsPenalized(const fxData& data);
+
+    void AddModifier(InventoryItemRef targRef, const fxData& data, bool update);
+    void RemoveModifier(InventoryItemRef targRef, const fxData& data, bool update);
+    void RemoveItem(InventoryItemRef iRef, bool update);
+
+    // recalculates node, then nodes depending on it.  node is dropped when it has no modifiers left
+    void Recalculate(uint64_t key, bool update, uint8 depth=0);
+    EvilNumber Calculate(const fxNode& node);
+    void RecalculateDependents(uint64_t key, bool update, uint8 depth);
+
+    void AddIndex(std::unordered_map<uint16, std::vector<InventoryItemRef>>& index, uint16 key, InventoryItemRef iRef);
+    void RemoveIndex(std::unordered_map<uint16, std::vector<InventoryItemRef>>& index, uint16 key, uint32 itemID);
+    void GetIndex(std::unordered_map<uint16, std::vector<InventoryItemRef>>& index, uint16 key, std::vector<InventoryItemRef>& into);
+
+private:
+    std::map<uint64_t, fxNode> m_nodes;             // k,v of (itemID, attrID), node.  ordered, so an item's nodes are a range
+    std::multimap<uint64_t, uint64_t> m_dependents; // k,v of source (itemID, attrID), target (itemID, attrID).  one per edge
+
+    // modifiers applied by group or required skill, kept for modules and charges added later
+    std::unordered_multimap<uint16, fxData> m_groupFilters;     // k,v of groupID, data.  modules of group
+    std::unordered_multimap<uint16, fxData> m_moduleFilters;    // k,v of skillID, data.  modules requiring skill
+    std::unordered_multimap<uint16, fxData> m_chargeFilters;    // k,v of skillID, data.  charges requiring skill
+
+    std::unordered_map<uint16, std::vector<InventoryItemRef>> m_modsByGroup;
+    std::unordered_map<uint16, std::vector<InventoryItemRef>> m_modsBySkill;
+    std::unordered_map<uint16, std::vector<InventoryItemRef>> m_chargesBySkill;
+    std::unordered_map<uint16, std::vector<InventoryItemRef>> m_skillsBySkill;  // built on first use after Clear() or ResetSkillIndex()
+    bool m_skillIndex;
+};
+
+#endif  // _EVE_FX_GRAPH_H__
@@ -13,6 +13,7 @@
 #include "effects/EffectsActions.h"
 #include "effects/EffectsProcessor.h"
 #include "inventory/InventoryItem.h"
+#include "inventory/ItemFactory.h"
 #include "character/Character.h"
 #include "ship/Ship.h"
 #include "ship/modules/GenericModule.h"
@@ -31,252 +32,152 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
 {
     double profileStartTime = GetTimeUSeconds();
 
-    bool skill = false;
-    switch (data.srcRef->categoryID()) {
-        case  EVEDB::invCategories::Skill:
-        case  EVEDB::invCategories::Implant: {  // cat::implant also covers grp::booster
-            skill = true;
-        } break;
+    std::vector<fxModifier> modifiers;
+    FX::ParseExpression(sFxDataMgr.GetExpressions(), expression, IsSkillSource(data.srcRef), data.srcRef->typeID(), data, modifiers);
+    for (auto& cur : modifiers) {
+        fxData mod = fxData();
+        static_cast<fxModifier&>(mod) = cur;
+        mod.srcRef = data.srcRef;
+        pItem->AddModifier(mod);
     }
 
-    using namespace FX;
-    switch(expression.operandID) {
-        // these return the given expressionValue
-        case Operands::DEFBOOL:   //23  this evaulates to 'true' (Bool(1))
-        case Operands::DEFINT: {  //27  this is used as  0,1,2,{raceID}
-            //  seems to be called only to online/offline modules (and screws up my Online/Offline code...)
-            /** @todo  if this is used, change the Put* methods to use ModuleItem
-            int8 value = atoi(expression.expressionValue.c_str());
-            if (module) {
-                if (value == 0)
-                    data.srcRef->PutOffline();
-                if (value == 1)
-                    data.srcRef->PutOnline(isRig);
-                return; // we are done at this point
-            } */
-        } break;
-        case Operands::DEFASSOCIATION: { //21
-            data.math = GetAssociationEnum(expression.expressionValue);
-            /*
-            if (data.math > Math::MaxMathMethod) {
-                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): out of range mathOp: %s(%i) for operand %u (%s).", \
-                        GetMathMethodName(data.math), data.math, expression.operandID, operand.operandKey.c_str());
-            } */
-        } break;
-        case Operands::DEFENVIDX: {     //24
-            data.targLoc = GetEnvironmentEnum(expression.expressionValue);
-            /*
-            if (data.targLoc > Target::MaxTargLocation) {
-                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): out of range targLoc: %i for operand %u (%s).", \
-                        data.targAttr, expression.operandID, operand.operandKey.c_str());
-            } */
-        } break;
-        // these provide the given expressionID (attrib/grp)
-        case Operands::DEFATTRIBUTE: {  //22
-            if (expression.expressionAttributeID) {
-                if (data.targAttr) {  // always processed first
-                    data.srcAttr = expression.expressionAttributeID;
-                } else {
-                    data.targAttr = expression.expressionAttributeID;
-                }
-            } else {
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): opATTR called with no expressionAttributeID defined");
-            }
-        } break;
-        case Operands::DEFGROUP: {      //26
-            data.fxSrc = Source::Group;
-            if (expression.expressionGroupID) {
-                data.grpID = expression.expressionGroupID;
-            } else if (expression.expressionValue != "") {
-                ;   // will have to figure out how to do this one.
-                _log(EFFECTS__WARNING, "FxProc::ParseExpression(): opGROUP using expressionValue %s called by %s",\
-                        expression.expressionValue.c_str(), expression.expressionName.c_str());
-            } else {
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): opGROUP called with no expressionGroupID or expressionValue defined");
-            }
-        } break;
-        case Operands::DEFTYPEID: {     //29
-            if (skill)
-                data.fxSrc = Source::Skill;
-            if (expression.expressionTypeID) {
-                data.typeID = expression.expressionTypeID;
-            } else if (expression.expressionValue != "") {
-                ;   // will have to figure out how to do this one.
-                _log(EFFECTS__WARNING, "FxProc::ParseExpression(): opTYPEID using expressionValue %s", expression.expressionValue.c_str());
-            } else {
-                _log(EFFECTS__ERROR, "FxProc::ParseExpression(): opTYPEID called with no expressionTypeID or expressionValue defined");
-            }
-        } break;
-        case Operands::GETTYPE: { //36, %(arg1)s.GetTypeID()  --used by SRLG in AORSM
-            if (!data.typeID)
-                data.typeID = data.srcRef->typeID();    // get items on ship that require SkillItem in srcRef
-        } break;
-        // do as stated
-        case Operands::GM:      //37, %(arg1)s.GetModule(%(arg2)s)      --used by subsystems as (GetModule(Ship:201):55)
-        case Operands::RSA: {   //64, %(arg1)s.%(arg2)s      -- used by AGRSM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-        } break;
-        case Operands::COMBINE: { //17, %(arg1)s); (%(arg2)s      --executes two statements
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            fxData data1 = fxData();
-            data1.action = Action::Invalid;
-            data1.srcRef = data.srcRef;
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data1, pMod);
-        } break;
-        case Operands::LG: {    //48, %(arg1)s.LocationGroup.%(arg2)s  -- specify a group by grpID for a location'  used by ALGM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);   //source
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);   //groupID
-        } break;
-        case Operands::SRLG: {    //49, %(arg1)s.SkillRequiredLocationGroup[%(arg2)s]  --  specify a group by skillID for a location   used by ALRSM and AORSM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);   //source
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);   //skillID
-            if (!data.fxSrc) {    // fxSrc = Self in this case.  update to remove this hack?
-                //_log(EFFECTS__TRACE, "FxProc::ParseExpression(): SRLG: setting fxSrc from %s to Skill for %s.  self: %s", \
-                        GetSourceName(data.fxSrc), data.srcRef->name(), (pItem == data.srcRef.get() ? "true" : "false"));
-                data.fxSrc = Source::Skill;
-            }
-        } break;
-        case Operands::ATT:     //12, %(arg1)s->%(arg2)s               --(item:attribID)
-        case Operands::EFF:     //31, %(arg2)s.%(arg1)s                --define association type
-        case Operands::GA:      //34, %(arg1)s.%(arg2)s                --GetAttribute      (no known uses)
-        case Operands::GET:     //35, %(arg1)s.%(arg2)s()              --used a lot.  eg. Get(Ship:101) means 'get attribute 101 on ShipItem'
-        case Operands::IA: {    //40, %(arg1)s                         --used by AGSM
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data);
-            if (expression.arg2)
-                ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data);
-        } break;
-        // effect function calls.
-        // here is where we'll actually add the modifier data to the item's map
-        case Operands::AIM:     //6,  AddItemModifier(env,%(arg1)s, %(arg2)s)
-        case Operands::AGRSM:   //5,  [%(arg1)s].AGRSM(%(arg2)s)    --AddGangRequiredSkillModifier
-        case Operands::AGSM: {  //3,  [%(arg1)s].AGSM(%(arg2)s)        --AddGangShipModifier
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-            pItem->AddModifier(data);
-        } break;
-        case Operands::ALGM:    //7,  (%(arg1)s).AddLocationGroupModifier (%(arg2)s)
-        case Operands::ALM:     //8,  (%(arg1)s).AddLocationModifier (%(arg2)s)
-        case Operands::ALRSM:   //9,  (%(arg1)s).AddLocationRequiredSkillModifier(%(arg2)s)
-        case Operands::AORSM: { //11, (%(arg1)s).AddOwnerRequiredSkillModifier(%(arg2)s)
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-            if ((skill) and (!data.fxSrc))      // fxSrc = Self in this case.  update to remove this hack?
-                data.fxSrc = Source::Skill;
-            pItem->AddModifier(data);
-        } break;
-        // remove modifier calls only partially enabled for modules and charges.
-        // will implement for implants and boosters when those systems are written.
-        case Operands::RIM:     //58, (%(arg1)s).RemoveItemModifier (%(arg2)s)
-        case Operands::RGGM:    //54, [%(arg1)s].RemoveGangGroupModifier(%(arg2)s)
-        case Operands::RGSM:    //55, [%(arg1)s].RemoveGangShipModifier(%(arg2)s)
-        case Operands::RGORSM:  //56, [%(arg1)s].RemoveGangOwnerRequiredSkillModifier(%(arg2)s)
-        case Operands::RGRSM: { //57, [%(arg1)s].RemoveGangRequiredSkillModifier(%(arg2)s)
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-            pItem->RemoveModifier(data);
-        } break;
-        case Operands::RLGM:    //59, (%(arg1)s).RemoveLocationGroupModifier (%(arg2)s)
-        case Operands::RLM:     //60, (%(arg1)s).RemoveLocationModifier (%(arg2)s)
-        case Operands::RLRSM:   //61, (%(arg1)s).RemoveLocationRequiredSkillModifier(%(arg2)s)
-        case Operands::RORSM: { //62, (%(arg1)s).RemoveOwnerRequiredSkillModifier(%(arg2)s)
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), data, pMod);
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), data, pMod);
-            if ((skill) and (!data.fxSrc))     // fxSrc = Self in this case.  update to remove this hack?
-                data.fxSrc = Source::Skill;
-            pItem->RemoveModifier(data);
-        } break;
-        /*
-        // next 3 not used here, as they are only used by effect 16 (Online), which is covered in GenericModule class.
-        case Operands::OR:     //'%(arg1)s OR %(arg2)s'       -- used with 'if' in arg2 as 'y'.   ((if x then y) OR z)  (used as "else" or elif)
-        case Operands::AND:    //'(%(arg1)s) AND (%(arg2)s)'  -- used with 'if' in arg1 as 'x'.   (if (x AND y) then ....)
-        case Operands::IF: {    //'If(%(arg1)s), Then (%(arg2)s)'    -- std conditional.  (if x then y)
-        } break;
-        // trivial attribute operations
-        case Operands::ADD: {      //1, (%(arg1)s)+(%(arg2)s)
-            // this isnt complete.
-            fxData arg1 = fxData();
-                arg1.srcRef = data.srcRef;
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), arg1, pMod);
-            fxData arg2 = fxData();
-                arg2.srcRef = data.srcRef;
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), arg2, pMod);
-            data.result = (arg1.result + arg2.result);
-        } break;
-        case Operands::GTE: {  //39    %(arg1)s>=%(arg2)s
-            fxData arg1 = fxData();
-                arg1.srcRef = data.srcRef;
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg1), arg1, pMod);
-            fxData arg2 = fxData();
-                arg2.srcRef = data.srcRef;
-            ParseExpression(pItem, sFxDataMgr.GetExpression(expression.arg2), arg2, pMod);
-            //  this needs work
-            //if (arg1.srcRef->GetAttribute(arg1.srcAttr) >= arg2.targLoc->GetAttribute(arg2.targAttr))
-            //    data.result = true;
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
+}
 
-        } break;
-        case Operands::GT: {   //38    %(arg1)s> %(arg2)s
+void FxProc::ExecuteExpression(InventoryItem* pItem, uint16 expressionID, InventoryItemRef srcRef)
+{
+    double profileStartTime = GetTimeUSeconds();
 
-        } break;
+    const fxProgram& program = sFxDataMgr.GetProgram(expressionID, IsSkillSource(srcRef));
+    for (auto& cur : program) {
+        fxData data = fxData();
+        static_cast<fxModifier&>(data) = cur.data;
+        data.srcRef = srcRef;
+        if (cur.srcType)
+            data.typeID = srcRef->typeID();
+        pItem->AddModifier(data);
+    }
 
-        case Operands::UE: {   //73    UserError(%(arg1)s)
-            // not using this yet.
-        } break;
-        case Operands::SKILLCHECK: {   //67    SkillCheck(%(arg1)s)
-            //data.result = true;
-        } break;
-        // module action method calls...not used.
-        case Operands::ATTACK: // 13,
-        case Operands::CARGOSCAN: // 14,
-        case Operands::CHEATTELEDOCK: // 15,
-        case Operands::CHEATTELEGATE: // 16,
-        case Operands::DECLOAKWAVE: // 19,
-        case Operands::ECMBURST: // 30,
-        case Operands::EMPWAVE: // 32,
-        case Operands::LAUNCH: // 44,
-        case Operands::LAUNCHDEFENDERMISSILE: // 45,
-        case Operands::LAUNCHDRONE: // 46,
-        case Operands::LAUNCHFOFMISSILE: // 47,
-        case Operands::MINE: // 50,
-        case Operands::POWERBOOST: // 53,
-        case Operands::SHIPSCAN: // 66,
-        case Operands::SURVEYSCAN: // 69,
-        case Operands::TARGETHOSTILES: // 70,
-        case Operands::TARGETSILENTLY: // 71,
-        case Operands::TOOLTARGETSKILLS: // 72,
-        case Operands::SPEEDBOOST: {   //75    EVEmu-specific operand to apply modified speed attribs to destiny variables and update bubble
-            data.action = expression.operandID;
-           // pItem->AddModifier(data);
-        } break;
-        default: {              // in case the op hasnt been defined, make a note here
-            if (is_log_enabled(EFFECTS__UNDEFINED)) {
-                std::ostringstream ret;
-                Operand operand = sFxDataMgr.GetOperand(expression.operandID);
-                ret << "Operand id:" << expression.operandID << " key:" << operand.operandKey;
-                if (operand.format.empty()) {
-                    ret << " - has not been defined.";
-                } else {                // % {'arg1': arg1, 'arg2': arg2, 'value': expression.expressionValue}
-                    ret << " - should be added as " << operand.format.c_str();
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
+}
+
+static bool SameModifiers(const std::multimap<int8, fxData>& a, const std::multimap<int8, fxData>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    std::multimap<int8, fxData>::const_iterator itrA = a.begin(), itrB = b.begin();
+    for (; itrA != a.end(); ++itrA, ++itrB) {
+        const fxData& dA = itrA->second;
+        const fxData& dB = itrB->second;
+        if ((itrA->first != itrB->first)
+        or  (dA.math != dB.math)
+        or  (dA.fxSrc != dB.fxSrc)
+        or  (dA.targLoc != dB.targLoc)
+        or  (dA.action != dB.action)
+        or  (dA.remove != dB.remove)
+        or  (dA.targAttr != dB.targAttr)
+        or  (dA.srcAttr != dB.srcAttr)
+        or  (dA.grpID != dB.grpID)
+        or  (dA.typeID != dB.typeID)
+        or  (dA.srcRef.get() != dB.srcRef.get()))
+            return false;
+    }
+    return true;
+}
+
+uint32 FxProc::VerifyPrograms()
+{
+    double start = GetTimeMSeconds();
+    uint32 checked(0), failed(0);
+    std::vector<uint16> typeIDs;
+    sFxDataMgr.GetTypeIDs(typeIDs);
+
+    std::vector<TypeEffects> typeFx;
+    std::multimap<int8, fxData> parsed;
+    for (auto typeID : typeIDs) {
+        // temp item of this type as source and modifier container, so category and typeID are those used in game
+        ItemData idata(typeID, ownerSystem, locTemp, flagNone, 1);
+        InventoryItemRef iRef = sItemFactory.SpawnTempItem(idata);
+        if (iRef.get() == nullptr)
+            continue;
+
+        typeFx.clear();
+        sFxDataMgr.GetTypeEffect(typeID, typeFx);
+        for (auto cur : typeFx) {
+            Effect effect = sFxDataMgr.GetEffect(cur.effectID);
+            uint16 expressions[2] = {effect.preExpression, effect.postExpression};
+            for (uint8 i = 0; i < 2; ++i) {
+                iRef->ClearModifiers();
+                fxData data = fxData();
+                data.action = FX::Action::Invalid;
+                data.srcRef = iRef;
+                ParseExpression(iRef.get(), sFxDataMgr.GetExpression(expressions[i]), data);
+                parsed.swap(iRef->m_modifiers);
+                iRef->ClearModifiers();
+                ExecuteExpression(iRef.get(), expressions[i], iRef);
+                ++checked;
+                if (!SameModifiers(parsed, iRef->m_modifiers)) {
+                    ++failed;
+                    _log(EFFECTS__ERROR, "FxProc::VerifyPrograms(): %s expression %u of effect %u on type %u differs.  parsed %zu modifiers, compiled %zu.", \
+                            (i ? "post" : "pre"), expressions[i], cur.effectID, typeID, parsed.size(), iRef->m_modifiers.size());
                 }
-                _log(EFFECTS__UNDEFINED, "FxProc::ParseExpression() - %s", ret.str().c_str());
+                parsed.clear();
             }
-        } break;
-        */
+        }
+        // modifiers hold a ref to the item
+        iRef->ClearModifiers();
     }
 
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
+    sLog.Cyan("    FxProc", "Verified %u compiled expressions of %zu types in %.3fms.  %u differ from parsed expressions.", \
+            checked, typeIDs.size(), (GetTimeMSeconds() - start), failed);
+    return failed;
+}
+
+// modifier targets the ship, or modules, charges or target found on it
+static bool NeedsShip(const fxData& data)
+{
+    if (data.fxSrc == FX::Source::Group)
+        return true;
+    switch (data.targLoc) {
+        case FX::Target::Ship:
+        case FX::Target::Other:
+        case FX::Target::Charge:
+        case FX::Target::Target: {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FxProc::IsSkillSource(InventoryItemRef srcRef)
+{
+    switch (srcRef->categoryID()) {
+        case  EVEDB::invCategories::Skill:
+        case  EVEDB::invCategories::Implant: {  // cat::implant also covers grp::booster
+            return true;
+        }
+    }
+    return false;
 }
 
 void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShip, bool update/*false*/)
 {
 
     using namespace FX;
+    // modifiers are kept in ship's graph, which recalculates only the attributes they change.
+    //  without a ship, modifiers on the item itself and the character are applied in place, as they were before the graph
+    FxGraph shipless;
+    FxGraph& graph = (pShip == nullptr ? shipless : pShip->GetFxGraph());
     //uint8 action = Action::dgmActInvalid;
     for (auto cur : pItem->m_modifiers) {  // k,v of assoc, data<math, src, targLoc, targAttr, srcAttr, grpID, typeID>
     double profileStartTime = GetTimeUSeconds();
+        if ((pShip == nullptr) and NeedsShip(cur.second)) {
+            _log(EFFECTS__WARNING, "FxProc::ApplyEffects(): %s(%u) has no ship.  modifier to %s skipped.", \
+                    cur.second.srcRef->name(), cur.second.srcRef->itemID(), GetTargLocName(cur.second.targLoc));
+            continue;
+        }
         /*
         if (cur.second.action) {
             action = cur.second.action;
@@ -289,11 +190,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
         switch (cur.second.fxSrc) {
             case Source::Group: {     // not a source per se, but defines effect's target selection requirements
                 // this is to apply modifiers to ship's modules of groupID defined in 'grpID'
-                std::vector<InventoryItemRef> moduleList;
-                pShip->GetModuleManager()->GetModuleListOfRefsAsc(moduleList);
-                for (auto mod : moduleList)
-                    if (mod->groupID() == cur.second.grpID)
-                        itemRefVec.push_back(mod);
+                graph.GetModulesByGroup(cur.second.grpID, itemRefVec);
             } break;
             case Source::Skill: {    // source of this effect is skill, implant, or booster
                 if (cur.second.typeID == EVEDB::invTypes::Invalid) {    //invalid
@@ -309,7 +206,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                     case Target::Ship:  {
                         if (cur.second.typeID) {
                             // .....ship's modules that require skillID defined in "typeID"
-                            pShip->GetModuleManager()->GetModuleListByReqSkill(cur.second.typeID, itemRefVec);
+                            graph.GetModulesByReqSkill(cur.second.typeID, itemRefVec);
                         } else {
                             // ..... ship that require skill in 'srcRef'
                             if (pShip->HasReqSkill(cur.second.srcRef->typeID()))
@@ -319,12 +216,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                     case Target::Char: {
                         if (cur.second.typeID) {
                             // ....char skills that require skill in 'srcRef' or defined in 'typeID'
-                            uint16 skillID = cur.second.typeID;
-                            std::vector<InventoryItemRef> allSkills;
-                            pChar->GetSkillsList(allSkills);
-                            for (auto curSkill : allSkills)
-                                if (curSkill->HasReqSkill(skillID))
-                                    itemRefVec.push_back(curSkill);
+                            graph.GetSkillsByReqSkill(pChar, cur.second.typeID, itemRefVec);
                         } else {
                             // ....character itself
                             itemRefVec.push_back(static_cast<InventoryItemRef>(pChar));
@@ -337,11 +229,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                     case Target::Charge: {
                         // ....charges
                         // will need more testing to verify this.
-                        std::map<EVEItemFlags, InventoryItemRef> charges;
-                        pShip->GetModuleManager()->GetLoadedCharges(charges);
-                        for (auto mod : charges)
-                            if (mod.second->HasReqSkill(cur.second.typeID))
-                                itemRefVec.push_back(mod.second);
+                        graph.GetChargesByReqSkill(cur.second.typeID, itemRefVec);
                     } break;
                     case Target::Target: {
                         // ...current target (focused, volatile...removed on 'invalid target')
@@ -450,6 +338,9 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
             } break;
         }
 
+        // group and skill filtered modifiers also apply to modules and charges added later
+        graph.ApplyFilter(cur.second);
+
         if (itemRefVec.empty())
             if ((cur.second.typeID == 0)
             and (cur.second.grpID == 0)) {
@@ -479,6 +370,17 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
         for (auto item : itemRefVec) {
             if (item.get() == nullptr)  // still occasional nulls in the vector (segfaults)
                 continue;
+            if ((pShip != nullptr) and (cur.second.targLoc != Target::Target)) {
+                _log(EFFECTS__MESSAGE, "FxProc::ApplyEffects(%i): %s(%u) - src(%s:%u)=%.3f <%s> targ(%s:%u) %s %s(%u).", \
+                        cur.first, cur.second.srcRef->name(), cur.second.srcRef->itemID(), \
+                        GetSourceName(cur.second.fxSrc), cur.second.srcAttr, srcValue.get_float(), GetMathMethodName(opID), \
+                        GetTargLocName(cur.second.targLoc), cur.second.targAttr, (cur.second.remove ? "removed from" : "added to"), \
+                        item->name(), item->itemID());
+                // update is used to send attrib changes to client when changing module states while in space, but NOT for pilot login. (client acts funky)
+                graph.ApplyModifier(item, cur.second, update);
+                continue;
+            }
+            // current target belongs to another ship and this modifier is dropped on 'invalid target', or there is no ship graph.  modify its value in place
             // get targAttr
             targValue = item->GetAttribute(cur.second.targAttr);
             // check for inf/nan and then reset?  this will fuck up all previous fx processing on this value.
@@ -553,58 +455,6 @@ EvilNumber FxProc::CalculateAttributeValue(EvilNumber val1/*targ*/, EvilNumber v
     return val1;
 }
 
-int8 FxProc::GetAssociationEnum(const std::string& association)
-{   // opID 21
-    if (association == "PreAssignment") {
-        return FX::Math::PreAssignment;
-    } else if (association == "PreDiv") {
-        return FX::Math::PreDiv;
-    } else if (association == "PreMul") {
-        return FX::Math::PreMul;
-    } else if (association == "ModAdd") {
-        return FX::Math::ModAdd;
-    } else if (association == "ModSub") {
-        return FX::Math::ModSub;
-    } else if (association == "PostPercent") {
-        return FX::Math::PostPercent;
-    } else if (association == "PostMul") {
-        return FX::Math::PostMul;
-    } else if (association == "PostDiv") {
-        return FX::Math::PostDiv;
-    } else if (association == "PostAssignment") {
-        return FX::Math::PostAssignment;
-    } else if (association == "SkillCheck") {
-        return FX::Math::SkillCheck;
-    } else if (association == "AddRate") {
-        return FX::Math::AddRate;
-    } else if (association == "SubRate") {
-        return FX::Math::SubRate;
-    } else {
-        return FX::Math::Invalid;  //throw std::bad_typeid();
-    }
-}
-
-int8 FxProc::GetEnvironmentEnum(const std::string& env)
-{   // opID 24
-    if (env == "Self") {
-        return FX::Target::Self;
-    } else if (env == "Char") {
-        return FX::Target::Char;
-    } else if (env == "Ship") {
-        return FX::Target::Ship;
-    } else if (env == "Target") {
-        return FX::Target::Target;
-    } else if (env == "Area") {
-        return FX::Target::Area;
-    } else if (env == "Other") {
-        return FX::Target::Other;
-    } else if (env == "Charge") {
-        return FX::Target::Charge;
-    } else {
-        return FX::Target::Invalid;  //throw std::bad_typeid();
-    }
-}
-
 const char* FxProc::GetMathMethodName(int8 id)
 {
     switch (id) {
@@ -706,10 +556,10 @@ void FxProc::DecodeExpression(Expression expression, fxData& data)
         case Operands::DEFINT: {  //27  this is used as  0,1,2,{raceID}
         } break;
         case Operands::DEFASSOCIATION: { //21
-            data.math = GetAssociationEnum(expression.expressionValue);
+            data.math = FX::GetAssociationEnum(expression.expressionValue);
         } break;
         case Operands::DEFENVIDX: {     //24
-            data.targLoc = GetEnvironmentEnum(expression.expressionValue);
+            data.targLoc = FX::GetEnvironmentEnum(expression.expressionValue);
         } break;
         // these provide the given expressionID (attrib/grp)
         case Operands::DEFATTRIBUTE: {  //22
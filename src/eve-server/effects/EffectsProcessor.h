@@ -28,10 +28,13 @@ public:
 
     // pItem is modifier container
     void            ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShip, bool update=false);
-    // pItem is modifier container
+    // pItem is modifier container.  walks the expression tree each call (see FX::ParseExpression())
     void            ParseExpression(InventoryItem* pItem, Expression expression, fxData& data, GenericModule* pMod=nullptr);
-    int8            GetEnvironmentEnum(const std::string& domain);
-    int8            GetAssociationEnum(const std::string& association);
+    // pItem is modifier container.  adds modifiers of compiled expression, same as ParseExpression() does
+    void            ExecuteExpression(InventoryItem* pItem, uint16 expressionID, InventoryItemRef srcRef);
+    // compares compiled expressions to ParseExpression() for all effects of all types.  returns number of mismatches
+    uint32          VerifyPrograms();
+    bool            IsSkillSource(InventoryItemRef srcRef);
 
     const char*     GetSourceName(int8 id);
     const char*     GetMathMethodName(int8 id);
@@ -244,6 +244,14 @@ int main( int argc, char* argv[] )
             sLog.Warning( "       ServerInit", "Unable to find log directory '%s', only logging to the screen now.", sConfig.files.logDir.c_str() );
         }
     }
+    sLogWriter.SetRotation((uint64_t)sConfig.files.logRotateSize * 1024 * 1024, sConfig.files.logRotateTime * 60);
+    if (sConfig.files.logAsync) {
+        if (sLogWriter.Start()) {
+            sLog.Green( "       ServerInit", "Log output is written by background thread." );
+        } else {
+            sLog.Warning( "       ServerInit", "Unable to start log writer thread.  Log output is written by calling threads." );
+        }
+    }
     std::printf("\n");     // spacer
 
     sLog.Green("       ServerInit", "Server Configuration Files Loaded.");
@@ -577,6 +585,15 @@ int main( int argc, char* argv[] )
     }
     std::printf("\n");     // spacer
 
+    /* Start up the network reactor, so client sockets do not each get their own thread */
+    if (sConfig.net.useReactor) {
+        sLog.Green( "       ServerInit", "Starting Network Reactor");
+        if (!sNetReactor.Initialize(sConfig.threads.NetworkThreads))
+            sLog.Error( "       NetReactor", "Error starting Network Reactor.  Falling back to thread per connection." );
+    } else {
+        sLog.Warning( "       NetReactor", "Disabled.  Using thread per connection." );
+    }
+
     /* Start up the TCP server */
     EVETCPServer tcps;
     char errbuf[ TCPCONN_ERRBUF_SIZE ];
@@ -602,7 +619,8 @@ int main( int argc, char* argv[] )
                          sConfig.database.port,
                          sConfig.database.useSocket,
                          sConfig.database.autoReconnect,
-                         sConfig.debug.UseProfiling
+                         sConfig.debug.UseProfiling,
+                         sConfig.threads.DatabaseThreads
                         );
     if (sDatabase.GetStatus() != DBcore::Connected) {
         // error msg printed in DBcore::Initalize routine
@@ -856,7 +874,6 @@ int main( int argc, char* argv[] )
     #endif
     */
 
-    uint32 start(0);
     EVETCPConnection* tcpc(nullptr);
 
     if (sConfig.debug.UseProfiling) {
@@ -876,6 +893,9 @@ int main( int argc, char* argv[] )
 
     sLog.Cyan("           Server", "Started on %s", currentDateTime().c_str());
 
+    /* start the tick schedule.  this should be the last call before the main loop */
+    sTickScheduler.Initialize(m_sleepTime);
+
     /////////////////////////////////////////////////////////////////////////////////////
     //     !!!  DO NOT PUT ANY INITIALIZATION CODE OR CALLS BELOW THIS LINE   !!!
     /////////////////////////////////////////////////////////////////////////////////////
@@ -886,7 +906,7 @@ int main( int argc, char* argv[] )
      */
     while (m_run) {
         Timer::SetCurrentTime();
-        start = GetTickCount();
+        sTickScheduler.BeginTick();
 
         /* Freeze Detector Code */
         //++m_worldLoopCounter;
@@ -896,13 +916,14 @@ int main( int argc, char* argv[] )
 
         sEntityList.Process();
 
+        /* hand results of pooled db reads back to their callers */
+        sDatabase.ProcessCompletions();
+
         /*  process console commands, if any, and check for 'exit' command */
         m_run = sConsole.Process();
 
-        /* do the stuff for thread sleeping */
-        start = GetTickCount() - start;
-        if (m_sleepTime > start)
-            std::this_thread::sleep_for(std::chrono::milliseconds(start));
+        /* sleep until next tick is due */
+        sTickScheduler.EndTick();
     }
 
     /*
@@ -957,11 +978,16 @@ int main( int argc, char* argv[] )
     /* close the db handler */
     sLog.Warning("   ServerShutdown", "Closing DataBase Connection." );
     sDatabase.Close();
+    /* stop the network reactor.  all clients are gone by now */
+    sLog.Warning("   ServerShutdown", "Shutting down Network Reactor." );
+    sNetReactor.Shutdown();
     /** @todo  the thread system is only implemented for tcp connections at this time. */
     sLog.Warning("   ServerShutdown", "Shutting down Thread Manager." );
     /* join open threads */
     sThread.EndThreads();
     sLog.Warning("   ServerShutdown", "EVEmu is Offline.");
+    /* write queued log records and stop log writer */
+    sLogWriter.Stop();
     /* close logfile */
     log_close_logfile();
     exit(EXIT_SUCCESS);
@@ -1063,11 +1089,16 @@ static void CleanUp() {
     /* close the db handler */
     sLog.Warning("   ServerShutdown", "Closing DataBase Connection." );
     sDatabase.Close();
+    /* stop the network reactor.  all clients are gone by now */
+    sLog.Warning("   ServerShutdown", "Shutting down Network Reactor." );
+    sNetReactor.Shutdown();
     /** @todo  the thread system is only implemented for tcp connections at this time. */
     sLog.Warning("   ServerShutdown", "Shutting down Thread Manager." );
     /* join open threads */
     sThread.EndThreads();
     sLog.Warning("   ServerShutdown", "EVEmu is Offline.");
+    /* write queued log records and stop log writer */
+    sLogWriter.Stop();
     /* close logfile */
     log_close_logfile();
 }
@@ -37,6 +37,7 @@
 /************************************************************************/
 // profile
 #include "Profiler.h"
+#include "TickScheduler.h"
 // auth
 #include "auth/PasswordModule.h"
 // cache
@@ -51,6 +52,7 @@
 #include "network/EVETCPServer.h"
 #include "network/EVEPktDispatch.h"
 #include "network/EVESession.h"
+#include "network/MarshaledNotification.h"
 // marshal
 #include "marshal/EVEMarshal.h"
 #include "marshal/EVEMarshalOpcodes.h"
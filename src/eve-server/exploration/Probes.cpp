@@ -530,6 +530,7 @@ void ProbeSE::SendSlimChange()
     PyTuple* updates = new PyTuple(2);
         updates->SetItem(0, new PyString("OnSlimItemChange"));
         updates->SetItem(1, probeData);
+    InvalidateSlimItem();
     m_destiny->SendSingleDestinyUpdate(&updates, true);
 }
 
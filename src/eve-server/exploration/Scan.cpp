@@ -108,29 +108,21 @@ PyRep* Scan::ConeScan(Call_ConeScan args) {
      * acDP = arc cosine of DP to give angle
      * test acDP < cone angle = point is inside cone.
      */
-    bool test = false;
-    float dot(0), acDP(0), angle(args.ScanAngle/2);
+    // the entity grid does this test for each entity in range, comparing dot product against cosine of cone angle
+    double angle(args.ScanAngle/2);
     std::vector<SystemEntity*> seVec;
     const GPoint vertex(m_client->GetShipSE()->GetPosition());
-    const GPoint U(args.x, args.y, args.z);
-    m_client->SystemMgr()->DScan(args.range, vertex, seVec);
-    _log(SCAN__TRACE, "ConeScan() - query returned %u objects within range.  angle is %.3f", seVec.size(), angle);
+    const GVector U(args.x, args.y, args.z);
+    m_client->SystemMgr()->DScan(args.range, vertex, U, angle, seVec);
+    _log(SCAN__TRACE, "ConeScan() - query returned %u objects within cone.  angle is %.3f", seVec.size(), angle);
     PyList* list = new PyList();
     for (auto cur : seVec ) {
-        GVector VR(vertex, cur->GetPosition());
-        VR.normalize();
-        dot = U.dotProduct(VR);
-        acDP = acos(dot);
-        if (acDP < angle) {
-            test = true;
-            DirectionScanResult res;
-            res.id         = cur->GetID();
-            res.typeID     = cur->GetSelf()->typeID();
-            res.groupID    = cur->GetSelf()->groupID();
-            list->AddItem(res.Encode());
-        }
-        _log(SCAN__TRACE, "ConeScan() - tested %s(%u).  dot %.5f, acDP %.5f, result %s", cur->GetName(), cur->GetID(), dot, acDP, test?"true":"false");
-        test = false;
+        DirectionScanResult res;
+        res.id         = cur->GetID();
+        res.typeID     = cur->GetSelf()->typeID();
+        res.groupID    = cur->GetSelf()->groupID();
+        list->AddItem(res.Encode());
+        _log(SCAN__TRACE, "ConeScan() - found %s(%u).", cur->GetName(), cur->GetID());
     }
 
     return list;
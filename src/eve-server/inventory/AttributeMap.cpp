@@ -45,8 +45,20 @@
  */
 
 
+/* attributes saved by SaveShipState() */
+static const uint16 s_shipStateAttrs[] = {
+    AttrShieldCharge,
+    AttrArmorDamage,
+    AttrDamage,
+    AttrHeatHi,
+    AttrHeatMed,
+    AttrHeatLow
+};
+
 AttributeMap::AttributeMap( InventoryItem& item)
-: mItem(item)
+: mItem(item),
+mStateQueued(false),
+mWriteQueued(false)
 {
     mAttributes.clear();
 }
@@ -58,22 +70,51 @@ AttributeMap::~AttributeMap()
 
 
 bool AttributeMap::Load(bool reset/*false*/) {
+    // ship state still in the write queue is newer than its rows, so it is kept from memory instead of waiting on the write
+    std::vector<std::pair<uint16, EvilNumber>> state;
+    bool wait(true);
+    if (reset and !mWriteQueued) {
+        wait = false;
+        if (mStateQueued)
+            for (auto attrID : s_shipStateAttrs) {
+                AttrMap::iterator itr = mAttributes.find(attrID);
+                if (itr != mAttributes.end())
+                    state.push_back(std::make_pair(attrID, itr->second));
+            }
+    }
+
     if (reset) {
         // this will allow total clearing of attribs to eliminate the necessity of 'removing' effects
         mAttributes.clear();
     }
     /* First, we copy default attributes values from our itemType, loaded into memObj when type is loaded */
     // (except char ability scores...dunno why yet)
+    mAttributes.reserve(mItem.type().GetAttributeCount());
     mItem.type().CopyAttributes(mItem);
 
     // check for temp items.  they arent saved to db
-    if (!IsTempItem(mItem.itemID()) and !IsNPC(mItem.itemID())) {
+    std::vector<Inv::AttrData> preload;
+    if (sItemFactory.GetPreloadedAttributes(mItem.itemID(), preload)) {
+        /* saved attribs were read with the item's container contents */
+        EvilNumber value;
+        for (auto cur : preload) {
+            if (cur.type) {
+                value = cur.valueFloat;
+            } else {
+                value = cur.valueInt;
+            }
+            SetAttribute(cur.attrID, value, false);
+        }
+    } else if (!IsTempItem(mItem.itemID()) and !IsNPC(mItem.itemID())) {
         /* load saved attribs from the db, if any, to update the defaults with items current (saved) values*/
         DBQueryResult res;
         if (IsCharacter(mItem.itemID())) {
             if (!sDatabase.RunQuery(res, "SELECT attributeID, valueInt, valueFloat FROM chrCharacterAttributes WHERE charID=%u", mItem.itemID()))
                 _log(DATABASE__ERROR, "AttributeMap", "Error in db load query: %s", res.error.c_str());
         } else {
+            // ship state is saved through the write queue
+            if (wait)
+                sDatabase.WaitFor(mItem.itemID());
             if (!sDatabase.RunQuery(res, "SELECT attributeID, valueInt, valueFloat FROM entity_attributes WHERE itemID=%u", mItem.itemID()))
                 _log(DATABASE__ERROR, "AttributeMap", "Error in db load query: %s", res.error.c_str());
         }
@@ -93,6 +134,14 @@ bool AttributeMap::Load(bool reset/*false*/) {
             SetAttribute(row.GetUInt(0), value, false);
         }
     }
+    for (auto cur : state)
+        SetAttribute(cur.first, cur.second, false);
+
+    // map now matches saved values
+    mDirty.clear();
+    mStateQueued = false;
+    mWriteQueued = false;
+
     /* item now has it's own attribute map, and is deleted when item object is destroyed or reset */
     if (is_log_enabled(ATTRIBUTE__INFO))
         _log(ATTRIBUTE__INFO, "AttributeMap::Load()  Loaded %u attribs for %s.", mAttributes.size(), mItem.name());
@@ -104,6 +153,20 @@ bool AttributeMap::SaveAttributes() {
 }
 
 bool AttributeMap::Save() {
+    if (mDirty.empty())
+        return true;
+
+    std::vector<Inv::AttrData> attribs, failed;
+    if (!GetSaveData(attribs))
+        return false;
+    if (!attribs.empty())
+        ItemDB::SaveAttributes(IsCharacter(mItem.itemID()), attribs, failed);
+    for (auto cur : failed)
+        mDirty.insert(cur.attrID);
+    return failed.empty();
+}
+
+bool AttributeMap::GetSaveData(std::vector<Inv::AttrData>& into) {
     /** @note
      * we are saving:
      *   ability attribs for characters
@@ -114,15 +177,21 @@ bool AttributeMap::Save() {
      *
      *  ship damage saved separately
      */
-    if (IsStaticItem(mItem.itemID()))
+    if (mDirty.empty())
         return true;
+    if (IsStaticItem(mItem.itemID())) {
+        mDirty.clear();
+        return true;
+    }
 
+    // only attributes changed since last save are written.  rows are upserted, so unchanged rows are left as they are
     bool save(false);
-    std::vector<Inv::AttrData> attribs;
-    attribs.clear();
-    AttrMapItr itr = mAttributes.begin(), end = mAttributes.end();
+    AttrMapItr itr, end = mAttributes.end();
     if (IsCharacter(mItem.itemID())) {
-        for (; itr != end; ++itr) {
+        for (auto cur : mDirty) {
+            itr = mAttributes.find(cur);
+            if (itr == end)
+                continue;
             switch (itr->first) {
                 case AttrCharisma:
                 case AttrIntelligence:
@@ -139,14 +208,13 @@ bool AttributeMap::Save() {
                 case AttrMemoryBonus:
                 case AttrPerceptionBonus:
                 case AttrWillpowerBonus: {
-                    if (itr->second == EvilZero)
-                        continue;
+                    // zero is written too.  rows are upserted, so skipping it would leave the previous value in the db
                     Inv::AttrData data = Inv::AttrData();
                     data.itemID = mItem.itemID();
                     data.attrID = itr->first;
                     data.type = false;
                     data.valueInt = itr->second.get_int();
-                    attribs.push_back(data);
+                    into.push_back(data);
                 }
             }
         }
@@ -155,9 +223,11 @@ bool AttributeMap::Save() {
         switch (mItem.categoryID()) {
             case EVEDB::invCategories::Asteroid:    // asteroids and blueprints are NOT saved here
             case EVEDB::invCategories::Blueprint: {
+                mDirty.clear();
                 return false;
             } break;
             case EVEDB::invCategories::Ship: {      // ship attribs saved in shipItem, not here.
+                mDirty.clear();
                 return true;
             } break;
             case EVEDB::invCategories::Skill: {     // save SP, Level and times for skills
@@ -180,7 +250,10 @@ bool AttributeMap::Save() {
             } break;
         }
 
-        for (; itr != end; ++itr) {
+        for (auto cur : mDirty) {
+            itr = mAttributes.find(cur);
+            if (itr == end)
+                continue;
             save = false;
             if (skill)
                 if ((itr->first == AttrSkillPoints)
@@ -203,13 +276,12 @@ bool AttributeMap::Save() {
                     data.type = true;
                     data.valueFloat = itr->second.get_double();
                 }
-                attribs.push_back(data);
+                into.push_back(data);
             }
         }
     }
 
-    if (!attribs.empty())
-        ItemDB::SaveAttributes(IsCharacter(mItem.itemID()), attribs);
+    mDirty.clear();
     return true;
 }
 
@@ -226,6 +298,7 @@ void AttributeMap::SetAttribute(uint16 attrID, EvilNumber& num, bool notify/*tru
     AttrMapItr itr = mAttributes.find(attrID);
     if (itr == mAttributes.end()) {
         mAttributes.emplace(attrID, num);
+        mDirty.insert(attrID);
         if (notify) {
             Add(attrID, num);
         } else if (is_log_enabled(ATTRIBUTE__MISSING)) {
@@ -275,6 +348,7 @@ void AttributeMap::SetAttribute(uint16 attrID, EvilNumber& num, bool notify/*tru
     }
 
     itr->second = num;
+    mDirty.insert(attrID);
 }
 
 void AttributeMap::MultiplyAttribute(uint16 attrID, EvilNumber& num, bool notify/*false*/)
@@ -300,6 +374,7 @@ void AttributeMap::MultiplyAttribute(uint16 attrID, EvilNumber& num, bool notify
 
     EvilNumber oldValue(itr->second);
     itr->second *= num;
+    mDirty.insert(attrID);
 
     if (notify)
         Change(attrID, oldValue, itr->second);
@@ -490,66 +565,10 @@ void AttributeMap::SaveShipState()
     Inserts << "REPLACE INTO entity_attributes ";
     Inserts << " (itemID, attributeID, valueInt, valueFloat) VALUES";
     bool save(false);
-    AttrMap::iterator cur = mAttributes.find(AttrShieldCharge);
-    if (cur != mAttributes.end()) {
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << cur->first << ", ";
-        if ( cur->second.get_type() == evil_number_int ) {
-            Inserts << cur->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << cur->second.get_double() << ")";
-        }
-    }
-    cur = mAttributes.find(AttrArmorDamage);
-    if (cur != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << cur->first << ", ";
-        if ( cur->second.get_type() == evil_number_int ) {
-            Inserts << cur->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << cur->second.get_double() << ")";
-        }
-    }
-    cur = mAttributes.find(AttrDamage);
-    if (cur != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << cur->first << ", ";
-        if ( cur->second.get_type() == evil_number_int ) {
-            Inserts << cur->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << cur->second.get_double() << ")";
-        }
-    }
-    cur = mAttributes.find(AttrHeatHi);
-    if (cur != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << cur->first << ", ";
-        if ( cur->second.get_type() == evil_number_int ) {
-            Inserts << cur->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << cur->second.get_double() << ")";
-        }
-    }
-    cur = mAttributes.find(AttrHeatMed);
-    if (cur != mAttributes.end()) {
-        if (save)
-            Inserts << ",";
-        save = true;
-        Inserts << "(" << mItem.itemID() << ", " << cur->first << ", ";
-        if ( cur->second.get_type() == evil_number_int ) {
-            Inserts << cur->second.get_int() << ", NULL)";
-        } else {
-            Inserts << " NULL, " << cur->second.get_double() << ")";
-        }
-    }
-    cur = mAttributes.find(AttrHeatLow);
-    if (cur != mAttributes.end()) {
+    for (auto attrID : s_shipStateAttrs) {
+        AttrMap::iterator cur = mAttributes.find(attrID);
+        if (cur == mAttributes.end())
+            continue;
         if (save)
             Inserts << ",";
         save = true;
@@ -561,17 +580,18 @@ void AttributeMap::SaveShipState()
         }
     }
 
+    // fire-and-forget; Load() waits for queued writes of this item, or keeps these values on reset.
+    //  safe from system tics, where this is held until the tic ends; nothing reads it back within the tic
     if (save) {
-        DBerror err;
-        if (!sDatabase.RunQuery(err, Inserts.str().c_str())) {
-            _log(DATABASE__ERROR, "SaveShipState - unable to save attributes for %u - %s", mItem.itemID(), err.c_str());
-        }
+        sDatabase.QueueWrite(mItem.itemID(), Inserts.str());
+        mStateQueued = true;
     }
 }
 
 // Delete() only called from InventoryItem::Delete()
 void AttributeMap::Delete() {
     mAttributes.clear();
+    mDirty.clear();
 }
 
 void AttributeMap::DeleteAttribute(uint16 attrID) {
@@ -579,6 +599,7 @@ void AttributeMap::DeleteAttribute(uint16 attrID) {
     AttrMapItr itr = mAttributes.find(attrID);
     if (itr != mAttributes.end()) {
         mAttributes.erase(itr);
+        mDirty.erase(attrID);
         // if it's not in the map, it's not in db, either...
         DBerror err;
         if (IsCharacter(mItem.itemID())) {
@@ -586,9 +607,9 @@ void AttributeMap::DeleteAttribute(uint16 attrID) {
                 _log(DATABASE__ERROR, "DeleteAttribute - unable to delete attribute %u for %u - %s", attrID, mItem.itemID(), err.c_str());
             }
         } else {
-            if (!sDatabase.RunQuery(err, "DELETE FROM entity_attributes WHERE itemID = %u AND attributeID = %u", mItem.itemID(), attrID)) {
-                _log(DATABASE__ERROR, "DeleteAttribute - unable to delete attribute %u for %u - %s", attrID, mItem.itemID(), err.c_str());
-            }
+            // queued behind any ship state write of this item, so that cannot bring the row back
+            sDatabase.QueueWrite(mItem.itemID(), "DELETE FROM entity_attributes WHERE itemID = %u AND attributeID = %u", mItem.itemID(), attrID);
+            mWriteQueued = true;
         }
     } else {
         _log(ATTRIBUTE__WARNING, "Attribute %u not found in %s(%u) when calling delete ", attrID, mItem.name(), mItem.itemID());
@@ -28,10 +28,12 @@
 #define __EVE_ATTRIBUTE_MGR__H__INCL__
 
 #include "./eve-common.h"
+#include "utils/FlatMap.h"
 
 #include "inventory/InventoryDB.h"
 
-typedef std::map<uint16, EvilNumber>    AttrMap;
+// sorted vector.  items hold a few dozen attributes each, which are mostly read
+typedef FlatMap<uint16, EvilNumber>     AttrMap;
 typedef AttrMap::iterator               AttrMapItr;
 typedef AttrMap::const_iterator         AttrMapConstItr;
 
@@ -52,15 +54,34 @@ public:
     bool HasAttribute(const uint16 attrID) const;
     bool HasAttribute(const uint16 attrID, EvilNumber& value) const;
 
+    /* writes saved attributes changed since last save (see GetSaveData()) */
     bool Save();
+    /**
+     * @brief Gets attributes to save which changed since they were last saved, and marks them saved.
+     *  rows which then fail to write are marked again with SetDirty().
+     *
+     * @param[out] into Attribute rows are appended here, to be written with ItemDB::SaveAttributes().
+     *
+     * @return False if attributes of this item are never saved here.
+     */
+    bool GetSaveData(std::vector<Inv::AttrData>& into);
+    /** @return True if any attribute changed since it was last saved. */
+    bool IsDirty() const                                { return !mDirty.empty(); }
+    // marks attribute unsaved again, when writing its GetSaveData() row failed
+    void SetDirty(uint16 attrID)                        { mDirty.insert(attrID); }
 
     void Delete();
     void DeleteAttribute(uint16 attrID);
 
-    // load the default attributes that come with the item's typeID
+    /**
+     * @brief Loads default attributes of item's type, then its saved values.
+     *
+     * @param[in] reset Clears the map first.  if only ship state was queued for writing since last load,
+     *  its values are kept from memory instead of waiting for the write to land.
+     */
     bool Load(bool reset=false);
 
-    /* only save the ship damage and heat. other attribs are calculated when ship activated */
+    /* only save the ship damage and heat. other attribs are calculated when ship activated.  written through the db queue */
     void SaveShipState();
     bool SaveAttributes();
 
@@ -117,6 +138,12 @@ protected:
     InventoryItem& mItem;
 
     AttrMap mAttributes;
+    // attributes changed since last save.  cleared by GetSaveData() and Load()
+    std::set<uint16> mDirty;
+
+    // writes of this item queued since last Load()
+    bool mStateQueued;      // by SaveShipState()
+    bool mWriteQueued;      // any other.  Load() must wait for these
 
 private:
     InventoryDB m_db;
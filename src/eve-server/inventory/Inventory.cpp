@@ -67,6 +67,7 @@ void Inventory::Unload()
     Inventory* inv(nullptr);
     if (!sConsole.IsShutdown()) {
         std::vector<Inv::SaveData> items;
+        std::vector<uint32> unloaded, failed;
         items.clear();
         std::map<uint32, InventoryItemRef>::iterator itr = mContents.begin();
         while (itr != mContents.end()) {
@@ -81,24 +82,29 @@ void Inventory::Unload()
                     continue;
                 }
 
-                Inv::SaveData data = Inv::SaveData();
-                    data.itemID = itr->first;
-                    data.contraband = itr->second->contraband();
-                    data.flag = itr->second->flag();
-                    data.locationID = itr->second->locationID();
-                    data.ownerID = itr->second->ownerID();
-                    data.position = itr->second->position();
-                    data.quantity = itr->second->quantity();
-                    data.singleton = itr->second->isSingleton();
-                    data.typeID = itr->second->typeID();
-                    data.customInfo = itr->second->customInfo();
-                items.push_back(data);
+                // changes since last save would be lost once the item leaves the factory
+                if (itr->second->IsAttributeDirty()) {
+                    itr->second->GetAttributeMap()->Save();
+                    // attributes which failed to save are marked dirty again
+                    if (itr->second->IsAttributeDirty())
+                        failed.push_back(itr->first);
+                }
+                if (itr->second->IsDirty()) {
+                    Inv::SaveData data = Inv::SaveData();
+                    itr->second->GetSaveData(data);
+                    items.push_back(data);
+                }
             }
-            sItemFactory.RemoveItem(itr->first);
+            unloaded.push_back(itr->first);
             itr = mContents.erase(itr);
         }
 
-        ItemDB::SaveItems(items);
+        ItemDB::SaveItems(items, failed);
+        // items the db failed to save are left in the factory, where the next SaveItems() retries them
+        sItemFactory.SetUnsaved(failed, std::vector<Inv::AttrData>());
+        for (auto cur : unloaded)
+            if (std::find(failed.begin(), failed.end(), cur) == failed.end())
+                sItemFactory.RemoveItem(cur);
     }
     mContents.clear();
     m_contentsByFlag.clear();
@@ -178,18 +184,22 @@ bool Inventory::LoadContents() {
         return false;
     }
 
+    // load all items together, so their rows and attributes are read in a few queries instead of a few per item
+    std::vector<uint32> loadIDs;
+    loadIDs.reserve(items.size());
     for (auto cur : items) {
         if ((cur == od.ownerID) or (cur == od.locID) or (cur == m_myID))
             continue;
-        InventoryItemRef iRef = sItemFactory.GetItem(cur);
-        if (iRef.get() == nullptr) {
-            _log(INV__WARNING, "Inventory::LoadContents() - Failed to load item %u contained in %u. Skipping.", cur, m_myID);
-            continue;
-        } else {
-            AddItem(iRef);
-        }
+        loadIDs.push_back(cur);
     }
 
+    std::vector<InventoryItemRef> iRefs;
+    sItemFactory.GetItems(loadIDs, iRefs);
+    if (iRefs.size() < loadIDs.size())
+        _log(INV__WARNING, "Inventory::LoadContents() - Failed to load %u of %u items contained in %u. Skipping.", loadIDs.size() - iRefs.size(), loadIDs.size(), m_myID);
+    for (auto cur : iRefs)
+        AddItem(cur);
+
     if (sConfig.debug.UseProfiling)
         sProfiler.AddTime(Profile::itemload, GetTimeUSeconds() - profileStartTime);
 
@@ -55,7 +55,8 @@ m_data(_data),
 m_type(_type),
 m_itemID(_itemID),
 m_timestamp(0),  // placeholder for fx timestamp, once implemented
-m_delete(false)
+m_delete(false),
+m_dirty(false)
 {
     // assert for data consistency
     assert(_data.typeID == _type.id());
@@ -73,7 +74,8 @@ m_itemID(oth.m_itemID),
 m_data(oth.m_data),
 m_type(oth.m_type),
 m_timestamp(oth.m_timestamp),
-m_delete(false)
+m_delete(false),
+m_dirty(false)
 {
     sLog.Error("InventoryItem()", "InventoryItem copy c'tor called.");
     EvE::traceStack();
@@ -89,7 +91,8 @@ m_itemID(oth.m_itemID),
 m_data(oth.m_data),
 m_type(oth.m_type),
 m_timestamp(oth.m_timestamp),
-m_delete(false)
+m_delete(false),
+m_dirty(false)
 {
     sLog.Error("InventoryItem()", "InventoryItem move c'tor called.");
     EvE::traceStack();
@@ -135,6 +138,21 @@ InventoryItemRef InventoryItem::Load(uint32 itemID)
     return InventoryItem::Load<InventoryItem>(itemID);
 }
 
+InventoryItemRef InventoryItem::Load(uint32 itemID, const ItemData &data)
+{
+    const ItemType *iType = sItemFactory.GetType(data.typeID);
+    if (iType == nullptr)
+        return InventoryItemRef(nullptr);
+
+    InventoryItemRef iRef = InventoryItem::_LoadItem<InventoryItem>(itemID, *iType, data);
+    if (!iRef)
+        return InventoryItemRef(nullptr);
+    if (!iRef->_Load())
+        return InventoryItemRef(nullptr);
+
+    return iRef;
+}
+
 InventoryItemRef InventoryItem::SpawnItem(uint32 itemID, const ItemData &data)
 {
     if (data.quantity == 0)
@@ -701,6 +719,7 @@ void InventoryItem::Donate(uint32 new_owner/*ownerSystem*/, uint32 new_location/
     m_data.flag = new_flag;
     m_data.ownerID = new_owner;
     m_data.locationID = new_location;
+    m_dirty = true;
 
     if ((old_location != m_data.locationID) // diff container
     or ((old_location == m_data.locationID) // or same container
@@ -764,6 +783,7 @@ void InventoryItem::Move(uint32 new_location/*locTemp*/, EVEItemFlags new_flag/*
     // update data
     m_data.flag = new_flag;
     m_data.locationID = new_location;
+    m_dirty = true;
 
     if ((old_location != m_data.locationID) // diff container
     or ((old_location == m_data.locationID) // or same container
@@ -829,6 +849,7 @@ void InventoryItem::Relocate(uint32 locID, EVEItemFlags flag) {
     // update data
     m_data.flag = flag;
     m_data.locationID = locID;
+    m_dirty = true;
 
     if ((old_location != m_data.locationID) // diff container
     or ((old_location == m_data.locationID) // or same container
@@ -949,6 +970,7 @@ bool InventoryItem::SetQuantity(int32 qty, bool notify/*false*/, bool deleteOnZe
     }
     int32 old_qty = m_data.quantity;
     m_data.quantity = qty;
+    m_dirty = true;
 
     if (m_data.quantity > maxEveItem) {
         codelog(ITEM__ERROR, "II::SetQuantity() - %s(%u): quantity overflow", m_data.name.c_str(), m_itemID);
@@ -991,6 +1013,7 @@ bool InventoryItem::SetFlag(EVEItemFlags flag, bool notify/*false*/) {
 
     EVEItemFlags old_flag = m_data.flag;
     m_data.flag = flag;
+    m_dirty = true;
 
     ItemDB::UpdateLocation(m_itemID, m_data.locationID, m_data.flag);
 
@@ -1009,6 +1032,7 @@ bool InventoryItem::ChangeSingleton(bool singleton, bool notify/*false*/) {
 
     bool old_singleton = m_data.singleton;
     m_data.singleton = singleton;
+    m_dirty = true;
 
     //verify quantity is -1 for singletons
     if (m_data.singleton)
@@ -1038,6 +1062,7 @@ void InventoryItem::ChangeOwner(uint32 new_owner, bool notify/*false*/) {
 
     uint32 old_owner = m_data.ownerID;
     m_data.ownerID = new_owner;
+    m_dirty = true;
 
     if (sConfig.world.saveOnUpdate)
         SaveItem();
@@ -1107,12 +1132,33 @@ void InventoryItem::SaveItem()
                   customInfo().c_str()
                   );
 
-    ItemDB::SaveItem(m_itemID, data);
-    // item attributes are saved in ItemFactory.cpp:96  (save loop on shutdown for loaded items)
+    if (ItemDB::SaveItem(m_itemID, data))
+        m_dirty = false;
+    // item attributes are also saved by ItemFactory::SaveItems() (periodic checkpoint and shutdown)
     // make call here for items saved after *some* change
     pAttributeMap->Save();
 }
 
+bool InventoryItem::IsAttributeDirty() const
+{
+    return pAttributeMap->IsDirty();
+}
+
+void InventoryItem::GetSaveData(Inv::SaveData& into)
+{
+    into.itemID = m_itemID;
+    into.contraband = m_data.contraband;
+    into.flag = m_data.flag;
+    into.locationID = m_data.locationID;
+    into.ownerID = m_data.ownerID;
+    into.position = m_data.position;
+    into.quantity = m_data.quantity;
+    into.singleton = m_data.singleton;
+    into.typeID = m_type.id();
+    into.customInfo = m_data.customInfo;
+    m_dirty = false;
+}
+
 void InventoryItem::UpdateLocation() {
     ItemDB::UpdateLocation(m_itemID, m_data.locationID, m_data.flag);
 }
@@ -1295,6 +1341,7 @@ void InventoryItem::SetCustomInfo(const char *ci) {
     } else {
         m_data.customInfo = "";
     }
+    m_dirty = true;
 
     if (sConfig.world.saveOnUpdate)
         SaveItem();
@@ -1311,6 +1358,7 @@ void InventoryItem::SetPosition(const GPoint& pos)
     } */
 
     m_data.position = pos;
+    m_dirty = true;
     _log(ITEM__RELOCATE, "%s(%u) Relocating to %.2f, %.2f, %.2f.", m_data.name.c_str(), \
             m_itemID, m_data.position.x, m_data.position.y, m_data.position.z);
 }
@@ -1466,22 +1514,6 @@ void InventoryItem::AddModifier(fxData &data)
     m_modifiers.emplace(data.math, data);
 }
 
-void InventoryItem::RemoveModifier(fxData &data)
-{
-    switch (data.math) {
-        case FX::Math::PreMul:         data.math = FX::Math::PreDiv;          break;
-        case FX::Math::PreDiv:         data.math = FX::Math::PreMul;          break;
-        case FX::Math::ModAdd:         data.math = FX::Math::ModSub;          break;
-        case FX::Math::ModSub:         data.math = FX::Math::ModAdd;          break;
-        case FX::Math::PostMul:        data.math = FX::Math::PostDiv;         break;
-        case FX::Math::PostDiv:        data.math = FX::Math::PostMul;         break;
-        case FX::Math::PostPercent:    data.math = FX::Math::RevPostPercent;  break;
-        case FX::Math::PreAssignment:  data.math = FX::Math::PostAssignment;  break;
-        case FX::Math::PostAssignment: data.math = FX::Math::PreAssignment;   break;
-    }
-    m_modifiers.emplace(data.math, data);
-}
-
 void InventoryItem::ClearModifiers()
 {
     _log(EFFECTS__TRACE, "Clearing modifier map for %s", m_data.name.c_str());
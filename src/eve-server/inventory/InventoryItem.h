@@ -135,12 +135,20 @@ public:
     // sets new flag, if different, saves update to db, and (optionally) notifies client of change
     bool                    SetFlag(EVEItemFlags flag, bool notify=false);
     // sets owner for player-owned npc types (drone, missile, etc)
-    void                    SetOwner(uint32 ownerID)    { m_data.ownerID = ownerID; }
+    void                    SetOwner(uint32 ownerID)    { m_data.ownerID = ownerID; m_dirty = true; }
 
     /* public-access data functions handled in base class. */
     void                    SaveItem();  //save the item to the DB.
     void                    UpdateLocation();   // save item's location, owner, flag
-    void                   UpdateLocation(uint32 locID) { m_data.locationID = locID; }  // change item's locationID without saving
+    void                   UpdateLocation(uint32 locID) { m_data.locationID = locID; m_dirty = true; }  // change item's locationID without saving
+
+    /* saved item data changed since the item was last saved.  set by mutators, cleared by SaveItem() and GetSaveData() */
+    bool                    IsDirty() const             { return m_dirty; }
+    // marks item unsaved again, when writing its GetSaveData() failed
+    void                    SetDirty()                  { m_dirty = true; }
+    bool                    IsAttributeDirty() const;
+    // fills data to save this item with ItemDB::SaveItems(), and clears dirty flag
+    void                    GetSaveData(Inv::SaveData& into);
 
     /* virtual functions default to base class and overridden as needed */
     virtual void            Delete();  //totally removes item from game and deletes from the DB.
@@ -209,6 +217,8 @@ public:
     /*  Item Creating and Loading methods */
     /* calls _Ty::Load<_Ty>.  */
     static InventoryItemRef Load( uint32 itemID);
+    /* as above, using item data already read from db.  used by ItemFactory::GetItems() */
+    static InventoryItemRef Load( uint32 itemID, const ItemData &data);
     /* creates new Item and calls item::_Load() */
     /* does not save to db.  does not add item to ItemFactory */
     static InventoryItemRef SpawnItem( uint32 itemID, const ItemData &data);
@@ -281,6 +291,7 @@ protected:
 
 private:
     bool m_delete;
+    bool m_dirty;
     ItemData m_data;
     ItemType m_type;
 
@@ -293,7 +304,6 @@ public:
     // this clears m_modifiers
     void ClearModifiers();
     void AddModifier(fxData &data);
-    void RemoveModifier(fxData &data);
     // this deletes all attributes, reloads default attribs from itemType and
     void ResetAttributes();   //  when called at the wrong time, this will really fuck up ship attributes.  ;)
 
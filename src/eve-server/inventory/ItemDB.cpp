@@ -29,6 +29,24 @@
 #include "inventory/ItemDB.h"
 
 
+// max rows written by one statement of SaveItems() and SaveAttributes()
+const uint16 SAVE_BATCH_ROWS = 500;
+// max itemIDs read by one statement of GetItems() and GetAttributes()
+const uint16 LOAD_BATCH_ROWS = 1000;
+
+// appends "(id, id, ...)" for ids [begin, end) to query
+static void AppendIDList(std::string& query, std::vector<uint32>::const_iterator begin, std::vector<uint32>::const_iterator end)
+{
+    char buf[16];
+    query += "(";
+    for (std::vector<uint32>::const_iterator itr = begin; itr != end; ++itr) {
+        snprintf(buf, sizeof(buf), "%s%u", (itr == begin ? "" : ","), *itr);
+        query += buf;
+    }
+    query += ")";
+}
+
+
 bool ItemDB::GetItem(uint32 itemID, ItemData &into) {
     /* called by RefPtr<_Ty> _Load() at InventoryItem.h:189 */
     DBQueryResult res;
@@ -180,6 +198,73 @@ bool ItemDB::GetItem(uint32 itemID, ItemData &into) {
     return true;
 }
 
+void ItemDB::GetItems(const std::vector<uint32>& itemIDs, std::map<uint32, ItemData>& into)
+{
+    std::string query;
+    std::vector<uint32>::const_iterator itr = itemIDs.begin(), end = itemIDs.end(), last;
+    while (itr != end) {
+        last = ((end - itr) > LOAD_BATCH_ROWS ? itr + LOAD_BATCH_ROWS : end);
+        query = "SELECT itemID, itemName, typeID, ownerID, locationID, flag, contraband,"
+                "  singleton, quantity, x, y, z, customInfo"
+                " FROM entity WHERE itemID IN ";
+        AppendIDList(query, itr, last);
+        itr = last;
+
+        DBQueryResult res;
+        if (!sDatabase.RunQuery(res, query.c_str())) {
+            codelog(DATABASE__ERROR, "Error in GetItems query: %s", res.error.c_str());
+            continue;
+        }
+
+        DBResultRow row;
+        while (res.GetRow(row)) {
+            ItemData& data = into[row.GetUInt(0)];
+            data.name = row.GetText(1);
+            data.typeID = row.GetUInt(2);
+            data.ownerID = (row.IsNull(3) ? 1 : row.GetUInt(3));
+            data.locationID = (row.IsNull(4) ? 0 : row.GetUInt(4));
+            data.flag = (EVEItemFlags)row.GetUInt(5);
+            data.contraband = row.GetInt(6) ? true : false;
+            data.singleton = row.GetInt(7) ? true : false;
+            data.quantity = row.GetUInt(8);
+            data.position.x = row.GetDouble(9);
+            data.position.y = row.GetDouble(10);
+            data.position.z = row.GetDouble(11);
+            data.customInfo = (row.IsNull(12) ? "" : row.GetText(12));
+        }
+    }
+}
+
+void ItemDB::GetAttributes(const std::vector<uint32>& itemIDs, std::map<uint32, std::vector<Inv::AttrData>>& into)
+{
+    std::string query;
+    std::vector<uint32>::const_iterator itr = itemIDs.begin(), end = itemIDs.end(), last;
+    while (itr != end) {
+        last = ((end - itr) > LOAD_BATCH_ROWS ? itr + LOAD_BATCH_ROWS : end);
+        query = "SELECT itemID, attributeID, valueInt, valueFloat FROM entity_attributes WHERE itemID IN ";
+        AppendIDList(query, itr, last);
+        itr = last;
+
+        DBQueryResult res;
+        if (!sDatabase.RunQuery(res, query.c_str())) {
+            codelog(DATABASE__ERROR, "Error in GetAttributes query: %s", res.error.c_str());
+            continue;
+        }
+
+        DBResultRow row;
+        Inv::AttrData data = Inv::AttrData();
+        while (res.GetRow(row)) {
+            data.itemID = row.GetUInt(0);
+            data.attrID = row.GetUInt(1);
+            // both null is saved as int 0
+            data.type = (row.IsNull(2) and !row.IsNull(3));
+            data.valueInt = (row.IsNull(2) ? 0 : row.GetInt64(2));
+            data.valueFloat = (row.IsNull(3) ? 0.0 : row.GetDouble(3));
+            into[data.itemID].push_back(data);
+        }
+    }
+}
+
 uint32 ItemDB::NewItem(const ItemData &data) {
     // check for common errors ('common' is relative.)
     if (data.position.isNaN() or data.position.isInf())
@@ -261,88 +346,96 @@ bool ItemDB::SaveItem(uint32 itemID, const ItemData &data) {
     return true;
 }
 
-void ItemDB::SaveItems(std::vector<Inv::SaveData>& data)
+uint32 ItemDB::SaveItems(std::vector<Inv::SaveData>& data, std::vector<uint32>& failed)
 {
-    std::ostringstream Inserts;
-    // start the insert into command.
-    Inserts << "INSERT INTO entity";
-    Inserts << " (itemID, typeID, ownerID, locationID, flag, contraband, singleton, quantity, x, y, z, customInfo)";
-    bool first = true;
-    for (auto cur : data) {
-        if (cur.position.isNaN() or cur.position.isInf()) {
-            _log(DATABASE__ERROR, "ItemDB::SaveItems() - %u has invalid position", cur.itemID);
-            continue;
+    uint32 rows(0), count(0);
+    std::string query, customInfoEsc;
+    char buf[256];
+    std::vector<uint32> batch;
+    std::vector<Inv::SaveData>::const_iterator itr = data.begin(), end = data.end();
+    while (itr != end) {
+        // one statement per SAVE_BATCH_ROWS rows, so a large save doesnt hold the db in a single huge query
+        query.clear();
+        query.reserve(SAVE_BATCH_ROWS * 128);
+        query = "INSERT INTO entity (itemID, typeID, ownerID, locationID, flag, contraband, singleton, quantity, x, y, z, customInfo) VALUES ";
+        count = 0;
+        batch.clear();
+        for (; (itr != end) and (count < SAVE_BATCH_ROWS); ++itr) {
+            // bad data wont save on retry either.  it is dropped here, and saved when item changes again
+            if (itr->position.isNaN() or itr->position.isInf()) {
+                _log(DATABASE__ERROR, "ItemDB::SaveItems() - %u has invalid position.  not saved.", itr->itemID);
+                continue;
+            }
+            if (itr->locationID == 0) {
+                _log(DATABASE__ERROR, "ItemDB::SaveItems() - %u has invalid location.  not saved.", itr->itemID);
+                continue;
+            }
+            snprintf(buf, sizeof(buf), "%s(%u, %u, %u, %u, %u, %u, %u, %u, %f, %f, %f, '",
+                     (count ? ", " : ""), itr->itemID, itr->typeID, itr->ownerID, itr->locationID, (uint16)itr->flag,
+                     (itr->contraband ? 1 : 0), (itr->singleton ? 1 : 0), itr->quantity,
+                     itr->position.x, itr->position.y, itr->position.z);
+            query += buf;
+            sDatabase.DoEscapeString(customInfoEsc, itr->customInfo);
+            query += customInfoEsc;
+            query += "')";
+            batch.push_back(itr->itemID);
+            ++count;
         }
-        if (cur.locationID == 0) {
-            _log(DATABASE__ERROR, "ItemDB::SaveItems() - %u has invalid location", cur.itemID);
+
+        if (count == 0)
             continue;
-        }
-        if (first) {
-            Inserts << " VALUES ";
-            first = false;
-        } else {
-            Inserts << ", ";
-        }
-        Inserts << "(" << cur.itemID << ", " << cur.typeID << ", " << cur.ownerID << ", " << cur.locationID << ", ";
-        Inserts << cur.flag << ", " << cur.contraband << ", " << (cur.singleton ? 1 : 0) << ", ";
-        Inserts << cur.quantity << ", " << std::to_string(cur.position.x) << ", " << std::to_string(cur.position.y) << ", " << std::to_string(cur.position.z);
-        Inserts << ", '" << cur.customInfo << "')";
-    }
 
-    if (!first) {
-        Inserts << "ON DUPLICATE KEY UPDATE ";
-        Inserts << "quantity=VALUES(quantity), ";
-        Inserts << "ownerID=VALUES(ownerID), ";
-        Inserts << "locationID=VALUES(locationID), ";
-        Inserts << "flag=VALUES(flag), ";
-        Inserts << "singleton=VALUES(singleton), ";
-        Inserts << "quantity=VALUES(quantity), ";
-        Inserts << "x=VALUES(x), ";
-        Inserts << "y=VALUES(y), ";
-        Inserts << "z=VALUES(z), ";
-        Inserts << "customInfo=VALUES(customInfo) ";
+        query += " ON DUPLICATE KEY UPDATE"
+                 " quantity=VALUES(quantity), ownerID=VALUES(ownerID), locationID=VALUES(locationID), flag=VALUES(flag),"
+                 " singleton=VALUES(singleton), x=VALUES(x), y=VALUES(y), z=VALUES(z), customInfo=VALUES(customInfo)";
         DBerror err;
-        if (!sDatabase.RunQuery(err, Inserts.str().c_str()))
+        if (sDatabase.RunQuery(err, query.c_str())) {
+            rows += count;
+        } else {
             _log(DATABASE__ERROR, "SaveItems - unable to save data - %s", err.c_str());
+            failed.insert(failed.end(), batch.begin(), batch.end());
+        }
     }
+
+    return rows;
 }
 
-void ItemDB::SaveAttributes(bool isChar, std::vector<Inv::AttrData>& data)
+uint32 ItemDB::SaveAttributes(bool isChar, std::vector<Inv::AttrData>& data, std::vector<Inv::AttrData>& failed)
 {
-    std::ostringstream Inserts;
-    // start the insert into command.
-    if (isChar) {
-        DBerror err;
-        sDatabase.RunQuery(err, "DELETE FROM chrCharacterAttributes WHERE charID = %u", data[0].itemID);
-        Inserts << "INSERT INTO chrCharacterAttributes";
-        Inserts << " (charID, attributeID, valueInt, valueFloat)";
-    } else {
-        Inserts << "INSERT INTO entity_attributes";
-        Inserts << " (itemID, attributeID, valueInt, valueFloat)";
-    }
-    bool first(true);
-    for (auto cur : data) {
-        if (first) {
-            Inserts << " VALUES ";
-            first = false;
-        } else
-            Inserts << ", ";
-        Inserts << "(" << cur.itemID << ", " << cur.attrID << ", ";
-        if (cur.type) {
-            Inserts << "NULL, " << cur.valueFloat << ")";
+    uint32 rows(0), count(0);
+    std::string query;
+    char buf[128];
+    std::vector<Inv::AttrData>::const_iterator itr = data.begin(), end = data.end(), first;
+    while (itr != end) {
+        first = itr;
+        query.clear();
+        query.reserve(SAVE_BATCH_ROWS * 48);
+        if (isChar) {
+            query = "INSERT INTO chrCharacterAttributes (charID, attributeID, valueInt, valueFloat) VALUES ";
         } else {
-            Inserts << cur.valueInt << ", NULL)";
+            query = "INSERT INTO entity_attributes (itemID, attributeID, valueInt, valueFloat) VALUES ";
+        }
+        count = 0;
+        for (; (itr != end) and (count < SAVE_BATCH_ROWS); ++itr, ++count) {
+            if (itr->type) {
+                snprintf(buf, sizeof(buf), "%s(%u, %u, NULL, %.15g)", (count ? ", " : ""), itr->itemID, itr->attrID, itr->valueFloat);
+            } else {
+                snprintf(buf, sizeof(buf), "%s(%u, %u, %li, NULL)", (count ? ", " : ""), itr->itemID, itr->attrID, itr->valueInt);
+            }
+            query += buf;
         }
-    }
 
-    if (!first) {
-        Inserts << "ON DUPLICATE KEY UPDATE ";
-        Inserts << "valueInt=VALUES(valueInt), ";
-        Inserts << "valueFloat=VALUES(valueFloat)";
+        query += " ON DUPLICATE KEY UPDATE valueInt=VALUES(valueInt), valueFloat=VALUES(valueFloat)";
         DBerror err;
-        if (!sDatabase.RunQuery(err, Inserts.str().c_str()))
-            _log(DATABASE__ERROR, "SaveItems - unable to save data - %s", err.c_str());
+        if (sDatabase.RunQuery(err, query.c_str())) {
+            rows += count;
+        } else {
+            _log(DATABASE__ERROR, "SaveAttributes - unable to save data - %s", err.c_str());
+            failed.insert(failed.end(), first, itr);
+        }
     }
+
+    return rows;
 }
 
 bool ItemDB::DeleteItem(uint32 itemID) {
@@ -357,10 +450,9 @@ bool ItemDB::DeleteItem(uint32 itemID) {
         return false;
     }
 
-    if (!sDatabase.RunQuery(err, "DELETE FROM entity_attributes WHERE itemID=%u", itemID)) {
-        codelog(DATABASE__ERROR, "Failed to delete item %u: %s", itemID, err.c_str());
-        return false;
-    }
+    // queued behind any ship state write of this item, so that cannot bring the rows back.
+    //  from system tics (wrecks, cans) this is held until the tic ends; the item is gone, so nothing reads the rows meanwhile
+    sDatabase.QueueWrite(itemID, "DELETE FROM entity_attributes WHERE itemID=%u", itemID);
     return true;
 }
 
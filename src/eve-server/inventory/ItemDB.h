@@ -34,6 +34,10 @@ class ItemDB
 public:
     // get item data based on itemID
     static bool GetItem(uint32 itemID, ItemData &into);
+    // get item data and saved attributes of many entity table items at once, in batches of LOAD_BATCH_ROWS ids.
+    //  items not found are not added to 'into'
+    static void GetItems(const std::vector< uint32 > &itemIDs, std::map< uint32, ItemData > &into);
+    static void GetAttributes(const std::vector< uint32 > &itemIDs, std::map< uint32, std::vector< Inv::AttrData > > &into);
     static bool DeleteItem(uint32 itemID);
 
     static void UpdateLocation(uint32 itemID, uint32 locationID, EVEItemFlags flag);
@@ -41,8 +45,10 @@ public:
     static uint32 NewItem(const ItemData &data);
 
     static bool SaveItem(uint32 itemID, const ItemData &data);
-    static void SaveItems(std::vector< Inv::SaveData > &data);
-    static void SaveAttributes(bool isChar, std::vector< Inv::AttrData > &data);
+    // these write rows in batches, and return the number of rows written.  rows of batches the db failed to write are added to failed.
+    //  item rows with bad data (invalid position or location) are logged and skipped, but not added to failed
+    static uint32 SaveItems(std::vector< Inv::SaveData > &data, std::vector< uint32 > &failed);
+    static uint32 SaveAttributes(bool isChar, std::vector< Inv::AttrData > &data, std::vector< Inv::AttrData > &failed);
 
     // only used in ConsoleCommands to test/process fx data
     static void GetItems(uint16 catID, std::map<uint16, std::string> &typeIDs);
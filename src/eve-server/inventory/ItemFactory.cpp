@@ -28,9 +28,11 @@
 
 #include "Client.h"
 #include "EVEServerConfig.h"
+#include "Profiler.h"
 #include "character/Character.h"
 #include "exploration/Probes.h"
 #include "inventory/InventoryDB.h"
+#include "inventory/ItemDB.h"
 #include "inventory/ItemFactory.h"
 #include "inventory/ItemType.h"
 #include "manufacturing/Blueprint.h"
@@ -51,6 +53,9 @@ m_nextTempID(0),
 m_nextNPCID(0),
 m_nextDroneID(0),
 m_nextMissileID(0),
+m_saveKey(0),
+m_saveRowsKey(0),
+m_loadRowsKey(0),
 m_db(nullptr)
 {
 }
@@ -77,6 +82,12 @@ int ItemFactory::Initialize()
 
     m_db = new InventoryDB();
 
+    if (sConfig.debug.UseProfiling) {
+        m_saveKey = sProfiler.RegisterKey("itemSave");
+        m_saveRowsKey = sProfiler.RegisterKey("itemSaveRows", "rows");
+        m_loadRowsKey = sProfiler.RegisterKey("itemLoadRows", "rows");
+    }
+
     sLog.Blue("      ItemFactory", "Item Factory Initialized.");
     return 1;
 }
@@ -100,34 +111,59 @@ void ItemFactory::Close()
 void ItemFactory::SaveItems() {
     if (sConfig.debug.DeleteTrackingCans)
         InventoryDB::DeleteTrackingCans();
-    uint32 count(0);
-    double startTime = GetTimeMSeconds();
+    double startTime = GetTimeUSeconds();
+    // only items and attributes changed since they were last saved are written
     std::vector<Inv::SaveData> items;
-    items.clear();
-    for (auto cur : m_items) {
-        if (IsPlayerItem(cur.first)) { // this is a hack for now.  will eventually move to static/dynamic item maps
-            cur.second->SaveAttributes();
+    std::vector<Inv::AttrData> charAttribs, itemAttribs;
+    {
+        MutexLock lock(mMutex);
+        for (auto& cur : m_items) {
+            if (!IsPlayerItem(cur.first)) // this is a hack for now.  will eventually move to static/dynamic item maps
+                continue;
+            if (cur.second->IsAttributeDirty())
+                cur.second->GetAttributeMap()->GetSaveData(IsCharacter(cur.first) ? charAttribs : itemAttribs);
+            if (!cur.second->IsDirty())
+                continue;
             Inv::SaveData data = Inv::SaveData();
-                data.itemID = cur.first;
-                data.contraband = cur.second->contraband();
-                data.flag = cur.second->flag();
-                data.locationID = cur.second->locationID();
-                data.ownerID = cur.second->ownerID();
-                data.position = cur.second->position();
-                data.quantity = cur.second->quantity();
-                data.singleton = cur.second->isSingleton();
-                data.typeID = cur.second->typeID();
-                data.customInfo = cur.second->customInfo();
+            cur.second->GetSaveData(data);
             items.push_back(data);
-            ++count;
         }
     }
-    ItemDB::SaveItems(items);
-    sLog.Warning("        SaveItems", "Saved %u Dynamic Items in %.3fms.", count, (GetTimeMSeconds() -startTime));
+
+    std::vector<uint32> failedItems;
+    std::vector<Inv::AttrData> failedAttribs;
+    uint32 itemRows = ItemDB::SaveItems(items, failedItems);
+    uint32 attrRows = ItemDB::SaveAttributes(true, charAttribs, failedAttribs);
+    attrRows += ItemDB::SaveAttributes(false, itemAttribs, failedAttribs);
+    SetUnsaved(failedItems, failedAttribs);
+
+    double elapsed = GetTimeUSeconds() - startTime;
+    if (sConfig.debug.UseProfiling) {
+        sProfiler.AddTime(m_saveKey, elapsed);
+        sProfiler.AddTime(m_saveRowsKey, itemRows + attrRows);
+    }
+    sLog.Warning("        SaveItems", "Saved %u Dynamic Items and %u Attributes in %.3fms.", itemRows, attrRows, elapsed / 1000);
+}
+
+void ItemFactory::SetUnsaved(const std::vector<uint32>& items, const std::vector<Inv::AttrData>& attribs)
+{
+    MutexLock lock(mMutex);
+    std::map<uint32, InventoryItemRef>::iterator itr;
+    for (auto cur : items) {
+        itr = m_items.find(cur);
+        if (itr != m_items.end())
+            itr->second->SetDirty();
+    }
+    for (auto cur : attribs) {
+        itr = m_items.find(cur.itemID);
+        if (itr != m_items.end())
+            itr->second->GetAttributeMap()->SetDirty(cur.attrID);
+    }
 }
 
 void ItemFactory::AddItem(InventoryItemRef iRef)
 {
+    MutexLock lock(mMutex);
     if (IsTempItem(iRef->itemID()))
         return;
 
@@ -140,11 +176,13 @@ void ItemFactory::AddItem(InventoryItemRef iRef)
 
 void ItemFactory::RemoveItem(uint32 itemID)
 {
+    MutexLock lock(mMutex);
     m_items.erase(itemID);
 }
 
 uint32 ItemFactory::GetNextTempID()
 {
+    MutexLock lock(mMutex);
     if (m_nextTempID < PLANET_PIN_ID) {
         ++m_nextTempID;
     } else {
@@ -156,19 +194,23 @@ uint32 ItemFactory::GetNextTempID()
 
 uint32 ItemFactory::GetNextNPCID()
 {
+    MutexLock lock(mMutex);
     return ++m_nextNPCID;
 }
 
 uint32 ItemFactory::GetNextDroneID() {
+    MutexLock lock(mMutex);
     return ++m_nextDroneID;
 }
 
 uint32 ItemFactory::GetNextMissileID()
 {
+    MutexLock lock(mMutex);
     return ++m_nextMissileID;
 }
 
 Inventory* ItemFactory::GetInventoryFromId(uint32 itemID, bool load /*true*/) {
+    MutexLock lock(mMutex);
     // do we need to check trade containers here?
     if (!IsValidLocation(itemID))
         return nullptr;
@@ -188,6 +230,7 @@ Inventory* ItemFactory::GetInventoryFromId(uint32 itemID, bool load /*true*/) {
 }
 
 InventoryItemRef ItemFactory::GetInventoryItemFromID(uint32 itemID, bool load /*true*/) {
+    MutexLock lock(mMutex);
     InventoryItemRef iRef(nullptr);
     std::map<uint32, InventoryItemRef>::iterator itr = m_items.find(itemID);
     if (itr != m_items.end()) {
@@ -201,6 +244,7 @@ InventoryItemRef ItemFactory::GetInventoryItemFromID(uint32 itemID, bool load /*
 
 InventoryItemRef ItemFactory::GetItemContainer(uint32 itemID, bool load/*true*/)
 {
+    MutexLock lock(mMutex);
     InventoryItemRef iRef(nullptr);
     std::map<uint32, InventoryItemRef>::iterator itr = m_items.find(itemID);
     if (itr != m_items.end()) {
@@ -225,6 +269,7 @@ InventoryItemRef ItemFactory::GetItemContainer(uint32 itemID, bool load/*true*/)
 
 Inventory* ItemFactory::GetItemContainerInventory(uint32 itemID, bool load/*true*/)
 {
+    MutexLock lock(mMutex);
     InventoryItemRef iRef(nullptr);
     std::map<uint32, InventoryItemRef>::iterator itr = m_items.find(itemID);
     if (itr != m_items.end()) {
@@ -249,6 +294,7 @@ Inventory* ItemFactory::GetItemContainerInventory(uint32 itemID, bool load/*true
 
 template<class _Ty>
 const _Ty* ItemFactory::_GetType(uint16 typeID) {
+    MutexLock lock(mMutex);
     std::map<uint16, ItemType*>::iterator itr = m_types.find(typeID);
     if (itr == m_types.end()) {
         _Ty* type = _Ty::Load(typeID);
@@ -287,6 +333,7 @@ const StationType* ItemFactory::GetStationType(uint16 stationTypeID) {
 template<class _Ty>
 RefPtr<_Ty> ItemFactory::_GetItem(uint32 itemID)
 {
+    MutexLock lock(mMutex);
     std::map<uint32, InventoryItemRef>::iterator itr = m_items.find(itemID);
     if (itr == m_items.end()) {
         if (itemID < minAgent) {
@@ -313,6 +360,79 @@ InventoryItemRef ItemFactory::GetItem(uint32 itemID)
     return _GetItem<InventoryItem>(itemID);
 }
 
+void ItemFactory::GetItems(const std::vector<uint32>& itemIDs, std::vector<InventoryItemRef>& into)
+{
+    // player items not loaded yet are read together.  all others load as single items below
+    std::vector<uint32> loadIDs;
+    {
+        MutexLock lock(mMutex);
+        for (auto cur : itemIDs)
+            if (IsPlayerItem(cur) and (m_items.find(cur) == m_items.end()))
+                loadIDs.push_back(cur);
+    }
+
+    // mMutex is not held while reading; other threads only wait for it to touch the cache
+    std::map<uint32, ItemData> data;
+    if (!loadIDs.empty()) {
+        // ship state is saved through the write queue
+        sDatabase.WaitFor(loadIDs);
+        std::map<uint32, std::vector<Inv::AttrData>> attrs;
+        ItemDB::GetItems(loadIDs, data);
+        ItemDB::GetAttributes(loadIDs, attrs);
+        {
+            MutexLock lock(mMutex);
+            // items without saved attributes still skip their own query
+            for (auto& cur : data)
+                m_attrPreload[cur.first].swap(attrs[cur.first]);
+        }
+        if (sConfig.debug.UseProfiling)
+            sProfiler.AddTime(m_loadRowsKey, loadIDs.size());
+    }
+
+    into.reserve(into.size() + itemIDs.size());
+    std::map<uint32, ItemData>::iterator dItr;
+    std::map<uint32, InventoryItemRef>::iterator itr;
+    for (auto cur : itemIDs) {
+        {
+            MutexLock lock(mMutex);
+            itr = m_items.find(cur);
+            if (itr != m_items.end()) {
+                into.push_back(itr->second);
+                continue;
+            }
+        }
+        dItr = data.find(cur);
+        if (dItr == data.end()) {
+            InventoryItemRef iRef = GetItem(cur);
+            if (iRef.get() != nullptr)
+                into.push_back(iRef);
+            continue;
+        }
+        InventoryItemRef iRef = InventoryItem::Load(cur, dItr->second);
+        if (iRef.get() == nullptr)
+            continue;
+        // another thread may have loaded this item meanwhile.  keep the one already cached
+        MutexLock lock(mMutex);
+        into.push_back(m_items.insert(std::make_pair(cur, iRef)).first->second);
+    }
+
+    // drop attributes of items which failed to load.  nested calls keep their own items
+    MutexLock lock(mMutex);
+    for (auto cur : loadIDs)
+        m_attrPreload.erase(cur);
+}
+
+bool ItemFactory::GetPreloadedAttributes(uint32 itemID, std::vector<Inv::AttrData>& into)
+{
+    MutexLock lock(mMutex);
+    std::map<uint32, std::vector<Inv::AttrData>>::iterator itr = m_attrPreload.find(itemID);
+    if (itr == m_attrPreload.end())
+        return false;
+    into.swap(itr->second);
+    m_attrPreload.erase(itr);
+    return true;
+}
+
 BlueprintRef ItemFactory::GetBlueprint(uint32 blueprintID)
 {
     return _GetItem<Blueprint>(blueprintID);
@@ -29,6 +29,7 @@
 //#include "eve-compat.h"
 
 #include "utils/Singleton.h"
+#include "threading/Mutex.h"
 #include "inventory/ItemRef.h"
 //#include "../../eve-common/EVE_RAM.h"
 
@@ -62,7 +63,10 @@ public:
     int Initialize();
     uint32 Count()                                      { return m_items.size(); }
 
+    /* writes player items and attributes changed since last save.  called periodically and on shutdown */
     void SaveItems();
+    // marks items and attributes which failed to save as changed again, so the next SaveItems() retries them
+    void SetUnsaved(const std::vector<uint32>& items, const std::vector<Inv::AttrData>& attribs);
     void RemoveItem(uint32 itemID);
     void SetUsingClient(Client *pClient)                { m_pClient = pClient; }
     void UnsetUsingClient()                             { m_pClient = nullptr; }
@@ -96,6 +100,11 @@ public:
     StructureItemRef        GetStructure(uint32 structureID);
     StationOfficeRef        GetOffice(uint32 officeID);
     InventoryItemRef        GetItem(uint32 itemID);
+    // as GetItem() for each itemID, but player items not yet loaded are read from db in a few batched queries.
+    //  items which fail to load are not in 'into'
+    void                    GetItems(const std::vector<uint32>& itemIDs, std::vector<InventoryItemRef>& into);
+    // saved attributes read by GetItems(), taken by AttributeMap::Load().  returns false if none were read for itemID
+    bool                    GetPreloadedAttributes(uint32 itemID, std::vector<Inv::AttrData>& into);
     InventoryItemRef        GetItemContainer(uint32 itemID, bool load=true);
     InventoryItemRef        GetInventoryItemFromID(uint32 itemID, bool load=true);
     CargoContainerRef       GetCargoContainer(uint32 containerID);
@@ -144,6 +153,11 @@ protected:
     std::map<uint32, InventoryItemRef> m_items;
     std::map<uint32, InventoryItemRef> m_staticItems;
     std::map<uint32, InventoryItemRef> m_dynamicItems;
+    // k,v of itemID, saved attributes.  only holds items of a GetItems() call in progress
+    std::map<uint32, std::vector<Inv::AttrData>> m_attrPreload;
+
+    // guards the item and type caches and ID authority; systems may tic on several threads
+    Mutex mMutex;
 
     template<class _Ty>
     const _Ty *_GetType(uint16 typeID);
@@ -159,6 +173,11 @@ private:
     uint32 m_nextDroneID;
     uint32 m_nextMissileID;
 
+    // profile keys for SaveItems()
+    uint16 m_saveKey;
+    uint16 m_saveRowsKey;
+    // profile key for GetItems()
+    uint16 m_loadRowsKey;
 };
 
 //Singleton
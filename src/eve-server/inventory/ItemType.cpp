@@ -130,6 +130,8 @@ bool ItemType::_Load()
         m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrCapacity, m_type.capacity));
     if (m_type.race)
         m_AttributeMap.insert(std::pair<uint16, EvilNumber>(AttrRaceID, m_type.race));
+    // type attributes are kept for server's life
+    m_AttributeMap.shrink_to_fit();
 
     // load required skills and levels into their own map, for later checks
     if (HasAttribute(AttrRequiredSkill1))
@@ -87,8 +87,10 @@ public:
     const bool HasAttribute(const uint16 attributeID) const;
     EvilNumber GetAttribute(const uint16 attributeID) const;
     const void CopyAttributes(InventoryItem& itemRef) const;
+    size_t GetAttributeCount() const                    { return m_AttributeMap.size(); }
 
     bool HasReqSkill(const uint16 skillID) const;
+    const std::map<uint16, uint8>& GetReqSkills() const { return m_reqSkillMap; }
 
     /* new effects processing system */
     void GetEffectMap(const int8 state, std::map<uint16, Effect>& effectMap) const;
@@ -159,7 +161,7 @@ private:
     uint16 m_defaultFxID;                 // default effectID
 
     std::map<uint16, uint8> m_reqSkillMap;              // k,v map of required skill, level for this ItemType, if any.
-    std::map<uint16, EvilNumber> m_AttributeMap;        // k,v map of attributeID, value
+    AttrMap m_AttributeMap;                             // k,v map of attributeID, value
 
 };
 
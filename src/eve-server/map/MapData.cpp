@@ -21,9 +21,6 @@ MapData::MapData()
 : m_stationExtraInfo(nullptr),
 m_pseudoSecurities(nullptr)
 {
-    m_regionJumps.clear();
-    m_constJumps.clear();
-    m_systemJumps.clear();
 }
 
 MapData::~MapData()
@@ -45,9 +42,7 @@ int MapData::Initialize()
 
 void MapData::Clear()
 {
-    m_regionJumps.clear();
-    m_constJumps.clear();
-    m_systemJumps.clear();
+    m_jumpGraph.Clear();
 }
 
 void MapData::GetInfo()
@@ -72,19 +67,34 @@ void MapData::Populate()
     DBQueryResult* res = new DBQueryResult();
     MapDB::GetSystemJumps(*res);
     DBResultRow row;
+    uint32 regionJumps(0), constJumps(0), systemJumps(0);
+    std::set<uint32> systems;
     while (res->GetRow(row)) {
         //SELECT ctype, fromsol, tosol FROM mapConnections
         if (row.GetInt(0) == Map::Jumptype::Region) {
-            m_regionJumps.emplace(row.GetInt(1), row.GetInt(2));
+            ++regionJumps;
         } else if (row.GetInt(0) == Map::Jumptype::Constellation) {
-            m_constJumps.emplace(row.GetInt(1), row.GetInt(2));
+            ++constJumps;
         } else {
-            m_systemJumps.emplace(row.GetInt(1), row.GetInt(2));
+            ++systemJumps;
         }
+        // gates work both ways.  duplicates are dropped by Build()
+        m_jumpGraph.AddJump(row.GetUInt(1), row.GetUInt(2));
+        m_jumpGraph.AddJump(row.GetUInt(2), row.GetUInt(1));
+        systems.insert(row.GetUInt(1));
+        systems.insert(row.GetUInt(2));
     }
 
+    SystemData data = SystemData();
+    for (auto cur : systems)
+        if (sDataMgr.GetSystemData(cur, data))
+            m_jumpGraph.AddSystem(cur, data.regionID, data.securityRating);
+    m_jumpGraph.Build();
+
     sLog.Cyan("          MapData", "%u Region jumps, %u Constellation jumps and %u System jumps loaded in %.3fms.", //
-              m_regionJumps.size(), m_constJumps.size(), m_systemJumps.size(), (GetTimeMSeconds() - start));
+              regionJumps, constJumps, systemJumps, (GetTimeMSeconds() - start));
+    sLog.Cyan("          MapData", "Jump graph of %u systems and %u gates in %u regions uses %lu bytes of jump tables.", //
+              m_jumpGraph.GetSystemCount(), m_jumpGraph.GetGateCount(), m_jumpGraph.GetRegionCount(), m_jumpGraph.GetTableSize());
 
     // cleanup
     SafeDelete(res);
@@ -142,10 +152,15 @@ void MapData::GetMissionDestination(Agent* pAgent, uint8 misionType, MissionOffe
                 // neighboring system
                 bool run = true;
                 uint8 count = 0;
-                std::vector<uint32> sysList;
-                auto itr = m_systemJumps.equal_range(systemID);
-                for (auto it = itr.first; it != itr.second; ++it)
-                    sysList.push_back(it->second);
+                // neighbours within same constellation
+                std::vector<uint32> sysList, neighbours;
+                m_jumpGraph.GetNeighbours(systemID, neighbours);
+                SystemData data = SystemData();
+                sDataMgr.GetSystemData(systemID, data);
+                uint32 constellationID(data.constellationID);
+                for (auto cur : neighbours)
+                    if (sDataMgr.GetSystemData(cur, data) and (data.constellationID == constellationID))
+                        sysList.push_back(cur);
                 /** @todo not sure why this is empty, but have segfaults from empty vector. */
                 if (sysList.empty()) {
                     StationData data = StationData();
@@ -14,6 +14,7 @@
 #include "../eve-server.h"
 
 #include "../../eve-common/EVE_Missions.h"
+#include "../../eve-common/utils/JumpGraph.h"
 
 class Agent;
 
@@ -36,6 +37,15 @@ public:
 
     void GetMissionDestination(Agent* pAgent, uint8 misionType, MissionOffer& offer);
 
+    // stargate jumps between systems.  returns JumpGraph::NoRoute for unreachable systems
+    uint16              GetJumps(uint32 fromSystemID, uint32 toSystemID) const
+                                                        { return m_jumpGraph.GetJumps(fromSystemID, toSystemID); }
+    // route from one system to another, inclusive.  pref is JumpGraph::Shortest, Safer or LessSecure
+    bool                GetRoute(uint32 fromSystemID, uint32 toSystemID, uint8 pref, std::vector<uint32>& into) const
+                                                        { return m_jumpGraph.GetRoute(fromSystemID, toSystemID, pref, into); }
+    void                GetSystemsInRange(uint32 systemID, uint16 jumps, std::vector<uint32>& into) const
+                                                        { m_jumpGraph.GetSystemsInRange(systemID, jumps, into); }
+
 protected:
     void                Populate();
 
@@ -44,9 +54,7 @@ private:
     PyTuple*            m_stationExtraInfo;
     PyObject*           m_pseudoSecurities;
 
-    std::multimap<uint32, uint32>        m_regionJumps;  //fromSys/toSys
-    std::multimap<uint32, uint32>        m_constJumps;   //fromSys/toSys
-    std::multimap<uint32, uint32>        m_systemJumps;  //fromSys/toSys
+    JumpGraph           m_jumpGraph;
 
 };
 
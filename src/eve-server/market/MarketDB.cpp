@@ -106,50 +106,10 @@ PyRep *MarketDB::GetRegionBest(uint32 regionID) {
     return DBResultToIndexRowset(res, "typeID");
 }
 
-PyRep *MarketDB::GetOrders( uint32 regionID, uint16 typeID )
-{
-    // returns a tuple (sell, buy) of PyObjectEx with data in PyPackedRows
-
-    PyTuple* tup = new PyTuple(2);
-    DBQueryResult res;
-    //query sell orders
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "    price, volRemaining, typeID, orderRange AS `range`, orderID,"
-        "   volEntered, minVolume, bid, issued as issueDate, duration,"
-        "   stationID, regionID, solarSystemID, jumps"
-        " FROM mktOrders "
-        " WHERE regionID=%u AND typeID=%u AND bid=%u", regionID, typeID, Market::Type::Sell))
-    {
-        codelog( MARKET__DB_ERROR, "Error in query: %s", res.error.c_str() );
-        return nullptr;
-    }
-    _log(MARKET__DB_TRACE, "GetOrders() - Fetched %u sell orders for type %u", res.GetRowCount(), typeID);
-    tup->SetItem(0, DBResultToCRowset( res ) );
-
-    //query buy orders
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        "    price, volRemaining, typeID, orderRange AS `range`, orderID,"
-        "   volEntered, minVolume, bid, issued as issueDate, duration,"
-        "   stationID, regionID, solarSystemID, jumps"
-        " FROM mktOrders "
-        " WHERE regionID=%u AND typeID=%u AND bid=%u", regionID, typeID, Market::Type::Buy))
-    {
-        codelog( MARKET__DB_ERROR, "Error in query: %s", res.error.c_str() );
-        PyDecRef( tup );
-        return nullptr;
-    }
-    _log(MARKET__DB_TRACE, "GetOrders() - Fetched %u buy orders for type %u", res.GetRowCount(), typeID);
-    tup->SetItem(1, DBResultToCRowset( res ) );
-
-    if (is_log_enabled(MARKET__DUMP))
-        tup->Dump(MARKET__DUMP, "    ");
-    return tup;
-}
-
 PyRep* MarketDB::GetOrdersForOwner(uint32 ownerID)
 {
+    // order changes are written through the write queue
+    sDatabase.WaitFor(ownerID);
     DBQueryResult res;
     if (!sDatabase.RunQuery(res,
         "SELECT"
@@ -169,177 +129,102 @@ PyRep* MarketDB::GetOrdersForOwner(uint32 ownerID)
     return DBResultToRowset(res);
 }
 
-PyRep *MarketDB::GetOrderRow(uint32 orderID) {
+void MarketDB::LoadOrders(std::vector<Market::SaveData>& into)
+{
     DBQueryResult res;
     if (!sDatabase.RunQuery(res,
         "SELECT"
-        "   price, volRemaining, typeID, orderRange AS `range`, orderID,"
-        "   volEntered, minVolume, bid, issued as issueDate, duration,"
-        "   stationID, regionID, solarSystemID, jumps"
-        " FROM mktOrders"
-        " WHERE orderID=%u", orderID))
+        "   orderID, typeID, ownerID, regionID, stationID, solarSystemID, orderRange,"
+        "   bid, price, escrow, minVolume, volEntered, volRemaining,"
+        "   issued, contraband, duration, jumps, isCorp, accountKey, memberID"
+        " FROM mktOrders"))
     {
         codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
-        return nullptr;
-    }
-
-    DBResultRow row;
-    if (!res.GetRow(row)) {
-        codelog(MARKET__ERROR, "Order %u not found.", orderID);
-        return nullptr;
+        return;
     }
 
-    return DBRowToPackedRow(row);
-}
-
-//NOTE: needs a lot of work to implement orderRange
-uint32 MarketDB::FindBuyOrder(Call_PlaceCharOrder &call) {
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT orderID"
-        " FROM mktOrders"
-        " WHERE bid=1"
-        "  AND typeID=%u"
-        "  AND stationID=%u"
-        "  AND volRemaining >= %u"
-        "  AND price > %.2f"
-        " ORDER BY price DESC"
-        " LIMIT 1;",
-        call.typeID,
-        call.stationID,
-        call.quantity,
-        call.price - 0.1/*, sConfig.market.FindBuyOrder*/))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
+    into.reserve(res.GetRowCount());
 
     DBResultRow row;
-    if (res.GetRow(row))
-        return row.GetUInt(0);
+    while (res.GetRow(row)) {
+        Market::SaveData data = Market::SaveData();
+        data.orderID        = row.GetUInt(0);
+        data.typeID         = row.GetUInt(1);
+        data.ownerID        = row.GetUInt(2);
+        data.regionID       = row.GetUInt(3);
+        data.stationID      = row.GetUInt(4);
+        data.solarSystemID  = row.GetUInt(5);
+        data.orderRange     = row.GetInt(6);    // stored unsigned; station range (-1) reads back as 4294967295
+        data.bid            = row.GetBool(7);
+        data.price          = row.GetFloat(8);
+        data.escrow         = row.GetFloat(9);
+        data.minVolume      = row.GetUInt(10);
+        data.volEntered     = row.GetUInt(11);
+        data.volRemaining   = row.GetUInt(12);
+        data.issued         = row.GetInt64(13);
+        data.contraband     = row.GetBool(14);
+        data.duration       = row.GetUInt(15);
+        data.jumps          = row.GetInt(16);
+        data.isCorp         = row.GetBool(17);
+        data.accountKey     = row.GetUInt(18);
+        data.memberID       = row.GetUInt(19);
+        into.push_back(data);
+    }
 
-    return 0;    //no order found.
+    _log(MARKET__DB_TRACE, "LoadOrders() - Fetched %u orders", res.GetRowCount());
 }
 
-uint32 MarketDB::FindSellOrder(Call_PlaceCharOrder &call)
+uint32 MarketDB::GetNextOrderID()
 {
+    // orderIDs are given out by MarketMgr, so inserts can be queued.
+    // use the table's auto_increment (which survives deleted orders) when the server can see it
+    uint32 orderID(1);
     DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT orderID"
-        " FROM mktOrders"
-        " WHERE bid=0"
-        "  AND typeID=%u"
-        "  AND stationID=%u"
-        "  AND volRemaining >= %u"
-        "  AND price < %.2f"
-        " ORDER BY price ASC"
-        " LIMIT 1;",
-        call.typeID,
-        call.stationID,
-        call.quantity,
-        call.price + 0.1/*, sConfig.market.FindSellOrder*/))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
-        return 0;
-    }
-
     DBResultRow row;
-    if (res.GetRow(row))
-        return row.GetUInt(0);
-
-    return 0;
-}
-
-bool MarketDB::GetOrderInfo(uint32 orderID, Market::OrderInfo &oInfo) {
-    //orderID, typeID, ownerID, regionID, stationID, orderRange, bid, price, escrow,
-    // minVolume, volEntered, volRemaining, issued, contraband, duration, jumps, isCorp, accountKey, memberID
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        " volRemaining,"
-        " price,"
-        " typeID,"
-        " stationID,"
-        " regionID,"
-        " ownerID,"
-        " bid,"
-        " isCorp"
-        " FROM mktOrders"
-        " WHERE orderID=%u",
-        orderID))
-    {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", res.error.c_str());
-        return false;
-    }
+    if (sDatabase.RunQuery(res,
+        "SELECT AUTO_INCREMENT FROM information_schema.TABLES"
+        " WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = 'mktOrders'"))
+        if (res.GetRow(row) and !row.IsNull(0))
+            orderID = row.GetUInt(0);
 
-    DBResultRow row;
-    if (!res.GetRow(row)) {
-        _log(MARKET__WARNING, "Order %u not found.", orderID);
-        return false;
+    if (!sDatabase.RunQuery(res, "SELECT MAX(orderID) FROM mktOrders")) {
+        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
+        return orderID;
     }
+    if (res.GetRow(row) and !row.IsNull(0))
+        if (row.GetUInt(0) >= orderID)
+            orderID = row.GetUInt(0) + 1;
 
-    oInfo.quantity   = row.GetUInt(0);
-    oInfo.price      = row.GetFloat(1);
-    oInfo.typeID     = row.GetUInt(2);
-    oInfo.stationID  = row.GetUInt(3);
-    oInfo.regionID   = row.GetUInt(4);
-    oInfo.ownerID    = row.GetUInt(5);
-    oInfo.isBuy      = row.GetBool(6);
-    oInfo.isCorp     = row.GetBool(7);
-
-    return true;
+    return orderID;
 }
 
 //NOTE: this logic needs some work if there are multiple concurrent market services running at once.  there wont be.
-bool MarketDB::AlterOrderQuantity(uint32 orderID, uint32 new_qty) {
-    DBerror err;
-    if (!sDatabase.RunQuery(err, "UPDATE mktOrders SET volRemaining = %u WHERE orderID = %u",  new_qty, orderID)) {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
-        return false;
-    }
-    return true;
+void MarketDB::AlterOrderQuantity(uint32 ownerID, uint32 orderID, uint32 new_qty) {
+    sDatabase.QueueWrite(ownerID, "UPDATE mktOrders SET volRemaining = %u WHERE orderID = %u",  new_qty, orderID);
 }
 
-bool MarketDB::AlterOrderPrice(uint32 orderID, double new_price) {
-    DBerror err;
-    if (!sDatabase.RunQuery(err, "UPDATE mktOrders SET price = %.2f WHERE orderID = %u", new_price, orderID)) {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
-        return false;
-    }
-    return true;
+void MarketDB::AlterOrderPrice(uint32 ownerID, uint32 orderID, float new_price) {
+    sDatabase.QueueWrite(ownerID, "UPDATE mktOrders SET price = %.2f WHERE orderID = %u", new_price, orderID);
 }
 
-bool MarketDB::DeleteOrder(uint32 orderID) {
-    DBerror err;
-    if (!sDatabase.RunQuery(err, "DELETE FROM mktOrders WHERE orderID = %u", orderID)) {
-        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
-        return false;
-    }
-    return true;
+void MarketDB::DeleteOrder(uint32 ownerID, uint32 orderID) {
+    sDatabase.QueueWrite(ownerID, "DELETE FROM mktOrders WHERE orderID = %u", orderID);
 }
 
-uint32 MarketDB::StoreOrder(Market::SaveData &data) {
-    DBerror err;
-    uint32 orderID(0);
-    if (!sDatabase.RunQueryLID(err, orderID,
+void MarketDB::StoreOrder(const Market::SaveData &data) {
+    sDatabase.QueueWrite(data.ownerID,
         "INSERT INTO mktOrders ("
-        " typeID, ownerID, regionID, stationID, solarSystemID, orderRange,"
+        " orderID, typeID, ownerID, regionID, stationID, solarSystemID, orderRange,"
         " bid, price, escrow, minVolume, volEntered, volRemaining,"
         " issued, contraband, duration, jumps, isCorp, accountKey, memberID"
         " ) VALUES ("
-        "    %u, %u, %u, %u, %u, %u,"
+        "    %u, %u, %u, %u, %u, %u, %u,"
         "    %u, %.2f, %.2f, %u, %u, %u,"
         "    %li, %u, %u, %u, %u, %u, %u"
         " )",
-        data.typeID, data.ownerID, data.regionID, data.stationID, data.solarSystemID, data.orderRange,
+        data.orderID, data.typeID, data.ownerID, data.regionID, data.stationID, data.solarSystemID, data.orderRange,
         data.bid?1:0, data.price, data.escrow, data.minVolume, data.volEntered, data.volRemaining,
-        data.issued, data.contraband?1:0, data.duration, data.jumps, data.isCorp?1:0, data.accountKey, data.memberID))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", err.c_str());
-        return 0;
-    }
-
-    return orderID;
+        data.issued, data.contraband?1:0, data.duration, data.jumps, data.isCorp?1:0, data.accountKey, data.memberID);
 }
 
 PyRep *MarketDB::GetTransactions(uint32 clientID, Market::TxData& data) {
@@ -355,6 +240,8 @@ PyRep *MarketDB::GetTransactions(uint32 clientID, Market::TxData& data) {
         buy = "AND transactionType=";
         buy += std::to_string(data.isBuy);
     }
+    // transactions are recorded through the write queue, keyed by clientID
+    sDatabase.WaitFor(clientID);
     DBQueryResult res;
     if (!sDatabase.RunQuery(res,
         "SELECT"
@@ -376,8 +263,8 @@ PyRep *MarketDB::GetTransactions(uint32 clientID, Market::TxData& data) {
 bool MarketDB::RecordTransaction(Market::TxData &data) {
     //transactionID, transactionDate, typeID, keyID, quantity, price,
     //  transactionType, clientID, regionID, stationID, corpTransaction, characterID
-    DBerror err;
-    if (!sDatabase.RunQuery(err,
+    // fire-and-forget; keyed by owner (clientID) so GetTransactions() can wait for it
+    sDatabase.QueueWrite(data.clientID,
         "INSERT INTO"
         " mktTransactions ("
         "    transactionDate, typeID, keyID, quantity, price,"
@@ -386,11 +273,7 @@ bool MarketDB::RecordTransaction(Market::TxData &data) {
         " %f, %u, %u, %u, %f,"
         " %u, %u, %u, %u, %u, %u)",
         GetFileTimeNow(), data.typeID, data.accountKey, data.quantity, data.price,
-        data.isBuy > 0?1:0, data.clientID, data.regionID, data.stationID, data.isCorp?1:0, data.memberID))
-    {
-        codelog(MARKET__DB_ERROR, "Error in query: %s", err.c_str());
-        return false;
-    }
+        data.isBuy > 0?1:0, data.clientID, data.regionID, data.stationID, data.isCorp?1:0, data.memberID);
     return true;
 }
 
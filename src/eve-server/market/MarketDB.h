@@ -40,8 +40,6 @@ class MarketDB
 {
 public:
     PyRep* GetMarketGroups();
-    PyRep* GetOrders(uint32 regionID, uint16 typeID);
-    PyRep* GetOrderRow(uint32 orderID);
     PyRep* GetRegionBest(uint32 regionID);
     PyRep* GetSystemAsks(uint32 solarSystemID);
     PyRep* GetStationAsks(uint32 stationID);
@@ -49,15 +47,15 @@ public:
 
     PyRep* GetTransactions(uint32 ownerID, Market::TxData &data);
 
-    bool DeleteOrder(uint32 orderID);
-    bool GetOrderInfo(uint32 orderID, Market::OrderInfo &oInfo);
-    bool AlterOrderPrice(uint32 orderID, double new_price);
     bool RecordTransaction(Market::TxData &data);
-    bool AlterOrderQuantity(uint32 orderID, uint32 new_qty);
 
-    uint32 FindBuyOrder(Call_PlaceCharOrder &call);
-    uint32 FindSellOrder(Call_PlaceCharOrder &call);
-    uint32 StoreOrder(Market::SaveData& data);
+    /* for MarketMgr order book.  order changes are queued writes keyed by ownerID */
+    void LoadOrders(std::vector<Market::SaveData>& into);
+    uint32 GetNextOrderID();
+    void StoreOrder(const Market::SaveData& data);
+    void AlterOrderPrice(uint32 ownerID, uint32 orderID, float new_price);
+    void AlterOrderQuantity(uint32 ownerID, uint32 orderID, uint32 new_qty);
+    void DeleteOrder(uint32 ownerID, uint32 orderID);
 
 
     /* for base price estimator */
@@ -18,6 +18,7 @@
 #include "account/AccountService.h"
 #include "cache/ObjCacheService.h"
 #include "inventory/InventoryItem.h"
+#include "map/MapData.h"
 #include "market/MarketMgr.h"
 #include "station/StationDataMgr.h"
 
@@ -33,7 +34,8 @@
 
 MarketMgr::MarketMgr()
 : m_marketGroups(nullptr),
-m_manager(nullptr)
+m_manager(nullptr),
+m_nextOrderID(1)
 {
     m_timeStamp = 0;
 }
@@ -45,8 +47,10 @@ MarketMgr::~MarketMgr()
 
 void MarketMgr::Close()
 {
-    /** @todo put a save method here which will save anything changed before shutdown */
+    // order changes are already queued for writing, and the db flushes its queues when closed.
     PyDecRef(m_marketGroups);
+    m_books.clear();
+    m_orders.clear();
     sLog.Warning("        MarketMgr", "Market Manager has been closed." );
 }
 
@@ -68,10 +72,17 @@ void MarketMgr::Populate()
 
     Process();
 
-    // market orders stored as {regionID/typeID}    --do we want to store orders in memory for loaded region??
-    // m_db.GetOrders(call.client->GetRegionID(), args.arg);
+    std::vector<Market::SaveData> orders;
+    m_db.LoadOrders(orders);
+    m_orders.reserve(orders.size());
+    for (auto& cur : orders) {
+        m_orders[cur.orderID] = cur;
+        AddToBook(cur);
+    }
+    m_nextOrderID = m_db.GetNextOrderID();
 
     sLog.Blue("        MarketMgr", "Market Manager loaded in %.3fms.", (GetTimeMSeconds() - start));
+    sLog.Cyan("        MarketMgr", "%u market orders in %u books.", (uint32)m_orders.size(), (uint32)m_books.size());
     sLog.Cyan("        MarketMgr", "Market Manager Updates Price History every %u hours.", sConfig.market.HistoryUpdateTime);
 }
 
@@ -235,7 +246,7 @@ void MarketMgr::SendOnOwnOrderChanged(Client* pClient, uint32 orderID, uint8 act
     if (order != nullptr) {
         ooc.order = order;
     } else {
-        ooc.order = m_db.GetOrderRow(orderID);
+        ooc.order = GetOrderRow(orderID);
     }
 
     switch (action) {
@@ -272,6 +283,265 @@ void MarketMgr::InvalidateOrdersCache(uint32 regionID, uint32 typeID)
 }
 
 
+// columns of order rows sent to client
+static DBRowDescriptor* NewOrderHeader()
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    header->AddColumn("price",          DBTYPE_R4);
+    header->AddColumn("volRemaining",   DBTYPE_UI4);
+    header->AddColumn("typeID",         DBTYPE_UI2);
+    header->AddColumn("range",          DBTYPE_UI4);
+    header->AddColumn("orderID",        DBTYPE_UI4);
+    header->AddColumn("volEntered",     DBTYPE_UI4);
+    header->AddColumn("minVolume",      DBTYPE_UI4);
+    header->AddColumn("bid",            DBTYPE_BOOL);
+    header->AddColumn("issueDate",      DBTYPE_UI8);
+    header->AddColumn("duration",       DBTYPE_UI2);
+    header->AddColumn("stationID",      DBTYPE_UI4);
+    header->AddColumn("regionID",       DBTYPE_UI4);
+    header->AddColumn("solarSystemID",  DBTYPE_I4);
+    header->AddColumn("jumps",          DBTYPE_I2);
+    return header;
+}
+
+// fields in NewOrderHeader() column order
+static void FillOrderRow(const Market::SaveData& data, PyPackedRow* into)
+{
+    into->SetField(0U, new PyFloat(data.price));
+    into->SetField(1,  new PyInt(data.volRemaining));
+    into->SetField(2,  new PyInt(data.typeID));
+    into->SetField(3,  new PyInt(data.orderRange));
+    into->SetField(4,  new PyInt(data.orderID));
+    into->SetField(5,  new PyInt(data.volEntered));
+    into->SetField(6,  new PyInt(data.minVolume));
+    into->SetField(7,  new PyBool(data.bid));
+    into->SetField(8,  new PyLong(data.issued));
+    into->SetField(9,  new PyInt(data.duration));
+    into->SetField(10, new PyInt(data.stationID));
+    into->SetField(11, new PyInt(data.regionID));
+    into->SetField(12, new PyInt(data.solarSystemID));
+    into->SetField(13, new PyInt(data.jumps));
+}
+
+PyRep* MarketMgr::GetOrders(uint32 regionID, uint16 typeID)
+{
+    PyRep* result(nullptr);
+    std::string method_name ("GetOrders_");
+    method_name += std::to_string(regionID);
+    method_name += "_";
+    method_name += std::to_string(typeID);
+    ObjectCachedMethodID method_id("marketProxy", method_name.c_str());
+    //check to see if this method is in the cache already.  it is invalidated whenever this book changes
+    if (!m_manager->cache_service->IsCacheLoaded(method_id)) {
+        // returns a tuple (sell, buy) of PyObjectEx with data in PyPackedRows
+        DBRowDescriptor* header = NewOrderHeader();
+        CRowSet* sell = new CRowSet(&header);
+        header = NewOrderHeader();
+        CRowSet* buy = new CRowSet(&header);
+
+        std::unordered_map<uint64_t, OrderBook>::iterator bookItr = m_books.find(GetBookKey(regionID, typeID));
+        if (bookItr != m_books.end()) {
+            for (auto cur : bookItr->second.sell)
+                FillOrderRow(m_orders[cur.second], sell->NewRow());
+            for (auto cur : bookItr->second.buy)
+                FillOrderRow(m_orders[cur.second], buy->NewRow());
+        }
+        _log(MARKET__DB_TRACE, "GetOrders() - Built %u sell and %u buy orders for type %u in region %u", \
+                (uint32)sell->GetRowCount(), (uint32)buy->GetRowCount(), typeID, regionID);
+
+        PyTuple* tup = new PyTuple(2);
+            tup->SetItem(0, sell);
+            tup->SetItem(1, buy);
+        if (is_log_enabled(MARKET__DUMP))
+            tup->Dump(MARKET__DUMP, "    ");
+        result = tup;
+        m_manager->cache_service->GiveCache(method_id, &result);
+    }
+
+    //now we know its in the cache one way or the other, so build a
+    //cached object cached method call result.
+    return m_manager->cache_service->MakeObjectCachedMethodCallResult(method_id);
+}
+
+PyRep* MarketMgr::GetOrderRow(uint32 orderID)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end()) {
+        codelog(MARKET__ERROR, "Order %u not found.", orderID);
+        return nullptr;
+    }
+
+    PyPackedRow* row = new PyPackedRow(NewOrderHeader());
+    FillOrderRow(itr->second, row);
+    return row;
+}
+
+bool MarketMgr::GetOrderInfo(uint32 orderID, Market::OrderInfo& oInfo)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end()) {
+        _log(MARKET__WARNING, "Order %u not found.", orderID);
+        return false;
+    }
+
+    const Market::SaveData& data = itr->second;
+    oInfo.isBuy      = data.bid;
+    oInfo.isCorp     = data.isCorp;
+    oInfo.typeID     = data.typeID;
+    oInfo.orderID    = data.orderID;
+    oInfo.ownerID    = data.ownerID;
+    oInfo.stationID  = data.stationID;
+    oInfo.regionID   = data.regionID;
+    oInfo.quantity   = data.volRemaining;
+    oInfo.accountKey = data.accountKey;
+    oInfo.memberID   = data.memberID;
+    oInfo.price      = data.price;
+    return true;
+}
+
+bool MarketMgr::InRange(const Market::SaveData& order, uint32 stationID, uint32 solarSystemID)
+{
+    // books are regional, so region range always matches
+    switch (order.orderRange) {
+        case Market::Range::Station:    return (order.stationID == stationID);
+        case Market::Range::System:     return (order.solarSystemID == solarSystemID);
+        case Market::Range::Region:     return true;
+    }
+    // jump ranges
+    return (sMapData.GetJumps(order.solarSystemID, solarSystemID) <= order.orderRange);
+}
+
+uint32 MarketMgr::FindSellOrder(Call_PlaceCharOrder& args)
+{
+    std::unordered_map<uint64_t, OrderBook>::iterator bookItr = m_books.find(GetBookKey(sDataMgr.GetStationRegion(args.stationID), args.typeID));
+    if (bookItr == m_books.end())
+        return 0;
+
+    // lowest price first.  sell orders are only filled at their own station
+    double maxPrice(args.price + 0.1);
+    for (auto cur : bookItr->second.sell) {
+        if (cur.first >= maxPrice)
+            break;
+        const Market::SaveData& data = m_orders[cur.second];
+        if ((data.stationID == (uint32)args.stationID) and (data.volRemaining >= (uint32)args.quantity))
+            return data.orderID;
+    }
+
+    return 0;    //no order found.
+}
+
+uint32 MarketMgr::FindBuyOrder(Call_PlaceCharOrder& args)
+{
+    std::unordered_map<uint64_t, OrderBook>::iterator bookItr = m_books.find(GetBookKey(sDataMgr.GetStationRegion(args.stationID), args.typeID));
+    if (bookItr == m_books.end())
+        return 0;
+
+    // highest price first
+    uint32 solarSystemID(sDataMgr.GetStationSystem(args.stationID));
+    double minPrice(args.price - 0.1);
+    for (PriceIndex::reverse_iterator itr = bookItr->second.buy.rbegin(); itr != bookItr->second.buy.rend(); ++itr) {
+        if (itr->first <= minPrice)
+            break;
+        const Market::SaveData& data = m_orders[itr->second];
+        if ((data.volRemaining >= (uint32)args.quantity) and InRange(data, args.stationID, solarSystemID))
+            return data.orderID;
+    }
+
+    return 0;    //no order found.
+}
+
+uint32 MarketMgr::StoreOrder(Market::SaveData& data)
+{
+    data.orderID = m_nextOrderID++;
+    m_orders[data.orderID] = data;
+    AddToBook(data);
+    m_db.StoreOrder(data);
+    InvalidateOrdersCache(data.regionID, data.typeID);
+    return data.orderID;
+}
+
+bool MarketMgr::AlterOrderPrice(uint32 orderID, float newPrice)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return false;
+
+    RemoveFromBook(itr->second);
+    itr->second.price = newPrice;
+    AddToBook(itr->second);
+    m_db.AlterOrderPrice(itr->second.ownerID, orderID, newPrice);
+    InvalidateOrdersCache(itr->second.regionID, itr->second.typeID);
+    return true;
+}
+
+bool MarketMgr::AlterOrderQuantity(uint32 orderID, uint32 newQty)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return false;
+
+    itr->second.volRemaining = newQty;
+    m_db.AlterOrderQuantity(itr->second.ownerID, orderID, newQty);
+    InvalidateOrdersCache(itr->second.regionID, itr->second.typeID);
+    return true;
+}
+
+bool MarketMgr::DeleteOrder(uint32 orderID)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return false;
+
+    RemoveFromBook(itr->second);
+    m_db.DeleteOrder(itr->second.ownerID, orderID);
+    InvalidateOrdersCache(itr->second.regionID, itr->second.typeID);
+    m_orders.erase(itr);
+    return true;
+}
+
+void MarketMgr::RemoveOwnerOrders(uint32 ownerID)
+{
+    std::unordered_map<uint32, Market::SaveData>::iterator itr = m_orders.begin();
+    while (itr != m_orders.end()) {
+        if (itr->second.ownerID == ownerID) {
+            RemoveFromBook(itr->second);
+            InvalidateOrdersCache(itr->second.regionID, itr->second.typeID);
+            itr = m_orders.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
+void MarketMgr::AddToBook(const Market::SaveData& data)
+{
+    OrderBook& book = m_books[GetBookKey(data.regionID, data.typeID)];
+    if (data.bid) {
+        book.buy.insert(std::make_pair(data.price, data.orderID));
+    } else {
+        book.sell.insert(std::make_pair(data.price, data.orderID));
+    }
+}
+
+void MarketMgr::RemoveFromBook(const Market::SaveData& data)
+{
+    std::unordered_map<uint64_t, OrderBook>::iterator bookItr = m_books.find(GetBookKey(data.regionID, data.typeID));
+    if (bookItr == m_books.end())
+        return;
+
+    PriceIndex& index = (data.bid ? bookItr->second.buy : bookItr->second.sell);
+    std::pair<PriceIndex::iterator, PriceIndex::iterator> range = index.equal_range(data.price);
+    for (PriceIndex::iterator itr = range.first; itr != range.second; ++itr)
+        if (itr->second == data.orderID) {
+            index.erase(itr);
+            break;
+        }
+
+    if (bookItr->second.sell.empty() and bookItr->second.buy.empty())
+        m_books.erase(bookItr);
+}
+
+
 /** @todo take off market overhead fees */
 /*
  *    def BrokersFee(self, stationID, amount, commissionPercentage):
@@ -303,7 +573,7 @@ void MarketMgr::InvalidateOrdersCache(uint32 regionID, uint32 typeID)
 bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef iRef, Call_PlaceCharOrder& args, uint16 accountKey/*Account::KeyType::Cash*/) {
 
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!m_db.GetOrderInfo(orderID, oInfo)) {
+    if (!GetOrderInfo(orderID, oInfo)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to get order info for #%u.", orderID);
         return true;
     }
@@ -465,11 +735,10 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
     if (qtyStatus == Market::QtyStatus::Under) {
         uint32 newQty(oInfo.quantity - args.quantity);
         _log(MARKET__TRACE, "ExecuteBuyOrder - Partially satisfied order #%u, altering quantity to %u.", orderID, newQty);
-        if (!m_db.AlterOrderQuantity(orderID, newQty)) {
+        if (!AlterOrderQuantity(orderID, newQty)) {
             _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to alter quantity of order #%u.", orderID);
             return true;
         }
-        InvalidateOrdersCache(oInfo.regionID, args.typeID);
         if (isPlayer or isCorp)
             SendOnOwnOrderChanged(seller, orderID, Market::Action::Modify, args.useCorp);
 
@@ -477,12 +746,11 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
     }
 
     _log(MARKET__TRACE, "ExecuteBuyOrder - Satisfied order #%u, deleting.", orderID);
-    PyRep* order = m_db.GetOrderRow(orderID);
-    if (!m_db.DeleteOrder(orderID)) {
+    PyRep* order = GetOrderRow(orderID);
+    if (!DeleteOrder(orderID)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to delete order #%u.", orderID);
         return true;
     }
-    InvalidateOrdersCache(oInfo.regionID, args.typeID);
     if (isPlayer or isCorp)
         SendOnOwnOrderChanged(seller, orderID, Market::Action::Expiry, args.useCorp, order);
     return true;
@@ -490,7 +758,7 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 
 void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, Call_PlaceCharOrder& args) {
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!m_db.GetOrderInfo(orderID, oInfo)) {
+    if (!GetOrderInfo(orderID, oInfo)) {
         _log(MARKET__ERROR, "ExecuteSellOrder - Failed to get info about sell order %u.", orderID);
         return;
     }
@@ -539,21 +807,19 @@ void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, Call_PlaceCharOr
 
     if (orderConsumed) {
         _log(MARKET__TRACE, "ExecuteSellOrder - satisfied order #%u, deleting.", orderID);
-        PyRep* order = m_db.GetOrderRow(orderID);
-        if (!m_db.DeleteOrder(orderID)) {
+        PyRep* order = GetOrderRow(orderID);
+        if (!DeleteOrder(orderID)) {
             _log(MARKET__ERROR, "ExecuteSellOrder - Failed to delete order #%u.", orderID);
             return;
         }
-        InvalidateOrdersCache(oInfo.regionID, args.typeID);
         SendOnOwnOrderChanged(seller, orderID, Market::Action::Expiry, args.useCorp, order);
     } else {
         uint32 newQty(oInfo.quantity - args.quantity);
         _log(MARKET__TRACE, "ExecuteSellOrder - Partially satisfied order #%u, altering quantity to %u.", orderID, newQty);
-        if (!m_db.AlterOrderQuantity(orderID, newQty)) {
+        if (!AlterOrderQuantity(orderID, newQty)) {
             _log(MARKET__ERROR, "ExecuteSellOrder - Failed to alter quantity of order #%u.", orderID);
             return;
         }
-        InvalidateOrdersCache(oInfo.regionID, args.typeID);
         SendOnOwnOrderChanged(seller, orderID, Market::Action::Modify, args.useCorp);
     }
 
@@ -48,6 +48,23 @@ public:
 
     void InvalidateOrdersCache(uint32 regionID, uint32 typeID);
 
+    /* order book.  all orders are kept in memory and matched here; changes are written to db through the write queue */
+    // cached.  returns tuple of (sell, buy) rowsets of given type in given region
+    PyRep* GetOrders(uint32 regionID, uint16 typeID);
+    PyRep* GetOrderRow(uint32 orderID);
+    bool GetOrderInfo(uint32 orderID, Market::OrderInfo& oInfo);
+    // best-priced sell order at args.stationID which will fill args.quantity at args.price.  returns 0 if none
+    uint32 FindSellOrder(Call_PlaceCharOrder& args);
+    // best-priced buy order in range of args.stationID which will take args.quantity at args.price.  returns 0 if none
+    uint32 FindBuyOrder(Call_PlaceCharOrder& args);
+    // assigns data.orderID
+    uint32 StoreOrder(Market::SaveData& data);
+    bool AlterOrderPrice(uint32 orderID, float newPrice);
+    bool AlterOrderQuantity(uint32 orderID, uint32 newQty);
+    bool DeleteOrder(uint32 orderID);
+    // drops orders of deleted owner from book.  db rows are removed by caller
+    void RemoveOwnerOrders(uint32 ownerID);
+
     bool NeedsUpdate()                                  { return m_timeStamp > GetFileTimeNow()?false:true; }
 
     PyRep* GetMarketGroups()                            { PyIncRef(m_marketGroups); return m_marketGroups; }
@@ -66,6 +83,10 @@ public:
 protected:
     void Populate();
 
+    void AddToBook(const Market::SaveData& data);
+    void RemoveFromBook(const Market::SaveData& data);
+    bool InRange(const Market::SaveData& order, uint32 stationID, uint32 solarSystemID);
+
 private:
     MarketDB m_db;
     PyServiceMgr* m_manager;
@@ -75,11 +96,18 @@ private:
     int64 m_timeStamp;
 
     // markets are regional.  there are 66 regions.
-    // market orders are stored as {regionID/typeID}
-    //  load market data by region, sorted by system/station.
-    //  station data will also store StationRef to owning/containing station for easier access later
-    //  will be able to implement 'jumps' and other market conditionals
-    //  ** this could take ~16m for average market data per region
+    // market orders are stored by orderID, and indexed by price per {regionID/typeID}
+    //  sell orders are searched lowest price first, buy orders highest price first
+    typedef std::multimap<float, uint32> PriceIndex;   // price/orderID
+    struct OrderBook {
+        PriceIndex sell;
+        PriceIndex buy;
+    };
+    static uint64_t GetBookKey(uint32 regionID, uint16 typeID)   { return ((uint64_t)regionID << 32) | typeID; }
+
+    uint32 m_nextOrderID;
+    std::unordered_map<uint32, Market::SaveData> m_orders;     // orderID/data
+    std::unordered_map<uint64_t, OrderBook> m_books;           // {regionID/typeID}/book
 };
 
 //Singleton
@@ -174,27 +174,7 @@ PyResult MarketProxyService::Handle_GetOrders(PyCallArgs &call) {
         return nullptr;
     }
 
-    PyRep* result(nullptr);
-    std::string method_name ("GetOrders_");
-    method_name += std::to_string(call.client->GetRegionID());
-    method_name += "_";
-    method_name += std::to_string(args.arg);
-    ObjectCachedMethodID method_id(GetName(), method_name.c_str());
-    //check to see if this method is in the cache already.
-    if (!m_manager->cache_service->IsCacheLoaded(method_id))
-    {
-        //this method is not in cache yet, load up the contents and cache it.
-        result = m_db.GetOrders(call.client->GetRegionID(), args.arg);
-        if (result == nullptr) {
-            _log(MARKET__DB_ERROR, "Failed to load cache, generating empty contents.");
-            result = PyStatic.NewNone();
-        }
-        m_manager->cache_service->GiveCache(method_id, &result);
-    }
-
-    //now we know its in the cache one way or the other, so build a
-    //cached object cached method call result.
-    result = m_manager->cache_service->MakeObjectCachedMethodCallResult(method_id);
+    PyRep* result = sMktMgr.GetOrders(call.client->GetRegionID(), args.arg);
 
     /*{'FullPath': u'UI/Messages', 'messageID': 258616, 'label': u'MktMarketOpeningTitle'}(u'Market not open yet', None, None)
      * {'FullPath': u'UI/Messages', 'messageID': 258617, 'label': u'MktMarketOpeningBody'}
@@ -280,7 +260,7 @@ PyResult MarketProxyService::Handle_PlaceCharOrder(PyCallArgs &call) {
         if (args.duration == 0) {
             // immediate.  look for open sell order that matches all reqs (price, qty, distance, etc)
             // check distance shit, set order range and make station list.  this shit will be nuts.
-            uint32 orderID = m_db.FindSellOrder(args);
+            uint32 orderID = sMktMgr.FindSellOrder(args);
             if (orderID) {
                 // found one.
                 _log(MARKET__TRACE, "PlaceCharOrder - Found sell order #%u in %s for %s. (type %i, price %.2f, qty %i, range %i)", \
@@ -325,12 +305,7 @@ PyResult MarketProxyService::Handle_PlaceCharOrder(PyCallArgs &call) {
         data.jumps = 1;     // not sure if this is used....
 
         // create buy order
-        uint32 orderID(m_db.StoreOrder(data));
-        if (orderID == 0) {
-            _log(MARKET__ERROR, "PlaceCharOrder - Failed to record buy order in the DB.");
-            call.client->SendErrorMsg("Failed to record the order.");
-            return nullptr;
-        }
+        uint32 orderID(sMktMgr.StoreOrder(data));
 
         std::string reason = "DESC:  Setting up buy order in ";
         reason += stDataMgr.GetStationName(args.stationID).c_str();
@@ -355,7 +330,6 @@ PyResult MarketProxyService::Handle_PlaceCharOrder(PyCallArgs &call) {
         }
 
         //send notification of new order...
-        sMktMgr.InvalidateOrdersCache(call.client->GetRegionID(), args.typeID);
         sMktMgr.SendOnOwnOrderChanged(call.client, orderID, Market::Action::Add, args.useCorp);
     } else {
         //sell order
@@ -441,11 +415,13 @@ PyResult MarketProxyService::Handle_PlaceCharOrder(PyCallArgs &call) {
             bool search(true);
             uint32 orderID(0), origQty(args.quantity);
             while (args.quantity and search) {
-                orderID = m_db.FindBuyOrder(args);
+                orderID = sMktMgr.FindBuyOrder(args);
                 if (orderID) {
                     _log(MARKET__TRACE, "PlaceCharOrder - Found buy order #%u in %s for %s.", \
                             orderID, stDataMgr.GetStationName(args.stationID).c_str(), call.client->GetName());
                     search = sMktMgr.ExecuteBuyOrder(call.client, orderID, iRef, args);
+                } else {
+                    search = false;
                 }
             }
 
@@ -498,13 +474,8 @@ PyResult MarketProxyService::Handle_PlaceCharOrder(PyCallArgs &call) {
         data.contraband = iRef->contraband();   // does this need to check region/system?
         data.jumps = 1;     // not sure if this is used....
 
-        //store the order in the DB.
-        uint32 orderID = m_db.StoreOrder(data);
-        if (orderID == 0) {
-            _log(MARKET__ERROR, "PlaceCharOrder - Failed to record sell order in the DB.");
-            call.client->SendErrorMsg("Failed to record the order in the DB!");
-            return nullptr;
-        }
+        //add the order to the book.  it is written to the DB through the write queue
+        uint32 orderID = sMktMgr.StoreOrder(data);
 
         if (iRef->quantity() == args.quantity) {
             //take item from seller
@@ -519,7 +490,6 @@ PyResult MarketProxyService::Handle_PlaceCharOrder(PyCallArgs &call) {
         }
 
         //notify client about new order.
-        sMktMgr.InvalidateOrdersCache(call.client->GetRegionID(), args.typeID);
         sMktMgr.SendOnOwnOrderChanged(call.client, orderID, Market::Action::Add, args.useCorp);
 
         // calculate total for broker fees
@@ -558,7 +528,7 @@ PyResult MarketProxyService::Handle_ModifyCharOrder(PyCallArgs &call) {
     // client coded to throw error if price > 9223372036854.0
     // we need to pull data from db for typeID and isCorp...
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!m_db.GetOrderInfo(args.orderID, oInfo)) {
+    if (!sMktMgr.GetOrderInfo(args.orderID, oInfo)) {
         _log(MARKET__ERROR, "ModifyCharOrder - Failed to get info about order #%u.", args.orderID);
         return nullptr;
     }
@@ -573,12 +543,11 @@ PyResult MarketProxyService::Handle_ModifyCharOrder(PyCallArgs &call) {
                         reason.c_str(), Journal::EntryType::MarketEscrow, args.orderID,
                         Account::KeyType::Cash, Account::KeyType::Escrow);
 
-    if (!m_db.AlterOrderPrice(args.orderID, args.newPrice)) {
+    if (!sMktMgr.AlterOrderPrice(args.orderID, args.newPrice)) {
         _log(MARKET__ERROR, "ModifyCharOrder - Failed to modify price for order #%u.", call.client->GetName(), args.orderID);
         return nullptr;
     }
 
-    sMktMgr.InvalidateOrdersCache(call.client->GetRegionID(), oInfo.typeID);
     sMktMgr.SendOnOwnOrderChanged(call.client, args.orderID, Market::Action::Modify, oInfo.isCorp);
 
     return nullptr;
@@ -592,7 +561,7 @@ PyResult MarketProxyService::Handle_CancelCharOrder(PyCallArgs &call) {
     }
 
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!m_db.GetOrderInfo(args.orderID, oInfo)) {
+    if (!sMktMgr.GetOrderInfo(args.orderID, oInfo)) {
         _log(MARKET__ERROR, "CancelCharOrder - Failed to get info about order #%u.", call.client->GetName(), args.orderID);
         return nullptr;
     }
@@ -613,13 +582,12 @@ PyResult MarketProxyService::Handle_CancelCharOrder(PyCallArgs &call) {
             iRef->Donate(call.client->GetCharacterID(), oInfo.stationID, flagHangar, true);
     }
 
-    PyRep* order(m_db.GetOrderRow(args.orderID));
-    if (!m_db.DeleteOrder(args.orderID)) {
+    PyRep* order(sMktMgr.GetOrderRow(args.orderID));
+    if (!sMktMgr.DeleteOrder(args.orderID)) {
         _log(MARKET__ERROR, "CancelCharOrder - Failed to delete order #%u.", args.orderID);
         return nullptr;
     }
 
-    sMktMgr.InvalidateOrdersCache(call.client->GetRegionID(), oInfo.typeID);
     sMktMgr.SendOnOwnOrderChanged(call.client, args.orderID, Market::Action::Expiry, oInfo.isCorp, order);
 
     return nullptr;
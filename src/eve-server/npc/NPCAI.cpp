@@ -291,16 +291,24 @@ void NPCAIMgr::Process() {
     switch(m_state) {
         case NPCAI::State::Idle: {
             if (m_beginFindTarget.Check()) {
-                std::vector<Client*> clientVec;
-                clientVec.clear();
+                // only entities within sight range are looked at.  the nearest valid player in our bubble is targeted
+                std::vector<SystemEntity*> seVec;
+                m_npc->SystemMgr()->GetEntitiesInRange(m_npc->GetPosition(), m_sightRange, seVec);
+                Client* pClient(nullptr);
                 DestinyManager* pDestiny(nullptr);
-                m_npc->SysBubble()->GetPlayers(clientVec); // what about player drones?  yes...later
-                for (auto cur : clientVec) {
-                    if (cur->IsInvul())
+                SystemEntity* pTarget(nullptr);
+                double dist(0), targetDist(0);
+                for (auto cur : seVec) {   // what about player drones?  yes...later
+                    if (!cur->IsShipSE() or !cur->HasPilot())
                         continue;
-                    if (cur->GetShipSE() == nullptr)
+                    if (cur->SysBubble() != m_npc->SysBubble())
                         continue;
-                    if (cur->InPod()) {
+                    pClient = cur->GetPilot();
+                    if (pClient->IsInvul())
+                        continue;
+                    if (pClient->GetShipSE() != cur)
+                        continue;
+                    if (pClient->InPod()) {
                         if (sConfig.npc.TargetPod) {
                             if (m_npc->SystemMgr()->GetSystemSecurityRating() > sConfig.npc.TargetPodSec)
                                 continue;
@@ -308,15 +316,19 @@ void NPCAIMgr::Process() {
                             continue;
                         }
                     }
-                    pDestiny = cur->GetShipSE()->DestinyMgr();
+                    pDestiny = cur->DestinyMgr();
                     if (pDestiny == nullptr)   // this shouldnt be needed, but whatever...
                         continue;
                     if (pDestiny->IsCloaked() or pDestiny->IsWarping())
                         continue;
-                    if (m_npc->GetPosition().distance(cur->GetShipSE()->GetPosition()) > m_sightRange)
-                        continue;
-
-                    Target(cur->GetShipSE());
+                    dist = m_npc->GetPosition().distance(cur->GetPosition());
+                    if ((pTarget == nullptr) or (dist < targetDist)) {
+                        pTarget = cur;
+                        targetDist = dist;
+                    }
+                }
+                if (pTarget != nullptr) {
+                    Target(pTarget);
                     return;
                 }
                 if (sConfig.npc.IdleWander)
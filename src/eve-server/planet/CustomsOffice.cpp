@@ -287,6 +287,7 @@ void CustomsSE::SendSlimUpdate()
     PyTuple* sItem = new PyTuple(2);
         sItem->SetItem(0,                               new PyString("OnSlimItemChange"));
         sItem->SetItem(1,                               shipData);
+    InvalidateSlimItem();
     m_destiny->SendSingleDestinyUpdate(&sItem);   // consumed
 }
 
@@ -795,7 +795,7 @@ void PlanetDB::RemovePin(uint32 pinID)
     DBerror err;
     sDatabase.RunQuery(err, "DELETE FROM piPins WHERE pinID = %u", pinID);
     sDatabase.RunQuery(err, "DELETE FROM entity WHERE itemID = %u", pinID);
-    sDatabase.RunQuery(err, "DELETE FROM entity_attributes WHERE itemID = %u", pinID);
+    sDatabase.QueueWrite(pinID, "DELETE FROM entity_attributes WHERE itemID = %u", pinID);
 }
 
 void PlanetDB::RemoveHead(uint32 ecuID, uint32 headID)
@@ -815,6 +815,7 @@ PyResult BeyonceBound::Handle_CmdAbandonLoot(PyCallArgs &call) {
         if (pSE == nullptr)
             continue;
         pSE->Abandon();
+        pSE->InvalidateSlimItem();
         PyTuple* slimData = new PyTuple(2);
             slimData->SetItem(0, new PyLong(pSE->GetID()));
             slimData->SetItem(1, new PyObject( "foo.SlimItem", pSE->MakeSlimItem()));
@@ -85,6 +85,8 @@ void ShipItem::LogOut()
 {
     SetAttribute(AttrOnline, EvilZero, false);
     SaveShip();
+    // graph holds refs to this ship
+    m_fxGraph.Clear();
 
     pInventory->Unload();
 
@@ -472,6 +474,10 @@ void ShipItem::AddItem(InventoryItemRef iRef)
 
     InventoryItem::AddItem(iRef);
 
+    // hi slot modules are listed in our slim item
+    if (IsHiSlot(iRef->flag()) and (m_pilot != nullptr) and (m_pilot->GetShipSE() != nullptr))
+        m_pilot->GetShipSE()->InvalidateSlimItem();
+
     // add item mass to ship's mass if set in options (additive...loaded ship should be heavy)
     if (sConfig.server.CargoMassAdditive) {
         uint32 mass = GetAttribute(AttrMass).get_uint32();
@@ -539,6 +545,10 @@ void ShipItem::RemoveItem(InventoryItemRef iRef)
     if (m_pilot == nullptr)
         return;
 
+    // hi slot modules are listed in our slim item
+    if (IsHiSlot(iRef->flag()) and (m_pilot->GetShipSE() != nullptr))
+        m_pilot->GetShipSE()->InvalidateSlimItem();
+
     // check to see if item is currently in a module slot.
     if (IsModuleSlot(iRef->flag())) {
         if (IsRigSlot(iRef->flag())) {
@@ -1822,6 +1832,7 @@ void ShipItem::ProcessEffects(bool add/*false*/, bool update/*false*/)
         pAttributeMap->SaveShipState();      // save ship damage as it's removed on next call
         ResetAttributes();
         ClearModuleModifiers();
+        m_fxGraph.Clear();
         m_pilot->GetChar()->ResetModifiers();
         std::vector< InventoryItemRef > modVec;
         m_ModuleManager->GetModuleListOfRefsAsc(modVec);
@@ -1842,10 +1853,7 @@ void ShipItem::ProcessShipEffects(bool update/*false*/)
 {
     _log(EFFECTS__TRACE, "ShipItem::ProcessShipEffects()");
     for (auto it : type().m_stateFxMap) {
-        fxData data = fxData();
-        data.action = FX::Action::Invalid;
-        data.srcRef = static_cast<InventoryItemRef>(this);
-        sFxProc.ParseExpression(this, sFxDataMgr.GetExpression(it.second.preExpression), data);
+        sFxProc.ExecuteExpression(this, it.second.preExpression, static_cast<InventoryItemRef>(this));
     }
     // apply processed ship effects
     sFxProc.ApplyEffects(this, m_pilot->GetChar().get(), this, update);
@@ -1885,6 +1893,7 @@ void ShipItem::ResetEffects() {
     // reset attributes on char, ship, all modules and charges
     pAttributeMap->SaveShipState();      // save ship damage as it's removed on next call
     ResetAttributes();
+    m_fxGraph.Clear();
     m_pilot->GetChar()->ResetModifiers();
     std::vector< InventoryItemRef > modVec;
     m_ModuleManager->GetModuleListOfRefsAsc(modVec);
@@ -30,6 +30,7 @@
 #include "EVEServerConfig.h"
 #include "StaticDataMgr.h"
 #include "effects/EffectsData.h"
+#include "effects/EffectsGraph.h"
 #include "fleet/FleetData.h"
 #include "inventory/ItemType.h"
 #include "inventory/InventoryItem.h"
@@ -78,6 +79,8 @@ public:
 
     bool HasModuleManager()                             { return (m_ModuleManager != nullptr); }
     ModuleManager* GetModuleManager()                   { return m_ModuleManager; }
+    // modifiers applied to this ship, its pilot, modules and charges
+    FxGraph& GetFxGraph()                               { return m_fxGraph; }
 
     virtual void Delete();
 
@@ -275,6 +278,8 @@ private:
     //the ship's module manager.  We own this
     ModuleManager* m_ModuleManager;
 
+    FxGraph m_fxGraph;
+
     InventoryItemRef m_targetRef;       // this is only used for module effects that require a target.  is here because of the ease of aquiring/sending (common code)
 
     std::vector<uint32> m_onlineModuleVec;      // for onlining modules when undocking
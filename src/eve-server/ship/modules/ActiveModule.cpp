@@ -832,10 +832,7 @@ void ActiveModule::LoadCharge(InventoryItemRef chargeRef)
         // process new charge's effects (load timer will determine if fx are applied based on existing charge)
         // GM::Online proc fx when client logs in...this is to avoid dupe calls
         for (auto it : chargeRef->type().m_stateFxMap) {
-            fxData data = fxData();
-            data.action = FX::Action::Invalid;
-            data.srcRef = chargeRef;
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+            sFxProc.ExecuteExpression(m_modRef.get(), it.second.preExpression, chargeRef);
         }
         if (pClient->IsInSpace()) {
             /*  **** this sets "reload blink" status on weapon button
@@ -891,10 +888,7 @@ void ActiveModule::UnloadCharge()
 
         m_modRef->ClearModifiers();
         for (auto it : m_chargeRef->type().m_stateFxMap) {
-            fxData data = fxData();
-            data.action = FX::Action::Invalid;
-            data.srcRef = m_chargeRef;
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+            sFxProc.ExecuteExpression(m_modRef.get(), it.second.postExpression, m_chargeRef);
         }
 
         // apply to containing module to properly remove effects
@@ -140,10 +140,7 @@ void GenericModule::Online()
         } else {
             _log(MODULE__MESSAGE, "GenericModule::Online() - module %u(%s) loading charge fx for %s.", itemID(), m_modRef->name(), m_chargeRef->name());
             for (auto it : m_chargeRef->type().m_stateFxMap) {
-                fxData data = fxData();
-                data.action = FX::Action::Invalid;
-                data.srcRef = m_chargeRef;
-                sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+                sFxProc.ExecuteExpression(m_modRef.get(), it.second.preExpression, m_chargeRef);
             }
         }
     }
@@ -206,10 +203,7 @@ void GenericModule::Offline()
                     itemID(), m_modRef->name());
         } else {
             for (auto it : m_chargeRef->type().m_stateFxMap) {
-                fxData data = fxData();
-                data.action = FX::Action::Invalid;
-                data.srcRef = m_chargeRef;
-                sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+                sFxProc.ExecuteExpression(m_modRef.get(), it.second.postExpression, m_chargeRef);
             }
         }
     }
@@ -246,16 +240,13 @@ void GenericModule::ProcessEffects(int8 state, bool active/*false*/)
     for (auto it : effectMap) {
         if (it.first == 16)    // skip the online effect.  this is done internally elsewhere
             continue;
-        fxData data = fxData();
-        data.action = FX::Action::Invalid;
-        data.srcRef = m_modRef;
         /* module and charge effects will be added/removed from it's item
          * active/overload/gang/other effects will be applied and removed when called.
          */
         if (active) {
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+            sFxProc.ExecuteExpression(m_modRef.get(), it.second.preExpression, m_modRef);
         } else {
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+            sFxProc.ExecuteExpression(m_modRef.get(), it.second.postExpression, m_modRef);
         }
     }
 }
@@ -148,6 +148,7 @@ bool ModuleManager::Initialize() {
                         //cur->SetQuantity(cur->quantity());    //OIC
                         cur->SetAttribute(AttrQuantity, cur->quantity(), false);   // OMAC
                         m_charges.emplace(cur->flag(), cur);
+                        pShipItem->GetFxGraph().AddCharge(cur);
                     }
                     pMod = nullptr;
                 } break;
@@ -961,6 +962,7 @@ void ModuleManager::LoadCharge(InventoryItemRef chargeRef, EVEItemFlags flag)
         chargeRef->Move(pShipItem->itemID(), flag, pShipItem->HasPilot()?pShipItem->GetPilot()->IsDocked():false);
         //chargeRef->Move(pShipItem->itemID(), flag, false);
         m_charges.emplace(flag, chargeRef);
+        pShipItem->GetFxGraph().AddCharge(chargeRef, pShipItem->HasPilot());
     }
 
     // this will enable module loading blink if ship in space, even on reload/fillup
@@ -1038,6 +1040,7 @@ void ModuleManager::UnloadCharge(GenericModule* pMod)
     }
 
     pMod->UnloadCharge();
+    pShipItem->GetFxGraph().RemoveCharge(chargeRef, pShipItem->HasPilot());
 
     // if charge is depleted, update has already been sent to client thru OMAC
     if (chargeRef->quantity() < 1)
@@ -1517,6 +1520,9 @@ void ModuleManager::addModuleRef(EVEItemFlags flag, GenericModule* pMod)
 
     _log(MODULE__TRACE, "MM::addModuleRef() - adding %s in %s to map.", pMod->GetSelf()->name(), sDataMgr.GetFlagName(flag));
 
+    // apply kept skill and group modifiers to new module
+    pShipItem->GetFxGraph().AddModule(pMod->GetSelf(), (pShipItem->HasPilot() and !pShipItem->GetPilot()->IsLogin()));
+
     // Maintain the Modules Fitted By Group counter for this module group:
     if (m_modByGroup.find(pMod->groupID()) != m_modByGroup.end()) {
         m_modByGroup.find(pMod->groupID())->second += 1;
@@ -1573,6 +1579,8 @@ void ModuleManager::deleteModuleRef(EVEItemFlags flag, GenericModule* pMod)
 
     _log(MODULE__TRACE, "MM::deleteModuleRef() - removing %s from %s.", pMod->GetSelf()->name(), sDataMgr.GetFlagName(flag));
 
+    pShipItem->GetFxGraph().RemoveModule(pMod->GetSelf(), pShipItem->HasPilot());
+
     // Maintain the Modules Fitted By Group counter for this module group:
     if (m_modByGroup.find(pMod->groupID()) != m_modByGroup.end()) {
         m_modByGroup.find(pMod->groupID())->second -= 1;
@@ -0,0 +1,116 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#include "eve-server.h"
+
+#include "system/BallStore.h"
+#include "system/DestinyManager.h"
+
+BallStore::BallStore()
+: m_open( false )
+{
+}
+
+void BallStore::Begin()
+{
+    m_open = true;
+}
+
+void BallStore::End()
+{
+    // nothing may queue while balls are handed back
+    m_open = false;
+
+    m_balls.Integrate();
+
+    for (size_t i = 0; i < m_moveOwners.size(); ++i) {
+        DestinyManager* pDestiny = m_moveOwners[i];
+        if (pDestiny == nullptr)
+            continue;
+        pDestiny->m_ballStore = nullptr;
+        pDestiny->EndBallMove( m_balls.GetMovePosition( i ), m_balls.GetMoveVelocity( i ) );
+    }
+    for (size_t i = 0; i < m_missileOwners.size(); ++i) {
+        DestinyManager* pDestiny = m_missileOwners[i];
+        if (pDestiny == nullptr)
+            continue;
+        pDestiny->m_ballStore = nullptr;
+        pDestiny->EndMissileMove( m_balls.GetMissilePosition( i ), m_balls.GetMissileVelocity( i ), m_balls.GetMissileHeading( i ) );
+    }
+
+    m_balls.Clear();
+    m_moveOwners.clear();
+    m_missileOwners.clear();
+}
+
+bool BallStore::QueueMove( DestinyManager* pDestiny, const GPoint& position, const GVector& heading, float speed )
+{
+    if (!m_open)
+        return false;
+
+    pDestiny->m_ballStore = this;
+    pDestiny->m_ballIdx = m_balls.AddMove( position, heading, speed );
+    pDestiny->m_ballMissile = false;
+    m_moveOwners.push_back( pDestiny );
+    return true;
+}
+
+bool BallStore::QueueMissile( DestinyManager* pDestiny, const GPoint& position, const GPoint& target, float speed )
+{
+    if (!m_open)
+        return false;
+
+    pDestiny->m_ballStore = this;
+    pDestiny->m_ballIdx = m_balls.AddMissile( position, target, speed );
+    pDestiny->m_ballMissile = true;
+    m_missileOwners.push_back( pDestiny );
+    return true;
+}
+
+void BallStore::Flush( DestinyManager* pDestiny )
+{
+    size_t idx = pDestiny->m_ballIdx;
+    pDestiny->m_ballStore = nullptr;
+    if (pDestiny->m_ballMissile) {
+        m_missileOwners[idx] = nullptr;
+        m_balls.IntegrateMissile( idx );
+        pDestiny->EndMissileMove( m_balls.GetMissilePosition( idx ), m_balls.GetMissileVelocity( idx ), m_balls.GetMissileHeading( idx ) );
+    } else {
+        m_moveOwners[idx] = nullptr;
+        m_balls.IntegrateMove( idx );
+        pDestiny->EndBallMove( m_balls.GetMovePosition( idx ), m_balls.GetMoveVelocity( idx ) );
+    }
+}
+
+void BallStore::Cancel( DestinyManager* pDestiny )
+{
+    pDestiny->m_ballStore = nullptr;
+    if (pDestiny->m_ballMissile) {
+        m_missileOwners[pDestiny->m_ballIdx] = nullptr;
+    } else {
+        m_moveOwners[pDestiny->m_ballIdx] = nullptr;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __SYSTEM__BALL_STORE_H__INCL__
+#define __SYSTEM__BALL_STORE_H__INCL__
+
+#include "destiny/BallIntegrator.h"
+
+class DestinyManager;
+
+/**
+ * @brief Moves the balls of one system in a single pass per tic.
+ *
+ * While open (around the entity loop of SystemManager::ProcessTic()), DestinyManager hands
+ * its ball to the store instead of moving it.  End() then moves all queued balls with
+ * Destiny::BallIntegrator and hands the results back to their DestinyManager, which
+ * finishes the move as it would have done itself.
+ *
+ * A queued ball which must move again, be changed or leave the system before End()
+ * is moved right away with Flush().
+ *
+ * Enabled with <BatchedMovement> in the cosmic section of server config.
+ *
+ * @author EVEmu Team
+ */
+class BallStore
+{
+public:
+    BallStore();
+
+    /** @brief Opens store for this tic. */
+    void Begin();
+    /** @brief Moves all queued balls, hands them back and closes store. */
+    void End();
+
+    bool IsOpen() const                                 { return m_open; }
+
+    /** @return True if ball was queued.  false if store is closed; caller moves ball itself. */
+    bool QueueMove( DestinyManager* pDestiny, const GPoint& position, const GVector& heading, float speed );
+    bool QueueMissile( DestinyManager* pDestiny, const GPoint& position, const GPoint& target, float speed );
+
+    /** @brief Moves given ball now.  must be queued here. */
+    void Flush( DestinyManager* pDestiny );
+    /** @brief Drops given ball without moving it.  must be queued here. */
+    void Cancel( DestinyManager* pDestiny );
+
+private:
+    bool m_open;
+
+    Destiny::BallIntegrator m_balls;
+
+    // owners of balls in m_balls, by index.  null once flushed or cancelled
+    std::vector<DestinyManager*> m_moveOwners;
+    std::vector<DestinyManager*> m_missileOwners;
+};
+
+#endif /* !__SYSTEM__BALL_STORE_H__INCL__ */
@@ -48,6 +48,7 @@ m_bubbleID(0)
     m_wanderers.clear();
     m_bubbleIDMap.clear();
     m_sysBubbleMap.clear();
+    m_sysBubbleGrid.clear();
 }
 
 BubbleManager::~BubbleManager() {
@@ -65,6 +66,9 @@ int BubbleManager::Initialize() {
 void BubbleManager::clear() {
     for (auto cur : m_bubbles)
         SafeDelete(cur);
+    for (auto cur : m_sysBubbleGrid)
+        SafeDelete(cur.second);
+    m_sysBubbleGrid.clear();
 
     sLog.Warning("        BubbleMgr", "Bubble Manager has been closed." );
 }
@@ -217,22 +221,36 @@ SystemBubble* BubbleManager::FindBubble(SystemEntity *ent) const {
 }
 
 SystemBubble* BubbleManager::FindBubble(uint32 systemID, const GPoint &pos) const {
+    MutexLock lock(mMutex);
     // Finds a range containing all elements whose key is k.
     // pair<iterator, iterator> equal_range(const key_type& k)
     _log(DESTINY__BUBBLE_DEBUG, "BubbleManager::FindBubble() - Searching point %.1f, %.1f, %.1f in system %u.", \
                 pos.x, pos.y, pos.z, systemID);
 
-    auto range = m_sysBubbleMap.equal_range(systemID);
-    for ( auto itr = range.first; itr != range.second; ++itr )
-        if (itr->second->InBubble(pos))
-            return itr->second;
+    SpatialGrid<SystemBubble>* pGrid(GetBubbleGrid(systemID));
+    if (pGrid == nullptr)
+        return nullptr;
+
+    // nearest center within bubble radius (plus grey area) is the bubble containing pos
+    std::vector<SystemBubble*> bubbles;
+    pGrid->QueryNearest(pos, 1, bubbles, BUBBLE_RADIUS_METERS + BUBBLE_HYSTERESIS_METERS);
+    if (!bubbles.empty() and bubbles.front()->InBubble(pos))
+        return bubbles.front();
 
     //not in any existing bubble.
     return nullptr;
 }
 
+SpatialGrid<SystemBubble>* BubbleManager::GetBubbleGrid(uint32 systemID) const {
+    std::map<uint32, SpatialGrid<SystemBubble>*>::const_iterator itr = m_sysBubbleGrid.find(systemID);
+    if (itr == m_sysBubbleGrid.end())
+        return nullptr;
+    return itr->second;
+}
+
 SystemBubble* BubbleManager::GetBubble(SystemManager* sysMgr, const GPoint& pos)
 {
+    MutexLock lock(mMutex);
     SystemBubble* pBubble(FindBubble(sysMgr->GetID(), pos));
     if (pBubble == nullptr)
         pBubble = MakeBubble(sysMgr, pos);
@@ -241,23 +259,29 @@ SystemBubble* BubbleManager::GetBubble(SystemManager* sysMgr, const GPoint& pos)
 }
 
 SystemBubble* BubbleManager::MakeBubble(SystemManager* sysMgr, GPoint pos) {
+    MutexLock lock(mMutex);
     // determine if new center (pos) is within 2x radius of another bubble center. (overlap)
-    auto range = m_sysBubbleMap.equal_range(sysMgr->GetID());
-    for ( auto itr = range.first; itr != range.second; ++itr )
-        if (itr->second->IsOverlap(pos)) {
-            GVector dir(itr->second->GetCenter(), pos);
-            dir.normalize();
-            _log(DESTINY__BUBBLE_DEBUG, "BubbleManager::MakeBubble()::IsOverlap() - dir: %.3f,%.3f,%.3f", dir.x, dir.y, dir.z);
-            // move pos away from center
-            pos = itr->second->GetCenter() + (dir * (BUBBLE_RADIUS_METERS * 2));
-            break;
-        }
+    SpatialGrid<SystemBubble>* pGrid(GetBubbleGrid(sysMgr->GetID()));
+    if (pGrid == nullptr) {
+        pGrid = new SpatialGrid<SystemBubble>(BUBBLE_RADIUS_METERS * 2);
+        m_sysBubbleGrid[sysMgr->GetID()] = pGrid;
+    }
+    std::vector<SystemBubble*> bubbles;
+    pGrid->QueryNearest(pos, 1, bubbles, BUBBLE_RADIUS_METERS * 2);
+    if (!bubbles.empty() and bubbles.front()->IsOverlap(pos)) {
+        GVector dir(bubbles.front()->GetCenter(), pos);
+        dir.normalize();
+        _log(DESTINY__BUBBLE_DEBUG, "BubbleManager::MakeBubble()::IsOverlap() - dir: %.3f,%.3f,%.3f", dir.x, dir.y, dir.z);
+        // move pos away from center
+        pos = bubbles.front()->GetCenter() + (dir * (BUBBLE_RADIUS_METERS * 2));
+    }
 
     SystemBubble* pBubble = new SystemBubble(sysMgr, pos, BUBBLE_RADIUS_METERS);
     if (pBubble != nullptr) {
         m_bubbles.push_back(pBubble);
         m_bubbleIDMap.emplace(pBubble->GetID(), pBubble);
         m_sysBubbleMap.emplace(sysMgr->GetID(), pBubble);
+        pGrid->Insert(pBubble, pBubble->GetCenter());
         if (sConfig.debug.BubbleTrack)
             pBubble->MarkCenter();
     }
@@ -266,6 +290,7 @@ SystemBubble* BubbleManager::MakeBubble(SystemManager* sysMgr, GPoint pos) {
 
 SystemBubble* BubbleManager::FindBubbleByID(uint16 bubbleID)
 {
+    MutexLock lock(mMutex);
     std::map<uint32, SystemBubble*>::iterator itr = m_bubbleIDMap.find(bubbleID);
     if (itr != m_bubbleIDMap.end())
         return itr->second;
@@ -274,6 +299,7 @@ SystemBubble* BubbleManager::FindBubbleByID(uint16 bubbleID)
 
 void BubbleManager::ClearSystemBubbles(uint32 systemID)
 {
+    MutexLock lock(mMutex);
     auto range = m_sysBubbleMap.equal_range(systemID);
     for (auto itr = range.first; itr != range.second; ++itr){
         m_bubbles.remove(itr->second);
@@ -281,10 +307,19 @@ void BubbleManager::ClearSystemBubbles(uint32 systemID)
     }
 
     m_sysBubbleMap.erase(systemID);
+    std::map<uint32, SpatialGrid<SystemBubble>*>::iterator itr = m_sysBubbleGrid.find(systemID);
+    if (itr != m_sysBubbleGrid.end()) {
+        SafeDelete(itr->second);
+        m_sysBubbleGrid.erase(itr);
+    }
 }
 
 void BubbleManager::RemoveBubble(uint32 systemID, SystemBubble* pSB)
 {
+    MutexLock lock(mMutex);
+    SpatialGrid<SystemBubble>* pGrid(GetBubbleGrid(systemID));
+    if (pGrid != nullptr)
+        pGrid->Remove(pSB);
     auto range = m_sysBubbleMap.equal_range(systemID);
     for (auto itr = range.first; itr != range.second; ++itr)
         if (itr->second == pSB) {
@@ -299,11 +334,13 @@ void BubbleManager::RemoveBubble(uint32 systemID, SystemBubble* pSB)
 /* for beltmgr */
 void BubbleManager::AddSpawnID(uint16 bubbleID, uint32 spawnID)
 {
+    MutexLock lock(mMutex);
     m_spawnIDs.emplace(bubbleID, spawnID);
 }
 
 void BubbleManager::RemoveSpawnID(uint16 bubbleID, uint32 spawnID)
 {
+    MutexLock lock(mMutex);
     // is this right??
     auto range = m_spawnIDs.equal_range(bubbleID);
     for (auto itr = range.first; itr != range.second; ++itr )
@@ -315,13 +352,21 @@ void BubbleManager::RemoveSpawnID(uint16 bubbleID, uint32 spawnID)
 
 uint32 BubbleManager::GetBeltID(uint16 bubbleID)
 {
+    MutexLock lock(mMutex);
     std::map<uint16, uint32>::iterator itr = m_spawnIDs.find(bubbleID);
     if (itr == m_spawnIDs.end())
         return 0;
     return itr->second;
 }
 
+uint32 BubbleManager::GetBubbleID()
+{
+    MutexLock lock(mMutex);
+    return ++m_bubbleID;
+}
+
 uint32 BubbleManager::GetBubbleCount(uint32 systemID) {
+    MutexLock lock(mMutex);
     uint32 count = 0;
     auto range = m_sysBubbleMap.equal_range(systemID);
     for (auto itr = range.first; itr != range.second; ++itr)
@@ -329,6 +374,13 @@ uint32 BubbleManager::GetBubbleCount(uint32 systemID) {
     return count;
 }
 
+void BubbleManager::GetBubbles(uint32 systemID, std::vector<SystemBubble*>& into) {
+    MutexLock lock(mMutex);
+    auto range = m_sysBubbleMap.equal_range(systemID);
+    for (auto itr = range.first; itr != range.second; ++itr)
+        into.push_back(itr->second);
+}
+
 void BubbleManager::GetBubbleCenterMarkers(std::vector<CosmicSignature>& anom) {
     ContainerSE* cSE(nullptr);
     for (auto cur : m_sysBubbleMap) {
@@ -27,7 +27,9 @@
 
 
 #include <unordered_map>
+#include "math/SpatialGrid.h"
 #include "system/SystemEntity.h"
+#include "threading/Mutex.h"
 
 static const float BUBBLE_RADIUS_METERS = 300000.0f;       // EVE retail uses 250km and allows grid manipulation  NOTE:  this is based on testing for best results.  -allan
 static const float BUBBLE_HYSTERESIS_METERS = 5000.0f;     // How far out of the existing bubble a ship needs to fly before being placed into a new or different bubble
@@ -39,10 +41,9 @@ class GPoint;
 //any of the optimized space searching algorithms which we
 // may develop based on bubbles.
 //
-// Right now it is stupid and searches for a bubble using a
-// linear search. obviously a much better spacial partitioning
-// scheme could be written later (octtree or quadtree maybe?)
-// and this would be the place to put it.
+// bubble centers of each system are kept in a grid with cells of one
+// bubble diameter, so finding the bubble at a point only looks at the
+// few bubbles near it.
 class BubbleManager
 : public Singleton<BubbleManager>
 {
@@ -76,7 +77,7 @@ public:
     void RemoveBubble(uint32 systemID, SystemBubble* pSB);
 
     uint32 Count()                                      { return m_bubbles.size(); }
-    uint32 GetBubbleID()                                { return ++m_bubbleID; }
+    uint32 GetBubbleID();
 
     // for spawn system     -allan 15April16
     void AddSpawnID(uint16 bubbleID, uint32 spawnID);
@@ -85,6 +86,8 @@ public:
 
     // for .list command
     uint32 GetBubbleCount(uint32 systemID);
+    // for collision detection
+    void GetBubbles(uint32 systemID, std::vector<SystemBubble*>& into);
 
     // for .bubbletrack command
     void MarkCenters(); // for all bubbles, across all systems
@@ -114,6 +117,13 @@ private:
     std::map<uint32, SystemBubble*> m_bubbleIDMap;     // bubbleID/bubble*
 
     std::unordered_multimap<uint32, SystemBubble*> m_sysBubbleMap;  // systemID/bubble*
+    std::map<uint32, SpatialGrid<SystemBubble>*> m_sysBubbleGrid;   // systemID/bubble centers
+
+    // returns grid of given system, or NULL if system has no bubbles
+    SpatialGrid<SystemBubble>* GetBubbleGrid(uint32 systemID) const;
+
+    // guards bubble and spawn containers against systems ticking on other threads
+    mutable Mutex mMutex;
 };
 
 //Singleton
@@ -493,6 +493,7 @@ void WreckContainer::MakeSlimItemChange()
         return;
     if ((mySE == nullptr) or (mySE->SysBubble() == nullptr))
         return;
+    mySE->InvalidateSlimItem();
     PyDict* slimPod = mySE->MakeSlimItem();
     PyTuple* shipData = new PyTuple(2);
         shipData->SetItem(0, new PyLong(itemID()));
@@ -69,9 +69,13 @@ m_warpAccelTime(1),
 m_warpDecelTime(1),
 m_warpState(nullptr),
 m_targBubble(nullptr),
-m_warpCapacitorNeed(0.00001f)
+m_warpCapacitorNeed(0.00001f),
+m_inTic(false),
+m_ballStore(nullptr),
+m_ballIdx(0),
+m_ballMissile(false),
+m_moveStamp(0.0)
 {
-    m_bump = false;
     m_stop = false;
     m_accel = false;
     m_decel = false;
@@ -116,6 +120,8 @@ m_warpCapacitorNeed(0.00001f)
 }
 
 DestinyManager::~DestinyManager() {
+    if (m_ballStore != nullptr)
+        m_ballStore->Cancel(this);
     m_warpTimer.Disable();
     SafeDelete(m_warpState);
 }
@@ -129,7 +135,9 @@ void DestinyManager::Process() {
 
     double profileStartTime = GetTimeUSeconds();
     //check for and process Destiny::Ball::State changes.
+    m_inTic = true;
     ProcessState();
+    m_inTic = false;
 
     if (sConfig.debug.UseProfiling)
         sProfiler.AddTime(Profile::destiny, GetTimeUSeconds() - profileStartTime);
@@ -150,6 +158,8 @@ void DestinyManager::ProcessState() {
         } break;
         case Ball::Mode::MISSILE: {
             // if target was removed, continue movement and wait for Missile::EndOfLife() call to do cleanup
+            if (mySE->SystemMgr()->GetBallStore().QueueMissile(this, m_position, m_targetPoint, m_maxSpeed))
+                break;  // moved along with the rest of the system at end of tic
             //set current direction based on position and targetPoint.  this will keep missile aligned properly
             GVector moveVector(m_position, m_targetPoint);
             moveVector.normalize();
@@ -252,6 +262,7 @@ void DestinyManager::ProcessState() {
  */
  //Velocity setting methods
 void DestinyManager::SetSpeedFraction(float fraction/*1.0*/, bool startMovement/*false*/) {
+    FlushBall();
     // this sets current speed fraction for object.
 
     // if orbiting, call Orbit() and let code reset the variables
@@ -349,6 +360,7 @@ void DestinyManager::SetSpeedFraction(float fraction/*1.0*/, bool startMovement/
 }
 
 void DestinyManager::UpdateVelocity(bool isMoving) {
+    FlushBall();
     uint8 logType = 0;
     if ((m_ballMode == Destiny::Ball::Mode::WARP) and (m_warpState != nullptr)) {
         /*  Warp() finished, and ship dropped out of warp at m_speedToLeaveWarp,
@@ -538,6 +550,7 @@ void DestinyManager::Stop() {
 }
 
 void DestinyManager::Halt() {
+    FlushBall();
 
     SafeDelete(m_warpState);
 
@@ -584,51 +597,11 @@ void DestinyManager::Eject()
 }
 
 // Global collision methods
-//  check for collision.  called by Move()
-void DestinyManager::CheckBump()
-{
-    double profileStartTime = GetTimeUSeconds();
-
-    //  collision detection code here
-    /*  in this case, we are ONLY interested in objects
-     *   that have drifted within each others radius (for whatever reason)
-     *  this only checks for ships running sub-warp speeds
-     *   in relation to other objects in bubble.
-     */
-
-    // NOTE:  object's "massive = true" means it can bump/collide  (massive = solid)
-
-    // initial implementation will ONLY check player ships for bumping.
-    std::vector<Client*> vPlayers;
-    mySE->SysBubble()->GetPlayers(vPlayers);
-    Client* pClient = mySE->GetPilot();
-    GPoint pos(GetPosition());
-    float distance = 0.0f;
-    for (auto cur : vPlayers) {
-        if (cur == pClient)
-            continue;
-        distance = pos.distance(cur->GetShipSE()->GetPosition());
-        distance -= (mySE->GetRadius() - cur->GetShipSE()->GetRadius());
-        if (distance < BUMP_DISTANCE) {
-            Bump(cur->GetShipSE());
-            m_bump = true;
-        } else {
-            m_bump = false;
-        }
-    }
-    /** @todo  add data and checks for each ship bumped
-     * to give single bump msg for each ship combo
-     * without spamming their overview
-     */
-
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::collision, GetTimeUSeconds() - profileStartTime);
-}
-
+/*  contacts are found once per tic for each bubble by SystemBubble::ProcessBumps(),
+ *   which calls Bump() on the faster ball of each pair that has just come into contact.
+ */
 void DestinyManager::Bump(SystemEntity* pSE)
 {
-    if (m_bump)
-        return;
     // bump code here
     /*  determine most massive object...maybe not.  use percentiles here (becham math)
      *  determine direction(s) involved
@@ -648,14 +621,15 @@ void DestinyManager::Bump(SystemEntity* pSE)
     /*  run-time options for bumping jetcans, biomass, and other space objects
      *   bump drones??  prolly not, for simplicity
      */
-    std::string msg1 = "You have bumped ";
-    msg1 += pSE->GetPilot()->GetName();
-    mySE->GetPilot()->SendNotifyMsg(msg1.c_str());
-    // this test isnt needed right now, as it's ONLY checking against players and will always return true.
-    //  will keep it in here for later expansion.
+    // any massive ball may bump now, so only pilots are told about it
+    if (mySE->HasPilot()) {
+        std::string msg1 = "You have bumped ";
+        msg1 += (pSE->HasPilot() ? pSE->GetPilot()->GetName() : pSE->GetName());
+        mySE->GetPilot()->SendNotifyMsg(msg1.c_str());
+    }
     if (pSE->HasPilot()) {
         std::string msg2 = "You have been bumped by ";
-        msg2 += mySE->GetPilot()->GetName();
+        msg2 += (mySE->HasPilot() ? mySE->GetPilot()->GetName() : mySE->GetName());
         pSE->GetPilot()->SendNotifyMsg(msg2.c_str());
     }
 }
@@ -695,6 +669,9 @@ void DestinyManager::Bounce(GVector direction, float speed)
 
 // main movement method
 void DestinyManager::MoveObject() {
+    // a ball moving again this tic must finish its first move before it may start another
+    FlushBall();
+
     if (mySE->SysBubble() == nullptr)
         mySE->SystemMgr()->AddEntity(mySE);
 
@@ -880,23 +857,43 @@ void DestinyManager::MoveObject() {
     }
 
     //set speed, direction and position for this round of movement
+    m_moveStamp = timeStamp;
+    if (m_inTic and mySE->SystemMgr()->GetBallStore().QueueMove(this, m_position, m_shipHeading, speed))
+        return;     // moved along with the rest of the system at end of tic.  BallStore calls EndBallMove()
+
     m_velocity = m_shipHeading * speed;
     SetPosition(m_position + m_velocity, sConfig.debug.PositionHack);   // (PositionHack == true) here will force position update to client
+    EndMove();
+}
 
+void DestinyManager::FlushBall() {
+    if (m_ballStore != nullptr)
+        m_ballStore->Flush(this);
+}
+
+void DestinyManager::EndBallMove(const GPoint& position, const GVector& velocity) {
+    m_velocity = velocity;
+    SetPosition(position, sConfig.debug.PositionHack);   // (PositionHack == true) here will force position update to client
+    EndMove();
+}
+
+void DestinyManager::EndMissileMove(const GPoint& position, const GVector& velocity, const GVector& heading) {
+    m_shipHeading = heading;
+    m_velocity = velocity;
+    SetPosition(position);
+}
+
+void DestinyManager::EndMove() {
     if (is_log_enabled(DESTINY__MOVE_DEBUG))
         _log(DESTINY__MOVE_DEBUG, "Destiny::MoveObject() - %s(%u) Pos:%.2f,%.2f,%.2f  Vel:%.3f,%.3f,%.3f  Head:%.3f,%.3f,%.3f", \
             mySE->GetName(), mySE->GetID(), m_position.x, m_position.y, m_position.z, m_velocity.x, m_velocity.y, m_velocity.z,\
             m_shipHeading.x, m_shipHeading.y, m_shipHeading.z);
 
-    if (sConfig.cosmic.BumpEnabled)
-        if (mySE->HasPilot() and mySE->SysBubble()->HasPlayers()) // no players in bubble = nothing to check against (for now)
-            CheckBump();
-
     if (sEntityList.GetTracking()) {
         // create jetcan to visualize object movement
         std::string str = mySE->GetName();
         str += "  ";
-        str += itoa(timeStamp);
+        str += itoa(m_moveStamp);
         ItemData idata(23, ownerSystem, mySE->GetLocationID(), flagNone, str.c_str(), m_position, "Position Test");
         CargoContainerRef iRef = CargoContainer::SpawnTemp(idata);
         if (iRef.get() != nullptr) {
@@ -1900,6 +1897,7 @@ void DestinyManager::GotoPoint(const GPoint& point) {
 }
 
 void DestinyManager::WarpTo(const GPoint& where, int32 distance/*0*/, bool autoPilot/*false*/, SystemEntity* pSE/*nullptr*/) {
+    FlushBall();
     /* warp order..
      * pick destination -> align/accel -> aura "warp drive active" -> cap drain -> accel
      *      -> enter warp -> warp -> decel -> leave warp -> coast -> stop
@@ -2308,6 +2306,8 @@ void DestinyManager::DockingAccepted()
 
 void DestinyManager::SetPosition(const GPoint &pt, bool update /*false*/) {
     _log(DESTINY__TRACE, "Destiny::SetPosition() called by %s(%u)", mySE->GetName(), mySE->GetID());
+    // if our ball is queued, finish that move first so BallStore will not overwrite this position
+    FlushBall();
 
     if (pt.isZero()) {
         _log(DESTINY__TRACE, "Destiny::SetPosition() - %s(%u) point is zero", mySE->GetName(), mySE->GetID());
@@ -2629,6 +2629,7 @@ void DestinyManager::UpdateNewShip(const ShipItemRef newShipRef) {
         shipItem->SetItem(0, new PyString("OnSlimItemChange"));
         shipItem->SetItem(1, shipData);
     updates.push_back(shipItem);
+    mySE->InvalidateSlimItem();
     SendDestinyUpdate(updates);
 
     UpdateShipVariables();
@@ -2656,6 +2657,7 @@ void DestinyManager::UpdateOldShip(ShipSE* pShipSE)
     PyTuple* shipItem = new PyTuple(2);
         shipItem->SetItem(0, new PyString("OnSlimItemChange"));
         shipItem->SetItem(1, shipData);
+    pShipSE->InvalidateSlimItem();
     SendSingleDestinyUpdate(&shipItem);   // consumed
 
     SendBallInteractive(pShipSE->GetShipItemRef(), false);
@@ -2690,6 +2692,7 @@ void DestinyManager::UnCloak() {
 
 void DestinyManager::TractorBeamStart(SystemEntity* pShipSE, EvilNumber speed)
 {
+    FlushBall();
     /** @todo  need to update this */
     m_ballMode = Destiny::Ball::Mode::FOLLOW;
 
@@ -3101,6 +3104,8 @@ void DestinyManager::SendDestinyUpdate( std::vector<PyTuple*>& updates, std::vec
     // this check shouldnt be needed...
     if (!mySE->SystemMgr()->IsLoaded())
         return;
+    // whatever clients are told here, our cached ball is now outdated
+    mySE->InvalidateDestiny();
     if (self_only) {
         if (!mySE->HasPilot()) {
             // this entity is NOT a player ship...change to BubbleCast (or silently fail)
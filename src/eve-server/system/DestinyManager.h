@@ -93,13 +93,19 @@ namespace Destiny {
 
 //this object manages an entity's position and movement in a system.
 
+class BallStore;
+
 class DestinyManager {
+    friend class BallStore;     // to hand batched moves back
 public:
     DestinyManager(SystemEntity* self);
     ~DestinyManager();
 
     void Process();
 
+    /* finishes this tic's move now, if our ball is queued in BallStore */
+    void FlushBall();
+
     void SendSingleDestinyEvent(PyTuple** ev, bool self_only=false) const;
     void SendSingleDestinyUpdate(PyTuple** up, bool self_only=false) const;
     void SendDestinyUpdate(std::vector<PyTuple*> &updates, bool self_only=false) const;
@@ -123,6 +129,8 @@ public:
     void SetPosition(const GPoint& pt, bool update = false);
     void SetMaxVelocity(float maxVelocity);
     void UpdateShipVariables();
+    // called by SystemBubble::ProcessBumps() when this ball comes into contact with another
+    void Bump(SystemEntity* pSE);
 
     /* Global Actions */
     void Stop();
@@ -302,10 +310,17 @@ protected:
 private:
     bool m_changeDelay;                 // this is to try to sync destiny with client, as client has a delay when changing destiny states.
 
+    // Batched movement (see BallStore)
+    bool m_inTic;                       // set while Process() runs; only moves made by our own tic are batched
+    BallStore* m_ballStore;             // store our ball is queued in for this tic, if any.  we do not own this
+    size_t m_ballIdx;                   // index of our ball in m_ballStore
+    bool m_ballMissile;                 // our ball is in missile group of m_ballStore
+    double m_moveStamp;                 // seconds into current move, kept for EndMove()
+    void EndBallMove(const GPoint& position, const GVector& velocity);
+    void EndMissileMove(const GPoint& position, const GVector& velocity, const GVector& heading);
+    void EndMove();                     //common code after a ship has moved
+
     // Internal Collision Methods   -allan Nov 2015
-    bool m_bump;
-    void CheckBump();                              //iterate thru objects in current bubble to check for collisions
-    void Bump(SystemEntity* who);                  //math methods for determining direction and speed of bumped ships
     void Bounce(GVector direction, float speed);   //packet sending for ships after bounce
 
     // Internal Turn Methods    -allan  Aug - Oct, 2015
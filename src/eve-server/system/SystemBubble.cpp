@@ -396,6 +396,83 @@ void SystemBubble::GetPlayers(std::vector<Client*> &into) const {
         into.push_back(cur.second);
 }
 
+void SystemBubble::FindContacts(std::vector<BumpContact>& into)
+{
+    /* sweep and prune along x axis.
+     *  balls are sorted by the low end of their x extent, then swept in that order while keeping
+     *  the balls whose extent still overlaps the current one.  only those pairs get the y/z and distance checks.
+     */
+    m_bumpBalls.clear();
+    DestinyManager* pDestiny(nullptr);
+    for (auto cur : m_dynamicEntities) {
+        SystemEntity* pSE(cur.second);
+        if (!pSE->IsShipSE() and !pSE->IsNPCSE() and !pSE->IsDroneSE() and !pSE->IsContainerSE())
+            continue;
+        pDestiny = pSE->DestinyMgr();
+        if ((pDestiny == nullptr) or pDestiny->IsWarping() or pDestiny->IsCloaked())
+            continue;
+        BumpExtent ext;
+            ext.radius = pSE->GetRadius();
+            ext.lo = pSE->GetPosition().x - ext.radius - BUMP_DISTANCE / 2.0;
+            ext.hi = pSE->GetPosition().x + ext.radius + BUMP_DISTANCE / 2.0;
+            ext.pSE = pSE;
+        m_bumpBalls.push_back(ext);
+    }
+    if (m_bumpBalls.size() < 2)
+        return;
+
+    std::sort(m_bumpBalls.begin(), m_bumpBalls.end());
+
+    double reach(0);
+    for (size_t i = 0; i < m_bumpBalls.size(); ++i) {
+        const BumpExtent& cur = m_bumpBalls[i];
+        const GPoint& pos = cur.pSE->GetPosition();
+        bool moving(cur.pSE->DestinyMgr()->IsMoving());
+        for (size_t j = i + 1; j < m_bumpBalls.size(); ++j) {
+            const BumpExtent& oth = m_bumpBalls[j];
+            if (oth.lo > cur.hi)
+                break;      // sorted by lo; no later ball overlaps cur on x
+            if (!moving and !oth.pSE->DestinyMgr()->IsMoving())
+                continue;
+            const GPoint& othPos = oth.pSE->GetPosition();
+            reach = cur.radius + oth.radius + BUMP_DISTANCE;
+            if ((fabs(pos.y - othPos.y) >= reach) or (fabs(pos.z - othPos.z) >= reach))
+                continue;
+            if (pos.distance(othPos) >= reach)
+                continue;
+
+            BumpContact contact;
+            if (cur.pSE->DestinyMgr()->GetSpeed() >= oth.pSE->DestinyMgr()->GetSpeed()) {
+                contact.a = cur.pSE;
+                contact.b = oth.pSE;
+            } else {
+                contact.a = oth.pSE;
+                contact.b = cur.pSE;
+            }
+            into.push_back(contact);
+        }
+    }
+}
+
+void SystemBubble::ProcessBumps()
+{
+    m_bumpContacts.clear();
+    FindContacts(m_bumpContacts);
+
+    // only pairs not already in contact at last check are bumped, so each bump is sent once
+    std::unordered_set<uint64_t> pairs;
+    uint32 idA(0), idB(0);
+    for (auto cur : m_bumpContacts) {
+        idA = cur.a->GetID();
+        idB = cur.b->GetID();
+        uint64_t key = (idA < idB ? ((uint64_t)idA << 32) | idB : ((uint64_t)idB << 32) | idA);
+        pairs.insert(key);
+        if (m_bumpPairs.find(key) == m_bumpPairs.end())
+            cur.a->DestinyMgr()->Bump(cur.b);
+    }
+    m_bumpPairs.swap(pairs);
+}
+
 SystemEntity* SystemBubble::GetRandomEntity()
 {
     // this is used for idle npc's as a orbit target while waiting for something to pewpew
@@ -546,9 +623,9 @@ void SystemBubble::SendAddBalls(SystemEntity* to_who) {
             if (cur.second->DestinyMgr()->IsCloaked())
                 continue;
         if (!cur.second->IsMissileSE() or !cur.second->IsFieldSE())
-            addballs.damageDict[cur.first] = cur.second->MakeDamageState();
-        addballs.slims->AddItem( new PyObject( "foo.SlimItem", cur.second->MakeSlimItem() ) );
-        cur.second->EncodeDestiny( *destinyBuffer );
+            addballs.damageDict[cur.first] = cur.second->GetDamageState();
+        addballs.slims->AddItem( new PyObject( "foo.SlimItem", cur.second->GetSlimItem() ) );
+        cur.second->GetDestiny( *destinyBuffer );
     }
 
     if (addballs.slims->empty()) {
@@ -594,14 +671,14 @@ void SystemBubble::SendAddBalls2( SystemEntity* to_who ) {
 
     for (auto cur : m_dynamicEntities) {
         if (cur.second->IsMissileSE() or cur.second->IsContainerSE()) {
-            addballs2.extraBallData->AddItem(cur.second->MakeSlimItem());
+            addballs2.extraBallData->AddItem(cur.second->GetSlimItem());
         } else {
             PyTuple* balls = new PyTuple(2);
-                balls->SetItem(0, cur.second->MakeSlimItem());
-                balls->SetItem(1, cur.second->MakeDamageState());
+                balls->SetItem(0, cur.second->GetSlimItem());
+                balls->SetItem(1, cur.second->GetDamageState());
             addballs2.extraBallData->AddItem(balls);
         }
-        cur.second->EncodeDestiny(*destinyBuffer);
+        cur.second->GetDestiny(*destinyBuffer);
     }
 
     if (addballs2.extraBallData->size() < 1) {
@@ -644,13 +721,13 @@ void SystemBubble::AddBallExclusive( SystemEntity* pSE ) {
 
     AddBalls addballs;
     //encode destiny binary
-    pSE->EncodeDestiny( *destinyBuffer );
+    pSE->GetDestiny( *destinyBuffer );
     addballs.state = new PyBuffer( &destinyBuffer );
 	//encode damage state
-    addballs.damageDict[ pSE->GetID() ] = pSE->MakeDamageState();
+    addballs.damageDict[ pSE->GetID() ] = pSE->GetDamageState();
 	//encode SlimItem
     addballs.slims = new PyList();
-    addballs.slims->AddItem( new PyObject( "foo.SlimItem", pSE->MakeSlimItem() ) );
+    addballs.slims->AddItem( new PyObject( "foo.SlimItem", pSE->GetSlimItem() ) );
 
     _log(DESTINY__BUBBLE_TRACE, "SystemBubble::AddBallExclusive() - Adding entity %u to bubble %u", pSE->GetID(), m_bubbleID);
     if (is_log_enabled(DESTINY__BALL_DUMP))
@@ -973,9 +1050,15 @@ void SystemBubble::BubblecastDestinyEvent( PyTuple** payload, const char* desc )
 
 void SystemBubble::BubblecastSendNotification(const char* notifyType, const char* idType, PyTuple** payload, bool seq)
 {
+    std::vector<Client*> cVec;
+    cVec.reserve(m_players.size());
     for (auto cur : m_players) {
         _log( DESTINY__BUBBLECAST, "BubblecastNotify %s to %s(%u)", notifyType, cur.second->GetName(), cur.first );
-        PyIncRef(*payload);
-        cur.second->SendNotification( notifyType, idType, payload, seq );
+        cVec.push_back(cur.second);
     }
+
+    // Multicast() consumes its payload, but caller keeps ownership of ours
+    PyIncRef(*payload);
+    PyTuple* tmp(*payload);
+    sEntityList.Multicast(cVec, notifyType, idType, &tmp, seq);
 }
@@ -43,6 +43,12 @@ class TowerSE;
 class DroneSE;
 class PyObject;
 
+/* pair of massive balls in contact.  'a' is the faster moving one */
+struct BumpContact {
+    SystemEntity* a;
+    SystemEntity* b;
+};
+
 class SystemBubble {
 public:
     SystemBubble(SystemManager* pSystem, const GPoint& center, double radius);
@@ -142,6 +148,13 @@ public:
     /* for system setstate */
     PyObject* GetDroneState() const;
 
+    /* for collision detection.  called once per tic by SystemManager */
+    // lists pairs of massive balls (ships, npcs, drones, containers) closer than BUMP_DISTANCE, hull to hull.
+    //  each pair is listed once, and at least one ball of each pair is moving.
+    void FindContacts(std::vector<BumpContact>& into);
+    // calls Bump() for each pair which has come into contact since last call
+    void ProcessBumps();
+
     /* for command .syncloc - updates all players in bubble with positions of all dSE */
     void SyncPos();
     /* for command dropLoot - commands all npcs in bubble to jettison loot */
@@ -176,6 +189,18 @@ private:
     std::map<uint32, SystemEntity*> m_entities;         //we do not own these.
     std::map<uint32, DroneSE*> m_drones;                //we do not own these.
 
+    // for collision detection
+    struct BumpExtent {
+        double lo;          // x extent of ball, including half of bump distance
+        double hi;
+        double radius;
+        SystemEntity* pSE;
+        bool operator<(const BumpExtent& oth) const     { return lo < oth.lo; }
+    };
+    std::vector<BumpExtent> m_bumpBalls;                // sorted by lo.  kept between tics to save allocations
+    std::vector<BumpContact> m_bumpContacts;
+    std::unordered_set<uint64_t> m_bumpPairs;           // pairs (lower itemID << 32 | higher itemID) in contact at last check
+
     // for spawn system     -allan 15July15
     Timer m_spawnTimer;
     bool m_ice :1;
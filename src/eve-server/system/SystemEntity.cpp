@@ -55,7 +55,12 @@ m_system(system),
 m_bubble(nullptr),
 m_destiny(nullptr),
 m_targMgr(nullptr),
-m_killed(false)
+m_killed(false),
+m_slimCache(nullptr),
+m_damageCache(nullptr),
+m_slimStamp(0),
+m_damageStamp(0),
+m_destinyStamp(0)
 {
     assert(m_system != nullptr);
     assert(m_self.get() != nullptr);
@@ -73,6 +78,12 @@ m_killed(false)
     _log(SE__DEBUG, "Created SE for item %s (%u) with radius of %.1f.", self->name(), self->itemID(), m_radius);
 }
 
+SystemEntity::~SystemEntity()
+{
+    PySafeDecRef(m_slimCache);
+    PySafeDecRef(m_damageCache);
+}
+
 void SystemEntity::Process() {
     if (m_killed) {
         _log(SE__DEBUG, "SE::Process() - %s(%u) is dead but still in system.", m_self->name(), m_self->itemID());
@@ -96,6 +107,103 @@ PyTuple* SystemEntity::MakeDamageState() {
     return ddds.Encode();
 }
 
+void SystemEntity::SetPosition(const GPoint &pos) {
+    m_self->SetPosition(pos);
+    InvalidateDestiny();
+    // keep our system's entity grid current
+    if (m_system != nullptr)
+        m_system->MoveEntity(this);
+}
+
+/* encode cache
+ * bubble joins send slim item, damage state and destiny ball of every entity in bubble to the newcomer,
+ *  and the newcomer's to everyone there.  these are built once and shared until something changes them.
+ * slim and damage are immutable PyReps handed out by ref, destiny is a copy of the ball bytes.
+ * - destiny is invalidated by SetPosition() and any destiny update sent for this entity.
+ *    for mobile entities it is only kept within the stamp it was built, as their balls change every tick.
+ * - slim is invalidated by slim changes sent to clients, and kept at most SLIM_MAX_AGE stamps
+ * - damage is invalidated by SendDamageStateChanged(), and kept at most DAMAGE_MAX_AGE stamps.
+ *    a slightly old state is ok here, as client extrapolates shield from its timestamp and recharge
+ */
+static const uint32 SLIM_MAX_AGE = 60;
+static const uint32 DAMAGE_MAX_AGE = 5;
+
+// systems tick on several threads, so these are shared by all of them
+static std::atomic<uint64_t> s_slimHits(0), s_slimMisses(0);
+static std::atomic<uint64_t> s_damageHits(0), s_damageMisses(0);
+static std::atomic<uint64_t> s_destinyHits(0), s_destinyMisses(0);
+
+PyDict* SystemEntity::GetSlimItem() {
+    uint32 stamp = sEntityList.GetStamp();
+    if ((m_slimCache != nullptr) and (stamp - m_slimStamp < SLIM_MAX_AGE)) {
+        ++s_slimHits;
+        PyIncRef(m_slimCache);
+        return m_slimCache;
+    }
+    ++s_slimMisses;
+    PySafeDecRef(m_slimCache);
+    m_slimCache = MakeSlimItem();
+    m_slimStamp = stamp;
+    PyIncRef(m_slimCache);
+    return m_slimCache;
+}
+
+PyTuple* SystemEntity::GetDamageState() {
+    uint32 stamp = sEntityList.GetStamp();
+    if ((m_damageCache != nullptr) and (stamp - m_damageStamp < DAMAGE_MAX_AGE)) {
+        ++s_damageHits;
+        PyIncRef(m_damageCache);
+        return m_damageCache;
+    }
+    ++s_damageMisses;
+    PySafeDecRef(m_damageCache);
+    m_damageCache = MakeDamageState();
+    m_damageStamp = stamp;
+    PyIncRef(m_damageCache);
+    return m_damageCache;
+}
+
+void SystemEntity::GetDestiny(Buffer& into) {
+    uint32 stamp = sEntityList.GetStamp();
+    if ((m_destinyStamp != 0) and ((m_destiny == nullptr) or (m_destinyStamp == stamp))) {
+        ++s_destinyHits;
+        into.AppendSeq(m_destinyCache.begin(), m_destinyCache.end());
+        return;
+    }
+    ++s_destinyMisses;
+    size_t start = into.size();
+    EncodeDestiny(into);
+    m_destinyCache.clear();
+    if (into.size() > start)
+        m_destinyCache.assign(&into[start], &into[start] + (into.size() - start));
+    m_destinyStamp = stamp;
+}
+
+void SystemEntity::InvalidateSlimItem() {
+    if (m_slimCache == nullptr)
+        return;
+    PyDecRef(m_slimCache);
+    m_slimCache = nullptr;
+}
+
+void SystemEntity::InvalidateDamageState() {
+    if (m_damageCache == nullptr)
+        return;
+    PyDecRef(m_damageCache);
+    m_damageCache = nullptr;
+}
+
+void SystemEntity::PrintCacheStats() {
+    uint64_t hits[3] = {s_slimHits, s_damageHits, s_destinyHits};
+    uint64_t misses[3] = {s_slimMisses, s_damageMisses, s_destinyMisses};
+    const char* names[3] = {"SlimItem", "DamageState", "Destiny"};
+    for (uint8 i = 0; i < 3; ++i) {
+        uint64_t total = hits[i] + misses[i];
+        sLog.Blue("     Encode Cache", "%-11s - %lu hits, %lu misses (%.1f%% hit rate)",
+                  names[i], hits[i], misses[i], (total > 0 ? hits[i] * 100.0 / total : 0.0));
+    }
+}
+
 void SystemEntity::MakeDamageState(DoDestinyDamageState &into) {
     into.shield = 1;
     into.recharge = 110000;
@@ -170,6 +278,7 @@ void SystemEntity::SendDamageStateChanged() {  //working 24Apr15
         dmgChange.entityID = m_self->itemID();
         dmgChange.state = dmgState.Encode();
     PyTuple *up = dmgChange.Encode();
+    InvalidateDamageState();
     if (m_targMgr != nullptr)
         m_targMgr->QueueUpdate(&up);
     PySafeDecRef(up);
@@ -81,7 +81,7 @@ class SystemEntity {
     friend class SystemBubble;    /* only to update m_bubble */
 public:
     SystemEntity(InventoryItemRef self, PyServiceMgr &services, SystemManager* system);
-    virtual ~SystemEntity()                             { /* do nothing here */ }
+    virtual ~SystemEntity();
 
     /* Process Calls - Overridden as needed in derived classes */
     virtual void                Process();
@@ -202,7 +202,7 @@ public:
     uint32                      GetLocationID()         { return m_self->locationID(); }
     const char*                 GetName() const         { return m_self->name(); }
     const GPoint&               GetPosition() const     { return m_self->position(); }
-    void                  SetPosition(const GPoint &pos){ m_self->SetPosition(pos); }
+    void                        SetPosition(const GPoint &pos);
     inline double               x()                     { return m_self->position().x; }
     inline double               y()                     { return m_self->position().y; }
     inline double               z()                     { return m_self->position().z; }
@@ -214,7 +214,7 @@ public:
     void                        SetFleetID(uint32 set)  { m_fleetID = set; }
 
     int8                        GetHarmonic()           { return m_harmonic; }
-    void                        SetHarmonic(int8 set)   { m_harmonic = set; }
+    void                        SetHarmonic(int8 set)   { m_harmonic = set; InvalidateDestiny(); InvalidateSlimItem(); }
 
 
     /* public generic functions handled in base class. */
@@ -225,6 +225,15 @@ public:
     double                      DistanceTo2(const SystemEntity* other);
     PyTuple*                    MakeDamageState();
 
+    /* cached encodings, shared by every bubble join until invalidated.  see SystemEntity.cpp */
+    PyDict*                     GetSlimItem();          // returns new ref
+    PyTuple*                    GetDamageState();       // returns new ref
+    void                        GetDestiny(Buffer& into);
+    void                        InvalidateSlimItem();
+    void                        InvalidateDamageState();
+    void                        InvalidateDestiny()     { m_destinyStamp = 0; }
+    static void                 PrintCacheStats();
+
     /* public specific functions handled in base class. */
     virtual void                Abandon();
 
@@ -275,6 +284,15 @@ protected:
     uint32                      m_fleetID;
     uint32                      m_ownerID;
 
+private:
+    /* cached encodings.  stamp is sEntityList.GetStamp() when built, 0 when invalid */
+    PyDict*                     m_slimCache;
+    PyTuple*                    m_damageCache;
+    std::vector<uint8>          m_destinyCache;
+    uint32                      m_slimStamp;
+    uint32                      m_damageStamp;
+    uint32                      m_destinyStamp;
+
 };
 
 
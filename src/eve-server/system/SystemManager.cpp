@@ -72,6 +72,8 @@ m_players(0),
 m_beltCount(0),
 m_gateCount(0),
 m_activityTime(0),
+m_ticTime(0.0),
+m_entityGrid(ENTITY_GRID_CELL_METERS),
 m_activeRatSpawns(0),
 m_activeGateSpawns(0),
 m_activeRoidSpawns(0),
@@ -212,6 +214,9 @@ bool SystemManager::ProcessTic() {
      *  std::map internally orders items by key(itemID here), so use an int var to hold last-processed itemID (mLast).
      *  when iteration starts over, increment until cur > mLast and continue from there to end of list.
      */
+    if (sConfig.cosmic.BatchedMovement)
+        m_ballStore.Begin();
+
     std::map<uint32, SystemEntity*>::iterator itr = m_ticEntities.begin();
     uint32 mLast(0);
     while (itr != m_ticEntities.end()) {
@@ -232,6 +237,14 @@ bool SystemManager::ProcessTic() {
         ++itr;
     }
 
+    // move balls queued during the loop in one pass
+    if (m_ballStore.IsOpen())
+        m_ballStore.End();
+
+    // all balls have moved for this tic; check for collisions
+    if (sConfig.cosmic.BumpEnabled)
+        ProcessBumps();
+
     // check bounty timer
     if (m_bountyTimer.Check(sConfig.server.BountyPayoutDelayed))
         PayBounties();
@@ -249,12 +262,26 @@ bool SystemManager::ProcessTic() {
             cur.second->Process();
     }
 
+    m_ticTime = GetTimeUSeconds() - profileStartTime;
     if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::system, GetTimeUSeconds() - profileStartTime);
+        sProfiler.AddTime(Profile::system, m_ticTime);
 
     return SystemActivity();
 }
 
+void SystemManager::ProcessBumps() {
+    double profileStartTime = GetTimeUSeconds();
+
+    m_bumpBubbles.clear();
+    sBubbleMgr.GetBubbles(m_data.systemID, m_bumpBubbles);
+    for (auto cur : m_bumpBubbles)
+        if (cur->HasPlayers())  // no players in bubble = nobody to tell about bumps
+            cur->ProcessBumps();
+
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::collision, GetTimeUSeconds() - profileStartTime);
+}
+
 bool SystemManager::SystemActivity() {
     if (m_activityTime == 0)
         return true;
@@ -290,6 +317,7 @@ void SystemManager::UnloadSystem() {
             continue;
         }
         pSE = itr->second;
+        m_entityGrid.Remove(pSE);
 
         if (pSE->TargetMgr() != nullptr)
             pSE->TargetMgr()->Unload();
@@ -324,6 +352,7 @@ void SystemManager::UnloadSystem() {
     m_npcs.clear();
     // at this point, system entity list should be clear...but just in case, hit it again
     m_entities.clear();
+    m_entityGrid.Clear();
     // this is dupe container. contents unloaded in another call
     m_ticEntities.clear();
     // at this point, system static entity list should be clear...but just in case, hit it again
@@ -351,6 +380,7 @@ bool SystemManager::LoadSystemStatics() {
     std::vector<DBSystemEntity> entities;
     entities.clear();
     m_entities.clear();
+    m_entityGrid.Clear();
     m_staticEntities.clear();
     if (!SystemDB::LoadSystemStaticEntities(m_data.systemID, entities)) {
         sLog.Error( "SystemManager::LoadSystemStatics()", "Unable to load celestial entities during boot of %s(%u).", m_data.name.c_str(), m_data.systemID);
@@ -422,6 +452,7 @@ bool SystemManager::LoadSystemStatics() {
             _log(INV__WARNING, "SystemManager::LoadSystemStatics() - Failed to load additional data for entity %u. Continuing.", cur.itemID);
 
         m_entities[cur.itemID] = pSE;
+        m_entityGrid.Insert(pSE, pSE->GetPosition());
         m_staticEntities[cur.itemID] = pSE;
         AddItemToInventory(pSE->GetSelf());
     }
@@ -988,6 +1019,7 @@ void SystemManager::AddEntity(SystemEntity* pSE, bool addSignal/*true*/) {
     } else {
         _log(ITEM__TRACE, "%s(%u): Added to system manager for %s(%u)", pSE->GetName(), itemID, m_data.name.c_str(), m_data.systemID);
         m_entities[itemID] = pSE;
+        m_entityGrid.Insert(pSE, pSE->GetPosition());
 
         if ((pSE->GetCategoryID() == EVEDB::invCategories::SovereigntyStructure)
          or (pSE->IsCOSE())
@@ -1020,6 +1052,9 @@ void SystemManager::RemoveEntity(SystemEntity* pSE) {
     /** @note  this does not remove static balls (bubble center markers) and no clue why */
     if (pSE == nullptr)
         return;
+    // finish this tic's move while entity is still ours
+    if (pSE->DestinyMgr() != nullptr)
+        pSE->DestinyMgr()->FlushBall();
     sBubbleMgr.Remove(pSE);
     // Remove Entity's Item Ref from Solar System Dynamic Inventory:
     RemoveItemFromInventory(pSE->GetSelf());
@@ -1038,6 +1073,7 @@ void SystemManager::AddMarker(SystemEntity* pSE, bool sendBall/*false*/, bool ad
         return;
 
     m_entities[pSE->GetID()] = pSE;
+    m_entityGrid.Insert(pSE, pSE->GetPosition());
     // Add Entity's Item Ref to Solar System Dynamic Inventory:
     //m_solarSystemRef->AddItemToInventory(pSE->GetSelf());
 
@@ -1368,6 +1404,7 @@ void SystemManager::RemoveItemFromInventory(InventoryItemRef iRef)
     auto itr = m_entities.find(iRef->itemID());
     if (itr != m_entities.end()) {
         _log(ITEM__TRACE, "%s(%u): Removed from system manager for %s(%u)", iRef->name(), iRef->itemID(), m_data.name.c_str(), m_data.systemID);
+        m_entityGrid.Remove(itr->second);
         m_entities.erase(itr);
     } else {
         _log(ITEM__WARNING, "%s(%u): Called RemoveEntity(), but they weren\'t found in system manager for %s(%u)", \
@@ -1460,30 +1497,55 @@ void SystemManager::DScan(int64 range, const GPoint& pos, std::vector<SystemEnti
      * may not be in this version, but check for "scan inhibitor" POS module; ships in it are invis to dscan
      * AttrDScanImmune is from rhea expansion.  may be able to implement here.
      */
-    for (auto cur : m_entities) {
-        // these dont show on dscan
-        if (IsTempItem(cur.first))
-            continue;
-        if (IsAsteroid(cur.first))
-            if (!sConfig.server.AsteroidsOnDScan)
-                continue;
-        if (IsNPC(cur.first))
-            continue;
-        if (cur.second->IsDeployableSE())       // not sure if this is right or not
-            continue;
-        if (cur.second->IsShipSE()) {
-            if (cur.second->GetGroupID() == EVEDB::invGroups::CovertOps)
-                continue;
-            if (cur.second->GetGroupID() == EVEDB::invGroups::CombatRecon)
-                continue;
-        }
-        if (cur.second->DestinyMgr() != nullptr)
-            if (cur.second->DestinyMgr()->IsCloaked())
-                continue;
-        // made it this far.  add item to scan list
-        if (pos.distance(cur.second->GetPosition()) < range)
-            vector.push_back(cur.second);
+    std::vector<SystemEntity*> seVec;
+    m_entityGrid.QueryRadius(pos, range, seVec);
+    for (auto cur : seVec)
+        if (IsDScanVisible(cur))
+            vector.push_back(cur);
+}
+
+void SystemManager::DScan(int64 range, const GPoint& pos, const GVector& dir, double angle, std::vector<SystemEntity*>& vector)
+{
+    std::vector<SystemEntity*> seVec;
+    m_entityGrid.QueryCone(pos, dir, angle, range, seVec);
+    for (auto cur : seVec)
+        if (IsDScanVisible(cur))
+            vector.push_back(cur);
+}
+
+bool SystemManager::IsDScanVisible(SystemEntity* pSE)
+{
+    uint32 itemID(pSE->GetID());
+    // these dont show on dscan
+    if (IsTempItem(itemID))
+        return false;
+    if (IsAsteroid(itemID))
+        if (!sConfig.server.AsteroidsOnDScan)
+            return false;
+    if (IsNPC(itemID))
+        return false;
+    if (pSE->IsDeployableSE())       // not sure if this is right or not
+        return false;
+    if (pSE->IsShipSE()) {
+        if (pSE->GetGroupID() == EVEDB::invGroups::CovertOps)
+            return false;
+        if (pSE->GetGroupID() == EVEDB::invGroups::CombatRecon)
+            return false;
     }
+    if (pSE->DestinyMgr() != nullptr)
+        if (pSE->DestinyMgr()->IsCloaked())
+            return false;
+    return true;
+}
+
+void SystemManager::GetEntitiesInRange(const GPoint& pos, double range, std::vector<SystemEntity*>& vector) const
+{
+    m_entityGrid.QueryRadius(pos, range, vector);
+}
+
+void SystemManager::MoveEntity(SystemEntity* pSE)
+{
+    m_entityGrid.Move(pSE, pSE->GetPosition());
 }
 
 PyRep* SystemManager::GetCurrentEntities()
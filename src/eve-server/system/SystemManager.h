@@ -31,6 +31,8 @@
 #include "system/BubbleManager.h"
 #include "system/SolarSystem.h"
 #include "system/SystemDB.h"
+#include "system/BallStore.h"
+#include "math/SpatialGrid.h"
 
 
 class PyRep;
@@ -51,6 +53,9 @@ class DungeonMgr;
 class SpawnMgr;
 class PyServiceMgr;
 
+// cell size of the grid of entities.  about the largest npc sight range, so aggro checks see a few cells
+static const double ENTITY_GRID_CELL_METERS = 50000.0;
+
 class DynamicEntityFactory {
 public:
     // you MUST call (your SystemManager)->AddEntity([this returned object]) after this to actually put the entity in space
@@ -69,6 +74,10 @@ public:
     void UpdateData();          // called from EntityList every 5m for active systems
 
     bool IsLoaded()                                     { return m_loaded; }
+    // duration of last ProcessTic() call, in microseconds
+    double GetTicTime() const                           { return m_ticTime; }
+    // balls moved during ProcessTic() when batched movement is enabled
+    BallStore& GetBallStore()                           { return m_ballStore; }
 
     SystemEntity* GetSE(uint32 entityID) const;
     NPC* GetNPCSE(uint32 entityID) const;
@@ -142,6 +151,12 @@ public:
 
     // this returns entities in range for display on dscan.
     void DScan(int64 range, const GPoint& pos, std::vector< SystemEntity* >& vector);
+    // this returns entities in range and inside cone of given half angle (in radians) for display on dscan.
+    void DScan(int64 range, const GPoint& pos, const GVector& dir, double angle, std::vector< SystemEntity* >& vector);
+    // this returns all entities within range of pos, using the entity grid
+    void GetEntitiesInRange(const GPoint& pos, double range, std::vector< SystemEntity* >& vector) const;
+    // updates position of pSE in entity grid.  called by SystemEntity::SetPosition()
+    void MoveEntity(SystemEntity* pSE);
     // this returns entities in system for display on Groove's Entity Map in client
     PyRep* GetCurrentEntities();
     // this returns entities in system for display on ship scanner when enabled.
@@ -209,6 +224,7 @@ private:
     bool SystemActivity();
     uint16 m_players;           // current total count
     uint32 m_activityTime;
+    double m_ticTime;
 
     // system entity lists:
     bool m_entityChanged :1;
@@ -217,6 +233,15 @@ private:
     std::map<uint32, SystemEntity*> m_entities;         // this list is all entities in this system.  we own these.
     std::map<uint32, SystemEntity*> m_ticEntities;      // this list is for entities that need process tics (objects, npc, client ships)
     std::map<uint32, SystemEntity*> m_staticEntities;   // this list is for static entities to send in setstate
+    SpatialGrid<SystemEntity> m_entityGrid;             // all entities in m_entities, by position
+    BallStore m_ballStore;
+
+    // finds and bumps balls in contact, in every bubble with players
+    void ProcessBumps();
+    std::vector<SystemBubble*> m_bumpBubbles;           // kept between tics to save allocations
+
+    // true if entity would show on dscan
+    bool IsDScanVisible(SystemEntity* pSE);
 
     // for bounty processing (20m timer)
     Timer m_bountyTimer;
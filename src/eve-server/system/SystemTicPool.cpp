@@ -0,0 +1,176 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+
+#include "eve-server.h"
+
+#include "system/SystemManager.h"
+#include "system/SystemTicPool.h"
+
+/* set while a thread runs ProcessTic() for the pool */
+static thread_local bool s_inTic = false;
+
+SystemTicPool::SystemTicPool()
+: mRunning( false ),
+  mBatch( 0 ),
+  mActive( 0 ),
+  mNext( 0 ),
+  mSystems( nullptr ),
+  mResults( nullptr )
+{
+    pthread_mutex_init( &mMutex, nullptr );
+    pthread_cond_init( &mStart, nullptr );
+    pthread_cond_init( &mDone, nullptr );
+}
+
+SystemTicPool::~SystemTicPool()
+{
+    Shutdown();
+
+    pthread_cond_destroy( &mDone );
+    pthread_cond_destroy( &mStart );
+    pthread_mutex_destroy( &mMutex );
+}
+
+bool SystemTicPool::Initialize( uint8 threads )
+{
+    // the calling thread processes systems too
+    if (threads < 2)
+        return false;
+
+    // pool threads start waiting for batch 1
+    mBatch = 0;
+    mRunning = true;
+    for (uint8 i = 1; i < threads; ++i) {
+        pthread_t thread;
+        if (pthread_create( &thread, nullptr, WorkerThread, this ) != 0) {
+            sLog.Error( "    SystemTicPool", "Failed to start pool thread %u.", i );
+            break;
+        }
+        mThreads.push_back( thread );
+    }
+
+    if (mThreads.empty()) {
+        mRunning = false;
+        return false;
+    }
+
+    return true;
+}
+
+void SystemTicPool::Shutdown()
+{
+    if (mThreads.empty())
+        return;
+
+    pthread_mutex_lock( &mMutex );
+    mRunning = false;
+    pthread_cond_broadcast( &mStart );
+    pthread_mutex_unlock( &mMutex );
+
+    for (auto cur : mThreads)
+        pthread_join( cur, nullptr );
+    mThreads.clear();
+}
+
+bool SystemTicPool::InTic()
+{
+    return s_inTic;
+}
+
+void SystemTicPool::Run( std::vector<SystemManager*>& systems, std::vector<uint8>& results )
+{
+    results.assign( systems.size(), 1 );
+    if (systems.empty())
+        return;
+
+    // slowest first, so no thread picks up a busy system at the end of the tic
+    std::stable_sort( systems.begin(), systems.end(),
+        [] ( const SystemManager* a, const SystemManager* b ) { return a->GetTicTime() > b->GetTicTime(); } );
+
+    pthread_mutex_lock( &mMutex );
+    mSystems = &systems;
+    mResults = &results;
+    mNext = 0;
+    mActive = mThreads.size();
+    ++mBatch;
+    pthread_cond_broadcast( &mStart );
+    pthread_mutex_unlock( &mMutex );
+
+    Work();
+
+    pthread_mutex_lock( &mMutex );
+    while (mActive > 0)
+        pthread_cond_wait( &mDone, &mMutex );
+    mSystems = nullptr;
+    mResults = nullptr;
+    pthread_mutex_unlock( &mMutex );
+}
+
+void SystemTicPool::Work()
+{
+    s_inTic = true;
+    // queued (write-behind) writes are queued by EntityList::RunDeferred() after the tic.  other queries run at once
+    sDatabase.BeginDeferWrites();
+    while (true) {
+        pthread_mutex_lock( &mMutex );
+        if (mNext >= mSystems->size()) {
+            pthread_mutex_unlock( &mMutex );
+            break;
+        }
+        const size_t idx(mNext++);
+        pthread_mutex_unlock( &mMutex );
+
+        // each system writes its own result slot
+        (*mResults)[idx] = (*mSystems)[idx]->ProcessTic() ? 1 : 0;
+    }
+    sDatabase.EndDeferWrites();
+    s_inTic = false;
+}
+
+void* SystemTicPool::WorkerThread( void* arg )
+{
+    SystemTicPool* pool = static_cast<SystemTicPool*>( arg );
+
+    uint32 batch(0);
+    pthread_mutex_lock( &pool->mMutex );
+    while (true) {
+        while (pool->mRunning and (pool->mBatch == batch))
+            pthread_cond_wait( &pool->mStart, &pool->mMutex );
+        if (!pool->mRunning)
+            break;
+        batch = pool->mBatch;
+        pthread_mutex_unlock( &pool->mMutex );
+
+        pool->Work();
+
+        pthread_mutex_lock( &pool->mMutex );
+        if (--pool->mActive == 0)
+            pthread_cond_signal( &pool->mDone );
+    }
+    pthread_mutex_unlock( &pool->mMutex );
+
+    return nullptr;
+}
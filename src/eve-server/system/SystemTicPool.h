@@ -0,0 +1,100 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#ifndef __SYSTEM__SYSTEM_TIC_POOL_H__INCL__
+#define __SYSTEM__SYSTEM_TIC_POOL_H__INCL__
+
+class SystemManager;
+
+/**
+ * @brief Worker threads running SystemManager::ProcessTic() of many systems in parallel.
+ *
+ * The calling (main) thread works along with the pool threads and Run() returns
+ * once every system has been processed.  Systems are handed out slowest first
+ * (by the duration of their previous tic), so a tic takes about as long as its
+ * busiest system.
+ *
+ * Anything which must not run concurrently with other systems (unloading systems,
+ * sending to clients of other systems) is queued with EntityList::Defer() while
+ * the pool is running, and run by EntityList once Run() has returned.
+ *
+ * @author EVEmu Team
+ */
+class SystemTicPool
+{
+public:
+    SystemTicPool();
+    ~SystemTicPool();
+
+    /**
+     * @brief Starts pool threads.
+     *
+     * @param[in] threads Number of threads processing systems, including the calling thread.
+     *
+     * @return True if at least one pool thread has been started.
+     */
+    bool Initialize( uint8 threads );
+    /** @brief Stops and joins pool threads. */
+    void Shutdown();
+
+    /** @return True if systems are processed in parallel. */
+    bool IsRunning() const                              { return !mThreads.empty(); }
+    /** @return Number of threads processing systems, including the calling thread. */
+    uint8 GetThreadCount() const                        { return (uint8)(mThreads.size() + 1); }
+
+    /**
+     * @brief Runs ProcessTic() of given systems.
+     *
+     * @param[in]  systems Systems to process; reordered by previous tic duration.
+     * @param[out] results Return value of ProcessTic() for each system (in reordered order).
+     */
+    void Run( std::vector<SystemManager*>& systems, std::vector<uint8>& results );
+
+    /** @return True if the calling thread is currently processing a system for the pool. */
+    static bool InTic();
+
+protected:
+    /** Thread entry point; casts arg to SystemTicPool and runs it. */
+    static void* WorkerThread( void* arg );
+    /** Processes systems of the current batch until none are left. */
+    void Work();
+
+    std::vector<pthread_t> mThreads;
+
+    pthread_mutex_t mMutex;
+    pthread_cond_t mStart;      // signalled when a batch is posted or pool is stopped
+    pthread_cond_t mDone;       // signalled when last worker finishes a batch
+
+    // guarded by mMutex
+    bool mRunning;
+    uint32 mBatch;              // batch counter, so workers run each batch once
+    uint32 mActive;             // pool threads still working on current batch
+    size_t mNext;               // next system to hand out
+
+    std::vector<SystemManager*>* mSystems;
+    std::vector<uint8>* mResults;
+};
+
+#endif /* !__SYSTEM__SYSTEM_TIC_POOL_H__INCL__ */
@@ -0,0 +1,179 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "destiny/BallIntegrator.h"
+
+/*
+ * Moves 10000 balls (8000 ships going somewhere, 2000 missiles chasing targets)
+ * for a number of tics, once with the scalar GPoint/GVector code DestinyManager
+ * uses for single balls, and once with BallIntegrator.
+ *
+ * Positions, velocities and headings of both must match bit for bit; timings of both are printed.
+ */
+
+static const uint32 BALLS = 10000;
+static const uint32 MISSILES = 2000;
+static const uint32 TICS = 100;
+
+struct IntegratorBall
+{
+    GPoint pos;
+    GVector vel;
+    GVector head;
+    GPoint target;      // missiles only
+    float speed;
+};
+
+static double Rand( double lo, double hi )
+{
+    return lo + (hi - lo) * (::rand() / (double)RAND_MAX);
+}
+
+static GVector RandHeading()
+{
+    GVector head( Rand( -1, 1 ), Rand( -1, 1 ), Rand( -1, 1 ) );
+    head.normalize();
+    return head;
+}
+
+/* copies of DestinyManager::MoveObject() and the MISSILE case of DestinyManager::ProcessState() */
+static void ScalarMove( IntegratorBall& ball )
+{
+    ball.vel = ball.head * ball.speed;
+    ball.pos = ball.pos + ball.vel;
+}
+
+static void ScalarMissile( IntegratorBall& ball )
+{
+    GVector moveVector( ball.pos, ball.target );
+    moveVector.normalize();
+    ball.head = moveVector;
+    ball.vel = (moveVector * ball.speed);
+    ball.pos = ball.pos + ball.vel;
+}
+
+static bool Same( const Ga::GaVec3& a, const Ga::GaVec3& b )
+{
+    return ::memcmp( &a.x, &b.x, sizeof( a.x ) ) == 0
+       and ::memcmp( &a.y, &b.y, sizeof( a.y ) ) == 0
+       and ::memcmp( &a.z, &b.z, sizeof( a.z ) ) == 0;
+}
+
+int destiny_BallIntegratorTest( int argc, char* argv[] )
+{
+    ::srand( 42 );
+
+    std::vector<IntegratorBall> balls( BALLS );
+    for (uint32 i = 0; i < BALLS; ++i) {
+        IntegratorBall& ball = balls[i];
+        ball.pos = GPoint( Rand( -3.0e12, 3.0e12 ), Rand( -3.0e12, 3.0e12 ), Rand( -3.0e12, 3.0e12 ) );
+        if (i < MISSILES) {
+            ball.speed = (float)Rand( 2000, 10000 );
+            if (i % 100 == 0) {
+                ball.target = ball.pos;     // target right at missile; heading must not be normalized
+            } else {
+                ball.target = ball.pos + RandHeading() * Rand( 1000, 150000 );
+            }
+        } else {
+            ball.head = RandHeading();
+            ball.speed = (float)Rand( 0, 3000 );
+        }
+    }
+    std::vector<IntegratorBall> batched( balls );
+
+    Destiny::BallIntegrator integrator;
+    integrator.Reserve( BALLS - MISSILES, MISSILES );
+
+    double scalarTime(0), batchTime(0), integrateTime(0);
+    for (uint32 tic = 0; tic < TICS; ++tic) {
+        // some ships turn, some change speed; missile targets drift.  applied the same to both sets
+        for (uint32 i = 0; i < BALLS; ++i) {
+            if (((i + tic) % 7) != 0)
+                continue;
+            if (i < MISSILES) {
+                GVector drift( RandHeading() * 100.0 );
+                balls[i].target += drift;
+                batched[i].target += drift;
+            } else {
+                GVector head( RandHeading() );
+                float speed = (float)Rand( 0, 3000 );
+                balls[i].head = batched[i].head = head;
+                balls[i].speed = batched[i].speed = speed;
+            }
+        }
+
+        double start = GetTimeUSeconds();
+        for (uint32 i = 0; i < BALLS; ++i) {
+            if (i < MISSILES) {
+                ScalarMissile( balls[i] );
+            } else {
+                ScalarMove( balls[i] );
+            }
+        }
+        scalarTime += GetTimeUSeconds() - start;
+
+        start = GetTimeUSeconds();
+        integrator.Clear();
+        for (uint32 i = 0; i < BALLS; ++i) {
+            const IntegratorBall& ball = batched[i];
+            if (i < MISSILES) {
+                integrator.AddMissile( ball.pos, ball.target, ball.speed );
+            } else {
+                integrator.AddMove( ball.pos, ball.head, ball.speed );
+            }
+        }
+        double integrateStart = GetTimeUSeconds();
+        integrator.Integrate();
+        integrateTime += GetTimeUSeconds() - integrateStart;
+        for (uint32 i = 0; i < BALLS; ++i) {
+            IntegratorBall& ball = batched[i];
+            if (i < MISSILES) {
+                ball.pos = integrator.GetMissilePosition( i );
+                ball.vel = integrator.GetMissileVelocity( i );
+                ball.head = integrator.GetMissileHeading( i );
+            } else {
+                ball.pos = integrator.GetMovePosition( i - MISSILES );
+                ball.vel = integrator.GetMoveVelocity( i - MISSILES );
+            }
+        }
+        batchTime += GetTimeUSeconds() - start;
+
+        for (uint32 i = 0; i < BALLS; ++i) {
+            if (!Same( balls[i].pos, batched[i].pos ) or !Same( balls[i].vel, batched[i].vel ) or !Same( balls[i].head, batched[i].head )) {
+                ::printf( "IntegratorBall %u differs at tic %u: scalar %.17g,%.17g,%.17g  batched %.17g,%.17g,%.17g\n", i, tic,
+                          balls[i].pos.x, balls[i].pos.y, balls[i].pos.z, batched[i].pos.x, batched[i].pos.y, batched[i].pos.z );
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    ::printf( "%u tics of %u balls (%u missiles); all positions, velocities and headings match.\n", TICS, BALLS, MISSILES );
+    ::printf( "  scalar:    %8.1f us per tic\n", scalarTime / TICS );
+    ::printf( "  batched:   %8.1f us per tic (%.1f us integrating)\n", batchTime / TICS, integrateTime / TICS );
+
+    return EXIT_SUCCESS;
+}
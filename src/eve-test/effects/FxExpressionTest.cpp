@@ -0,0 +1,234 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "effects/FxExpression.h"
+
+/*
+ * Builds random expression trees out of the operands FX::ParseExpression() knows,
+ * with the leaves effects use (associations, environments, attributes, groups, types),
+ * some of them unknown or empty as the db has them.
+ *
+ * Every tree is parsed, as FxProc does for each item, and compiled, as FxDataMgr does
+ * when effects are loaded, for item and skill sources.  The compiled program, with the
+ * source typeID put in, must give the same modifiers, in the same order.
+ */
+
+static const uint32 TREES = 20000;
+static const uint8 MAX_DEPTH = 6;
+static const uint16 SRC_TYPE_ID = 3300;   // Gunnery
+
+static const int8 INNER_OPS[] = {
+    FX::Operands::GM,    FX::Operands::RSA,   FX::Operands::LG,    FX::Operands::COMBINE,
+    FX::Operands::SRLG,  FX::Operands::ATT,   FX::Operands::EFF,   FX::Operands::GA,
+    FX::Operands::GET,   FX::Operands::IA,    FX::Operands::AIM,   FX::Operands::AGRSM,
+    FX::Operands::AGSM,  FX::Operands::ALGM,  FX::Operands::ALM,   FX::Operands::ALRSM,
+    FX::Operands::AORSM, FX::Operands::RIM,   FX::Operands::RGGM,  FX::Operands::RGSM,
+    FX::Operands::RGORSM, FX::Operands::RGRSM, FX::Operands::RLGM, FX::Operands::RLM,
+    FX::Operands::RLRSM, FX::Operands::RORSM
+};
+
+static const int8 LEAF_OPS[] = {
+    FX::Operands::DEFASSOCIATION, FX::Operands::DEFENVIDX, FX::Operands::DEFATTRIBUTE,
+    FX::Operands::DEFGROUP,       FX::Operands::DEFTYPEID, FX::Operands::GETTYPE,
+    FX::Operands::DEFBOOL,        FX::Operands::SPEEDBOOST, FX::Operands::POWERBOOST,
+    FX::Operands::ADD,            0
+};
+
+static const char* const ASSOCIATIONS[] = {
+    "PreAssignment", "PreMul", "PreDiv", "ModAdd", "ModSub", "PostMul", "PostDiv",
+    "PostPercent", "PostAssignment", "SkillCheck", "AddRate", "SubRate", "Unknown"
+};
+
+static const char* const ENVIRONMENTS[] = {
+    "Self", "Char", "Ship", "Target", "Other", "Area", "Charge", "Unknown"
+};
+
+template<typename T, size_t N>
+static const T& Pick( const T (&from)[N] )
+{
+    return from[ ::rand() % N ];
+}
+
+// adds a random expression tree to exps, and returns its root
+static uint16 AddExpression( ExpressionMap& exps, uint16& nextID, uint8 depth )
+{
+    Expression expression = Expression();
+    expression.id = nextID++;
+
+    if( (depth < MAX_DEPTH) and ((depth == 0) or (::rand() % 3 != 0)) ) {
+        expression.operandID = Pick( INNER_OPS );
+        expression.arg1 = AddExpression( exps, nextID, depth + 1 );
+        // one-argument operands, and references to missing expressions
+        switch( ::rand() % 8 ) {
+            case 0:  expression.arg2 = 0;                 break;
+            case 1:  expression.arg2 = 60000;             break;
+            default: expression.arg2 = AddExpression( exps, nextID, depth + 1 );
+        }
+    } else {
+        expression.operandID = Pick( LEAF_OPS );
+        switch( expression.operandID ) {
+            case FX::Operands::DEFASSOCIATION: expression.expressionValue = Pick( ASSOCIATIONS ); break;
+            case FX::Operands::DEFENVIDX:      expression.expressionValue = Pick( ENVIRONMENTS ); break;
+        }
+        // ids are left empty now and then, as some rows have them
+        if( ::rand() % 5 != 0 ) {
+            expression.expressionAttributeID = 1 + ::rand() % 2000;
+            expression.expressionGroupID = 1 + ::rand() % 1000;
+            expression.expressionTypeID = 1 + ::rand() % 30000;
+        }
+    }
+
+    exps[ expression.id ] = expression;
+    return expression.id;
+}
+
+static void Parse( const ExpressionMap& exps, uint16 expressionID, bool skill, std::vector<fxModifier>& into )
+{
+    fxModifier data = fxModifier();
+    data.action = FX::Action::Invalid;
+    FX::ParseExpression( exps, FX::GetExpression( exps, expressionID ), skill, SRC_TYPE_ID, data, into );
+}
+
+// compiles, then puts in source typeID as FxProc::ExecuteExpression() does
+static void Compile( const ExpressionMap& exps, uint16 expressionID, bool skill, std::vector<fxModifier>& into )
+{
+    fxStep step = fxStep();
+    step.data.action = FX::Action::Invalid;
+    fxProgram program;
+    FX::CompileExpression( exps, expressionID, skill, step, program );
+    for( const fxStep& cur : program ) {
+        into.push_back( cur.data );
+        if( cur.srcType )
+            into.back().typeID = SRC_TYPE_ID;
+    }
+}
+
+static bool SameModifier( const fxModifier& a, const fxModifier& b )
+{
+    return (a.math == b.math) and (a.fxSrc == b.fxSrc) and (a.targLoc == b.targLoc)
+       and (a.action == b.action) and (a.remove == b.remove) and (a.targAttr == b.targAttr)
+       and (a.srcAttr == b.srcAttr) and (a.grpID == b.grpID) and (a.typeID == b.typeID);
+}
+
+static void PrintModifier( const char* name, const fxModifier& data )
+{
+    ::printf( "  %s: math %i, fxSrc %i, targLoc %i, action %u, remove %u, targAttr %u, srcAttr %u, grpID %u, typeID %u\n",
+              name, data.math, data.fxSrc, data.targLoc, data.action, data.remove, data.targAttr, data.srcAttr, data.grpID, data.typeID );
+}
+
+// AORSM(SRLG(DEFENVIDX Ship, GETTYPE), EFF(DEFASSOCIATION PostPercent, ATT(DEFATTRIBUTE 64, DEFATTRIBUTE 292)))
+//  as skills use it, and the same with RORSM
+static bool CheckSkillModifier()
+{
+    ExpressionMap exps;
+    exps[ 3 ].operandID = FX::Operands::DEFENVIDX;      exps[ 3 ].expressionValue = "Ship";
+    exps[ 4 ].operandID = FX::Operands::GETTYPE;
+    exps[ 2 ].operandID = FX::Operands::SRLG;           exps[ 2 ].arg1 = 3; exps[ 2 ].arg2 = 4;
+    exps[ 6 ].operandID = FX::Operands::DEFASSOCIATION; exps[ 6 ].expressionValue = "PostPercent";
+    exps[ 8 ].operandID = FX::Operands::DEFATTRIBUTE;   exps[ 8 ].expressionAttributeID = 64;
+    exps[ 9 ].operandID = FX::Operands::DEFATTRIBUTE;   exps[ 9 ].expressionAttributeID = 292;
+    exps[ 7 ].operandID = FX::Operands::ATT;            exps[ 7 ].arg1 = 8; exps[ 7 ].arg2 = 9;
+    exps[ 5 ].operandID = FX::Operands::EFF;            exps[ 5 ].arg1 = 6; exps[ 5 ].arg2 = 7;
+    exps[ 1 ].operandID = FX::Operands::AORSM;          exps[ 1 ].arg1 = 2; exps[ 1 ].arg2 = 5;
+    exps[ 10 ] = exps[ 1 ];
+    exps[ 10 ].operandID = FX::Operands::RORSM;
+    for( auto& cur : exps )
+        cur.second.id = cur.first;
+
+    fxModifier expected = fxModifier();
+    expected.math = FX::Math::PostPercent;
+    expected.fxSrc = FX::Source::Skill;
+    expected.targLoc = FX::Target::Ship;
+    expected.targAttr = 64;
+    expected.srcAttr = 292;
+    expected.typeID = SRC_TYPE_ID;
+
+    for( uint16 root : { 1, 10 } ) {
+        if( root == 10 ) {
+            expected.math = FX::Math::RevPostPercent;
+            expected.remove = true;
+        }
+        std::vector<fxModifier> parsed, compiled;
+        Parse( exps, root, true, parsed );
+        Compile( exps, root, true, compiled );
+        if( (parsed.size() != 1) or (compiled.size() != 1)
+        or !SameModifier( parsed[ 0 ], expected ) or !SameModifier( compiled[ 0 ], expected ) ) {
+            ::printf( "Skill modifier of expression %u is wrong (%lu parsed, %lu compiled).\n", root, parsed.size(), compiled.size() );
+            PrintModifier( "expected", expected );
+            if( !parsed.empty() )
+                PrintModifier( "parsed", parsed[ 0 ] );
+            if( !compiled.empty() )
+                PrintModifier( "compiled", compiled[ 0 ] );
+            return false;
+        }
+    }
+    return true;
+}
+
+int effects_FxExpressionTest( int argc, char* argv[] )
+{
+    // expressions without ids are parsed with an error; keep output to test results
+    log_disable( EFFECTS__ERROR );
+    ::srand( 42 );
+
+    if( !CheckSkillModifier() )
+        return EXIT_FAILURE;
+
+    ExpressionMap exps;
+    uint16 nextID = 1;
+    for( uint32 i = 0; i < TREES; ++i ) {
+        // expression ids are uint16; start again with a new map when they run out
+        if( nextID > 50000 ) {
+            exps.clear();
+            nextID = 1;
+        }
+        uint16 root = AddExpression( exps, nextID, 0 );
+
+        for( uint8 skill = 0; skill < 2; ++skill ) {
+            std::vector<fxModifier> parsed, compiled;
+            Parse( exps, root, (skill > 0), parsed );
+            Compile( exps, root, (skill > 0), compiled );
+
+            if( parsed.size() != compiled.size() ) {
+                ::printf( "Expression %u (%s source) parsed %lu modifiers, compiled %lu.\n",
+                          root, (skill ? "skill" : "item"), parsed.size(), compiled.size() );
+                return EXIT_FAILURE;
+            }
+            for( size_t j = 0; j < parsed.size(); ++j ) {
+                if( SameModifier( parsed[ j ], compiled[ j ] ) )
+                    continue;
+                ::printf( "Expression %u (%s source) modifier %lu differs.\n", root, (skill ? "skill" : "item"), j );
+                PrintModifier( "parsed", parsed[ j ] );
+                PrintModifier( "compiled", compiled[ j ] );
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    ::printf( "%u expression trees compiled as parsed, for item and skill sources.\n", TREES );
+    return EXIT_SUCCESS;
+}
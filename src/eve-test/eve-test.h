@@ -41,6 +41,11 @@
 // marshal
 #include "marshal/EVEMarshal.h"
 #include "marshal/EVEUnmarshal.h"
+// network
+#include "network/MarshaledNotification.h"
+// python
+#include "python/PyPacket.h"
+#include "python/PyRep.h"
 // python/classes
 #include "python/classes/PyDatabase.h"
 // utils
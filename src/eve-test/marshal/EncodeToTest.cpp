@@ -0,0 +1,234 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "packets/AccountPkts.h"
+#include "packets/Bookmarks.h"
+#include "packets/BulkDataPkts.h"
+#include "packets/Calendar.h"
+#include "packets/Character.h"
+#include "packets/CorporationPkts.h"
+#include "packets/Crypto.h"
+#include "packets/Destiny.h"
+#include "packets/DogmaIM.h"
+#include "packets/Fleet.h"
+#include "packets/General.h"
+#include "packets/Inventory.h"
+#include "packets/LSCPkts.h"
+#include "packets/Language.h"
+#include "packets/Mail.h"
+#include "packets/Map.h"
+#include "packets/Manufacturing.h"
+#include "packets/Market.h"
+#include "packets/Missions.h"
+#include "packets/Missile.h"
+#include "packets/ObjectCaching.h"
+#include "packets/Planet.h"
+#include "packets/POS.h"
+#include "packets/Repair.h"
+#include "packets/Scan.h"
+#include "packets/Sovereignty.h"
+#include "packets/Standing.h"
+#include "packets/Trade.h"
+#include "packets/Tutorial.h"
+#include "packets/Wallet.h"
+
+/*
+ * Checks generated EncodeTo() of every packet element against Marshal() of its Encode().
+ *  elements are checked as default constructed, then some with values filled in.
+ */
+
+static bool CheckEncodeTo( const char* name, const PyRep* rep, bool res, const Buffer& direct )
+{
+    Buffer marshaled;
+    if (!Marshal( rep, marshaled ) ) {
+        ::printf( "%s: Marshal() failed.\n", name );
+        return false;
+    }
+    if (!res) {
+        ::printf( "%s: EncodeTo() failed.\n", name );
+        return false;
+    }
+    if (( marshaled.size() != direct.size() )
+    or !std::equal( marshaled.begin<uint8>(), marshaled.end<uint8>(), direct.begin<uint8>() ) )
+    {
+        ::printf( "%s: EncodeTo() gave %zu bytes, Marshal() %zu bytes; streams differ.\n", name, direct.size(), marshaled.size() );
+        return false;
+    }
+
+    return true;
+}
+
+template<class T>
+static bool CheckElement( const char* name, const T& obj )
+{
+    PyRep* rep = obj.Encode();
+    Buffer direct;
+    bool res = obj.EncodeTo( direct );
+    res = CheckEncodeTo( name, rep, res, direct );
+    PyDecRef( rep );
+    return res;
+}
+
+template<class T>
+static bool CheckDefault( const char* name )
+{
+    T obj;
+    return CheckElement( name, obj );
+}
+
+int marshal_EncodeToTest( int argc, char* argv[] )
+{
+    // null members are encoded with a warning; keep output to test results
+    log_disable( NET__PACKET_WARNING );
+
+    uint32 count(0), failed(0);
+
+#define CHECK_ELEMENT( name ) \
+    ++count; \
+    if (!CheckDefault<name>( #name ) ) \
+        ++failed;
+
+    ACCOUNTPKTS_ELEMENTS( CHECK_ELEMENT )
+    BOOKMARKS_ELEMENTS( CHECK_ELEMENT )
+    BULKDATAPKTS_ELEMENTS( CHECK_ELEMENT )
+    CALENDAR_ELEMENTS( CHECK_ELEMENT )
+    CHARACTER_ELEMENTS( CHECK_ELEMENT )
+    CORPORATIONPKTS_ELEMENTS( CHECK_ELEMENT )
+    CRYPTO_ELEMENTS( CHECK_ELEMENT )
+    DESTINY_ELEMENTS( CHECK_ELEMENT )
+    DOGMAIM_ELEMENTS( CHECK_ELEMENT )
+    FLEET_ELEMENTS( CHECK_ELEMENT )
+    GENERAL_ELEMENTS( CHECK_ELEMENT )
+    INVENTORY_ELEMENTS( CHECK_ELEMENT )
+    LSCPKTS_ELEMENTS( CHECK_ELEMENT )
+    LANGUAGE_ELEMENTS( CHECK_ELEMENT )
+    MAIL_ELEMENTS( CHECK_ELEMENT )
+    MAP_ELEMENTS( CHECK_ELEMENT )
+    MANUFACTURING_ELEMENTS( CHECK_ELEMENT )
+    MARKET_ELEMENTS( CHECK_ELEMENT )
+    MISSIONS_ELEMENTS( CHECK_ELEMENT )
+    MISSILE_ELEMENTS( CHECK_ELEMENT )
+    OBJECTCACHING_ELEMENTS( CHECK_ELEMENT )
+    PLANET_ELEMENTS( CHECK_ELEMENT )
+    POS_ELEMENTS( CHECK_ELEMENT )
+    REPAIR_ELEMENTS( CHECK_ELEMENT )
+    SCAN_ELEMENTS( CHECK_ELEMENT )
+    SOVEREIGNTY_ELEMENTS( CHECK_ELEMENT )
+    STANDING_ELEMENTS( CHECK_ELEMENT )
+    TRADE_ELEMENTS( CHECK_ELEMENT )
+    TUTORIAL_ELEMENTS( CHECK_ELEMENT )
+    WALLET_ELEMENTS( CHECK_ELEMENT )
+
+#undef CHECK_ELEMENT
+
+    // integers, reals and strings over all of their marshal forms
+    const int32 ints[] = { -1, 0, 1, 2, -2, 127, -128, 128, 255, 32767, -32768, 32768, 0x7FFFFFFF, (int32)0x80000000 };
+    for (auto cur : ints) {
+        SetBallPosition pos;
+        pos.entityID = cur;
+        pos.x = cur * 0.5;
+        pos.y = 0.0;
+        pos.z = -1e300;
+        ++count;
+        if (!CheckElement( "SetBallPosition", pos ) )
+            ++failed;
+    }
+
+    const int64 longs[] = { -1, 0, 1, 200, -40000, 0x7FFFFFFFLL, 0x80000000LL, 0xFFFFFFFFFFLL, -0xFFFFFFFFFFLL, 0x7FFFFFFFFFFFFFFFLL };
+    for (auto cur : longs) {
+        DoDestinyDamageState dmg;
+        dmg.shield = 0.25;
+        dmg.recharge = 1250000.0;
+        dmg.timestamp = cur;
+        dmg.armor = 1.0;
+        dmg.structure = 0.0;
+        ++count;
+        if (!CheckElement( "DoDestinyDamageState", dmg ) )
+            ++failed;
+    }
+
+    DoDestinyUpdateMain upd;
+    upd.updates = new PyList();
+    for (uint8 i = 0; i < 3; ++i) {
+        SetBallPosition pos;
+        pos.entityID = 140000000 + i;
+        upd.updates->AddItem( pos.Encode() );
+    }
+    upd.waitForBubble = true;
+    upd.events = new PyList();
+    ++count;
+    if (!CheckElement( "DoDestinyUpdateMain", upd ) )
+        ++failed;
+
+    // the client reads the bound object of a sparse rowset as a substruct holding a substream
+    GetMembersSparseRowset rowset;
+    PyTuple* bound = new PyTuple( 3 );
+    bound->SetItem( 0, new PyString( "N=700149:17018" ) );
+    bound->SetItem( 1, new PyDict() );
+    bound->SetItem( 2, new PyLong( 129515350203058462LL ) );
+    rowset.boundObject = bound;
+    rowset.realRowCount = 3;
+    ++count;
+    if (!CheckElement( "GetMembersSparseRowset", rowset ) ) {
+        ++failed;
+    } else {
+        PyRep* rep = rowset.Encode();
+        PyRep* args = rep->AsObject()->arguments();
+        PyRep* sub = args->AsTuple()->GetItem( 1 );
+        if (!sub->IsSubStruct()
+        or !sub->AsSubStruct()->sub()->IsSubStream()
+        or (sub->AsSubStruct()->sub()->AsSubStream()->decoded() != bound) )
+        {
+            ::printf( "GetMembersSparseRowset: boundObject is not wrapped in a substruct and substream.\n" );
+            ++failed;
+        }
+        PyDecRef( rep );
+    }
+
+    // time both paths over the same packet
+    const uint32 loops = 100000;
+    double start = GetTimeUSeconds();
+    for (uint32 i = 0; i < loops; ++i) {
+        Buffer out;
+        PyRep* rep = upd.Encode();
+        Marshal( rep, out );
+        PyDecRef( rep );
+    }
+    double encode = GetTimeUSeconds() - start;
+
+    start = GetTimeUSeconds();
+    for (uint32 i = 0; i < loops; ++i) {
+        Buffer out;
+        upd.EncodeTo( out );
+    }
+    double direct = GetTimeUSeconds() - start;
+
+    ::printf( "%u elements checked, %u failed.\n", count, failed );
+    ::printf( "DoDestinyUpdateMain x%u: Encode()+Marshal() %.0fus, EncodeTo() %.0fus\n", loops, encode, direct );
+
+    return (failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
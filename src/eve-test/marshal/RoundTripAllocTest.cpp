@@ -0,0 +1,339 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include <atomic>
+
+#include "packets/General.h"
+
+/*
+ * Counts heap allocations of a login session round trip: each packet is unmarshaled,
+ *  its substreams decoded and marshaled again, as the server does with calls it receives
+ *  and results it sends.  Marshaled bytes must equal the original ones, up to order of
+ *  dict entries, as PyDict does not keep it.
+ *
+ * The session is built from the packets a client exchanges while logging in:
+ *  character selection list, character selection, session change and character info.
+ */
+
+static const uint32 NODE_ID = 888444;
+static const uint32 USER_ID = 1001;
+static const int64 CLIENT_ID = 1000001;
+static const uint32 LOOPS = 2000;
+
+/* counts every global operator new of this program */
+static std::atomic<size_t> s_allocs( 0 );
+
+void* operator new( size_t size )
+{
+    ++s_allocs;
+    void* p = malloc( size == 0 ? 1 : size );
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete( void* p ) noexcept
+{
+    free( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+    free( p );
+}
+
+static Buffer* MarshalPacket( PyPacket& packet )
+{
+    PyRep* rep( packet.Encode() );
+    // Encode() does not take references of payloads
+    packet.payload = nullptr;
+    packet.named_payload = nullptr;
+
+    Buffer* data = new Buffer();
+    bool res( Marshal( rep, *data ) );
+    PyDecRef( rep );
+    if (!res)
+        SafeDelete( data );
+    return data;
+}
+
+static Buffer* NewCallReq( int64 callID, const char* service, const char* method, PyTuple* args )
+{
+    PyCallStream call;
+        call.remoteObject = 1;
+        call.method = method;
+        call.arg_tuple = args;
+        call.arg_dict = nullptr;
+
+    PyPacket packet;
+        packet.type_string = "macho.CallReq";
+        packet.type = CALL_REQ;
+        packet.source.type = PyAddress::Client;
+        packet.source.objectID = CLIENT_ID;
+        packet.source.callID = callID;
+        packet.dest.type = PyAddress::Any;
+        packet.dest.service = service;
+        packet.userid = USER_ID;
+        packet.payload = new PyTuple( 1 );
+        packet.payload->SetItem( 0, new PySubStream( call.Encode() ) );
+        packet.named_payload = new PyDict();
+        packet.named_payload->SetItemString( "machoVersion", new PyInt( 1 ) );
+    return MarshalPacket( packet );
+}
+
+static Buffer* NewCallRsp( int64 callID, const char* service, PyRep* result )
+{
+    PyPacket packet;
+        packet.type_string = "macho.CallRsp";
+        packet.type = CALL_RSP;
+        packet.source.type = PyAddress::Node;
+        packet.source.objectID = NODE_ID;
+        packet.source.service = service;
+        packet.source.callID = callID;
+        packet.dest.type = PyAddress::Client;
+        packet.dest.callID = callID;
+        packet.userid = USER_ID;
+        packet.payload = new PyTuple( 1 );
+        packet.payload->SetItem( 0, new PySubStream( result ) );
+        packet.named_payload = nullptr;
+    return MarshalPacket( packet );
+}
+
+static PyRep* NewCharacterList()
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    header->AddColumn( "characterID", DBTYPE_I4 );
+    header->AddColumn( "characterName", DBTYPE_WSTR );
+    header->AddColumn( "deletePrepareDateTime", DBTYPE_FILETIME );
+    header->AddColumn( "gender", DBTYPE_BOOL );
+    header->AddColumn( "typeID", DBTYPE_I4 );
+
+    CRowSet* rs = new CRowSet( &header );
+    for (uint32 i = 0; i < 3; ++i) {
+        PyPackedRow* row = rs->NewRow();
+        row->SetField( "characterID", new PyInt( 90000001 + i ) );
+        row->SetField( "characterName", new PyWString( "Test Pilot " + std::to_string( i ) ) );
+        row->SetField( "deletePrepareDateTime", new PyLong( 0 ) );
+        row->SetField( "gender", new PyBool( (i % 2) == 0 ) );
+        row->SetField( "typeID", new PyInt( 1373 + i ) );
+    }
+    return rs;
+}
+
+static PyRep* NewCharacterInfo()
+{
+    PyDict* info = new PyDict();
+    info->SetItemString( "characterID", new PyInt( 90000001 ) );
+    info->SetItemString( "characterName", new PyString( "Test Pilot 0" ) );
+    info->SetItemString( "corporationID", new PyInt( 1000044 ) );
+    info->SetItemString( "allianceID", PyStatic.NewNone() );
+    info->SetItemString( "stationID", new PyInt( 60004588 ) );
+    info->SetItemString( "solarSystemID", new PyInt( 30002187 ) );
+    info->SetItemString( "constellationID", new PyInt( 20000322 ) );
+    info->SetItemString( "regionID", new PyInt( 10000030 ) );
+    info->SetItemString( "shipID", new PyInt( 140000001 ) );
+    info->SetItemString( "balance", new PyFloat( 5000000.0 ) );
+    info->SetItemString( "securityRating", new PyFloat( 0.0 ) );
+    info->SetItemString( "description", new PyString( "" ) );
+    info->SetItemString( "bloodlineID", new PyInt( 7 ) );
+    info->SetItemString( "gender", PyStatic.NewTrue() );
+    info->SetItemString( "createDateTime", new PyLong( 132000000000000000LL ) );
+    return new PyObject( "util.KeyVal", info );
+}
+
+static Buffer* NewSessionChange()
+{
+    static const char* const keys[] = { "charid", "corpid", "stationid", "locationid", "solarsystemid2",
+                                        "constellationid", "regionid", "shipid", "corprole" };
+    static const int64 values[] = { 90000001, 1000044, 60004588, 60004588, 30002187,
+                                    20000322, 10000030, 140000001, 0 };
+
+    SessionChangeNotification scn;
+        scn.sessionID = 1234567890123LL;
+        scn.clueless = 0;
+        scn.changes = new PyDict();
+    for (uint32 i = 0; i < sizeof( keys ) / sizeof( keys[0] ); ++i) {
+        PyTuple* change = new PyTuple( 2 );
+            change->SetItem( 0, PyStatic.NewNone() );
+            change->SetItem( 1, new PyLong( values[i] ) );
+        scn.changes->SetItemString( keys[i], change );
+    }
+    scn.nodesOfInterest.push_back( -1 );
+    scn.nodesOfInterest.push_back( NODE_ID );
+
+    PyPacket packet;
+        packet.type_string = "macho.SessionChangeNotification";
+        packet.type = SESSIONCHANGENOTIFICATION;
+        packet.source.type = PyAddress::Node;
+        packet.source.objectID = NODE_ID;
+        packet.dest.type = PyAddress::Client;
+        packet.userid = USER_ID;
+        packet.payload = scn.Encode();
+        packet.named_payload = nullptr;
+    return MarshalPacket( packet );
+}
+
+static bool BuildSession( std::vector<Buffer*>& into )
+{
+    PyTuple* args = new PyTuple( 0 );
+    into.push_back( NewCallReq( 1, "charUnboundMgr", "GetCharactersToSelect", args ) );
+    into.push_back( NewCallRsp( 1, "charUnboundMgr", NewCharacterList() ) );
+
+    args = new PyTuple( 3 );
+        args->SetItem( 0, new PyInt( 90000001 ) );
+        args->SetItem( 1, PyStatic.NewFalse() );
+        args->SetItem( 2, PyStatic.NewNone() );
+    into.push_back( NewCallReq( 2, "charUnboundMgr", "SelectCharacterID", args ) );
+    into.push_back( NewSessionChange() );
+    into.push_back( NewCallRsp( 2, "charUnboundMgr", PyStatic.NewNone() ) );
+
+    args = new PyTuple( 1 );
+        args->SetItem( 0, new PyInt( 90000001 ) );
+    into.push_back( NewCallReq( 3, "charMgr", "GetPublicInfo", args ) );
+    into.push_back( NewCallRsp( 3, "charMgr", NewCharacterInfo() ) );
+
+    for (auto cur : into)
+        if (cur == nullptr)
+            return false;
+    return true;
+}
+
+/* same bytes in any order */
+static bool SameBytes( const Buffer& a, const Buffer& b )
+{
+    if (a.size() != b.size())
+        return false;
+
+    std::vector<uint8> sa( a.begin<uint8>(), a.end<uint8>() ), sb( b.begin<uint8>(), b.end<uint8>() );
+    std::sort( sa.begin(), sa.end() );
+    std::sort( sb.begin(), sb.end() );
+    return (sa == sb);
+}
+
+/* decodes substreams of rep, and marshals them again.  decoded contents must marshal to same bytes */
+static bool DecodeStreams( PyRep* rep )
+{
+    if (rep->IsSubStream()) {
+        PySubStream* ss = rep->AsSubStream();
+        ss->DecodeData();
+        if (ss->decoded() == nullptr)
+            return false;
+
+        Buffer data;
+        if (!Marshal( ss->decoded(), data ))
+            return false;
+        if (!SameBytes( data, ss->data()->content() ))
+            return false;
+        return DecodeStreams( ss->decoded() );
+    }
+
+    if (rep->IsTuple()) {
+        for (auto cur : *rep->AsTuple())
+            if ((cur != nullptr) and !DecodeStreams( cur ))
+                return false;
+    } else if (rep->IsList()) {
+        for (auto cur : *rep->AsList())
+            if ((cur != nullptr) and !DecodeStreams( cur ))
+                return false;
+    } else if (rep->IsDict()) {
+        for (auto cur : *rep->AsDict())
+            if ((cur.second != nullptr) and !DecodeStreams( cur.second ))
+                return false;
+    } else if (rep->IsObject()) {
+        return DecodeStreams( rep->AsObject()->arguments() );
+    }
+
+    return true;
+}
+
+static bool RoundTrip( const Buffer& packet )
+{
+    PyRep* rep = Unmarshal( packet );
+    if (rep == nullptr)
+        return false;
+
+    bool res( DecodeStreams( rep ) );
+    if (res) {
+        Buffer data;
+        res = Marshal( rep, data );
+        res = res and SameBytes( data, packet );
+    }
+
+    PyDecRef( rep );
+    return res;
+}
+
+int marshal_RoundTripAllocTest( int argc, char* argv[] )
+{
+    std::vector<Buffer*> session;
+    if (!BuildSession( session )) {
+        ::puts( "Failed to build login session." );
+        return EXIT_FAILURE;
+    }
+
+    size_t bytes(0);
+    for (auto cur : session)
+        bytes += cur->size();
+    ::printf( "Login session: %lu packets, %lu bytes.\n", session.size(), bytes );
+
+    /* first pass fills free lists */
+    size_t allocs( s_allocs );
+    for (uint32 i = 0; i < session.size(); ++i) {
+        if (!RoundTrip( *session[i] )) {
+            ::printf( "Round trip of packet %u failed or differs.\n", i );
+            return EXIT_FAILURE;
+        }
+    }
+    ::printf( "  first round trip:   %6lu allocations\n", s_allocs - allocs );
+
+    size_t heapBefore(0), reusedBefore(0);
+    FreeList::GetStats( heapBefore, reusedBefore );
+
+    allocs = s_allocs;
+    double start( GetTimeUSeconds() );
+    for (uint32 l = 0; l < LOOPS; ++l) {
+        for (auto cur : session) {
+            if (!RoundTrip( *cur )) {
+                ::puts( "Round trip failed or differs." );
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    double elapsed( GetTimeUSeconds() - start );
+    allocs = s_allocs - allocs;
+
+    size_t heap(0), reused(0);
+    FreeList::GetStats( heap, reused );
+
+    ::printf( "  later round trips:  %6lu allocations, %6lu nodes from free lists, %6lu nodes from heap, %8.1f us\n",
+              allocs / LOOPS, (reused - reusedBefore) / LOOPS, (heap - heapBefore) / LOOPS, elapsed / LOOPS );
+
+    for (auto cur : session)
+        SafeDelete( cur );
+
+    return EXIT_SUCCESS;
+}
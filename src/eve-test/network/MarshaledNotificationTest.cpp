@@ -0,0 +1,214 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+/*
+ * Compares per-recipient marshaling of a multicast notification (as Client::SendNotification
+ * does it) with MarshaledNotification, for a bubble of pilots over a number of ticks.
+ * Packets of both paths must carry identical (inflated) bytes.
+ */
+
+static const uint32 NODE_ID = 888444;
+static const uint32 RECIPIENTS = 200;
+static const uint32 TICKS = 10;
+
+/* destiny-like payload: a list of `count` (stamp, (name, (itemID, x, y, z))) updates */
+static PyTuple* NewPayload( uint32 count, uint32 stamp )
+{
+    PyList* updates = new PyList();
+    for (uint32 i = 0; i < count; ++i) {
+        PyTuple* args = new PyTuple( 4 );
+            args->items[0] = new PyLong( 140000000LL + i );
+            args->items[1] = new PyFloat( 1000.5 * i );
+            args->items[2] = new PyFloat( -250.25 * i );
+            args->items[3] = new PyFloat( 12345.0 + i );
+        PyTuple* call = new PyTuple( 2 );
+            call->items[0] = new PyString( "SetBallPosition" );
+            call->items[1] = args;
+        PyTuple* update = new PyTuple( 2 );
+            update->items[0] = new PyInt( stamp );
+            update->items[1] = call;
+        updates->AddItem( update );
+    }
+
+    PyTuple* payload = new PyTuple( 2 );
+        payload->items[0] = updates;
+        payload->items[1] = PyStatic.NewFalse();
+    return payload;
+}
+
+static void InitAddresses( PyAddress& source, PyAddress& dest )
+{
+    source.type = PyAddress::Node;
+    source.objectID = NODE_ID;
+
+    dest.type = PyAddress::Broadcast;
+    dest.service = "DoDestinyUpdate";
+    dest.bcast_idtype = "clientID";
+}
+
+static PyDict* NewNamedPayload( uint32 sn )
+{
+    PyDict* named = new PyDict();
+    named->SetItemString( "sn", new PyInt( sn ) );
+    return named;
+}
+
+/* returns packet contents with deflation undone */
+static bool Inflated( const Buffer& packet, Buffer& into )
+{
+    if (IsDeflated( packet ))
+        return InflateData( packet, into );
+
+    into = packet;
+    return true;
+}
+
+static bool RunTicks( uint32 updates )
+{
+    PyAddress source, dest;
+    InitAddresses( source, dest );
+
+    uint64_t perClientBytes(0), perClientDeflates(0), sharedBytes(0), sharedDeflates(0);
+    double perClientTime(0), sharedTime(0), start(0);
+    bool deflated(false);
+
+    for (uint32 tick = 1; tick <= TICKS; ++tick) {
+        std::vector<Buffer*> before, after;
+
+        /* before: payload is shared, but every recipient marshals and deflates its own packet */
+        PyTuple* payload( NewPayload( updates, tick ) );
+        start = GetTimeUSeconds();
+        for (uint32 r = 0; r < RECIPIENTS; ++r) {
+            PyIncRef( payload );
+            EVENotificationStream noti;
+                noti.remoteObject = 1;
+                noti.args = payload;
+
+            PyPacket* packet = new PyPacket();
+                packet->type_string = "macho.Notification";
+                packet->type = NOTIFICATION;
+                packet->source = source;
+                packet->dest = dest;
+                packet->userid = 1000 + r;
+                packet->payload = noti.Encode();
+                packet->named_payload = NewNamedPayload( tick );
+            PyRep* rep(packet->Encode());
+            packet->payload = nullptr;
+            packet->named_payload = nullptr;
+            SafeDelete( packet );
+
+            Buffer data;
+            if (!Marshal( rep, data )) {
+                ::puts( "Failed to marshal packet." );
+                return false;
+            }
+            PyDecRef( rep );
+            perClientBytes += data.size();
+
+            Buffer* out = new Buffer();
+            if (data.size() >= 0x2000) {
+                DeflateData( data, *out );
+                ++perClientDeflates;
+            } else {
+                *out = data;
+            }
+            before.push_back( out );
+        }
+        perClientTime += GetTimeUSeconds() - start;
+
+        /* after: marshal (and deflate) once, write per-recipient fields only */
+        start = GetTimeUSeconds();
+        {
+            EVENotificationStream noti;
+                noti.remoteObject = 1;
+                noti.args = payload;    // consumed by noti
+
+            MarshaledNotificationRef shared( new MarshaledNotification( source, dest, noti ) );
+            if (!shared->IsValid()) {
+                ::puts( "Failed to marshal shared notification." );
+                return false;
+            }
+            sharedBytes += shared->GetMarshaledSize();
+            if (shared->IsDeflated())
+                ++sharedDeflates;
+            deflated = shared->IsDeflated();
+
+            MarshalStream ms;
+            for (uint32 r = 0; r < RECIPIENTS; ++r) {
+                PyDict* named( NewNamedPayload( tick ) );
+                PyRep* user( new PyInt( 1000 + r ) );
+                Buffer fields;
+                ms.SaveRep( user, fields );
+                ms.SaveRep( named, fields );
+                sharedBytes += fields.size();
+                PyDecRef( user );
+
+                Buffer* out = new Buffer();
+                if (!shared->Write( 1000 + r, named, *out )) {
+                    ::puts( "Failed to write shared notification." );
+                    return false;
+                }
+                PyDecRef( named );
+                after.push_back( out );
+            }
+        }
+        sharedTime += GetTimeUSeconds() - start;
+
+        /* both paths must produce the same packets */
+        for (uint32 r = 0; r < RECIPIENTS; ++r) {
+            Buffer a, b;
+            if (!Inflated( *before[r], a ) or !Inflated( *after[r], b )) {
+                ::printf( "Failed to inflate packet of recipient %u.\n", r );
+                return false;
+            }
+            if ((a.size() != b.size()) or (memcmp( &a[0], &b[0], a.size() ) != 0)) {
+                ::printf( "Packet of recipient %u differs (%lu vs %lu bytes).\n", r, a.size(), b.size() );
+                return false;
+            }
+            SafeDelete( before[r] );
+            SafeDelete( after[r] );
+        }
+    }
+
+    ::printf( "  %u updates x %u recipients (%s):\n", updates, RECIPIENTS, deflated ? "deflated" : "not deflated" );
+    ::printf( "    per-recipient: %10lu bytes marshaled/tick, %4lu deflates/tick, %9.1f us/tick\n",
+              perClientBytes / TICKS, perClientDeflates / TICKS, perClientTime / TICKS );
+    ::printf( "    shared:        %10lu bytes marshaled/tick, %4lu deflates/tick, %9.1f us/tick\n",
+              sharedBytes / TICKS, sharedDeflates / TICKS, sharedTime / TICKS );
+    return true;
+}
+
+int network_MarshaledNotificationTest( int argc, char* argv[] )
+{
+    ::puts( "Marshaling multicast notifications..." );
+
+    // small bubble update (sent as is) and fleet-fight sized one (deflated)
+    if (!RunTicks( 8 ) or !RunTicks( 500 ))
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,275 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "network/StreamPacketizer.h"
+
+/*
+ * Feeds a login-like packet stream through the packetizer the way EVETCPConnection does,
+ * in recv-sized chunks, and compares it with the copying packetizer it replaced
+ * (recv buffer copied into the packetizer, every packet copied into its own Buffer,
+ * the remainder shifted to the front after every Process()).
+ * Both paths must unmarshal to identical packets.
+ */
+
+static const uint32 STREAM_CALLS = 2000;
+static const uint32 ROUNDS = 20;
+static const size_t RECV_SIZE = 0x10000;   // TCPCONN_RECVBUF_SIZE
+
+/* copying packetizer, as it was before */
+class CopyingPacketizer
+{
+public:
+    ~CopyingPacketizer()
+    {
+        while (!mPackets.empty()) {
+            SafeDelete( mPackets.front() );
+            mPackets.pop();
+        }
+    }
+
+    void InputData( const Buffer& data )
+    {
+        mBuffer.AppendSeq( data.begin<uint8>(), data.end<uint8>() );
+        mCopied += data.size();
+    }
+
+    void Process()
+    {
+        Buffer::const_iterator<uint8> cur = mBuffer.begin<uint8>(), end = mBuffer.end<uint8>();
+        while (sizeof( uint32 ) <= (size_t)(end - cur)) {
+            const Buffer::const_iterator<uint32> len = cur.As<uint32>();
+            const Buffer::const_iterator<uint8> start = ( len + 1 ).As<uint8>();
+            if (*len > (uint32)(end - start))
+                break;
+
+            mPackets.push( new Buffer( start, start + *len ) );
+            mCopied += *len;
+            ++mAllocs;
+            cur = start + *len;
+        }
+
+        if (cur != mBuffer.begin<uint8>()) {
+            mCopied += end - cur;
+            mBuffer.AssignSeq( cur, end );
+        }
+    }
+
+    Buffer* PopPacket()
+    {
+        Buffer* buf(nullptr);
+        if (!mPackets.empty()) {
+            buf = mPackets.front();
+            mPackets.pop();
+        }
+        return buf;
+    }
+
+    uint64_t mCopied = 0;
+    uint64_t mAllocs = 0;
+
+protected:
+    Buffer mBuffer;
+    std::queue<Buffer*> mPackets;
+};
+
+static PyRep* NewCall( const char* service, const char* method, PyTuple* args )
+{
+    PyTuple* call = new PyTuple( 4 );
+        call->items[0] = new PyInt( 1 );
+        call->items[1] = new PyString( method );
+        call->items[2] = args;
+        call->items[3] = new PyDict();
+    PyTuple* rep = new PyTuple( 2 );
+        rep->items[0] = new PyString( service );
+        rep->items[1] = call;
+    return rep;
+}
+
+/* client side of a login: handshake, then a burst of service calls, some of them bulky */
+static bool BuildStream( Buffer& stream, uint32& count )
+{
+    std::vector<PyRep*> reps;
+
+    PyTuple* version = new PyTuple( 6 );
+        version->items[0] = new PyInt( 170472 );
+        version->items[1] = new PyInt( 360 );
+        version->items[2] = new PyInt( 0 );
+        version->items[3] = new PyFloat( 7.31 );
+        version->items[4] = new PyInt( 360229 );
+        version->items[5] = new PyString( "EVE-EVE-TRANQUILITY@ccp" );
+    reps.push_back( version );
+
+    PyDict* login = new PyDict();
+        login->SetItemString( "user_name", new PyString( "testuser" ) );
+        login->SetItemString( "user_password_hash", new PyString( std::string( 40, 'a' ) ) );
+        login->SetItemString( "user_languageid", new PyString( "EN" ) );
+        login->SetItemString( "user_affiliateid", new PyInt( 0 ) );
+    reps.push_back( login );
+
+    for (uint32 i = 0; i < STREAM_CALLS; ++i) {
+        PyTuple* args;
+        if (i % 100 == 99) {
+            // bulky call (e.g. a settings upload); deflated below
+            PyList* list = new PyList();
+            for (uint32 j = 0; j < 1000; ++j)
+                list->AddItem( new PyInt( j ) );
+            args = new PyTuple( 1 );
+                args->items[0] = list;
+        } else {
+            args = new PyTuple( 2 );
+                args->items[0] = new PyInt( 140000000 + i );
+                args->items[1] = new PyString( "GetCharacterToSelect" );
+        }
+        reps.push_back( NewCall( "charUnboundMgr", "GetCharacterToSelect", args ) );
+    }
+
+    count = reps.size();
+    for (size_t i = 0; i < reps.size(); ++i) {
+        Buffer data;
+        bool ok = MarshalDeflate( reps[i], data );
+        PyDecRef( reps[i] );
+        if (!ok)
+            return false;
+
+        stream.Append<uint32>( data.size() );
+        stream.AppendSeq( data.begin<uint8>(), data.end<uint8>() );
+    }
+    return true;
+}
+
+/* recv() returns whatever arrived; split the stream in pseudo-random chunks up to RECV_SIZE */
+static void BuildChunks( size_t total, std::vector<size_t>& chunks )
+{
+    uint32 seed = 12345;
+    size_t done = 0;
+    while (done < total) {
+        seed = seed * 1103515245 + 12345;
+        size_t len = std::min<size_t>( 1 + (seed >> 8) % 4096, total - done );
+        if (seed % 16 == 0)
+            len = std::min<size_t>( RECV_SIZE, total - done );
+        chunks.push_back( len );
+        done += len;
+    }
+}
+
+static bool SameRep( PyRep* a, PyRep* b )
+{
+    Buffer x, y;
+    if (!Marshal( a, x ) or !Marshal( b, y ))
+        return false;
+    return (x.size() == y.size()) and (memcmp( &x[0], &y[0], x.size() ) == 0);
+}
+
+int network_StreamPacketizerTest( int argc, char* argv[] )
+{
+    ::puts( "Packetizing a login stream..." );
+
+    Buffer stream;
+    uint32 count(0);
+    if (!BuildStream( stream, count )) {
+        ::puts( "Failed to marshal stream." );
+        return EXIT_FAILURE;
+    }
+    std::vector<size_t> chunks;
+    BuildChunks( stream.size(), chunks );
+
+    double copyingTime(0), inPlaceTime(0), start(0);
+    uint64_t copyingCopied(0), copyingAllocs(0);
+
+    for (uint32 round = 0; round < ROUNDS; ++round) {
+        std::vector<PyRep*> before, after;
+
+        /* before: recv into a buffer, copy into packetizer, copy out every packet */
+        start = GetTimeUSeconds();
+        {
+            CopyingPacketizer packetizer;
+            Buffer recvBuf( RECV_SIZE );
+            size_t pos(0);
+            for (size_t c = 0; c < chunks.size(); ++c) {
+                recvBuf.Resize<uint8>( RECV_SIZE );
+                memcpy( &recvBuf[0], &stream[pos], chunks[c] );
+                recvBuf.Resize<uint8>( chunks[c] );
+                pos += chunks[c];
+
+                packetizer.InputData( recvBuf );
+                packetizer.Process();
+
+                Buffer* packet(nullptr);
+                while ((packet = packetizer.PopPacket()) != nullptr) {
+                    before.push_back( InflateUnmarshal( *packet ) );
+                    SafeDelete( packet );
+                }
+            }
+            copyingCopied += packetizer.mCopied;
+            copyingAllocs += packetizer.mAllocs;
+        }
+        copyingTime += GetTimeUSeconds() - start;
+
+        /* after: recv straight into the packetizer, unmarshal packets in place */
+        start = GetTimeUSeconds();
+        {
+            StreamPacketizer packetizer;
+            size_t pos(0);
+            for (size_t c = 0; c < chunks.size(); ++c) {
+                uint8* space = packetizer.GetInputSpace( RECV_SIZE );
+                memcpy( space, &stream[pos], chunks[c] );
+                packetizer.CommitInput( chunks[c] );
+                pos += chunks[c];
+
+                packetizer.Process();
+
+                Buffer::const_iterator<uint8> packet;
+                size_t len(0);
+                while (packetizer.PeekPacket( packet, len )) {
+                    after.push_back( InflateUnmarshal( packet, len ) );
+                    packetizer.ReleasePacket();
+                }
+            }
+        }
+        inPlaceTime += GetTimeUSeconds() - start;
+
+        /* both paths must produce the same packets */
+        if ((before.size() != count) or (after.size() != count)) {
+            ::printf( "Got %lu and %lu packets, expected %u.\n", before.size(), after.size(), count );
+            return EXIT_FAILURE;
+        }
+        for (uint32 i = 0; i < count; ++i) {
+            if ((before[i] == nullptr) or (after[i] == nullptr) or !SameRep( before[i], after[i] )) {
+                ::printf( "Packet %u differs.\n", i );
+                return EXIT_FAILURE;
+            }
+            PyDecRef( before[i] );
+            PyDecRef( after[i] );
+        }
+    }
+
+    ::printf( "  %u packets, %lu bytes in %lu chunks:\n", count, stream.size(), chunks.size() );
+    ::printf( "    copying:  %9.1f us/stream, %8lu bytes copied in packetizer, %5lu buffers allocated\n",
+              copyingTime / ROUNDS, copyingCopied / ROUNDS, copyingAllocs / ROUNDS );
+    ::printf( "    in place: %9.1f us/stream\n", inPlaceTime / ROUNDS );
+    return EXIT_SUCCESS;
+}
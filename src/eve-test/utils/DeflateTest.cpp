@@ -0,0 +1,251 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:     EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "cache/CachedObjectMgr.h"
+#include "utils/DirWalker.h"
+
+/*
+ * Inflates and deflates ObjCacheService payloads with uncompress()/compress(), as
+ * Deflate.cpp did before, and with the per-thread zlib streams.
+ *
+ * Payloads are read from the server cache directory (files.cacheDir, pass it as
+ * first argument); without one, rowsets shaped like the static data tables are
+ * built and deflated the way CachedObjectMgr::UpdateCache() does it.
+ */
+
+static const uint32 ROUNDS = 20;
+
+struct Payload
+{
+    std::string name;
+    Buffer deflated;
+    Buffer inflated;
+};
+
+/* inflate as it was: guess output size, re-inflate everything until it fits */
+static bool OldInflate( const Buffer& input, Buffer& output, uint32& passes )
+{
+    size_t outputSize(0), sizeMultiplier(0);
+    int res(0);
+    do {
+        outputSize = ( input.size() << ++sizeMultiplier );
+        output.Resize<uint8>( outputSize );
+        res = uncompress( &output[0], (uLongf*)&outputSize, &input[0], input.size() );
+        ++passes;
+    } while (Z_BUF_ERROR == res);
+
+    output.Resize<uint8>( Z_OK == res ? outputSize : 0 );
+    return Z_OK == res;
+}
+
+/* deflate as it was: fresh zlib state and compressBound buffer per call */
+static bool OldDeflate( const Buffer& input, Buffer& output, int level = Z_DEFAULT_COMPRESSION )
+{
+    size_t outputSize = compressBound( input.size() );
+    output.Resize<uint8>( outputSize );
+    int res = compress2( &output[0], (uLongf*)&outputSize, &input[0], input.size(), level );
+    output.Resize<uint8>( Z_OK == res ? outputSize : 0 );
+    return Z_OK == res;
+}
+
+static bool LoadCacheDir( const char* dir, std::vector<Payload*>& payloads )
+{
+    DirWalker walker;
+    if (!walker.OpenDir( dir, ".cache" ))
+        return false;
+
+    while (walker.NextFile()) {
+        std::string filename( dir );
+        filename += "/";
+        filename += walker.currentFileName();
+
+        FILE* f = fopen( filename.c_str(), "rb" );
+        if (f == nullptr)
+            continue;
+
+        CacheFileHeader header;
+        Payload* p = new Payload();
+        bool ok = (fread( &header, sizeof( header ), 1, f ) == 1) and (header.magic == CacheFileMagic);
+        if (ok) {
+            p->deflated.Resize<uint8>( header.length );
+            ok = (fread( &p->deflated[0], sizeof( uint8 ), header.length, f ) == header.length);
+        }
+        fclose( f );
+
+        // only deflated objects are of interest
+        if (ok and (header.length > 0) and IsDeflated( p->deflated )) {
+            p->name = walker.currentFileName();
+            payloads.push_back( p );
+        } else {
+            SafeDelete( p );
+        }
+    }
+
+    return !payloads.empty();
+}
+
+/* rowset of `rows` rows like invTypes: ids, names, descriptions, floats */
+static Payload* NewRowset( const char* name, uint32 rows )
+{
+    PyList* header = new PyList();
+    header->AddItem( new PyString( "typeID" ) );
+    header->AddItem( new PyString( "groupID" ) );
+    header->AddItem( new PyString( "typeName" ) );
+    header->AddItem( new PyString( "description" ) );
+    header->AddItem( new PyString( "mass" ) );
+    header->AddItem( new PyString( "volume" ) );
+    header->AddItem( new PyString( "published" ) );
+
+    PyList* lines = new PyList();
+    for (uint32 i = 0; i < rows; ++i) {
+        char typeName[64];
+        snprintf( typeName, sizeof( typeName ), "Type %u Mark %u", i / 7, i % 7 );
+        PyList* line = new PyList();
+        line->AddItem( new PyInt( 1000 + i ) );
+        line->AddItem( new PyInt( 20 + (i % 300) ) );
+        line->AddItem( new PyString( typeName ) );
+        line->AddItem( new PyString( "This item is used in manufacturing and can be refined into minerals." ) );
+        line->AddItem( new PyFloat( 1000.0 * (i % 50) ) );
+        line->AddItem( new PyFloat( 0.01 * (i % 400) ) );
+        line->AddItem( new PyBool( (i % 3) != 0 ) );
+        lines->AddItem( line );
+    }
+
+    PyDict* args = new PyDict();
+    args->SetItemString( "header", header );
+    args->SetItemString( "RowClass", new PyToken( "util.Row" ) );
+    args->SetItemString( "lines", lines );
+    PyObject* rowset = new PyObject( "util.Rowset", args );
+
+    Payload* p = new Payload();
+    p->name = name;
+    bool ok = MarshalDeflate( rowset, p->deflated, 0x2000, Z_BEST_COMPRESSION );
+    PyDecRef( rowset );
+    if (!ok)
+        SafeDelete( p );
+    return p;
+}
+
+int utils_DeflateTest( int argc, char* argv[] )
+{
+    std::vector<Payload*> payloads;
+    const char* dir( argc > 1 ? argv[1] : "../server_cache" );
+    if (LoadCacheDir( dir, payloads )) {
+        ::printf( "Deflating %lu cached objects from %s...\n", payloads.size(), dir );
+    } else {
+        ::printf( "No cached objects in %s; deflating generated rowsets...\n", dir );
+        payloads.push_back( NewRowset( "small rowset", 100 ) );
+        payloads.push_back( NewRowset( "medium rowset", 2000 ) );
+        payloads.push_back( NewRowset( "large rowset", 20000 ) );
+    }
+
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        Payload* p = payloads[i];
+        if (p == nullptr) {
+            ::puts( "Failed to build payload." );
+            return EXIT_FAILURE;
+        }
+
+        uint32 passes(0);
+        if (!OldInflate( p->deflated, p->inflated, passes )) {
+            ::printf( "Failed to inflate %s.\n", p->name.c_str() );
+            return EXIT_FAILURE;
+        }
+
+        double oldInflate(0), newInflate(0), hintInflate(0), oldDeflate(0), newDeflate(0), start(0);
+        size_t oldSize(0), newSize(0), fastSize(0), bestSize(0);
+        for (uint32 round = 0; round < ROUNDS; ++round) {
+            Buffer a, b, c, d, e;
+
+            passes = 0;
+            start = GetTimeUSeconds();
+            OldInflate( p->deflated, a, passes );
+            oldInflate += GetTimeUSeconds() - start;
+
+            start = GetTimeUSeconds();
+            bool ok = InflateData( p->deflated, b );
+            newInflate += GetTimeUSeconds() - start;
+
+            start = GetTimeUSeconds();
+            ok = InflateData( p->deflated, c, p->inflated.size() ) and ok;
+            hintInflate += GetTimeUSeconds() - start;
+
+            if (!ok or (b.size() != a.size()) or (c.size() != a.size())
+                or (memcmp( &a[0], &b[0], a.size() ) != 0) or (memcmp( &a[0], &c[0], a.size() ) != 0)) {
+                ::printf( "Inflated %s differs.\n", p->name.c_str() );
+                return EXIT_FAILURE;
+            }
+
+            start = GetTimeUSeconds();
+            OldDeflate( p->inflated, d );
+            oldDeflate += GetTimeUSeconds() - start;
+
+            start = GetTimeUSeconds();
+            ok = DeflateData( p->inflated, e );
+            newDeflate += GetTimeUSeconds() - start;
+
+            // same zlib, same parameters; output must match
+            if (!ok or (d.size() != e.size()) or (memcmp( &d[0], &e[0], d.size() ) != 0)) {
+                ::printf( "Deflated %s differs.\n", p->name.c_str() );
+                return EXIT_FAILURE;
+            }
+            oldSize = d.size();
+            newSize = e.size();
+        }
+
+        Buffer fast, best, check;
+        if (!DeflateData( p->inflated, fast, Z_BEST_SPEED ) or !DeflateData( p->inflated, best, Z_BEST_COMPRESSION )
+            or !InflateData( fast, check ) or (check.size() != p->inflated.size())) {
+            ::printf( "Failed to deflate %s at other levels.\n", p->name.c_str() );
+            return EXIT_FAILURE;
+        }
+        fastSize = fast.size();
+        bestSize = best.size();
+
+        // switching levels on one thread, as cache objects and live packets do, gives what a fresh stream gives
+        const int levels[] = { Z_BEST_SPEED, Z_BEST_COMPRESSION, Z_DEFAULT_COMPRESSION, Z_BEST_SPEED, Z_BEST_COMPRESSION };
+        for (int level : levels) {
+            Buffer d, e;
+            if (!OldDeflate( p->inflated, d, level ) or !DeflateData( p->inflated, e, level )
+                or (d.size() != e.size()) or (memcmp( &d[0], &e[0], d.size() ) != 0)) {
+                ::printf( "Deflated %s at level %i differs after switching levels.\n", p->name.c_str(), level );
+                return EXIT_FAILURE;
+            }
+        }
+
+        ::printf( "  %s: %lu bytes deflated, %lu inflated\n", p->name.c_str(), p->deflated.size(), p->inflated.size() );
+        ::printf( "    inflate: uncompress %8.1f us (%u passes), stream %8.1f us, stream with hint %8.1f us\n",
+                  oldInflate / ROUNDS, passes, newInflate / ROUNDS, hintInflate / ROUNDS );
+        ::printf( "    deflate: compress   %8.1f us (%lu bytes), stream %8.1f us (%lu bytes)\n",
+                  oldDeflate / ROUNDS, oldSize, newDeflate / ROUNDS, newSize );
+        ::printf( "    levels:  fastest %lu bytes, default %lu bytes, best %lu bytes\n", fastSize, newSize, bestSize );
+
+        SafeDelete( payloads[i] );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,272 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/FlatMap.h"
+
+/*
+ * Builds attribute maps for a loaded universe: 20000 items of a few hundred types,
+ * each type with 20-60 attributes drawn from ~2000 attributeIDs, loaded in attributeID
+ * order as AttributeMap::Load() does, then a few set by hand as effects and saved state do.
+ * Every map is built as std::map and as FlatMap, each through an allocator counting bytes.
+ *
+ * Lookups of present and missing attributes and full walks (as for item rows) are
+ * timed over both.  Results of both must match; memory and timings of both are printed.
+ */
+
+static const uint32 ITEMS = 20000;
+static const uint32 TYPES = 400;
+static const uint16 ATTRIBUTES = 2000;
+static const uint32 LOOKUPS = 4000000;
+
+static size_t s_allocated = 0;
+
+template <class T>
+struct CountingAlloc
+{
+    typedef T value_type;
+
+    CountingAlloc()                                     { }
+    template <class U> CountingAlloc( const CountingAlloc<U>& )  { }
+
+    T* allocate( size_t n )
+    {
+        // malloc keeps a header of a word per block; count it, as it is what a node map pays most for
+        s_allocated += n * sizeof(T) + sizeof(size_t);
+        return static_cast<T*>(::operator new( n * sizeof(T) ));
+    }
+    void deallocate( T* p, size_t n )
+    {
+        s_allocated -= n * sizeof(T) + sizeof(size_t);
+        ::operator delete( p );
+    }
+};
+template <class T, class U> bool operator==( const CountingAlloc<T>&, const CountingAlloc<U>& ) { return true; }
+template <class T, class U> bool operator!=( const CountingAlloc<T>&, const CountingAlloc<U>& ) { return false; }
+
+// layout of EvilNumber before it kept one value member
+struct OldEvilNumber
+{
+    double fVal;
+    int64 iVal;
+    EVIL_NUMBER_TYPE mType;
+};
+
+typedef std::map<uint16, EvilNumber, std::less<uint16>, CountingAlloc<std::pair<const uint16, EvilNumber>>> NodeAttrMap;
+typedef std::map<uint16, OldEvilNumber, std::less<uint16>, CountingAlloc<std::pair<const uint16, OldEvilNumber>>> OldAttrMap;
+typedef FlatMap<uint16, EvilNumber, CountingAlloc<std::pair<uint16, EvilNumber>>> FlatAttrMap;
+
+static bool FlatMapSameAs( const FlatAttrMap& flat, const NodeAttrMap& node )
+{
+    if (flat.size() != node.size())
+        return false;
+    FlatAttrMap::const_iterator fItr = flat.begin();
+    for (auto cur : node) {
+        // EvilNumber compares are not const
+        EvilNumber value( fItr->second );
+        if ((fItr->first != cur.first) or (value != cur.second))
+            return false;
+        ++fItr;
+    }
+    return true;
+}
+
+// random inserts, erases and lookups against std::map
+static bool FlatMapCheck()
+{
+    FlatMap<uint16, EvilNumber> flat;
+    std::map<uint16, EvilNumber> node;
+    for (uint32 i = 0; i < 100000; ++i) {
+        uint16 key = ::rand() % 300;
+        switch (::rand() % 4) {
+            case 0: {
+                EvilNumber value( (int32)::rand() );
+                if (flat.emplace( key, value ).second != node.emplace( key, value ).second)
+                    return false;
+            } break;
+            case 1: {
+                EvilNumber value( ::rand() / 7.0 );
+                if (flat.insert( std::make_pair( key, value ) ).second != node.insert( std::make_pair( key, value ) ).second)
+                    return false;
+            } break;
+            case 2: {
+                if (flat.erase( key ) != node.erase( key ))
+                    return false;
+            } break;
+            case 3: {
+                flat[key] += EvilOne;
+                node[key] += EvilOne;
+            } break;
+        }
+        if (flat.count( key ) != node.count( key ))
+            return false;
+    }
+    if (flat.size() != node.size())
+        return false;
+    FlatMap<uint16, EvilNumber>::iterator fItr = flat.begin();
+    for (auto cur : node) {
+        if ((fItr->first != cur.first) or (fItr->second != cur.second))
+            return false;
+        ++fItr;
+    }
+    return true;
+}
+
+int utils_FlatMapTest( int argc, char* argv[] )
+{
+    ::srand( 42 );
+
+    if (!FlatMapCheck()) {
+        ::printf( "FlatMap differs from std::map after random inserts and erases.\n" );
+        return EXIT_FAILURE;
+    }
+
+    ::printf( "sizeof(EvilNumber) %lu, was %lu.\n", sizeof(EvilNumber), sizeof(OldEvilNumber) );
+
+    // type attributes, sorted.  about one in four is a float
+    std::vector<std::vector<std::pair<uint16, EvilNumber>>> types( TYPES );
+    for (auto& type : types) {
+        std::set<uint16> ids;
+        uint32 count = 20 + ::rand() % 41;
+        while (ids.size() < count)
+            ids.insert( 1 + ::rand() % ATTRIBUTES );
+        for (auto id : ids) {
+            if (::rand() % 4)
+                type.push_back( std::make_pair( id, EvilNumber( (int32)(::rand() % 10000) ) ) );
+            else
+                type.push_back( std::make_pair( id, EvilNumber( ::rand() / 1000.0 ) ) );
+        }
+    }
+
+    std::vector<NodeAttrMap> nodeMaps( ITEMS );
+    std::vector<OldAttrMap> oldMaps( ITEMS );
+    std::vector<FlatAttrMap> flatMaps( ITEMS );
+    size_t entries(0), nodeBytes(0), oldBytes(0), flatBytes(0);
+    double nodeLoad(0), flatLoad(0);
+    for (uint32 i = 0; i < ITEMS; ++i) {
+        const std::vector<std::pair<uint16, EvilNumber>>& type = types[::rand() % TYPES];
+        // saved or modified attributes, some not of the type
+        std::vector<std::pair<uint16, EvilNumber>> extra;
+        for (uint32 j = ::rand() % 6; j > 0; --j)
+            extra.push_back( std::make_pair( 1 + ::rand() % ATTRIBUTES, EvilNumber( ::rand() / 100.0 ) ) );
+
+        size_t before = s_allocated;
+        double start = GetTimeUSeconds();
+        for (auto& cur : type)
+            nodeMaps[i].emplace( cur.first, cur.second );
+        for (auto& cur : extra)
+            nodeMaps[i][cur.first] = cur.second;
+        nodeLoad += GetTimeUSeconds() - start;
+        nodeBytes += s_allocated - before;
+
+        before = s_allocated;
+        start = GetTimeUSeconds();
+        flatMaps[i].reserve( type.size() );
+        for (auto& cur : type)
+            flatMaps[i].emplace( cur.first, cur.second );
+        for (auto& cur : extra)
+            flatMaps[i][cur.first] = cur.second;
+        flatLoad += GetTimeUSeconds() - start;
+        flatBytes += s_allocated - before;
+
+        before = s_allocated;
+        for (auto& cur : nodeMaps[i])
+            oldMaps[i].emplace( cur.first, OldEvilNumber() );
+        oldBytes += s_allocated - before;
+
+        if (!FlatMapSameAs( flatMaps[i], nodeMaps[i] )) {
+            ::printf( "Attributes of item %u differ after load.\n", i );
+            return EXIT_FAILURE;
+        }
+        entries += nodeMaps[i].size();
+    }
+    oldMaps.clear();
+
+    ::printf( "%u items, %lu attributes (%.1f per item).\n", ITEMS, entries, entries / (double)ITEMS );
+    ::printf( "  memory:  std::map (old EvilNumber) %6.1f MB, std::map %6.1f MB, FlatMap %6.1f MB\n",
+              oldBytes / 1048576.0, nodeBytes / 1048576.0, flatBytes / 1048576.0 );
+    ::printf( "  load:    std::map %8.1f us, FlatMap %8.1f us\n", nodeLoad, flatLoad );
+
+    // lookups, about one in five misses as HasAttribute() checks do
+    std::vector<std::pair<uint32, uint16>> keys( LOOKUPS );
+    for (auto& cur : keys) {
+        cur.first = ::rand() % ITEMS;
+        if (::rand() % 5) {
+            NodeAttrMap::const_iterator itr = nodeMaps[cur.first].begin();
+            std::advance( itr, ::rand() % nodeMaps[cur.first].size() );
+            cur.second = itr->first;
+        } else {
+            cur.second = 1 + ::rand() % ATTRIBUTES;
+        }
+    }
+
+    uint32 nodeFound(0), flatFound(0);
+    double nodeSum(0), flatSum(0);
+    double start = GetTimeUSeconds();
+    for (auto& cur : keys) {
+        NodeAttrMap::iterator itr = nodeMaps[cur.first].find( cur.second );
+        if (itr != nodeMaps[cur.first].end()) {
+            ++nodeFound;
+            nodeSum += itr->second.get_double();
+        }
+    }
+    double nodeFind = GetTimeUSeconds() - start;
+    start = GetTimeUSeconds();
+    for (auto& cur : keys) {
+        FlatAttrMap::iterator itr = flatMaps[cur.first].find( cur.second );
+        if (itr != flatMaps[cur.first].end()) {
+            ++flatFound;
+            flatSum += itr->second.get_double();
+        }
+    }
+    double flatFind = GetTimeUSeconds() - start;
+    if ((nodeFound != flatFound) or (nodeSum != flatSum)) {
+        ::printf( "Lookups differ: std::map found %u, FlatMap found %u.\n", nodeFound, flatFound );
+        return EXIT_FAILURE;
+    }
+
+    // walk every map, as for item rows sent to client
+    nodeSum = flatSum = 0;
+    start = GetTimeUSeconds();
+    for (auto& map : nodeMaps)
+        for (auto& cur : map)
+            nodeSum += cur.second.get_double();
+    double nodeWalk = GetTimeUSeconds() - start;
+    start = GetTimeUSeconds();
+    for (auto& map : flatMaps)
+        for (auto& cur : map)
+            flatSum += cur.second.get_double();
+    double flatWalk = GetTimeUSeconds() - start;
+    if (nodeSum != flatSum) {
+        ::printf( "Walks differ.\n" );
+        return EXIT_FAILURE;
+    }
+
+    ::printf( "  find:    std::map %8.1f us, FlatMap %8.1f us for %u lookups (%u found)\n", nodeFind, flatFind, LOOKUPS, flatFound );
+    ::printf( "  walk:    std::map %8.1f us, FlatMap %8.1f us for all items\n", nodeWalk, flatWalk );
+
+    return EXIT_SUCCESS;
+}
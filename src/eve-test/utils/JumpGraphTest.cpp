@@ -0,0 +1,237 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "utils/JumpGraph.h"
+
+/*
+ * Builds a stargate graph shaped like New Eden's: 64 regions of 85 systems,
+ * each region a random tree with a few loops, joined to neighbouring regions
+ * through border systems.  Jump counts, routes and range searches are checked
+ * against a plain breadth-first search over the same jumps.
+ *
+ * Then 1M random jump count queries within regions (as market ranges and agent
+ * missions ask them) are timed, along with a smaller number across regions.
+ */
+
+static const uint32 REGIONS = 64;
+static const uint32 REGION_SYSTEMS = 85;
+static const uint32 FIRST_SYSTEM = 30000001;
+static const uint32 FIRST_REGION = 10000001;
+static const uint32 CHECKS = 2000;
+static const uint32 QUERIES = 1000000;
+static const uint32 CROSS_QUERIES = 1000;
+
+typedef std::map<uint32, std::vector<uint32> > JumpMap;
+
+static uint32 RandomSystem()
+{
+    return FIRST_SYSTEM + ::rand() % (REGIONS * REGION_SYSTEMS);
+}
+
+static uint32 RandomSystemInRegion( uint32 systemID )
+{
+    uint32 first = FIRST_SYSTEM + ((systemID - FIRST_SYSTEM) / REGION_SYSTEMS) * REGION_SYSTEMS;
+    return first + ::rand() % REGION_SYSTEMS;
+}
+
+static void Link( JumpGraph& graph, JumpMap& jumps, uint32 a, uint32 b )
+{
+    graph.AddJump( a, b );
+    graph.AddJump( b, a );
+    jumps[ a ].push_back( b );
+    jumps[ b ].push_back( a );
+}
+
+// jumps from given system to every system reached
+static void ReferenceSearch( const JumpMap& jumps, uint32 from, std::map<uint32, uint16>& into )
+{
+    into.clear();
+    into[ from ] = 0;
+    std::deque<uint32> queue( 1, from );
+    while( !queue.empty() ) {
+        uint32 cur = queue.front();
+        queue.pop_front();
+        JumpMap::const_iterator itr = jumps.find( cur );
+        if( itr == jumps.end() )
+            continue;
+        for( uint32 next : itr->second ) {
+            if( into.find( next ) != into.end() )
+                continue;
+            into[ next ] = into[ cur ] + 1;
+            queue.push_back( next );
+        }
+    }
+}
+
+static bool IsNeighbour( const JumpMap& jumps, uint32 a, uint32 b )
+{
+    JumpMap::const_iterator itr = jumps.find( a );
+    return (itr != jumps.end()) and (std::find( itr->second.begin(), itr->second.end(), b ) != itr->second.end());
+}
+
+int utils_JumpGraphTest( int argc, char* argv[] )
+{
+    ::srand( 42 );
+
+    JumpGraph graph;
+    JumpMap jumps;
+    std::map<uint32, float> security;
+
+    for( uint32 r = 0; r < REGIONS; ++r ) {
+        // regions run from high security to null security, with some spread
+        float base = 1.0f - (float)r / REGIONS * 1.2f;
+        uint32 first = FIRST_SYSTEM + r * REGION_SYSTEMS;
+        for( uint32 i = 0; i < REGION_SYSTEMS; ++i ) {
+            float sec = base + (::rand() % 40 - 20) / 100.0f;
+            security[ first + i ] = sec;
+            graph.AddSystem( first + i, FIRST_REGION + r, sec );
+        }
+        // random tree, then loops
+        for( uint32 i = 1; i < REGION_SYSTEMS; ++i )
+            Link( graph, jumps, first + i, first + ::rand() % i );
+        for( uint32 i = 0; i < REGION_SYSTEMS / 4; ++i ) {
+            uint32 a = first + ::rand() % REGION_SYSTEMS, b = first + ::rand() % REGION_SYSTEMS;
+            if( (a != b) and !IsNeighbour( jumps, a, b ) )
+                Link( graph, jumps, a, b );
+        }
+    }
+    // regions joined in a chain, plus random borders
+    for( uint32 r = 1; r < REGIONS; ++r )
+        Link( graph, jumps, FIRST_SYSTEM + r * REGION_SYSTEMS + ::rand() % REGION_SYSTEMS,
+                            FIRST_SYSTEM + (r - 1) * REGION_SYSTEMS + ::rand() % REGION_SYSTEMS );
+    for( uint32 i = 0; i < REGIONS * 2; ++i ) {
+        uint32 a = RandomSystem(), b = RandomSystem();
+        if( (a != b) and !IsNeighbour( jumps, a, b ) )
+            Link( graph, jumps, a, b );
+    }
+    // a system without gates, as wormhole systems are
+    graph.AddSystem( 31000001, 11000001, -1.0f );
+
+    double start = GetTimeUSeconds();
+    graph.Build();
+    double buildTime = GetTimeUSeconds() - start;
+
+    if( graph.GetJumps( 31000001, FIRST_SYSTEM ) != JumpGraph::NoRoute ) {
+        ::puts( "System without gates is reachable." );
+        return EXIT_FAILURE;
+    }
+    if( graph.GetJumps( FIRST_SYSTEM, 1 ) != JumpGraph::NoRoute ) {
+        ::puts( "Unknown system is reachable." );
+        return EXIT_FAILURE;
+    }
+
+    // jump counts and routes against reference search
+    std::map<uint32, uint16> reference;
+    for( uint32 i = 0; i < CHECKS; ++i ) {
+        uint32 from = RandomSystem();
+        uint32 to = (IsEven( i ) ? RandomSystemInRegion( from ) : RandomSystem());
+        ReferenceSearch( jumps, from, reference );
+
+        uint16 count = graph.GetJumps( from, to );
+        if( count != reference[ to ] ) {
+            ::printf( "Jumps from %u to %u: %u, expected %u.\n", from, to, count, reference[ to ] );
+            return EXIT_FAILURE;
+        }
+
+        std::vector<uint32> route;
+        if( !graph.GetRoute( from, to, JumpGraph::Shortest, route ) or (route.size() != count + 1u)
+        or (route.front() != from) or (route.back() != to) ) {
+            ::printf( "Shortest route from %u to %u is wrong (%lu systems for %u jumps).\n", from, to, route.size(), count );
+            return EXIT_FAILURE;
+        }
+        for( size_t j = 1; j < route.size(); ++j )
+            if( !IsNeighbour( jumps, route[ j - 1 ], route[ j ] ) ) {
+                ::printf( "Route from %u to %u jumps from %u to %u without a gate.\n", from, to, route[ j - 1 ], route[ j ] );
+                return EXIT_FAILURE;
+            }
+
+        // safer route may be longer, but never passes more low security systems than the shortest
+        std::vector<uint32> safer;
+        if( !graph.GetRoute( from, to, JumpGraph::Safer, safer ) or (safer.size() < route.size()) ) {
+            ::printf( "Safer route from %u to %u is wrong.\n", from, to );
+            return EXIT_FAILURE;
+        }
+        uint32 lowShortest = 0, lowSafer = 0;
+        for( size_t j = 1; j < route.size(); ++j )
+            lowShortest += (security[ route[ j ] ] < 0.45f ? 1 : 0);
+        for( size_t j = 1; j < safer.size(); ++j ) {
+            lowSafer += (security[ safer[ j ] ] < 0.45f ? 1 : 0);
+            if( !IsNeighbour( jumps, safer[ j - 1 ], safer[ j ] ) ) {
+                ::printf( "Safer route from %u to %u jumps from %u to %u without a gate.\n", from, to, safer[ j - 1 ], safer[ j ] );
+                return EXIT_FAILURE;
+            }
+        }
+        if( lowSafer > lowShortest ) {
+            ::printf( "Safer route from %u to %u passes %u low security systems, shortest passes %u.\n", from, to, lowSafer, lowShortest );
+            return EXIT_FAILURE;
+        }
+
+        // range search
+        if( i % 20 == 0 ) {
+            std::vector<uint32> inRange;
+            graph.GetSystemsInRange( from, 3, inRange );
+            std::sort( inRange.begin(), inRange.end() );
+            std::vector<uint32> expected;
+            for( auto cur : reference )
+                if( (cur.second > 0) and (cur.second <= 3) )
+                    expected.push_back( cur.first );
+            if( inRange != expected ) {
+                ::printf( "Systems within 3 jumps of %u differ (%lu, expected %lu).\n", from, inRange.size(), expected.size() );
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    // timings
+    std::vector<std::pair<uint32, uint32> > pairs( QUERIES );
+    for( auto& cur : pairs ) {
+        cur.first = RandomSystem();
+        cur.second = RandomSystemInRegion( cur.first );
+    }
+    uint64_t sum = 0;
+    start = GetTimeUSeconds();
+    for( const auto& cur : pairs )
+        sum += graph.GetJumps( cur.first, cur.second );
+    double queryTime = GetTimeUSeconds() - start;
+
+    for( uint32 i = 0; i < CROSS_QUERIES; ++i ) {
+        pairs[ i ].first = RandomSystem();
+        pairs[ i ].second = RandomSystem();
+    }
+    start = GetTimeUSeconds();
+    for( uint32 i = 0; i < CROSS_QUERIES; ++i )
+        sum += graph.GetJumps( pairs[ i ].first, pairs[ i ].second );
+    double crossTime = GetTimeUSeconds() - start;
+
+    ::printf( "%u systems, %u gates in %u regions; built in %.1f ms, %lu bytes of region tables.\n",
+              graph.GetSystemCount(), graph.GetGateCount(), graph.GetRegionCount(), buildTime / 1000, graph.GetTableSize() );
+    ::printf( "  %u jump counts within regions: %8.1f ms (%.1f ns each)\n", QUERIES, queryTime / 1000, queryTime * 1000 / QUERIES );
+    ::printf( "  %u jump counts across regions: %8.1f ms (%.1f us each)\n", CROSS_QUERIES, crossTime / 1000, crossTime / CROSS_QUERIES );
+    ::printf( "  (checksum %lu)\n", sum );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include <atomic>
+#include <thread>
+
+/*
+ * Logs through a LogWriter into a temporary file, written by calling threads and by the
+ * writer thread, as the server does with async logging off and on.
+ *
+ * Throughput: 4 threads each log 50000 records as fast as they can.
+ * Tick: a thread doing ~1ms of work per tick logs 100 records per tick, as trace categories
+ * do, while 3 others log steadily; tick times are printed.
+ *
+ * Every record must be in the file or counted as dropped.
+ */
+
+static const uint32 THREADS = 4;
+static const uint32 RECORDS = 50000;
+static const uint32 TICKS = 200;
+static const uint32 TICK_RECORDS = 100;
+
+static void WriterTestLog( LogWriter& writer, const char* fmt, ... )
+{
+    va_list ap;
+    va_start( ap, fmt );
+    writer.Write( LogWriter::Sys, 0, 0, "TEST__TRACE", 2, fmt, ap );
+    va_end( ap );
+}
+
+// counts lines in file, and lines reporting drops
+static void WriterTestCount( FILE* file, uint64_t& lines, uint64_t& reports )
+{
+    lines = reports = 0;
+    char buf[8192];
+    rewind( file );
+    while (fgets( buf, sizeof(buf), file ) != nullptr) {
+        if (strstr( buf, "[LogWriter]" ) != nullptr)
+            ++reports;
+        else
+            ++lines;
+    }
+}
+
+static double WriterTestBusy()
+{
+    // ~1ms of work standing in for a tick
+    double start = GetTimeUSeconds(), sum = 0;
+    while (GetTimeUSeconds() - start < 1000.0)
+        for (uint32 i = 0; i < 100; ++i)
+            sum += sqrt( (double)i );
+    return sum;
+}
+
+static bool WriterTestRun( bool async )
+{
+    FILE* file = tmpfile();
+    if (file == nullptr) {
+        ::printf( "Unable to open temporary file.\n" );
+        return false;
+    }
+
+    LogWriter writer;
+    writer.SetConsole( false );
+    writer.Open( LogWriter::Sys, file );
+    if (async and !writer.Start()) {
+        ::printf( "Unable to start writer thread.\n" );
+        return false;
+    }
+
+    // throughput
+    double start = GetTimeUSeconds();
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < THREADS; ++t)
+        threads.push_back( std::thread( [&writer, t]() {
+            for (uint32 i = 0; i < RECORDS; ++i)
+                WriterTestLog( writer, "thread %u record %u: destiny update for ball %u at (%.2f, %.2f, %.2f)", t, i, i * 7, i * 1.5, i * 2.5, i * 3.5 );
+        } ) );
+    for (auto& cur : threads)
+        cur.join();
+    double logged = GetTimeUSeconds() - start;
+    writer.Flush();
+    double written = GetTimeUSeconds() - start;
+    threads.clear();
+
+    // tick
+    std::atomic<bool> running( true );
+    std::atomic<uint64_t> sent( THREADS * RECORDS + TICKS * TICK_RECORDS );
+    for (uint32 t = 1; t < THREADS; ++t)
+        threads.push_back( std::thread( [&writer, &running, &sent, t]() {
+            uint32 i = 0;
+            while (running) {
+                WriterTestLog( writer, "thread %u packet %u received", t, ++i );
+                ++sent;
+                std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+            }
+        } ) );
+    std::vector<double> ticks;
+    for (uint32 tick = 0; tick < TICKS; ++tick) {
+        double tickStart = GetTimeUSeconds();
+        WriterTestBusy();
+        for (uint32 i = 0; i < TICK_RECORDS; ++i)
+            WriterTestLog( writer, "tick %u: npc %u targets ship %u", tick, i, i + 1000 );
+        ticks.push_back( GetTimeUSeconds() - tickStart );
+    }
+    running = false;
+    for (auto& cur : threads)
+        cur.join();
+
+    writer.Stop();
+    LogWriterStats stats;
+    writer.GetStats( stats );
+
+    uint64_t lines(0), reports(0);
+    fflush( file );
+    WriterTestCount( file, lines, reports );
+    writer.Close( LogWriter::Sys );
+
+    std::sort( ticks.begin(), ticks.end() );
+    double sum = 0;
+    for (auto cur : ticks)
+        sum += cur;
+
+    ::printf( "%s:\n", (async ? "writer thread" : "calling threads") );
+    ::printf( "  throughput: %8.0f records/s logged, %8.0f records/s written\n",
+              THREADS * RECORDS / (logged / 1e6), THREADS * RECORDS / (written / 1e6) );
+    ::printf( "  tick:       avg %7.1f us, p99 %7.1f us, max %7.1f us (%u records per tick, ~1000 us of work)\n",
+              sum / ticks.size(), ticks[ticks.size() * 99 / 100], ticks.back(), TICK_RECORDS );
+    ::printf( "  %lu records written, %lu dropped in %lu reports, %lu batches\n", lines, stats.dropped, reports, stats.batches );
+
+    if (lines + stats.dropped != sent) {
+        ::printf( "%lu records logged, %lu in file and %lu dropped.\n", sent.load(), lines, stats.dropped );
+        return false;
+    }
+    if (!async and (stats.dropped > 0)) {
+        ::printf( "Records dropped without writer thread.\n" );
+        return false;
+    }
+    if ((stats.dropped > 0) and (reports == 0)) {
+        ::printf( "Dropped records were not reported.\n" );
+        return false;
+    }
+    return true;
+}
+
+int utils_LogWriterTest( int argc, char* argv[] )
+{
+    if (!WriterTestRun( false ))
+        return EXIT_FAILURE;
+    if (!WriterTestRun( true ))
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
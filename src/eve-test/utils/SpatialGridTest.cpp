@@ -0,0 +1,228 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-test.h"
+
+#include "math/SpatialGrid.h"
+
+/*
+ * Fills a grid with 5000 entities spread over a solar system the way a busy
+ * system looks: most of them grouped at a few dozen grids (gates, belts, stations),
+ * the rest in warp between them.  Each round moves every entity, then runs
+ * aggro (radius), dscan (cone) and nearest-neighbour queries against the grid
+ * and against a linear search over all entities, as the server did it before.
+ * Results of both must match.
+ *
+ * Nearest-neighbour queries are also run with a range limit wider than a cell,
+ * as bubble lookups use them.
+ */
+
+static const uint32 ENTITIES = 5000;
+static const uint32 SITES = 40;
+static const uint32 ROUNDS = 10;
+static const double SYSTEM_RADIUS = 3.0e12;     // ~20AU
+static const double SITE_RADIUS = 200000.0;
+static const double AGGRO_RANGE = 30000.0;
+static const double DSCAN_RANGE = 2.1e12;       // 14.3AU
+static const uint32 NEAREST = 8;
+static const double NEAREST_RANGES[] = { 75000.0, 1.0e6, 1.0e11 };
+
+struct Ball
+{
+    uint32 id;
+    GPoint pos;
+    GVector vel;
+};
+
+static double Rand( double lo, double hi )
+{
+    return lo + (hi - lo) * (::rand() / (double)RAND_MAX);
+}
+
+static GPoint RandPoint( const GPoint& center, double radius )
+{
+    return center + GVector( Rand( -radius, radius ), Rand( -radius, radius ), Rand( -radius, radius ) );
+}
+
+static void LinearRadius( const std::vector<Ball>& balls, const GPoint& center, double radius, std::vector<const Ball*>& into )
+{
+    for (const Ball& cur : balls)
+        if (center.distance( cur.pos ) < radius)
+            into.push_back( &cur );
+}
+
+static void LinearCone( const std::vector<Ball>& balls, const GPoint& apex, const GVector& axis, double angle, double range, std::vector<const Ball*>& into )
+{
+    for (const Ball& cur : balls) {
+        if (apex.distance( cur.pos ) >= range)
+            continue;
+        GVector dir( apex, cur.pos );
+        dir.normalize();
+        if (acos( axis.dotProduct( dir ) ) < angle)
+            into.push_back( &cur );
+    }
+}
+
+static void LinearNearest( const std::vector<Ball>& balls, const GPoint& center, size_t count, std::vector<const Ball*>& into, double maxRange = 0 )
+{
+    std::vector<std::pair<double, const Ball*>> all;
+    for (const Ball& cur : balls)
+        if ((maxRange <= 0) or (center.distance( cur.pos ) < maxRange))
+            all.push_back( std::make_pair( center.distance( cur.pos ), &cur ) );
+    count = std::min( count, all.size() );
+    std::partial_sort( all.begin(), all.begin() + count, all.end() );
+    for (size_t i = 0; i < count; ++i)
+        into.push_back( all[i].second );
+}
+
+// few objects far apart in a fine grid: the search sphere covers more cells than are occupied
+//  long before it reaches range
+static bool CheckSparseNearest()
+{
+    std::vector<Ball> balls( 3 );
+    balls[0].pos = GPoint( 0, 0, 0 );
+    balls[1].pos = GPoint( 250, 0, 0 );
+    balls[2].pos = GPoint( 0, 900, 0 );
+
+    SpatialGrid<const Ball> grid( 100.0 );
+    for (const Ball& cur : balls)
+        grid.Insert( &cur, cur.pos );
+
+    std::vector<const Ball*> found;
+    grid.QueryNearest( GPoint( 0, 0, 0 ), 5, found, 1000.0 );
+    if ((found.size() != 3) or (found[0] != &balls[0]) or (found[1] != &balls[1]) or (found[2] != &balls[2])) {
+        ::printf( "Sparse nearest query within 1000m found %lu of 3.\n", found.size() );
+        return false;
+    }
+    found.clear();
+    grid.QueryNearest( GPoint( 0, 0, 0 ), 5, found, 500.0 );
+    if ((found.size() != 2) or (found[0] != &balls[0]) or (found[1] != &balls[1])) {
+        ::printf( "Sparse nearest query within 500m found %lu of 2.\n", found.size() );
+        return false;
+    }
+    return true;
+}
+
+static bool SameSet( std::vector<const Ball*> a, std::vector<const Ball*> b )
+{
+    std::sort( a.begin(), a.end() );
+    std::sort( b.begin(), b.end() );
+    return a == b;
+}
+
+int utils_SpatialGridTest( int argc, char* argv[] )
+{
+    ::srand( 42 );
+
+    if (!CheckSparseNearest())
+        return EXIT_FAILURE;
+
+    std::vector<GPoint> sites;
+    for (uint32 i = 0; i < SITES; ++i)
+        sites.push_back( RandPoint( GPoint( 0, 0, 0 ), SYSTEM_RADIUS ) );
+
+    std::vector<Ball> balls( ENTITIES );
+    for (uint32 i = 0; i < ENTITIES; ++i) {
+        Ball& ball = balls[i];
+        ball.id = i;
+        if (i % 10 == 0) {
+            // in warp, at ~3AU/s
+            ball.pos = RandPoint( GPoint( 0, 0, 0 ), SYSTEM_RADIUS );
+            ball.vel = RandPoint( GPoint( 0, 0, 0 ), 1.0 );
+            ball.vel.normalize();
+            ball.vel *= 4.5e11;
+        } else {
+            ball.pos = RandPoint( sites[i % SITES], SITE_RADIUS );
+            ball.vel = RandPoint( GPoint( 0, 0, 0 ), 300.0 );
+        }
+    }
+
+    SpatialGrid<const Ball> grid( 50000.0 );
+    for (const Ball& cur : balls)
+        grid.Insert( &cur, cur.pos );
+
+    for (uint32 round = 0; round < ROUNDS; ++round) {
+        // one destiny tic: every ball moves
+        for (Ball& cur : balls) {
+            cur.pos += cur.vel;
+            grid.Move( &cur, cur.pos );
+        }
+
+        // every npc-ish ball looks for targets in aggro range
+        for (uint32 i = 0; i < ENTITIES; i += 5) {
+            std::vector<const Ball*> a, b;
+            grid.QueryRadius( balls[i].pos, AGGRO_RANGE, a );
+            LinearRadius( balls, balls[i].pos, AGGRO_RANGE, b );
+            if (!SameSet( a, b )) {
+                ::printf( "Aggro query of %u differs: grid %lu, linear %lu.\n", i, a.size(), b.size() );
+                return EXIT_FAILURE;
+            }
+        }
+
+        // a few dscans, 60 degree cones
+        for (uint32 i = 1; i < ENTITIES; i += 250) {
+            GVector axis( RandPoint( GPoint( 0, 0, 0 ), 1.0 ) );
+            axis.normalize();
+            std::vector<const Ball*> a, b;
+            grid.QueryCone( balls[i].pos, axis, M_PI / 6, DSCAN_RANGE, a );
+            LinearCone( balls, balls[i].pos, axis, M_PI / 6, DSCAN_RANGE, b );
+            if (!SameSet( a, b )) {
+                ::printf( "Cone query of %u differs: grid %lu, linear %lu.\n", i, a.size(), b.size() );
+                return EXIT_FAILURE;
+            }
+        }
+
+        // nearest neighbours
+        for (uint32 i = 0; i < ENTITIES; i += 45) {
+            std::vector<const Ball*> a, b;
+            grid.QueryNearest( balls[i].pos, NEAREST, a );
+            LinearNearest( balls, balls[i].pos, NEAREST, b );
+            if (a != b) {
+                ::printf( "Nearest query of %u differs.\n", i );
+                return EXIT_FAILURE;
+            }
+            // in range only.  warping balls (every 10th, so every other one here) are far from everything
+            for (double range : NEAREST_RANGES) {
+                a.clear();
+                b.clear();
+                grid.QueryNearest( balls[i].pos, NEAREST, a, range );
+                LinearNearest( balls, balls[i].pos, NEAREST, b, range );
+                if (a != b) {
+                    ::printf( "Nearest query of %u within %.0fm differs: grid %lu, linear %lu.\n", i, range, a.size(), b.size() );
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
+
+    for (const Ball& cur : balls)
+        grid.Remove( &cur );
+    if (!grid.empty() or (grid.GetCellCount() != 0)) {
+        ::puts( "Grid not empty after removing all entities." );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
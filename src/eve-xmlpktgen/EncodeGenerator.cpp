@@ -35,6 +35,15 @@ ClassEncodeGenerator::ClassEncodeGenerator( FILE* outputFile )
     RegisterProcessors();
 }
 
+bool ClassEncodeGenerator::EncodeElement( const TiXmlElement* field, const char* name, const char* varName )
+{
+    mName = name;
+
+    // item numbers are not reset here, so temporaries stay unique within the file
+    push( varName );
+    return ParseElement( field );
+}
+
 bool ClassEncodeGenerator::ProcessElementDef( const TiXmlElement* field )
 {
     mName = field->Attribute( "name" );
@@ -274,7 +283,7 @@ bool ClassEncodeGenerator::ProcessBuffer( const TiXmlElement* field )
         "        PyIncRef(%s);\n"
         "    } else {\n"
         "        _log(NET__PACKET_WARNING, \"Encode %s: %s is null.  Encoding an empty buffer.\");\n"
-        "        %s = new PyBuffer( 0 );\n"
+        "        %s = new PyBuffer( Buffer() );\n"
         "    }\n"
         "\n",
         name,
@@ -34,6 +34,20 @@ class ClassEncodeGenerator
 public:
     ClassEncodeGenerator( FILE* outputFile = NULL );
 
+    /**
+     * @brief Generates code which encodes given element into given variable.
+     *
+     * Used by ClassEncodeToGenerator for the parts it cannot write directly.
+     *
+     * @param[in] field   The element to be encoded.
+     * @param[in] name    Name of the class being generated, for warnings.
+     * @param[in] varName Variable which receives encoded element.
+     *
+     * @retval true  Generation ran successfully.
+     * @retval false Error occured during generation.
+     */
+    bool EncodeElement( const TiXmlElement* field, const char* name, const char* varName );
+
 protected:
     const char* top() const { return mVariableStack.top().c_str(); }
     void pop() { mVariableStack.pop(); }
@@ -0,0 +1,635 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#include "eve-xmlpktgen.h"
+
+#include "EncodeToGenerator.h"
+
+ClassEncodeToGenerator::ClassEncodeToGenerator( FILE* outputFile )
+: Generator( outputFile ),
+  mItemNumber( 0 ),
+  mName( nullptr ),
+  mEncode( outputFile )
+{
+    RegisterProcessors();
+}
+
+void ClassEncodeToGenerator::SetOutputFile( FILE* outputFile )
+{
+    Generator::SetOutputFile( outputFile );
+    mEncode.SetOutputFile( outputFile );
+}
+
+bool ClassEncodeToGenerator::ProcessElementDef( const TiXmlElement* field )
+{
+    mName = field->Attribute( "name" );
+    if (mName == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: <element> at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    const TiXmlElement* main = field->FirstChildElement();
+    if (main->NextSiblingElement() != nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: <element> at line " << field->Row() << " contains more than one root element, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "bool %s::EncodeTo( MarshalStream& into ) const\n"
+        "{\n",
+        mName
+    );
+
+    mItemNumber = 0;
+    if (!ParseElement( main ) )
+        return false;
+
+    fprintf( mOutputFile,
+        "    return true;\n"
+        "}\n"
+        "\n"
+        "bool %s::EncodeTo( Buffer& into ) const\n"
+        "{\n"
+        "    MarshalStream ms;\n"
+        "    ms.BeginStream( into );\n"
+        "    bool res = EncodeTo( ms );\n"
+        "    ms.EndStream();\n"
+        "    return res;\n"
+        "}\n"
+        "\n",
+        mName
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessElement( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    if (!%s.EncodeTo( into ))\n"
+        "        return false;\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessElementPtr( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    if (%s == nullptr) {\n"
+        "        _log(NET__PACKET_WARNING, \"Encode %s: %s is null. Encoding a PyNone\");\n"
+        "        into.SaveNone();\n"
+        "    } else if (!%s->EncodeTo( into ))\n"
+        "        return false;\n",
+        name,
+            mName, name,
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessRaw( const TiXmlElement* field )
+{
+    return SaveRepOrNone( field, false );
+}
+
+bool ClassEncodeToGenerator::ProcessInt( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    const char* none_marker = field->Attribute( "none_marker" );
+    if (none_marker != nullptr)
+        fprintf( mOutputFile,
+            "    if (%s == %s )\n"
+            "        into.SaveNone();\n"
+            "    else\n",
+            name, none_marker
+        );
+
+    fprintf( mOutputFile,
+        "    into.SaveInteger( %s );\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessLong( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    const char* none_marker = field->Attribute( "none_marker" );
+    if (none_marker != nullptr)
+        fprintf( mOutputFile,
+            "    if (%s == %s )\n"
+            "        into.SaveNone();\n"
+            "    else\n",
+            name, none_marker
+        );
+
+    fprintf( mOutputFile,
+        "    into.SaveLong( %s );\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessReal( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    const char* none_marker = field->Attribute( "none_marker" );
+    if (none_marker != nullptr)
+        fprintf( mOutputFile,
+            "    if (%s == %s )\n"
+            "        into.SaveNone();\n"
+            "    else\n",
+            name, none_marker
+        );
+
+    fprintf( mOutputFile,
+        "    into.SaveReal( %s );\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessBool( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveBoolean( %s );\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessNone( const TiXmlElement* field )
+{
+    fprintf( mOutputFile,
+        "    into.SaveNone();\n"
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessBuffer( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    if (%s == nullptr) {\n"
+        "        _log(NET__PACKET_WARNING, \"Encode %s: %s is null.  Encoding an empty buffer.\");\n"
+        "        into.SaveBuffer( Buffer() );\n"
+        "    } else if (!into.SaveRep( %s ))\n"
+        "        return false;\n",
+        name,
+            mName, name,
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessString( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    const char* none_marker = field->Attribute( "none_marker" );
+    if (none_marker != nullptr)
+        fprintf( mOutputFile,
+            "    if (%s == \"%s\" )\n"
+            "        into.SaveNone();\n"
+            "    else\n",
+            name, none_marker
+        );
+
+    fprintf( mOutputFile,
+        "    into.SaveString( %s );\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessStringInline( const TiXmlElement* field )
+{
+    const char* value = field->Attribute( "value" );
+    if (value == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: String element at line " << field->Row() << " has no value attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveString( \"%s\", %zu );\n",
+        value, strlen( value )
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessWString( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    const char* none_marker = field->Attribute( "none_marker" );
+    if (none_marker != nullptr)
+        fprintf( mOutputFile,
+            "    if (%s == \"%s\" )\n"
+            "        into.SaveNone();\n"
+            "    else\n",
+            name, none_marker
+        );
+
+    fprintf( mOutputFile,
+        "    into.SaveWString( %s );\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessWStringInline( const TiXmlElement* field )
+{
+    const char* value = field->Attribute( "value" );
+    if (value == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: WString element at line " << field->Row() << " has no value attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveWString( \"%s\", %zu );\n",
+        value, strlen( value )
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessToken( const TiXmlElement* field )
+{
+    bool optional = false;
+    const char* optional_str = field->Attribute( "optional" );
+    if (optional_str != nullptr)
+        optional = str2<bool>( optional_str );
+
+    return SaveRepOrNone( field, optional );
+}
+
+bool ClassEncodeToGenerator::ProcessTokenInline( const TiXmlElement* field )
+{
+    const char* value = field->Attribute( "value" );
+    if (value == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: Token element at line " << field->Row() << " has no type attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveToken( \"%s\", %zu );\n",
+        value, strlen( value )
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessObject( const TiXmlElement* field )
+{
+    bool optional = false;
+    const char* optional_str = field->Attribute( "optional" );
+    if (optional_str != nullptr)
+        optional = str2<bool>( optional_str );
+
+    return SaveRepOrNone( field, optional );
+}
+
+bool ClassEncodeToGenerator::ProcessObjectInline( const TiXmlElement* field )
+{
+    fprintf( mOutputFile,
+        "    into.SaveObjectHeader();\n"
+    );
+
+    // type string, then arguments
+    return ParseElementChildren( field, 2 );
+}
+
+bool ClassEncodeToGenerator::ProcessObjectEx( const TiXmlElement* field )
+{
+    bool optional = false;
+    const char* optional_str = field->Attribute( "optional" );
+    if (optional_str != nullptr)
+        optional = str2<bool>( optional_str );
+
+    return SaveRepOrNone( field, optional );
+}
+
+bool ClassEncodeToGenerator::ProcessTuple( const TiXmlElement* field )
+{
+    return SaveContainer( field, "SaveTupleSize( 0 )", "an empty tuple" );
+}
+
+bool ClassEncodeToGenerator::ProcessTupleInline( const TiXmlElement* field )
+{
+    const TiXmlNode* i = nullptr;
+
+    uint32 count = 0;
+    while( ( i = field->IterateChildren( i ) ) )
+    {
+        if (i->Type() == TiXmlNode::TINYXML_ELEMENT )
+            count++;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveTupleSize( %u );\n",
+        count
+    );
+
+    return ParseElementChildren( field );
+}
+
+bool ClassEncodeToGenerator::ProcessList( const TiXmlElement* field )
+{
+    return SaveContainer( field, "SaveListSize( 0 )", "an empty list" );
+}
+
+bool ClassEncodeToGenerator::ProcessListInline( const TiXmlElement* field )
+{
+    const TiXmlNode* i = nullptr;
+
+    uint32 count = 0;
+    while( ( i = field->IterateChildren( i ) ) )
+    {
+        if (i->Type() == TiXmlNode::TINYXML_ELEMENT )
+            count++;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveListSize( %u );\n",
+        count
+    );
+
+    return ParseElementChildren( field );
+}
+
+bool ClassEncodeToGenerator::ProcessListInt( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveListSize( (uint32)%s.size() );\n"
+        "    for (auto cur : %s)\n"
+        "        into.SaveInteger( cur );\n",
+        name,
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessListLong( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveListSize( (uint32)%s.size() );\n"
+        "    for (auto cur : %s)\n"
+        "        into.SaveLong( cur );\n",
+        name,
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessListStr( const TiXmlElement* field )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    fprintf( mOutputFile,
+        "    into.SaveListSize( (uint32)%s.size() );\n"
+        "    for (auto& cur : %s)\n"
+        "        into.SaveString( cur );\n",
+        name,
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::ProcessDict( const TiXmlElement* field )
+{
+    return SaveContainer( field, "SaveDictSize( 0 )", "an empty dict" );
+}
+
+bool ClassEncodeToGenerator::ProcessDictInline( const TiXmlElement* field )
+{
+    return SaveEncoded( field );
+}
+
+bool ClassEncodeToGenerator::ProcessDictRaw( const TiXmlElement* field )
+{
+    return SaveEncoded( field );
+}
+
+bool ClassEncodeToGenerator::ProcessDictInt( const TiXmlElement* field )
+{
+    return SaveEncoded( field );
+}
+
+bool ClassEncodeToGenerator::ProcessDictStr( const TiXmlElement* field )
+{
+    return SaveEncoded( field );
+}
+
+bool ClassEncodeToGenerator::ProcessSubStreamInline( const TiXmlElement* field )
+{
+    // substream data is a marshal stream of its own, with its own header
+    return SaveEncoded( field );
+}
+
+bool ClassEncodeToGenerator::ProcessSubStructInline( const TiXmlElement* field )
+{
+    fprintf( mOutputFile,
+        "    into.SaveSubStructHeader();\n"
+    );
+
+    return ParseElementChildren( field, 1 );
+}
+
+bool ClassEncodeToGenerator::SaveRepOrNone( const TiXmlElement* field, bool optional )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    if (optional)
+        fprintf( mOutputFile,
+            "    if (%s == nullptr)\n"
+            "        into.SaveNone();\n",
+            name
+        );
+    else
+        fprintf( mOutputFile,
+            "    if (%s == nullptr) {\n"
+            "        _log(NET__PACKET_WARNING, \"Encode %s: %s is null.  Encoding a PyNone\");\n"
+            "        into.SaveNone();\n"
+            "    }",
+            name,
+                mName, name
+        );
+
+    fprintf( mOutputFile,
+        "%s else if (!into.SaveRep( %s ))\n"
+        "        return false;\n",
+        (optional ? "   " : ""), name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::SaveContainer( const TiXmlElement* field, const char* emptyCall, const char* desc )
+{
+    const char* name = field->Attribute( "name" );
+    if (name == nullptr) {
+        std::cout << std::endl <<  "ClassEncodeToGenerator:: field at line " << field->Row() << " is missing the name attribute, skipping.";
+        return false;
+    }
+
+    bool optional = false;
+    const char* optional_str = field->Attribute( "optional" );
+    if (optional_str != nullptr)
+        optional = str2<bool>( optional_str );
+
+    fprintf( mOutputFile,
+        "    if (%s == nullptr) {\n"
+        "        _log(NET__PACKET_WARNING, \"Encode %s: %s is null.  Encoding %s.\");\n"
+        "        into.%s;\n"
+        "    }",
+        name,
+            mName, name, desc,
+            emptyCall
+    );
+
+    if (optional)
+        fprintf( mOutputFile,
+            " else if (%s->empty())\n"
+            "        into.SaveNone();\n"
+            "   ",
+            name
+        );
+
+    fprintf( mOutputFile,
+        " else if (!into.SaveRep( %s ))\n"
+        "        return false;\n",
+        name
+    );
+
+    return true;
+}
+
+bool ClassEncodeToGenerator::SaveEncoded( const TiXmlElement* field )
+{
+    char varname[16];
+    snprintf( varname, sizeof( varname ), "enc%u", mItemNumber++ );
+
+    fprintf( mOutputFile,
+        "    {\n"
+        "    PyRep* %s(nullptr);\n",
+        varname
+    );
+
+    if (!mEncode.EncodeElement( field, mName, varname ) )
+        return false;
+
+    fprintf( mOutputFile,
+        "    bool res = into.SaveRep( %s );\n"
+        "    PyDecRef( %s );\n"
+        "    if (!res)\n"
+        "        return false;\n"
+        "    }\n",
+        varname,
+        varname
+    );
+
+    return true;
+}
@@ -0,0 +1,104 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+    Author:        EVEmu Team
+*/
+
+#ifndef __ENCODETOGENERATOR_H_INCL__
+#define __ENCODETOGENERATOR_H_INCL__
+
+#include "EncodeGenerator.h"
+
+/**
+ * @brief Generates EncodeTo(), which writes marshal opcodes of a packet straight to a MarshalStream.
+ *
+ * Output is byte-for-byte what marshaling the result of Encode() gives, without building
+ * the PyRep tree first.  Fields which already are PyReps are visited as they are.
+ *
+ * Dict contents are marshaled in hash order of the built PyDict, so dicts built by Encode()
+ * (dictInline, dictRaw, dictInt, dictStr) and substreams, which are marshaled on their own,
+ * are still built by ClassEncodeGenerator code and then visited.
+ */
+class ClassEncodeToGenerator
+: public Generator
+{
+public:
+    ClassEncodeToGenerator( FILE* outputFile = NULL );
+
+    /** Sets output file of this and the fallback encode generator. */
+    void SetOutputFile( FILE* outputFile );
+
+protected:
+    bool ProcessElementDef( const TiXmlElement* field );
+    bool ProcessElement( const TiXmlElement* field );
+    bool ProcessElementPtr( const TiXmlElement* field );
+
+    bool ProcessRaw( const TiXmlElement* field );
+    bool ProcessInt( const TiXmlElement* field );
+    bool ProcessLong( const TiXmlElement* field );
+    bool ProcessReal( const TiXmlElement* field );
+    bool ProcessBool( const TiXmlElement* field );
+    bool ProcessNone( const TiXmlElement* field );
+    bool ProcessBuffer( const TiXmlElement* field );
+
+    bool ProcessString( const TiXmlElement* field );
+    bool ProcessStringInline( const TiXmlElement* field );
+    bool ProcessWString( const TiXmlElement* field );
+    bool ProcessWStringInline( const TiXmlElement* field );
+    bool ProcessToken( const TiXmlElement* field );
+    bool ProcessTokenInline( const TiXmlElement* field );
+
+    bool ProcessObject( const TiXmlElement* field );
+    bool ProcessObjectInline( const TiXmlElement* field );
+    bool ProcessObjectEx( const TiXmlElement* field );
+
+    bool ProcessTuple( const TiXmlElement* field );
+    bool ProcessTupleInline( const TiXmlElement* field );
+    bool ProcessList( const TiXmlElement* field );
+    bool ProcessListInline( const TiXmlElement* field );
+    bool ProcessListInt( const TiXmlElement* field );
+    bool ProcessListLong( const TiXmlElement* field );
+    bool ProcessListStr( const TiXmlElement* field );
+    bool ProcessDict( const TiXmlElement* field );
+    bool ProcessDictInline( const TiXmlElement* field );
+    bool ProcessDictRaw( const TiXmlElement* field );
+    bool ProcessDictInt( const TiXmlElement* field );
+    bool ProcessDictStr( const TiXmlElement* field );
+
+    bool ProcessSubStreamInline( const TiXmlElement* field );
+    bool ProcessSubStructInline( const TiXmlElement* field );
+
+    /** writes a PyRep* member, or PyNone when it is null */
+    bool SaveRepOrNone( const TiXmlElement* field, bool optional );
+    /** writes a container member; null is written as empty, and empty as PyNone when optional */
+    bool SaveContainer( const TiXmlElement* field, const char* emptyCall, const char* desc );
+    /** builds element with ClassEncodeGenerator code, then visits it */
+    bool SaveEncoded( const TiXmlElement* field );
+
+private:
+    uint32 mItemNumber;
+    const char* mName;
+
+    ClassEncodeGenerator mEncode;
+};
+
+#endif
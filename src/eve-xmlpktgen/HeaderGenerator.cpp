@@ -88,6 +88,8 @@ bool ClassHeaderGenerator::ProcessElementDef( const TiXmlElement* field )
         "    bool Decode(PyRep** packet);\n"
         "    bool Decode(%s** packet);\n"
         "    %s* Encode() const;\n"
+        "    bool EncodeTo(MarshalStream& into) const;\n"
+        "    bool EncodeTo(Buffer& into) const;\n"
         "\n"
         "    %s& operator=(const %s& oth);\n"
         "\n",
@@ -96,6 +96,8 @@ bool XMLPacketGen::ParseElements( const TiXmlElement* field )
         "\n"
         "#include \"python/PyVisitor.h\"\n"
         "#include \"python/PyRep.h\"\n"
+        "\n"
+        "class MarshalStream;\n"
         "\n",
         smGenFileComment,
         def.c_str(),
@@ -106,6 +108,8 @@ bool XMLPacketGen::ParseElements( const TiXmlElement* field )
         "\n"
         "#include \"eve-common.h\"\n"
         "\n"
+        "#include \"marshal/EVEMarshal.h\"\n"
+        "\n"
         "#include \"%s\"\n"
         "\n",
         smGenFileComment,
@@ -113,10 +117,24 @@ bool XMLPacketGen::ParseElements( const TiXmlElement* field )
     );
 
     //content
+    mElementNames.clear();
     bool res = ParseElementChildren( field );
 
     //footers:
+    // list of all elements, as X(name), so tests may check each of them
     fprintf( mHeaderFile,
+        "#define %s(X)",
+        FNameToListDef( mHeaderFileName ).c_str()
+    );
+    for( const std::string& cur : mElementNames )
+        fprintf( mHeaderFile,
+            " \\\n"
+            "    X(%s)",
+            cur.c_str()
+        );
+    fprintf( mHeaderFile,
+        "\n"
+        "\n"
         "#endif /* !%s */\n"
         "\n",
         def.c_str()
@@ -150,8 +168,12 @@ bool XMLPacketGen::ParseElementDef( const TiXmlElement* field )
                  && mDestruct.ParseElement( field )
                  && mDump.ParseElement( field )
                  && mEncode.ParseElement( field )
+                 && mEncodeTo.ParseElement( field )
                  && mHeader.ParseElement( field ) );
 
+    if( res )
+        mElementNames.push_back( field->Attribute( "name" ) );
+
     return res;
 }
 
@@ -188,6 +210,7 @@ void XMLPacketGen::SetSourceFile( const char* source )
             mDestruct.SetOutputFile( NULL );
             mDump.SetOutputFile( NULL );
             mEncode.SetOutputFile( NULL );
+            mEncodeTo.SetOutputFile( NULL );
         }
 
         mSourceFileName = source;
@@ -226,6 +249,7 @@ bool XMLPacketGen::OpenFiles()
             mDestruct.SetOutputFile( mSourceFile );
             mDump.SetOutputFile( mSourceFile );
             mEncode.SetOutputFile( mSourceFile );
+            mEncodeTo.SetOutputFile( mSourceFile );
         }
     }
 
@@ -249,6 +273,28 @@ std::string XMLPacketGen::FNameToDef( const char* buf )
     return res;
 }
 
+std::string XMLPacketGen::FNameToListDef( const std::string& fname )
+{
+    // base name without extension, as "packets/Destiny.h" -> "DESTINY_ELEMENTS"
+    size_t slash = fname.find_last_of( "/\\" );
+    slash = ( std::string::npos == slash ? 0 : slash + 1 );
+    size_t dot = fname.rfind( '.' );
+    if( std::string::npos == dot || dot < slash )
+        dot = fname.length();
+
+    std::string res;
+    for( size_t i = slash; i < dot; ++i )
+    {
+        if( !IsPrintable( fname[i] ) || fname[i] == '-' || fname[i] == '.' )
+            res += '_';
+        else
+            res += (char)toupper( fname[i] );
+    }
+
+    res += "_ELEMENTS";
+    return res;
+}
+
 
 
 
@@ -31,6 +31,7 @@
 #include "DestructGenerator.h"
 #include "DumpGenerator.h"
 #include "EncodeGenerator.h"
+#include "EncodeToGenerator.h"
 #include "DecodeGenerator.h"
 #include "CloneGenerator.h"
 #include "utils/XMLParserEx.h"
@@ -97,9 +98,14 @@ private:
     ClassDestructGenerator    mDestruct;
     ClassDumpGenerator        mDump;
     ClassEncodeGenerator    mEncode;
+    ClassEncodeToGenerator  mEncodeTo;
     ClassHeaderGenerator    mHeader;
 
+    /** names of elements generated into current files, listed at the end of header */
+    std::vector<std::string> mElementNames;
+
     static std::string FNameToDef( const char* buf );
+    static std::string FNameToListDef( const std::string& fname );
 
     static const char* const smGenFileComment;
 };